@@ -1544,6 +1544,422 @@ extern bt_interrupter *bt_graph_borrow_default_interrupter(bt_graph *graph)
 
 /*! @} */
 
+/*!
+@name Statistics
+@{
+*/
+
+/*!
+@brief
+    Makes the components of the trace processing graph \bt_p{graph}
+    update performance counters.
+
+When a trace processing graph has statistics enabled, the library
+measures, for each \bt_comp of the graph:
+
+<dl>
+  <dt>\bt_c_src_comp or \bt_c_flt_comp</dt>
+  <dd>
+    The number of created \bt_p_msg_iter, and, for all of them, the
+    number of \ref api-msg-iter-cls-meth-next "next" method calls,
+    of returned \bt_p_msg, and of calls which returned
+    #BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN, as well as the
+    time spent in the "next" method, including and excluding the
+    time spent in the "next" method of upstream message iterators.
+  </dd>
+
+  <dt>\bt_c_sink_comp</dt>
+  <dd>
+    The number of \ref api-comp-cls-dev-meth-consume "consume"
+    method calls, as well as the time spent in the "consume" method,
+    including and excluding the time spent in the "next" method of
+    upstream message iterators.
+  </dd>
+</dl>
+
+Get the performance counters with bt_graph_get_statistics().
+
+The library doesn't measure anything when you don't call this
+function.
+
+@param[in] graph
+    Trace processing graph of which to enable the statistics.
+
+@bt_pre_not_null{graph}
+@pre
+    \bt_p{graph} was not run yet: you didn't call bt_graph_run() or
+    bt_graph_run_once() with it.
+
+@sa bt_graph_get_statistics() &mdash;
+    Returns the performance counters of the components of a trace
+    processing graph.
+*/
+extern void bt_graph_enable_statistics(bt_graph *graph) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Status codes for bt_graph_get_statistics().
+*/
+typedef enum bt_graph_get_statistics_status {
+	/*!
+	@brief
+	    Success.
+	*/
+	BT_GRAPH_GET_STATISTICS_STATUS_OK		= __BT_FUNC_STATUS_OK,
+
+	/*!
+	@brief
+	    Out of memory.
+	*/
+	BT_GRAPH_GET_STATISTICS_STATUS_MEMORY_ERROR	= __BT_FUNC_STATUS_MEMORY_ERROR,
+} bt_graph_get_statistics_status;
+
+/*!
+@brief
+    Returns the performance counters of the components of the trace
+    processing graph \bt_p{graph}.
+
+On success, \bt_p{*statistics} is an \bt_array_val of which each
+element is a \bt_map_val containing the performance counters of one
+component of \bt_p{graph}, in the order in which you added the
+components. Each map value has the following entries:
+
+<dl>
+  <dt><code>component-name</code></dt>
+  <dd>Name of the component (\bt_string_val).</dd>
+
+  <dt><code>component-class-type</code></dt>
+  <dd>
+    Type of the class of the component (\bt_string_val):
+    <code>source</code>, <code>filter</code>, or <code>sink</code>.
+  </dd>
+
+  <dt><code>component-class-name</code></dt>
+  <dd>Name of the class of the component (\bt_string_val).</dd>
+
+  <dt><code>retained-memory-peak-size</code></dt>
+  <dd>
+    Peak size of the memory which the component and its message
+    iterators reported to retain, in bytes (\bt_uint_val; see
+    \ref api-graph-memory "Memory limit").
+  </dd>
+</dl>
+
+For a \bt_src_comp or a \bt_flt_comp, the map value also has the
+following \bt_p_uint_val entries:
+
+<dl>
+  <dt><code>message-iterator-count</code></dt>
+  <dd>Number of created message iterators.</dd>
+
+  <dt><code>next-calls</code></dt>
+  <dd>Number of "next" method calls.</dd>
+
+  <dt><code>messages</code></dt>
+  <dd>Number of returned messages.</dd>
+
+  <dt><code>again-count</code></dt>
+  <dd>
+    Number of "next" method calls which returned
+    #BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN.
+  </dd>
+
+  <dt><code>next-inclusive-time-ns</code></dt>
+  <dd>Time spent in the "next" method (ns).</dd>
+
+  <dt><code>next-exclusive-time-ns</code></dt>
+  <dd>
+    Time spent in the "next" method, excluding the time spent in the
+    "next" method of upstream message iterators (ns).
+  </dd>
+</dl>
+
+For a \bt_sink_comp, the map value also has the following
+\bt_p_uint_val entries:
+
+<dl>
+  <dt><code>consume-calls</code></dt>
+  <dd>Number of "consume" method calls.</dd>
+
+  <dt><code>consume-inclusive-time-ns</code></dt>
+  <dd>Time spent in the "consume" method (ns).</dd>
+
+  <dt><code>consume-exclusive-time-ns</code></dt>
+  <dd>
+    Time spent in the "consume" method, excluding the time spent in
+    the "next" method of upstream message iterators (ns).
+  </dd>
+</dl>
+
+@param[in] graph
+    Trace processing graph of which to get the performance counters.
+@param[out] statistics
+    <strong>On success</strong>, \bt_p{*statistics} is a new
+    reference of the performance counters of the components of
+    \bt_p{graph}.
+
+@retval #BT_GRAPH_GET_STATISTICS_STATUS_OK
+    Success.
+@retval #BT_GRAPH_GET_STATISTICS_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{graph}
+@pre
+    bt_graph_enable_statistics() was called with \bt_p{graph}.
+@bt_pre_not_null{statistics}
+
+@sa bt_graph_enable_statistics() &mdash;
+    Makes the components of a trace processing graph update
+    performance counters.
+*/
+extern bt_graph_get_statistics_status bt_graph_get_statistics(
+		const bt_graph *graph, const bt_value **statistics)
+		__BT_NOEXCEPT;
+
+/*! @} */
+
+/*!
+@name Memory limit
+@{
+
+@anchor api-graph-memory
+
+Components which keep \bt_p_msg or other data around, for example in
+a queue, report the size of the memory they retain with
+bt_self_component_add_retained_memory_size() and
+bt_self_component_remove_retained_memory_size(). When the graph has a
+memory limit, the library also reports the \bt_p_msg which it keeps for
+the auto-seek feature of a \bt_msg_iter (see
+bt_message_iterator_seek_ns_from_origin()).
+
+When a trace processing graph has a memory limit, a component can get
+how much memory it may still retain with
+bt_self_component_get_remaining_memory_budget(). When there's no
+budget left, a component is expected to stop buffering, for example by
+reading less data from its upstream message iterators or medium at
+once, instead of growing its buffers further.
+
+The library doesn't enforce the limit: it's a budget which the
+components share.
+*/
+
+/*!
+@brief
+    Sets the memory limit of the trace processing graph \bt_p{graph}
+    to \bt_p{limit} bytes.
+
+@param[in] graph
+    Trace processing graph of which to set the memory limit.
+@param[in] limit
+    New memory limit of \bt_p{graph} (bytes).
+
+@bt_pre_not_null{graph}
+@pre
+    \bt_p{graph} was not run yet: you didn't call bt_graph_run() or
+    bt_graph_run_once() with it.
+@pre
+    \bt_p{limit} is greater than 0.
+
+@sa bt_graph_get_retained_memory_size() &mdash;
+    Returns the size of the memory which the components of a trace
+    processing graph currently retain.
+@sa bt_self_component_get_remaining_memory_budget() &mdash;
+    Returns how much memory a component may still retain.
+*/
+extern void bt_graph_set_memory_limit(bt_graph *graph, uint64_t limit)
+		__BT_NOEXCEPT;
+
+/*!
+@brief
+    Returns the size of the memory which the components of the trace
+    processing graph \bt_p{graph} currently report to retain, in bytes.
+
+@param[in] graph
+    Trace processing graph of which to get the retained memory size.
+
+@returns
+    Size of the memory which the components of \bt_p{graph} retain
+    (bytes).
+
+@bt_pre_not_null{graph}
+
+@sa bt_graph_set_memory_limit() &mdash;
+    Sets the memory limit of a trace processing graph.
+*/
+extern uint64_t bt_graph_get_retained_memory_size(const bt_graph *graph)
+		__BT_NOEXCEPT;
+
+/*! @} */
+
+/*!
+@name Message pools
+@{
+
+@anchor api-graph-msg-pools
+
+To avoid allocating and freeing memory for each \bt_ev_msg,
+\bt_pb_msg, and \bt_pe_msg, a trace processing graph keeps the messages
+which are not used anymore in pools to reuse them later.
+
+By default, a message pool is initially empty and has no maximum size:
+after a burst of messages, the pool keeps all of them for the lifetime
+of the graph.
+
+You can:
+
+- Make the message pools of a trace processing graph allocate messages
+  when you first run the graph with
+  bt_graph_set_message_pool_prewarm_count().
+
+- Set the maximum size of the message pools of a trace processing graph
+  with bt_graph_set_message_pool_max_size(). When a message pool is
+  full, the library destroys the messages which are not used anymore
+  instead of keeping them. For an event message, the library also
+  destroys its \bt_ev instead of keeping it for later reuse.
+
+- Get the counters of the message pools of a trace processing graph
+  with bt_graph_get_message_pool_statistics().
+*/
+
+/*!
+@brief
+    Sets the maximum size of each message pool of the trace processing
+    graph \bt_p{graph} to \bt_p{max_size} messages.
+
+@param[in] graph
+    Trace processing graph of which to set the maximum size of the
+    message pools.
+@param[in] max_size
+    New maximum size of each message pool of \bt_p{graph} (number of
+    messages).
+
+@bt_pre_not_null{graph}
+@pre
+    \bt_p{graph} was not run yet: you didn't call bt_graph_run() or
+    bt_graph_run_once() with it.
+@pre
+    \bt_p{max_size} is greater than 0.
+
+@sa bt_graph_set_message_pool_prewarm_count() &mdash;
+    Sets the number of messages to allocate in each message pool of a
+    trace processing graph when you first run it.
+*/
+extern void bt_graph_set_message_pool_max_size(bt_graph *graph,
+		uint64_t max_size) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Sets the number of messages to allocate in each message pool of the
+    trace processing graph \bt_p{graph} when you first run it to
+    \bt_p{count}.
+
+When you first call bt_graph_run() or bt_graph_run_once() with
+\bt_p{graph}, the library allocates \bt_p{count} messages (or the
+maximum size of the pool, if it's less) in each message pool of
+\bt_p{graph}. If this allocation fails, bt_graph_run() or
+bt_graph_run_once() returns #BT_GRAPH_RUN_STATUS_MEMORY_ERROR or
+#BT_GRAPH_RUN_ONCE_STATUS_MEMORY_ERROR.
+
+@param[in] graph
+    Trace processing graph of which to set the message pool pre-warm
+    count.
+@param[in] count
+    Number of messages to allocate in each message pool of \bt_p{graph}.
+
+@bt_pre_not_null{graph}
+@pre
+    \bt_p{graph} was not run yet: you didn't call bt_graph_run() or
+    bt_graph_run_once() with it.
+
+@sa bt_graph_set_message_pool_max_size() &mdash;
+    Sets the maximum size of each message pool of a trace processing
+    graph.
+*/
+extern void bt_graph_set_message_pool_prewarm_count(bt_graph *graph,
+		uint64_t count) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Status codes for bt_graph_get_message_pool_statistics().
+*/
+typedef enum bt_graph_get_message_pool_statistics_status {
+	/*!
+	@brief
+	    Success.
+	*/
+	BT_GRAPH_GET_MESSAGE_POOL_STATISTICS_STATUS_OK			= __BT_FUNC_STATUS_OK,
+
+	/*!
+	@brief
+	    Out of memory.
+	*/
+	BT_GRAPH_GET_MESSAGE_POOL_STATISTICS_STATUS_MEMORY_ERROR	= __BT_FUNC_STATUS_MEMORY_ERROR,
+} bt_graph_get_message_pool_statistics_status;
+
+/*!
+@brief
+    Returns the counters of the message pools of the trace processing
+    graph \bt_p{graph}.
+
+On success, \bt_p{*statistics} is a \bt_map_val with the following
+entries, one for each message pool of \bt_p{graph}:
+
+<dl>
+  <dt><code>event</code></dt>
+  <dd>\bt_c_ev_msg pool.</dd>
+
+  <dt><code>packet-beginning</code></dt>
+  <dd>\bt_c_pb_msg pool.</dd>
+
+  <dt><code>packet-end</code></dt>
+  <dd>\bt_c_pe_msg pool.</dd>
+</dl>
+
+Each entry is a map value with the following \bt_p_uint_val entries:
+
+<dl>
+  <dt><code>hits</code></dt>
+  <dd>Number of messages which the library took from the pool.</dd>
+
+  <dt><code>misses</code></dt>
+  <dd>
+    Number of messages which the library allocated because the pool
+    was empty.
+  </dd>
+
+  <dt><code>discards</code></dt>
+  <dd>
+    Number of messages which the library destroyed because the pool
+    was full.
+  </dd>
+
+  <dt><code>size</code></dt>
+  <dd>Current number of messages in the pool.</dd>
+
+  <dt><code>peak-size</code></dt>
+  <dd>Largest number of messages in the pool so far.</dd>
+</dl>
+
+@param[in] graph
+    Trace processing graph of which to get the message pool counters.
+@param[out] statistics
+    <strong>On success</strong>, \bt_p{*statistics} is a new
+    reference of the message pool counters of \bt_p{graph}.
+
+@retval #BT_GRAPH_GET_MESSAGE_POOL_STATISTICS_STATUS_OK
+    Success.
+@retval #BT_GRAPH_GET_MESSAGE_POOL_STATISTICS_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{graph}
+@bt_pre_not_null{statistics}
+*/
+extern bt_graph_get_message_pool_statistics_status
+bt_graph_get_message_pool_statistics(const bt_graph *graph,
+		const bt_value **statistics) __BT_NOEXCEPT;
+
+/*! @} */
+
 /*!
 @name Listeners
 @{
@@ -1028,6 +1028,29 @@ typedef enum bt_message_type {
 extern bt_message_type bt_message_get_type(const bt_message *message)
 		__BT_NOEXCEPT;
 
+/*!
+@brief
+    Returns an estimate of the size of the memory which the message
+    \bt_p{message} retains, in bytes.
+
+For an \bt_ev_msg, this includes the size of the \bt_p_field of its
+\bt_ev. This doesn't include the size of shared objects such as
+\bt_p_stream, \bt_p_pkt, and classes.
+
+Use this function to report the memory which a component retains with
+bt_self_component_add_retained_memory_size().
+
+@param[in] message
+    Message of which to get the retained memory size.
+
+@returns
+    Estimated size of the memory which \bt_p{message} retains (bytes).
+
+@bt_pre_not_null{message}
+*/
+extern uint64_t bt_message_get_retained_memory_size(
+		const bt_message *message) __BT_NOEXCEPT;
+
 /*! @} */
 
 /*!
@@ -37,6 +37,9 @@ bt_self_component_port_borrow_component().
 Get the user data attached to a port with
 bt_self_component_port_get_data().
 
+Tell the upstream \bt_msg_iter of an input port which \bt_ev fields you
+need with bt_self_component_port_input_set_needed_event_fields().
+
 \ref api-fund-c-typing "Upcast" the "self" (private) types to the
 public and common self component port types with the
 <code>bt_self_component_port*_as_port*()</code> and
@@ -119,6 +122,89 @@ extern void *bt_self_component_port_get_data(
 
 /*! @} */
 
+/*!
+@name Needed event fields
+@{
+*/
+
+/*!
+@brief
+    Needed event field enumerators.
+*/
+typedef enum bt_self_component_port_input_needed_event_fields {
+	/*!
+	@brief
+	    Common context field (see bt_event_borrow_common_context_field()).
+	*/
+	BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_COMMON_CONTEXT		= 1 << 0,
+
+	/*!
+	@brief
+	    Specific context field (see bt_event_borrow_specific_context_field()).
+	*/
+	BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_SPECIFIC_CONTEXT	= 1 << 1,
+
+	/*!
+	@brief
+	    Payload field (see bt_event_borrow_payload_field()).
+	*/
+	BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_PAYLOAD		= 1 << 2,
+
+	/*!
+	@brief
+	    All the event fields.
+	*/
+	BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_ALL			=
+		BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_COMMON_CONTEXT |
+		BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_SPECIFIC_CONTEXT |
+		BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_PAYLOAD,
+} bt_self_component_port_input_needed_event_fields;
+
+/*!
+@brief
+    Sets the \bt_ev fields which the component of the \bt_iport
+    \bt_p{self_component_port} needs to \bt_p{needed_event_fields}.
+
+This is a hint for the upstream \bt_msg_iter: a \bt_msg_iter which
+bt_message_iterator_create_from_message_iterator() or
+bt_message_iterator_create_from_sink_component() creates afterwards on
+\bt_p{self_component_port} can get it with
+bt_self_message_iterator_get_needed_event_fields() and avoid decoding the
+event fields which are not part of \bt_p{needed_event_fields}.
+
+The event fields which are not part of \bt_p{needed_event_fields} still
+exist when their event class has a field class for them, but their
+values are unspecified: don't read them.
+
+A filter which passes event messages downstream as is must only declare,
+on its input ports, the event fields which the components downstream of
+its output ports need (see
+bt_self_message_iterator_get_needed_event_fields()).
+
+By default, a component needs all the event fields
+(#BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_ALL).
+
+@param[in] self_component_port
+    Input port of which to set the needed event fields.
+@param[in] needed_event_fields
+    Bitwise OR of #bt_self_component_port_input_needed_event_fields
+    enumerators (0 means none).
+
+@bt_pre_not_null{self_component_port}
+@pre
+    \bt_p{needed_event_fields} only contains
+    #bt_self_component_port_input_needed_event_fields enumerators.
+
+@sa bt_self_message_iterator_get_needed_event_fields() &mdash;
+    Returns the event fields which the downstream component of a
+    message iterator needs.
+*/
+extern void bt_self_component_port_input_set_needed_event_fields(
+		bt_self_component_port_input *self_component_port,
+		uint64_t needed_event_fields) __BT_NOEXCEPT;
+
+/*! @} */
+
 /*!
 @name Self to public upcast
 @{
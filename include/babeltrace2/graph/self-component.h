@@ -59,6 +59,12 @@ bt_self_component_set_data() and bt_self_component_get_data().
 Get a component's owning trace processing \bt_graph's effective
 \bt_mip version with bt_self_component_get_graph_mip_version().
 
+Report the memory which a component retains with
+bt_self_component_add_retained_memory_size() and
+bt_self_component_remove_retained_memory_size(), and get how much
+memory it may still retain with
+bt_self_component_get_remaining_memory_budget().
+
 Check whether or not a \bt_sink_comp is interrupted with
 bt_self_component_sink_is_interrupted().
 
@@ -659,6 +665,90 @@ uint64_t bt_self_component_get_graph_mip_version(
 
 /*! @} */
 
+/*!
+@name Memory accounting
+@{
+*/
+
+/*!
+@brief
+    Reports that the \bt_comp \bt_p{self_component}, or one of its
+    \bt_p_msg_iter, now retains \bt_p{size} more bytes of memory.
+
+Call this function when a component starts keeping data around, for
+example \bt_p_msg in a queue or a data buffer, and
+bt_self_component_remove_retained_memory_size() when it releases it.
+
+Use bt_message_get_retained_memory_size() to get an estimate of the
+size of the memory which a message retains.
+
+@param[in] self_component
+    Component instance.
+@param[in] size
+    Size of the additional memory which \bt_p{self_component}
+    retains (bytes).
+
+@bt_pre_not_null{self_component}
+
+@sa bt_self_component_remove_retained_memory_size() &mdash;
+    Reports that a component retains less memory.
+@sa bt_self_component_get_remaining_memory_budget() &mdash;
+    Returns how much memory a component may still retain.
+*/
+extern void bt_self_component_add_retained_memory_size(
+		bt_self_component *self_component, uint64_t size)
+		__BT_NOEXCEPT;
+
+/*!
+@brief
+    Reports that the \bt_comp \bt_p{self_component}, or one of its
+    \bt_p_msg_iter, now retains \bt_p{size} fewer bytes of memory.
+
+@param[in] self_component
+    Component instance.
+@param[in] size
+    Size of the memory which \bt_p{self_component} released (bytes).
+
+@bt_pre_not_null{self_component}
+@pre
+    \bt_p{self_component} retains at least \bt_p{size} bytes, as
+    reported with bt_self_component_add_retained_memory_size().
+
+@sa bt_self_component_add_retained_memory_size() &mdash;
+    Reports that a component retains more memory.
+*/
+extern void bt_self_component_remove_retained_memory_size(
+		bt_self_component *self_component, uint64_t size)
+		__BT_NOEXCEPT;
+
+/*!
+@brief
+    Returns how much memory the \bt_comp \bt_p{self_component} may
+    still retain, in bytes, according to the memory limit of its
+    trace processing \bt_graph.
+
+The budget is shared by all the components of the graph: it's the
+graph's memory limit minus the size of the memory which all its
+components currently retain.
+
+@param[in] self_component
+    Component instance.
+
+@returns
+    Remaining memory budget of \bt_p{self_component} (bytes), 0 if
+    the components of its graph already retain at least as much memory
+    as its limit, or \c UINT64_MAX if its graph has no memory limit.
+
+@bt_pre_not_null{self_component}
+
+@sa bt_graph_set_memory_limit() &mdash;
+    Sets the memory limit of a trace processing graph.
+*/
+extern uint64_t bt_self_component_get_remaining_memory_budget(
+		const bt_self_component *self_component) __BT_NOEXCEPT;
+
+/*! @} */
+
 /*!
 @name Sink component's interruption query
 @{
@@ -42,6 +42,10 @@ bt_self_message_iterator_get_data().
 Check whether or not a message iterator is interrupted with
 bt_self_message_iterator_is_interrupted().
 
+Make a message iterator pass the messages of one of its upstream
+message iterators through as is with
+bt_self_message_iterator_set_pass_through().
+
 Set whether or not a message iterator can seek forward with
 bt_self_message_iterator_configuration_set_can_seek_forward().
 */
@@ -192,6 +196,100 @@ extern bt_bool bt_self_message_iterator_is_interrupted(
 
 /*! @} */
 
+/*!
+@name Needed event fields
+@{
+*/
+
+/*!
+@brief
+    Returns the \bt_ev fields which the downstream \bt_comp of the
+    \bt_msg_iter \bt_p{self_message_iterator} needs.
+
+The downstream component sets this hint on its \bt_iport with
+bt_self_component_port_input_set_needed_event_fields() before it creates
+\bt_p{self_message_iterator}.
+
+\bt_p{self_message_iterator} may skip decoding the event fields which
+are not part of the returned value: their values are then unspecified.
+
+@param[in] self_message_iterator
+    Message iterator instance.
+
+@returns
+    Bitwise OR of #bt_self_component_port_input_needed_event_fields
+    enumerators which the downstream component of
+    \bt_p{self_message_iterator} needs.
+
+@bt_pre_not_null{self_message_iterator}
+*/
+extern uint64_t bt_self_message_iterator_get_needed_event_fields(
+		const bt_self_message_iterator *self_message_iterator)
+		__BT_NOEXCEPT;
+
+/*! @} */
+
+/*!
+@name Pass-through
+@{
+*/
+
+/*!
+@brief
+    Makes the \bt_msg_iter \bt_p{self_message_iterator} pass the
+    messages of its upstream message iterator
+    \bt_p{upstream_message_iterator} through as is until it reclaims
+    control.
+
+While a message iterator passes through, the library doesn't call its
+\link api-msg-iter-cls-meth-next "next" method\endlink anymore: the
+\link api-msg-iter-cls-meth-next "next" method\endlink of
+\bt_p{self_message_iterator} directly returns the message batches that
+bt_message_iterator_next() returns for \bt_p{upstream_message_iterator}.
+
+As soon as such a batch contains at least one \bt_msg of which the type
+is part of \bt_p{reclaim_message_types}, \bt_p{self_message_iterator}
+stops passing through: the library calls its
+\link api-msg-iter-cls-meth-next "next" method\endlink again, and the
+next call to bt_message_iterator_next() with
+\bt_p{upstream_message_iterator} returns this same batch.
+
+When bt_message_iterator_next() returns
+#BT_MESSAGE_ITERATOR_NEXT_STATUS_END for \bt_p{upstream_message_iterator}
+while \bt_p{self_message_iterator} passes through,
+\bt_p{self_message_iterator} also ends.
+
+Seeking \bt_p{self_message_iterator} makes it stop passing through.
+
+Call this function with \bt_p{upstream_message_iterator} set to
+\c NULL to make \bt_p{self_message_iterator} stop passing through.
+
+@param[in] self_message_iterator
+    Message iterator instance.
+@param[in] upstream_message_iterator
+    @parblock
+    Upstream message iterator of which to pass the messages through.
+
+    Can be \c NULL.
+    @endparblock
+@param[in] reclaim_message_types
+    Bitwise OR of #bt_message_type enumerators of which one message
+    in a batch of \bt_p{upstream_message_iterator} makes
+    \bt_p{self_message_iterator} stop passing through.
+
+@bt_pre_not_null{self_message_iterator}
+@pre
+    If not \c NULL, \bt_p{upstream_message_iterator} was created
+    with bt_message_iterator_create_from_message_iterator(), passing
+    \bt_p{self_message_iterator}, and is not ended.
+*/
+extern void bt_self_message_iterator_set_pass_through(
+		bt_self_message_iterator *self_message_iterator,
+		bt_message_iterator *upstream_message_iterator,
+		uint64_t reclaim_message_types) __BT_NOEXCEPT;
+
+/*! @} */
+
 /*!
 @name Configuration
 @{
@@ -9,6 +9,8 @@
 #include "logging/log.h"
 
 #include <stdbool.h>
+#include <sys/stat.h>
+#include <glib/gstdio.h>
 
 #include "autodisc.h"
 #include "common/common.h"
@@ -373,7 +375,13 @@ auto_source_discovery_internal_status support_info_query_all_sources(
 		goto error;
 	}
 
-	for (i_plugins = 0; i_plugins < plugin_count; i_plugins++) {
+	/*
+	 * Stop querying as soon as a component class claims `input` with
+	 * the maximum weight: as the first component class with the
+	 * highest weight wins, no other component class can win.
+	 */
+	for (i_plugins = 0; i_plugins < plugin_count && winner.weight < 1.0;
+			i_plugins++) {
 		const bt_plugin *plugin;
 		const char *plugin_name;
 		uint64_t source_count;
@@ -384,7 +392,9 @@ auto_source_discovery_internal_status support_info_query_all_sources(
 
 		source_count = bt_plugin_get_source_component_class_count(plugin);
 
-		for (i_sources = 0; i_sources < source_count; i_sources++) {
+		for (i_sources = 0;
+				i_sources < source_count && winner.weight < 1.0;
+				i_sources++) {
 			const bt_component_class_source *source_cc;
 			const bt_component_class *cc;
 			const char *source_cc_name;
@@ -566,6 +576,73 @@ auto_source_discovery_internal_status auto_discover_source_for_input_as_string(
 		interrupter);
 }
 
+static
+gint compare_dir_entry_names(gconstpointer a, gconstpointer b)
+{
+	return strcmp(*(const char * const *) a, *(const char * const *) b);
+}
+
+/*
+ * Read the names of all the entries of directory `path` into `names`,
+ * sorted so that the discovery order, and therefore the result, does
+ * not depend on the file system's order.
+ */
+static
+auto_source_discovery_internal_status read_sorted_dir_entry_names(
+		const char *path, GPtrArray *names, bt_logging_level log_level)
+{
+	auto_source_discovery_internal_status status;
+	GError *error = NULL;
+	GDir *dir;
+	const gchar *dirent;
+
+	dir = g_dir_open(path, 0, &error);
+	if (!dir) {
+#define BT_FMT "Failed to open directory %s: %s"
+		BT_LOGW(BT_FMT, path, error->message);
+
+		if (error->code == G_FILE_ERROR_ACCES) {
+			/* This is not a fatal error, we just skip it. */
+			status = AUTO_SOURCE_DISCOVERY_INTERNAL_STATUS_NO_MATCH;
+			goto end;
+		} else {
+			BT_AUTODISC_LOGE_APPEND_CAUSE(BT_FMT, path,
+				error->message);
+			goto error;
+		}
+#undef BT_FMT
+	}
+
+	do {
+		errno = 0;
+		dirent = g_dir_read_name(dir);
+		if (dirent) {
+			g_ptr_array_add(names, g_strdup(dirent));
+		} else if (errno != 0) {
+			BT_LOGW_ERRNO("Failed to read directory entry", ": dir=%s", path);
+			goto error;
+		}
+	} while (dirent);
+
+	g_ptr_array_sort(names, compare_dir_entry_names);
+	status = AUTO_SOURCE_DISCOVERY_INTERNAL_STATUS_OK;
+	goto end;
+
+error:
+	status = AUTO_SOURCE_DISCOVERY_INTERNAL_STATUS_ERROR;
+
+end:
+	if (dir) {
+		g_dir_close(dir);
+	}
+
+	if (error) {
+		g_error_free(error);
+	}
+
+	return status;
+}
+
 static
 auto_source_discovery_internal_status auto_discover_source_for_input_as_dir_or_file_rec(
 		GString *input,
@@ -578,18 +655,22 @@ auto_source_discovery_internal_status auto_discover_source_for_input_as_dir_or_f
 		const bt_interrupter *interrupter)
 {
 	auto_source_discovery_internal_status status;
-	GError *error = NULL;
-	GDir *dir = NULL;
+	GPtrArray *dir_entry_names = NULL;
+	GStatBuf st;
+	bool stat_ok;
+
+	/* One stat(2) call per entry: a trace can contain many files */
+	stat_ok = g_stat(input->str, &st) == 0;
 
-	if (g_file_test(input->str, G_FILE_TEST_IS_REGULAR)) {
+	if (stat_ok && S_ISREG(st.st_mode)) {
 		/* It's a file. */
 		status = support_info_query_all_sources(input->str,
 			"file", original_input_index, plugins, plugin_count,
 			component_class_restrict, log_level, auto_disc,
 			interrupter);
-	} else if (g_file_test(input->str, G_FILE_TEST_IS_DIR)) {
-		const gchar *dirent;
+	} else if (stat_ok && S_ISDIR(st.st_mode)) {
 		gsize saved_input_len;
+		guint i;
 		int dir_status = AUTO_SOURCE_DISCOVERY_INTERNAL_STATUS_NO_MATCH;
 
 		/* It's a directory. */
@@ -610,52 +691,42 @@ auto_source_discovery_internal_status auto_discover_source_for_input_as_dir_or_f
 			goto end;
 		}
 
-		dir = g_dir_open(input->str, 0, &error);
-		if (!dir) {
-#define BT_FMT "Failed to open directory %s: %s"
-			BT_LOGW(BT_FMT, input->str, error->message);
+		dir_entry_names = g_ptr_array_new_with_free_func(g_free);
+		if (!dir_entry_names) {
+			BT_AUTODISC_LOGE_APPEND_CAUSE("Failed to allocate a GPtrArray.");
+			goto error;
+		}
 
-			if (error->code == G_FILE_ERROR_ACCES) {
-				/* This is not a fatal error, we just skip it. */
-				status = AUTO_SOURCE_DISCOVERY_INTERNAL_STATUS_NO_MATCH;
-				goto end;
-			} else {
-				BT_AUTODISC_LOGE_APPEND_CAUSE(BT_FMT, input->str,
-					error->message);
-				goto error;
-			}
-#undef BT_FMT
+		status = read_sorted_dir_entry_names(input->str,
+			dir_entry_names, log_level);
+		if (status != AUTO_SOURCE_DISCOVERY_INTERNAL_STATUS_OK) {
+			/* Fatal error or inaccessible directory. */
+			goto end;
 		}
 
 		saved_input_len = input->len;
 
-		do {
-			errno = 0;
-			dirent = g_dir_read_name(dir);
-			if (dirent) {
-				g_string_append_c_inline(input, G_DIR_SEPARATOR);
-				g_string_append(input, dirent);
-
-				status = auto_discover_source_for_input_as_dir_or_file_rec(
-					input, original_input_index, plugins, plugin_count,
-					component_class_restrict, log_level, auto_disc,
-					interrupter);
-
-				g_string_truncate(input, saved_input_len);
-
-				if (status < 0) {
-					/* Fatal error. */
-					goto error;
-				} else if (status == AUTO_SOURCE_DISCOVERY_INTERNAL_STATUS_INTERRUPTED) {
-					goto end;
-				} else if (status == AUTO_SOURCE_DISCOVERY_INTERNAL_STATUS_OK) {
-					dir_status = AUTO_SOURCE_DISCOVERY_INTERNAL_STATUS_OK;
-				}
-			} else if (errno != 0) {
-				BT_LOGW_ERRNO("Failed to read directory entry", ": dir=%s", input->str);
+		for (i = 0; i < dir_entry_names->len; i++) {
+			g_string_append_c_inline(input, G_DIR_SEPARATOR);
+			g_string_append(input,
+				g_ptr_array_index(dir_entry_names, i));
+
+			status = auto_discover_source_for_input_as_dir_or_file_rec(
+				input, original_input_index, plugins, plugin_count,
+				component_class_restrict, log_level, auto_disc,
+				interrupter);
+
+			g_string_truncate(input, saved_input_len);
+
+			if (status < 0) {
+				/* Fatal error. */
 				goto error;
+			} else if (status == AUTO_SOURCE_DISCOVERY_INTERNAL_STATUS_INTERRUPTED) {
+				goto end;
+			} else if (status == AUTO_SOURCE_DISCOVERY_INTERNAL_STATUS_OK) {
+				dir_status = AUTO_SOURCE_DISCOVERY_INTERNAL_STATUS_OK;
 			}
-		} while (dirent);
+		}
 
 		status = dir_status;
 	} else {
@@ -669,12 +740,8 @@ error:
 	status = AUTO_SOURCE_DISCOVERY_INTERNAL_STATUS_ERROR;
 
 end:
-	if (dir) {
-		g_dir_close(dir);
-	}
-
-	if (error) {
-		g_error_free(error);
+	if (dir_entry_names) {
+		g_ptr_array_free(dir_entry_names, TRUE);
 	}
 
 	return status;
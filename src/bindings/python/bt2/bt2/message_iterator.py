@@ -37,7 +37,7 @@ class _UserComponentInputPortMessageIterator(
         self._at = 0
         super().__init__(ptr)
 
-    def __next__(self):
+    def _fill_current_msgs(self):
         if len(self._current_msgs) == self._at:
             status, msgs = native_bt.bt2_self_component_port_input_get_msg_range(
                 self._ptr
@@ -48,11 +48,29 @@ class _UserComponentInputPortMessageIterator(
             self._current_msgs = msgs
             self._at = 0
 
+    def __next__(self):
+        self._fill_current_msgs()
+
         msg_ptr = self._current_msgs[self._at]
         self._at += 1
 
         return bt2_message._create_from_ptr(msg_ptr)
 
+    # Returns a list of the next messages: the messages which this
+    # iterator already got from its upstream message iterator, but which
+    # __next__ didn't return yet, if any, or otherwise the next batch of
+    # messages from its upstream message iterator.
+    #
+    # Raises the same exceptions as __next__.
+    def next_batch(self):
+        self._fill_current_msgs()
+
+        msg_ptrs = self._current_msgs[self._at :]
+        self._current_msgs = []
+        self._at = 0
+
+        return [bt2_message._create_from_ptr(msg_ptr) for msg_ptr in msg_ptrs]
+
     def can_seek_beginning(self):
         (status, res) = native_bt.message_iterator_can_seek_beginning(self._ptr)
         bt2_utils._handle_func_status(
@@ -170,7 +188,13 @@ class _UserMessageIterator(_MessageIterator):
     def __next__(self):
         raise bt2_utils.Stop
 
-    def _bt_next_from_native(self):
+    def _bt_next_from_native(self, capacity):
+        # If the user iterator has a _user_next_batch method, then fill
+        # up to `capacity` messages of the native message array with a
+        # single call. Otherwise, call __next__ to get one message.
+        if hasattr(self, "_user_next_batch"):
+            return self._bt_next_batch_from_native(capacity)
+
         # this can raise anything: it's caught by the native part
         try:
             msg = next(self)
@@ -187,6 +211,39 @@ class _UserMessageIterator(_MessageIterator):
         msg._get_ref(msg._ptr)
         return int(msg._ptr)
 
+    def _bt_next_batch_from_native(self, capacity):
+        # this can raise anything: it's caught by the native part
+        try:
+            msgs = self._user_next_batch(capacity)
+        except StopIteration:
+            raise bt2_utils.Stop
+
+        msgs = list(msgs)
+
+        if len(msgs) == 0:
+            raise ValueError("_user_next_batch() returned no messages")
+
+        if len(msgs) > capacity:
+            raise ValueError(
+                "_user_next_batch() returned too many messages: "
+                "count={}, capacity={}".format(len(msgs), capacity)
+            )
+
+        # Check all the messages before acquiring any reference so that
+        # a failure doesn't leak references.
+        for msg in msgs:
+            bt2_utils._check_type(msg, bt2_message._MessageConst)
+
+        # Same as in _bt_next_from_native(): the references we return
+        # will be given to the message array.
+        addrs = []
+
+        for msg in msgs:
+            msg._get_ref(msg._ptr)
+            addrs.append(int(msg._ptr))
+
+        return addrs
+
     def _bt_can_seek_beginning_from_native(self):
         # Here, we mimic the behavior of the C API:
         #
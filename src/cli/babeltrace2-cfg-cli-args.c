@@ -852,6 +852,7 @@ enum {
 	OPT_INPUT_FORMAT,
 	OPT_LIST,
 	OPT_LOG_LEVEL,
+	OPT_MEMORY_LIMIT,
 	OPT_NAMES,
 	OPT_NO_DELTA,
 	OPT_OMIT_HOME_PLUGIN_PATH,
@@ -864,6 +865,7 @@ enum {
 	OPT_RETRY_DURATION,
 	OPT_RUN_ARGS,
 	OPT_RUN_ARGS_0,
+	OPT_STATS,
 	OPT_STREAM_INTERSECTION,
 	OPT_TIMERANGE,
 	OPT_VERBOSE,
@@ -1864,6 +1866,67 @@ end:
 	return status;
 }
 
+/*
+ * Parses the argument `arg` of the --memory-limit option, a size in
+ * bytes with an optional `K`, `M`, or `G` binary suffix, into
+ * `*limit`.
+ *
+ * Returns 0 on success, or -1 on error, appending an error cause.
+ */
+static
+int parse_memory_limit(const char *arg, uint64_t *limit)
+{
+	int ret = 0;
+	gchar *end;
+	guint64 value;
+	unsigned int shift = 0;
+
+	if (!g_ascii_isdigit(arg[0])) {
+		goto error;
+	}
+
+	errno = 0;
+	value = g_ascii_strtoull(arg, &end, 10);
+	if (errno == ERANGE) {
+		goto error;
+	}
+
+	switch (*end) {
+	case '\0':
+		break;
+	case 'K':
+		shift = 10;
+		end++;
+		break;
+	case 'M':
+		shift = 20;
+		end++;
+		break;
+	case 'G':
+		shift = 30;
+		end++;
+		break;
+	default:
+		goto error;
+	}
+
+	if (*end != '\0' || value == 0 || value > (UINT64_MAX >> shift)) {
+		goto error;
+	}
+
+	*limit = (uint64_t) value << shift;
+	goto end;
+
+error:
+	BT_CLI_LOGE_APPEND_CAUSE(
+		"Invalid --memory-limit option's argument: expecting a positive size in bytes, optionally followed by `K`, `M`, or `G`: `%s`",
+		arg);
+	ret = -1;
+
+end:
+	return ret;
+}
+
 /*
  * Prints the run command usage.
  */
@@ -1887,6 +1950,8 @@ void print_run_usage(FILE *fp)
 	fprintf(fp, "                                    expected format of CONNECTION below)\n");
 	fprintf(fp, "  -l, --log-level=LVL               Set the log level of the current component to LVL\n");
 	fprintf(fp, "                                    (`N`, `T`, `D`, `I`, `W`, `E`, or `F`)\n");
+	fprintf(fp, "      --memory-limit=SIZE           Make the components retain at most about\n");
+	fprintf(fp, "                                    SIZE bytes (suffixes: `K`, `M`, `G`)\n");
 	fprintf(fp, "  -p, --params=PARAMS               Add initialization parameters PARAMS to the\n");
 	fprintf(fp, "                                    current component (see the expected format\n");
 	fprintf(fp, "                                    of PARAMS below)\n");
@@ -1895,6 +1960,9 @@ void print_run_usage(FILE *fp)
 	fprintf(fp, "      --retry-duration=DUR          When babeltrace2(1) needs to retry to run\n");
 	fprintf(fp, "                                    the graph later, retry in DUR µs\n");
 	fprintf(fp, "                                    (default: 100000)\n");
+	fprintf(fp, "      --stats                       Print the performance counters of each\n");
+	fprintf(fp, "                                    component to the standard error when the\n");
+	fprintf(fp, "                                    graph ends\n");
 	fprintf(fp, "  -h, --help                        Show this help and quit\n");
 	fprintf(fp, "\n");
 	fprintf(fp, "See `babeltrace2 --help` for the list of general options.\n");
@@ -1965,9 +2033,11 @@ enum bt_config_cli_args_status bt_config_run_from_args(int argc, const char *arg
 		{ OPT_CONNECT, 'x', "connect", true },
 		{ OPT_HELP, 'h', "help", false },
 		{ OPT_LOG_LEVEL, 'l', "log-level", true },
+		{ OPT_MEMORY_LIMIT, '\0', "memory-limit", true },
 		{ OPT_PARAMS, 'p', "params", true },
 		{ OPT_RESET_BASE_PARAMS, 'r', "reset-base-params", false },
 		{ OPT_RETRY_DURATION, '\0', "retry-duration", true },
+		{ OPT_STATS, '\0', "stats", false },
 		ARGPAR_OPT_DESCR_SENTINEL
 	};
 
@@ -2179,6 +2249,16 @@ enum bt_config_cli_args_status bt_config_run_from_args(int argc, const char *arg
 				(uint64_t) retry_duration;
 			break;
 		}
+		case OPT_MEMORY_LIMIT:
+			if (parse_memory_limit(arg,
+					&cfg->cmd_data.run.memory_limit)) {
+				goto error;
+			}
+
+			break;
+		case OPT_STATS:
+			cfg->cmd_data.run.stats = true;
+			break;
 		default:
 			bt_common_abort();
 		}
@@ -2287,6 +2367,8 @@ void print_convert_usage(FILE *fp)
 	fprintf(fp, "                                    NAME\n");
 	fprintf(fp, "  -l, --log-level=LVL               Set the log level of the current component to LVL\n");
 	fprintf(fp, "                                    (`N`, `T`, `D`, `I`, `W`, `E`, or `F`)\n");
+	fprintf(fp, "      --memory-limit=SIZE           Make the components retain at most about\n");
+	fprintf(fp, "                                    SIZE bytes (suffixes: `K`, `M`, `G`)\n");
 	fprintf(fp, "  -p, --params=PARAMS               Add initialization parameters PARAMS to the\n");
 	fprintf(fp, "                                    current component (see the expected format\n");
 	fprintf(fp, "                                    of PARAMS below)\n");
@@ -2300,6 +2382,9 @@ void print_convert_usage(FILE *fp)
 	fprintf(fp, "      --run-args-0                  Print the equivalent arguments for the\n");
 	fprintf(fp, "                                    `run` command to the standard output,\n");
 	fprintf(fp, "                                    formatted for `xargs -0`, and quit\n");
+	fprintf(fp, "      --stats                       Print the performance counters of each\n");
+	fprintf(fp, "                                    component to the standard error when the\n");
+	fprintf(fp, "                                    graph ends\n");
 	fprintf(fp, "      --stream-intersection         Only process events when all streams\n");
 	fprintf(fp, "                                    are active\n");
 	fprintf(fp, "  -h, --help                        Show this help and quit\n");
@@ -2414,6 +2499,7 @@ const struct argpar_opt_descr convert_options[] = {
 	{ OPT_HELP, 'h', "help", false },
 	{ OPT_INPUT_FORMAT, 'i', "input-format", true },
 	{ OPT_LOG_LEVEL, 'l', "log-level", true },
+	{ OPT_MEMORY_LIMIT, '\0', "memory-limit", true },
 	{ OPT_NAMES, 'n', "names", true },
 	{ OPT_DEBUG_INFO, '\0', "debug-info", false },
 	{ OPT_NO_DELTA, '\0', "no-delta", false },
@@ -2425,6 +2511,7 @@ const struct argpar_opt_descr convert_options[] = {
 	{ OPT_RETRY_DURATION, '\0', "retry-duration", true },
 	{ OPT_RUN_ARGS, '\0', "run-args", false },
 	{ OPT_RUN_ARGS_0, '\0', "run-args-0", false },
+	{ OPT_STATS, '\0', "stats", false },
 	{ OPT_STREAM_INTERSECTION, '\0', "stream-intersection", false },
 	{ OPT_TIMERANGE, '\0', "timerange", true },
 	{ OPT_VERBOSE, 'v', "verbose", false },
@@ -3699,6 +3786,25 @@ enum bt_config_cli_args_status bt_config_convert_from_args(int argc,
 					goto error;
 				}
 				break;
+			case OPT_MEMORY_LIMIT:
+				if (bt_value_array_append_string_element(run_args,
+						"--memory-limit")) {
+					BT_CLI_LOGE_APPEND_CAUSE_OOM();
+					goto error;
+				}
+
+				if (bt_value_array_append_string_element(run_args, arg)) {
+					BT_CLI_LOGE_APPEND_CAUSE_OOM();
+					goto error;
+				}
+				break;
+			case OPT_STATS:
+				if (bt_value_array_append_string_element(run_args,
+						"--stats")) {
+					BT_CLI_LOGE_APPEND_CAUSE_OOM();
+					goto error;
+				}
+				break;
 			case OPT_BEGIN:
 			case OPT_CLOCK_CYCLES:
 			case OPT_CLOCK_DATE:
@@ -4066,7 +4172,9 @@ enum bt_config_cli_args_status bt_config_convert_from_args(int argc,
 		case OPT_OMIT_SYSTEM_PLUGIN_PATH:
 		case OPT_PARAMS:
 		case OPT_PLUGIN_PATH:
+		case OPT_MEMORY_LIMIT:
 		case OPT_RETRY_DURATION:
+		case OPT_STATS:
 			/* Ignore in this pass */
 			break;
 		default:
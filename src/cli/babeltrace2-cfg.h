@@ -73,6 +73,18 @@ struct bt_config {
 			 */
 			uint64_t retry_duration_us;
 
+			/*
+			 * Whether or not to print the performance
+			 * counters of the graph when it ends.
+			 */
+			bool stats;
+
+			/*
+			 * Memory limit of the graph (bytes), or 0 if
+			 * there's none.
+			 */
+			uint64_t memory_limit;
+
 			/*
 			 * Whether or not to trim the source trace to the
 			 * intersection of its streams.
@@ -1887,6 +1887,15 @@ int cmd_run_ctx_init(struct cmd_run_ctx *ctx, struct bt_config *cfg)
 		goto error;
 	}
 
+	if (cfg->cmd_data.run.stats) {
+		bt_graph_enable_statistics(ctx->graph);
+	}
+
+	if (cfg->cmd_data.run.memory_limit > 0) {
+		bt_graph_set_memory_limit(ctx->graph,
+			cfg->cmd_data.run.memory_limit);
+	}
+
 	bt_graph_add_interrupter(ctx->graph, the_interrupter);
 	add_listener_status = bt_graph_add_source_component_output_port_added_listener(
 		ctx->graph, graph_source_output_port_added_listener, ctx,
@@ -2446,6 +2455,137 @@ end:
 	return ret;
 }
 
+static
+double ns_to_ms(uint64_t ns)
+{
+	return (double) ns / 1000000.;
+}
+
+static
+uint64_t stats_map_uint(const bt_value *map, const char *key)
+{
+	const bt_value *val = bt_value_map_borrow_entry_value_const(map, key);
+
+	BT_ASSERT(val);
+	return bt_value_integer_unsigned_get(val);
+}
+
+/*
+ * Prints the counters of the message pools of the graph of `ctx` to
+ * the standard error.
+ */
+static
+int print_graph_message_pool_statistics(struct cmd_run_ctx *ctx)
+{
+	int ret = 0;
+	const bt_value *stats = NULL;
+	bt_graph_get_message_pool_statistics_status status;
+	static const char * const pool_names[] = {
+		"event",
+		"packet-beginning",
+		"packet-end",
+	};
+	size_t i;
+
+	status = bt_graph_get_message_pool_statistics(ctx->graph, &stats);
+	if (status != BT_GRAPH_GET_MESSAGE_POOL_STATISTICS_STATUS_OK) {
+		BT_CLI_LOGE_APPEND_CAUSE(
+			"Cannot get the message pool counters of the graph.");
+		ret = -1;
+		goto end;
+	}
+
+	fprintf(stderr, "\n%s%-24s %12s %12s %12s %12s%s\n",
+		bt_common_color_bold(), "Message pool", "Hits", "Misses",
+		"Discards", "Peak size", bt_common_color_reset());
+
+	for (i = 0; i < G_N_ELEMENTS(pool_names); i++) {
+		const bt_value *pool_stats =
+			bt_value_map_borrow_entry_value_const(stats,
+				pool_names[i]);
+
+		BT_ASSERT(pool_stats);
+		fprintf(stderr, "%-24s %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %12" PRIu64 "\n",
+			pool_names[i],
+			stats_map_uint(pool_stats, "hits"),
+			stats_map_uint(pool_stats, "misses"),
+			stats_map_uint(pool_stats, "discards"),
+			stats_map_uint(pool_stats, "peak-size"));
+	}
+
+end:
+	bt_value_put_ref(stats);
+	return ret;
+}
+
+/*
+ * Prints the performance counters of the components of the graph of
+ * `ctx` to the standard error.
+ */
+static
+int print_graph_statistics(struct cmd_run_ctx *ctx)
+{
+	int ret = 0;
+	const bt_value *stats = NULL;
+	bt_graph_get_statistics_status status;
+	uint64_t i;
+
+	status = bt_graph_get_statistics(ctx->graph, &stats);
+	if (status != BT_GRAPH_GET_STATISTICS_STATUS_OK) {
+		BT_CLI_LOGE_APPEND_CAUSE(
+			"Cannot get the performance counters of the graph.");
+		ret = -1;
+		goto end;
+	}
+
+	fprintf(stderr, "%s%-24s %-7s %12s %12s %10s %14s %14s %14s%s\n",
+		bt_common_color_bold(), "Component", "Type", "Calls",
+		"Messages", "Again", "Incl. (ms)", "Excl. (ms)",
+		"Peak mem (KiB)", bt_common_color_reset());
+
+	for (i = 0; i < bt_value_array_get_length(stats); i++) {
+		const bt_value *comp_stats =
+			bt_value_array_borrow_element_by_index_const(stats, i);
+		const char *type = bt_value_string_get(
+			bt_value_map_borrow_entry_value_const(comp_stats,
+				"component-class-type"));
+		const char *name = bt_value_string_get(
+			bt_value_map_borrow_entry_value_const(comp_stats,
+				"component-name"));
+
+		if (strcmp(type, "sink") == 0) {
+			fprintf(stderr, "%-24s %-7s %12" PRIu64 " %12s %10s %14.3f %14.3f %14" PRIu64 "\n",
+				name, type,
+				stats_map_uint(comp_stats, "consume-calls"),
+				"-", "-",
+				ns_to_ms(stats_map_uint(comp_stats,
+					"consume-inclusive-time-ns")),
+				ns_to_ms(stats_map_uint(comp_stats,
+					"consume-exclusive-time-ns")),
+				stats_map_uint(comp_stats,
+					"retained-memory-peak-size") / 1024);
+		} else {
+			fprintf(stderr, "%-24s %-7s %12" PRIu64 " %12" PRIu64 " %10" PRIu64 " %14.3f %14.3f %14" PRIu64 "\n",
+				name, type,
+				stats_map_uint(comp_stats, "next-calls"),
+				stats_map_uint(comp_stats, "messages"),
+				stats_map_uint(comp_stats, "again-count"),
+				ns_to_ms(stats_map_uint(comp_stats,
+					"next-inclusive-time-ns")),
+				ns_to_ms(stats_map_uint(comp_stats,
+					"next-exclusive-time-ns")),
+				stats_map_uint(comp_stats,
+					"retained-memory-peak-size") / 1024);
+		}
+	}
+
+	ret = print_graph_message_pool_statistics(ctx);
+
+end:
+	bt_value_put_ref(stats);
+	return ret;
+}
+
 static
 enum bt_cmd_status cmd_run(struct bt_config *cfg)
 {
@@ -2545,6 +2685,12 @@ error:
 	cmd_status = BT_CMD_STATUS_ERROR;
 
 end:
+	if (cmd_status != BT_CMD_STATUS_ERROR && cfg->cmd_data.run.stats) {
+		if (print_graph_statistics(&ctx)) {
+			cmd_status = BT_CMD_STATUS_ERROR;
+		}
+	}
+
 	cmd_run_ctx_destroy(&ctx);
 	return cmd_status;
 }
@@ -2036,6 +2036,9 @@ void bt_common_abort(void)
 		"BABELTRACE_EXEC_ON_ABORT";
 	const char *env_exec_on_abort;
 
+	/* Don't lose the last asynchronous log messages */
+	bt_log_flush();
+
 	env_exec_on_abort = getenv(exec_on_abort_env_name);
 	if (env_exec_on_abort) {
 		if (bt_common_is_setuid_setgid()) {
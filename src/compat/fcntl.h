@@ -216,4 +216,158 @@ end:
 }
 #endif /* #else #ifdef BABELTRACE_HAVE_POSIX_FALLOCATE */
 
+/*
+ * Advises the system that the `len` bytes of the file `fd` starting at
+ * `offset` will be read soon so that it starts reading them
+ * asynchronously.
+ *
+ * This is only a hint: on platforms without posix_fadvise(), this
+ * function does nothing and succeeds.
+ */
+#ifdef BABELTRACE_HAVE_POSIX_FADVISE
+
+#include <fcntl.h>
+
+static inline
+int bt_posix_fadvise_willneed(int fd, off_t offset, off_t len)
+{
+	return posix_fadvise(fd, offset, len, POSIX_FADV_WILLNEED);
+}
+
+#else /* #ifdef BABELTRACE_HAVE_POSIX_FADVISE */
+
+static inline
+int bt_posix_fadvise_willneed(int fd __attribute__((unused)),
+		off_t offset __attribute__((unused)),
+		off_t len __attribute__((unused)))
+{
+	return 0;
+}
+
+#endif /* #else #ifdef BABELTRACE_HAVE_POSIX_FADVISE */
+
+#include <unistd.h>
+#include <errno.h>
+
+#define BABELTRACE_COPY_FILE_RANGE_BUFLEN	65536
+
+static inline
+int _bt_copy_file_range_read_write(int fd_in, off_t off_in, int fd_out,
+		off_t off_out, size_t len)
+{
+	int ret = 0;
+	char buf[BABELTRACE_COPY_FILE_RANGE_BUFLEN];
+
+	while (len > 0) {
+		size_t copy_len = len < sizeof(buf) ? len : sizeof(buf);
+		ssize_t read_ret, write_ret;
+
+		if (lseek(fd_in, off_in, SEEK_SET) < 0 ||
+				lseek(fd_out, off_out, SEEK_SET) < 0) {
+			ret = errno;
+			goto end;
+		}
+
+		read_ret = read(fd_in, buf, copy_len);
+		if (read_ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			ret = errno;
+			goto end;
+		}
+
+		if (read_ret == 0) {
+			/* Unexpected end of `fd_in` */
+			ret = EIO;
+			goto end;
+		}
+
+		write_ret = write(fd_out, buf, read_ret);
+		if (write_ret < read_ret) {
+			ret = write_ret < 0 ? errno : EIO;
+			goto end;
+		}
+
+		off_in += read_ret;
+		off_out += read_ret;
+		len -= read_ret;
+	}
+
+end:
+	return ret;
+}
+
+/*
+ * Copies the `len` bytes of the file `fd_in` starting at `off_in` to
+ * the file `fd_out` at `off_out`.
+ *
+ * With copy_file_range(), the kernel copies the data without going
+ * through user space (possibly sharing the extents on file systems
+ * which support it); otherwise, or when the kernel can't copy between
+ * those two files, this function copies the data with read() and
+ * write().
+ *
+ * The file offsets of `fd_in` and `fd_out` are unspecified after this
+ * call.
+ *
+ * Returns 0 on success, or an `errno` value on error.
+ */
+#ifdef BABELTRACE_HAVE_COPY_FILE_RANGE
+
+static inline
+int bt_copy_file_range(int fd_in, off_t off_in, int fd_out, off_t off_out,
+		size_t len)
+{
+	int ret = 0;
+
+	while (len > 0) {
+		ssize_t copy_ret;
+
+		copy_ret = copy_file_range(fd_in, &off_in, fd_out, &off_out,
+			len, 0);
+		if (copy_ret < 0) {
+			switch (errno) {
+			case EINTR:
+				continue;
+			case ENOSYS:
+			case EXDEV:
+			case EINVAL:
+			case EOPNOTSUPP:
+				/* Copy the rest through user space */
+				ret = _bt_copy_file_range_read_write(fd_in,
+					off_in, fd_out, off_out, len);
+				goto end;
+			default:
+				ret = errno;
+				goto end;
+			}
+		}
+
+		if (copy_ret == 0) {
+			/* Unexpected end of `fd_in` */
+			ret = EIO;
+			goto end;
+		}
+
+		len -= copy_ret;
+	}
+
+end:
+	return ret;
+}
+
+#else /* #ifdef BABELTRACE_HAVE_COPY_FILE_RANGE */
+
+static inline
+int bt_copy_file_range(int fd_in, off_t off_in, int fd_out, off_t off_out,
+		size_t len)
+{
+	return _bt_copy_file_range_read_write(fd_in, off_in, fd_out, off_out,
+		len);
+}
+
+#endif /* #else #ifdef BABELTRACE_HAVE_COPY_FILE_RANGE */
+
 #endif /* _BABELTRACE_COMPAT_FCNTL_H */
@@ -571,6 +571,13 @@ public:
         return *static_cast<T *>(bt_self_component_port_get_data(this->_libSelfCompPortPtr()));
     }
 
+    /* Only valid for an input port */
+    SelfComponentPort neededEventFields(const std::uint64_t neededEventFields) const noexcept
+    {
+        bt_self_component_port_input_set_needed_event_fields(this->libObjPtr(), neededEventFields);
+        return *this;
+    }
+
 private:
     bt_self_component_port *_libSelfCompPortPtr() const noexcept
     {
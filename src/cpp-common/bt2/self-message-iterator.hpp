@@ -7,6 +7,8 @@
 #ifndef BABELTRACE_CPP_COMMON_BT2_SELF_MESSAGE_ITERATOR_HPP
 #define BABELTRACE_CPP_COMMON_BT2_SELF_MESSAGE_ITERATOR_HPP
 
+#include <cstdint>
+
 #include <babeltrace2/babeltrace.h>
 
 #include "common/common.h"
@@ -53,6 +55,11 @@ public:
         return SelfComponentOutputPort {bt_self_message_iterator_borrow_port(this->libObjPtr())};
     }
 
+    std::uint64_t neededEventFields() const noexcept
+    {
+        return bt_self_message_iterator_get_needed_event_fields(this->libObjPtr());
+    }
+
     bool isInterrupted() const noexcept
     {
         return static_cast<bool>(bt_self_message_iterator_is_interrupted(this->libObjPtr()));
@@ -173,7 +173,8 @@ end:
 	return ret;
 }
 
-int bt_ctfser_open_packet(struct bt_ctfser *ctfser)
+static
+int open_packet(struct bt_ctfser *ctfser, uint64_t initial_size_bytes)
 {
 	int ret = 0;
 
@@ -203,8 +204,7 @@ int bt_ctfser_open_packet(struct bt_ctfser *ctfser)
 	ctfser->prev_packet_size_bytes = 0;
 
 	/* Make initial space for the current packet */
-	ctfser->cur_packet_size_bytes = get_packet_size_increment_bytes(
-		ctfser);
+	ctfser->cur_packet_size_bytes = initial_size_bytes;
 
 	do {
 		ret = bt_posix_fallocate(ctfser->fd, ctfser->mmap_offset,
@@ -237,6 +237,43 @@ end:
 	return ret;
 }
 
+int bt_ctfser_open_packet(struct bt_ctfser *ctfser)
+{
+	return open_packet(ctfser, get_packet_size_increment_bytes(ctfser));
+}
+
+int bt_ctfser_open_packet_copy(struct bt_ctfser *ctfser, int fd,
+		off_t offset_bytes, uint64_t size_bytes)
+{
+	int ret;
+	uint64_t increment_bytes = get_packet_size_increment_bytes(ctfser);
+
+	/* Make enough initial space for the whole copied packet */
+	ret = open_packet(ctfser,
+		(size_bytes + increment_bytes) / increment_bytes *
+			increment_bytes);
+	if (ret) {
+		goto end;
+	}
+
+	ret = bt_copy_file_range(fd, offset_bytes, ctfser->fd,
+		ctfser->mmap_offset, size_bytes);
+	if (ret) {
+		BT_LOGE("Failed to copy packet data: path=\"%s\", fd=%d, "
+			"src-fd=%d, src-offset-bytes=%jd, size-bytes=%" PRIu64 ", "
+			"ret=%d",
+			ctfser->path->str, ctfser->fd, fd,
+			(intmax_t) offset_bytes, size_bytes, ret);
+		goto end;
+	}
+
+	/* Continue writing after the copied data */
+	ctfser->offset_in_cur_packet_bits = size_bytes * 8;
+
+end:
+	return ret;
+}
+
 void bt_ctfser_close_current_packet(struct bt_ctfser *ctfser,
 		uint64_t packet_size_bytes)
 {
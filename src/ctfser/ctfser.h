@@ -87,6 +87,18 @@ int bt_ctfser_fini(struct bt_ctfser *ctfser);
 BT_EXTERN_C
 int bt_ctfser_open_packet(struct bt_ctfser *ctfser);
 
+/*
+ * Opens a new packet of which the initial contents are the
+ * `size_bytes` bytes of the file `fd` starting at `offset_bytes`.
+ *
+ * The offset within the new packet is `size_bytes` × 8 bits: use
+ * bt_ctfser_set_offset_in_current_packet_bits() to overwrite parts of
+ * the copied data.
+ */
+BT_EXTERN_C
+int bt_ctfser_open_packet_copy(struct bt_ctfser *ctfser, int fd,
+		off_t offset_bytes, uint64_t size_bytes);
+
 /*
  * Closes the current packet, making its size `packet_size_bytes`.
  */
@@ -556,6 +568,33 @@ void bt_ctfser_set_offset_in_current_packet_bits(struct bt_ctfser *ctfser,
 	ctfser->offset_in_cur_packet_bits = offset_bits;
 }
 
+/*
+ * Returns the offset (bytes) of the current packet within the stream
+ * file.
+ *
+ * After bt_ctfser_close_current_packet(), and until the next call to
+ * bt_ctfser_open_packet(), the current packet is the closed packet.
+ */
+static inline
+uint64_t bt_ctfser_get_current_packet_offset_bytes(struct bt_ctfser *ctfser)
+{
+	return (uint64_t) ctfser->mmap_offset;
+}
+
+/*
+ * Returns the address of the first byte of the current packet.
+ *
+ * After bt_ctfser_close_current_packet(), and until the next call to
+ * bt_ctfser_open_packet(), the current packet is the closed packet.
+ */
+static inline
+const uint8_t *bt_ctfser_get_current_packet_addr(struct bt_ctfser *ctfser)
+{
+	BT_ASSERT_DBG(ctfser->base_mma);
+	return ((const uint8_t *) mmap_align_addr(ctfser->base_mma)) +
+		ctfser->mmap_base_offset;
+}
+
 static inline
 const char *bt_ctfser_get_file_path(struct bt_ctfser *ctfser)
 {
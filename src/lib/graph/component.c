@@ -389,6 +389,102 @@ void bt_self_component_set_data(struct bt_self_component *self_comp,
 	BT_LIB_LOGD("Set component's user data: %!+c", component);
 }
 
+void bt_component_add_retained_memory_size(struct bt_component *comp,
+		uint64_t size)
+{
+	struct bt_graph *graph;
+
+	BT_ASSERT_DBG(comp);
+	comp->retained_memory_size += size;
+
+	if (comp->retained_memory_size > comp->retained_memory_peak_size) {
+		comp->retained_memory_peak_size = comp->retained_memory_size;
+	}
+
+	graph = bt_component_borrow_graph(comp);
+	if (!graph) {
+		goto end;
+	}
+
+	if (graph->memory_limit > 0 &&
+			graph->retained_memory_size <= graph->memory_limit &&
+			graph->retained_memory_size + size > graph->memory_limit) {
+		BT_LIB_LOGI("Components retain more memory than the graph's limit: "
+			"%![comp-]+c, retained-size=%" PRIu64 ", limit=%" PRIu64,
+			comp, graph->retained_memory_size + size,
+			graph->memory_limit);
+	}
+
+	graph->retained_memory_size += size;
+
+end:
+	return;
+}
+
+void bt_component_remove_retained_memory_size(struct bt_component *comp,
+		uint64_t size)
+{
+	struct bt_graph *graph;
+
+	BT_ASSERT_DBG(comp);
+	BT_ASSERT_DBG(size <= comp->retained_memory_size);
+	comp->retained_memory_size -= size;
+	graph = bt_component_borrow_graph(comp);
+	if (graph) {
+		BT_ASSERT_DBG(size <= graph->retained_memory_size);
+		graph->retained_memory_size -= size;
+	}
+}
+
+BT_EXPORT
+void bt_self_component_add_retained_memory_size(
+		struct bt_self_component *self_comp, uint64_t size)
+{
+	struct bt_component *comp = (void *) self_comp;
+
+	BT_ASSERT_PRE_DEV_COMP_NON_NULL(comp);
+	bt_component_add_retained_memory_size(comp, size);
+}
+
+BT_EXPORT
+void bt_self_component_remove_retained_memory_size(
+		struct bt_self_component *self_comp, uint64_t size)
+{
+	struct bt_component *comp = (void *) self_comp;
+
+	BT_ASSERT_PRE_DEV_COMP_NON_NULL(comp);
+	BT_ASSERT_PRE_DEV("size-is-retained",
+		size <= comp->retained_memory_size,
+		"Component doesn't retain that much memory: %![comp-]+c, "
+		"size=%" PRIu64 ", retained-size=%" PRIu64,
+		comp, size, comp->retained_memory_size);
+	bt_component_remove_retained_memory_size(comp, size);
+}
+
+BT_EXPORT
+uint64_t bt_self_component_get_remaining_memory_budget(
+		const struct bt_self_component *self_comp)
+{
+	const struct bt_component *comp = (const void *) self_comp;
+	const struct bt_graph *graph;
+	uint64_t budget = UINT64_MAX;
+
+	BT_ASSERT_PRE_DEV_COMP_NON_NULL(comp);
+	graph = (const void *) bt_object_borrow_parent(&comp->base);
+	if (!graph || graph->memory_limit == 0) {
+		goto end;
+	}
+
+	if (graph->retained_memory_size >= graph->memory_limit) {
+		budget = 0;
+	} else {
+		budget = graph->memory_limit - graph->retained_memory_size;
+	}
+
+end:
+	return budget;
+}
+
 void bt_component_set_graph(struct bt_component *component,
 		struct bt_graph *graph)
 {
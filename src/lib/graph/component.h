@@ -19,6 +19,7 @@
 
 #include "component-class.h"
 #include "port.h"
+#include "statistics.h"
 
 typedef void (*bt_component_destroy_listener_func)(
 		struct bt_component *class, void *data);
@@ -47,6 +48,16 @@ struct bt_component {
 	GArray *destroy_listeners;
 
 	bool initialized;
+
+	/* Only updated when the graph has statistics enabled */
+	struct bt_component_statistics stats;
+
+	/*
+	 * Size of the memory which this component and its message
+	 * iterators currently retain, and its peak value (bytes).
+	 */
+	uint64_t retained_memory_size;
+	uint64_t retained_memory_peak_size;
 };
 
 static inline
@@ -103,6 +114,12 @@ enum bt_self_component_add_port_status bt_component_add_output_port(
 void bt_component_remove_port(struct bt_component *component,
 		struct bt_port *port);
 
+void bt_component_add_retained_memory_size(struct bt_component *comp,
+		uint64_t size);
+
+void bt_component_remove_retained_memory_size(struct bt_component *comp,
+		uint64_t size);
+
 void bt_component_add_destroy_listener(struct bt_component *component,
 		bt_component_destroy_listener_func func, void *data);
 
@@ -145,22 +145,25 @@ void destroy_graph(struct bt_object *obj)
 
 static
 void destroy_message_event(struct bt_message *msg,
-		struct bt_graph *graph __attribute__((unused)))
+		struct bt_graph *graph)
 {
+	bt_graph_remove_message(graph, msg);
 	bt_message_event_destroy(msg);
 }
 
 static
 void destroy_message_packet_begin(struct bt_message *msg,
-		struct bt_graph *graph __attribute__((unused)))
+		struct bt_graph *graph)
 {
+	bt_graph_remove_message(graph, msg);
 	bt_message_packet_destroy(msg);
 }
 
 static
 void destroy_message_packet_end(struct bt_message *msg,
-		struct bt_graph *graph __attribute__((unused)))
+		struct bt_graph *graph)
 {
+	bt_graph_remove_message(graph, msg);
 	bt_message_packet_destroy(msg);
 }
 
@@ -441,12 +444,28 @@ int consume_graph_sink(struct bt_component_sink *comp)
 {
 	enum bt_component_class_sink_consume_method_status consume_status;
 	struct bt_component_class_sink *sink_class = NULL;
+	struct bt_graph *graph;
 
 	BT_ASSERT_DBG(comp);
 	sink_class = (void *) comp->parent.class;
 	BT_ASSERT_DBG(sink_class->methods.consume);
+	graph = bt_component_borrow_graph(&comp->parent);
 	BT_LIB_LOGD("Calling user's consume method: %!+c", comp);
-	consume_status = sink_class->methods.consume((void *) comp);
+
+	if (G_UNLIKELY(graph->stats_enabled)) {
+		struct bt_component_statistics *stats = &comp->parent.stats;
+		struct bt_graph_statistics_frame frame;
+
+		bt_graph_statistics_frame_begin(&graph->stats_cur_frame,
+			&frame);
+		consume_status = sink_class->methods.consume((void *) comp);
+		bt_graph_statistics_frame_end(&graph->stats_cur_frame, &frame,
+			&stats->consume_incl_ns, &stats->consume_excl_ns);
+		stats->consume_calls++;
+	} else {
+		consume_status = sink_class->methods.consume((void *) comp);
+	}
+
 	BT_LOGD("User method returned: status=%s",
 		bt_common_func_status_string(consume_status));
 	BT_ASSERT_POST_DEV(CONSUME_METHOD_NAME, "valid-status",
@@ -570,6 +589,77 @@ end:
 	return status;
 }
 
+/*
+ * Drains the single sink component left in the graph's queue of sinks
+ * to consume, calling its "consume" method until it returns anything
+ * else than `BT_FUNC_STATUS_OK`, or until the graph is interrupted.
+ *
+ * This is the fast path of bt_graph_run() when there's a single sink
+ * to consume: there's no sink to choose, so there's no need to move the
+ * sink's node within the queue and to log it for each consume call.
+ */
+static
+int drain_single_sink(struct bt_graph *graph)
+{
+	int status;
+	struct bt_component_sink *sink;
+
+	BT_ASSERT_DBG(graph->sinks_to_consume->length == 1);
+	sink = g_queue_peek_head(graph->sinks_to_consume);
+	BT_LIB_LOGD("Draining graph's single sink: %![comp-]+c", sink);
+
+	do {
+		if (G_UNLIKELY(bt_graph_is_interrupted(graph))) {
+			BT_LIB_LOGI("Stopping the graph: "
+				"graph was interrupted: %!+g", graph);
+			status = BT_FUNC_STATUS_AGAIN;
+			goto end;
+		}
+
+		status = consume_graph_sink(sink);
+	} while (G_LIKELY(status == BT_FUNC_STATUS_OK));
+
+	if (status == BT_FUNC_STATUS_END) {
+		/* End reached: remove the sink from the queue */
+		g_queue_delete_link(graph->sinks_to_consume,
+			graph->sinks_to_consume->head);
+	}
+
+end:
+	BT_LIB_LOGD("Drained graph's single sink: %![comp-]+c, status=%s",
+		sink, bt_common_func_status_string(status));
+	return status;
+}
+
+static
+int prewarm_message_pools(struct bt_graph *graph)
+{
+	int status = BT_FUNC_STATUS_OK;
+	struct bt_object_pool *pools[] = {
+		&graph->event_msg_pool,
+		&graph->packet_begin_msg_pool,
+		&graph->packet_end_msg_pool,
+	};
+	size_t i;
+
+	BT_LIB_LOGD("Pre-warming graph's message pools: %![graph-]+g, "
+		"count=%" PRIu64, graph, graph->msg_pool_prewarm_count);
+
+	for (i = 0; i < G_N_ELEMENTS(pools); i++) {
+		if (bt_object_pool_prewarm(pools[i],
+				graph->msg_pool_prewarm_count)) {
+			BT_LIB_LOGE_APPEND_CAUSE(
+				"Failed to pre-warm message pool: "
+				"%![graph-]+g, %![pool-]+o", graph, pools[i]);
+			status = BT_FUNC_STATUS_MEMORY_ERROR;
+			goto end;
+		}
+	}
+
+end:
+	return status;
+}
+
 #define GRAPH_IS_CONFIGURED_METHOD_NAME					\
 	"bt_component_class_sink_graph_is_configured_method"
 
@@ -592,6 +682,13 @@ int configure_graph(struct bt_graph *graph, const char *api_func)
 		graph->has_sink, "Graph has no sink component: %!+g", graph);
 	graph->config_state = BT_GRAPH_CONFIGURATION_STATE_PARTIALLY_CONFIGURED;
 
+	if (graph->msg_pool_prewarm_count > 0) {
+		status = prewarm_message_pools(graph);
+		if (status) {
+			goto end;
+		}
+	}
+
 	for (i = 0; i < graph->components->len; i++) {
 		struct bt_component *comp = graph->components->pdata[i];
 		struct bt_component_sink *comp_sink = (void *) comp;
@@ -697,6 +794,17 @@ enum bt_graph_run_status bt_graph_run(struct bt_graph *graph)
 	BT_LIB_LOGI("Running graph: %!+g", graph);
 
 	do {
+		if (G_LIKELY(graph->sinks_to_consume->length == 1)) {
+			/*
+			 * Single sink left: drain it. This returns
+			 * `BT_FUNC_STATUS_AGAIN`, `BT_FUNC_STATUS_END`,
+			 * or an error status, like consume_no_check()
+			 * would for this sink.
+			 */
+			status = drain_single_sink(graph);
+			break;
+		}
+
 		/*
 		 * Check if the graph is interrupted at each iteration.
 		 * If the graph was interrupted by another thread or by
@@ -1302,10 +1410,42 @@ void bt_graph_add_message(struct bt_graph *graph,
 	 * * It is recycled back to one of this graph's pool.
 	 * * It is destroyed because it doesn't have any link to any
 	 *   graph, which means the original graph is already destroyed.
+	 * * It is destroyed because its pool is full, in which case
+	 *   it removes itself from this array with
+	 *   bt_graph_remove_message().
 	 */
+	msg->graph_msg_index = graph->messages->len;
 	g_ptr_array_add(graph->messages, msg);
 }
 
+void bt_graph_remove_message(struct bt_graph *graph,
+		struct bt_message *msg)
+{
+	struct bt_message *last_msg;
+
+	BT_ASSERT(graph);
+	BT_ASSERT(msg);
+
+	if (!graph->messages) {
+		/* Graph is being destroyed: message is already unlinked */
+		goto end;
+	}
+
+	BT_ASSERT_DBG(msg->graph_msg_index < graph->messages->len);
+	BT_ASSERT_DBG(graph->messages->pdata[msg->graph_msg_index] == msg);
+
+	/*
+	 * g_ptr_array_remove_index_fast() moves the last message to
+	 * the removed message's slot: update its index accordingly.
+	 */
+	last_msg = graph->messages->pdata[graph->messages->len - 1];
+	last_msg->graph_msg_index = msg->graph_msg_index;
+	g_ptr_array_remove_index_fast(graph->messages, msg->graph_msg_index);
+
+end:
+	return;
+}
+
 bool bt_graph_is_interrupted(const struct bt_graph *graph)
 {
 	BT_ASSERT_DBG(graph);
@@ -1333,6 +1473,299 @@ struct bt_interrupter *bt_graph_borrow_default_interrupter(bt_graph *graph)
 	return graph->default_interrupter;
 }
 
+BT_EXPORT
+void bt_graph_enable_statistics(struct bt_graph *graph)
+{
+	BT_ASSERT_PRE_GRAPH_NON_NULL(graph);
+	BT_ASSERT_PRE("graph-is-not-configured",
+		graph->config_state == BT_GRAPH_CONFIGURATION_STATE_CONFIGURING,
+		"Graph is not in the \"configuring\" state: %!+g", graph);
+	graph->stats_enabled = true;
+	BT_LIB_LOGI("Enabled graph's statistics: %!+g", graph);
+}
+
+BT_EXPORT
+void bt_graph_set_memory_limit(struct bt_graph *graph, uint64_t limit)
+{
+	BT_ASSERT_PRE_GRAPH_NON_NULL(graph);
+	BT_ASSERT_PRE("graph-is-not-configured",
+		graph->config_state == BT_GRAPH_CONFIGURATION_STATE_CONFIGURING,
+		"Graph is not in the \"configuring\" state: %!+g", graph);
+	BT_ASSERT_PRE("limit-is-not-zero", limit > 0,
+		"Memory limit is 0: %!+g", graph);
+	graph->memory_limit = limit;
+	BT_LIB_LOGI("Set graph's memory limit: %!+g, limit=%" PRIu64,
+		graph, limit);
+}
+
+BT_EXPORT
+uint64_t bt_graph_get_retained_memory_size(const struct bt_graph *graph)
+{
+	BT_ASSERT_PRE_DEV_GRAPH_NON_NULL(graph);
+	return graph->retained_memory_size;
+}
+
+BT_EXPORT
+void bt_graph_set_message_pool_max_size(struct bt_graph *graph,
+		uint64_t max_size)
+{
+	BT_ASSERT_PRE_GRAPH_NON_NULL(graph);
+	BT_ASSERT_PRE("graph-is-not-configured",
+		graph->config_state == BT_GRAPH_CONFIGURATION_STATE_CONFIGURING,
+		"Graph is not in the \"configuring\" state: %!+g", graph);
+	BT_ASSERT_PRE("max-size-is-not-zero", max_size > 0,
+		"Maximum message pool size is 0: %!+g", graph);
+	bt_object_pool_set_max_size(&graph->event_msg_pool, max_size);
+	bt_object_pool_set_max_size(&graph->packet_begin_msg_pool, max_size);
+	bt_object_pool_set_max_size(&graph->packet_end_msg_pool, max_size);
+	BT_LIB_LOGI("Set graph's maximum message pool size: %!+g, "
+		"max-size=%" PRIu64, graph, max_size);
+}
+
+BT_EXPORT
+void bt_graph_set_message_pool_prewarm_count(struct bt_graph *graph,
+		uint64_t count)
+{
+	BT_ASSERT_PRE_GRAPH_NON_NULL(graph);
+	BT_ASSERT_PRE("graph-is-not-configured",
+		graph->config_state == BT_GRAPH_CONFIGURATION_STATE_CONFIGURING,
+		"Graph is not in the \"configuring\" state: %!+g", graph);
+	graph->msg_pool_prewarm_count = count;
+	BT_LIB_LOGI("Set graph's message pool pre-warm count: %!+g, "
+		"count=%" PRIu64, graph, count);
+}
+
+/*
+ * Creates a map value containing the counters of the object pool
+ * `pool`.
+ */
+static
+struct bt_value *create_pool_statistics_value(
+		const struct bt_object_pool *pool)
+{
+	struct bt_value *map;
+	int ret;
+
+	map = bt_value_map_create();
+	if (!map) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to create a map value.");
+		goto error;
+	}
+
+	ret = bt_value_map_insert_unsigned_integer_entry(map, "hits",
+		pool->stats.hits);
+	ret |= bt_value_map_insert_unsigned_integer_entry(map, "misses",
+		pool->stats.misses);
+	ret |= bt_value_map_insert_unsigned_integer_entry(map, "discards",
+		pool->stats.discards);
+	ret |= bt_value_map_insert_unsigned_integer_entry(map, "size",
+		pool->size);
+	ret |= bt_value_map_insert_unsigned_integer_entry(map, "peak-size",
+		pool->stats.peak_size);
+	if (ret) {
+		BT_LIB_LOGE_APPEND_CAUSE(
+			"Failed to insert an entry into a map value.");
+		goto error;
+	}
+
+	goto end;
+
+error:
+	BT_VALUE_PUT_REF_AND_RESET(map);
+
+end:
+	return map;
+}
+
+BT_EXPORT
+enum bt_graph_get_message_pool_statistics_status
+bt_graph_get_message_pool_statistics(const struct bt_graph *graph,
+		const struct bt_value **statistics)
+{
+	enum bt_graph_get_message_pool_statistics_status status =
+		BT_FUNC_STATUS_OK;
+	struct bt_value *stats_map = NULL;
+	struct bt_value *pool_stats = NULL;
+	const struct {
+		const char *name;
+		const struct bt_object_pool *pool;
+	} pools[] = {
+		{ "event", &graph->event_msg_pool },
+		{ "packet-beginning", &graph->packet_begin_msg_pool },
+		{ "packet-end", &graph->packet_end_msg_pool },
+	};
+	size_t i;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_GRAPH_NON_NULL(graph);
+	BT_ASSERT_PRE_NON_NULL("statistics-output", statistics,
+		"Statistics (output)");
+
+	stats_map = bt_value_map_create();
+	if (!stats_map) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to create a map value.");
+		status = BT_FUNC_STATUS_MEMORY_ERROR;
+		goto end;
+	}
+
+	for (i = 0; i < G_N_ELEMENTS(pools); i++) {
+		pool_stats = create_pool_statistics_value(pools[i].pool);
+		if (!pool_stats) {
+			status = BT_FUNC_STATUS_MEMORY_ERROR;
+			goto end;
+		}
+
+		if (bt_value_map_insert_entry(stats_map, pools[i].name,
+				pool_stats)) {
+			BT_LIB_LOGE_APPEND_CAUSE(
+				"Failed to insert an entry into a map value.");
+			status = BT_FUNC_STATUS_MEMORY_ERROR;
+			goto end;
+		}
+
+		BT_VALUE_PUT_REF_AND_RESET(pool_stats);
+	}
+
+	*statistics = stats_map;
+	stats_map = NULL;
+
+end:
+	bt_value_put_ref(pool_stats);
+	bt_value_put_ref(stats_map);
+	return status;
+}
+
+static
+const char *comp_cls_type_stats_string(enum bt_component_class_type type)
+{
+	switch (type) {
+	case BT_COMPONENT_CLASS_TYPE_SOURCE:
+		return "source";
+	case BT_COMPONENT_CLASS_TYPE_FILTER:
+		return "filter";
+	case BT_COMPONENT_CLASS_TYPE_SINK:
+		return "sink";
+	default:
+		bt_common_abort();
+	}
+}
+
+/*
+ * Creates a map value containing the performance counters of the
+ * component `comp`.
+ */
+static
+struct bt_value *create_component_statistics_value(
+		const struct bt_component *comp)
+{
+	const struct bt_component_statistics *stats = &comp->stats;
+	struct bt_value *map;
+	int ret;
+
+	map = bt_value_map_create();
+	if (!map) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to create a map value.");
+		goto error;
+	}
+
+	ret = bt_value_map_insert_string_entry(map, "component-name",
+		comp->name->str);
+	ret |= bt_value_map_insert_string_entry(map,
+		"component-class-type",
+		comp_cls_type_stats_string(comp->class->type));
+	ret |= bt_value_map_insert_string_entry(map,
+		"component-class-name", comp->class->name->str);
+	ret |= bt_value_map_insert_unsigned_integer_entry(map,
+		"retained-memory-peak-size", comp->retained_memory_peak_size);
+
+	if (comp->class->type == BT_COMPONENT_CLASS_TYPE_SINK) {
+		ret |= bt_value_map_insert_unsigned_integer_entry(map,
+			"consume-calls", stats->consume_calls);
+		ret |= bt_value_map_insert_unsigned_integer_entry(map,
+			"consume-inclusive-time-ns", stats->consume_incl_ns);
+		ret |= bt_value_map_insert_unsigned_integer_entry(map,
+			"consume-exclusive-time-ns", stats->consume_excl_ns);
+	} else {
+		ret |= bt_value_map_insert_unsigned_integer_entry(map,
+			"message-iterator-count", stats->msg_iter_count);
+		ret |= bt_value_map_insert_unsigned_integer_entry(map,
+			"next-calls", stats->next_calls);
+		ret |= bt_value_map_insert_unsigned_integer_entry(map,
+			"messages", stats->msgs);
+		ret |= bt_value_map_insert_unsigned_integer_entry(map,
+			"again-count", stats->again_count);
+		ret |= bt_value_map_insert_unsigned_integer_entry(map,
+			"next-inclusive-time-ns", stats->next_incl_ns);
+		ret |= bt_value_map_insert_unsigned_integer_entry(map,
+			"next-exclusive-time-ns", stats->next_excl_ns);
+	}
+
+	if (ret) {
+		BT_LIB_LOGE_APPEND_CAUSE(
+			"Failed to insert an entry into a map value.");
+		goto error;
+	}
+
+	goto end;
+
+error:
+	BT_VALUE_PUT_REF_AND_RESET(map);
+
+end:
+	return map;
+}
+
+BT_EXPORT
+enum bt_graph_get_statistics_status bt_graph_get_statistics(
+		const struct bt_graph *graph,
+		const struct bt_value **statistics)
+{
+	enum bt_graph_get_statistics_status status = BT_FUNC_STATUS_OK;
+	struct bt_value *stats_array = NULL;
+	struct bt_value *comp_stats = NULL;
+	guint i;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_GRAPH_NON_NULL(graph);
+	BT_ASSERT_PRE_NON_NULL("statistics-output", statistics,
+		"Statistics (output)");
+	BT_ASSERT_PRE("graph-has-statistics-enabled", graph->stats_enabled,
+		"Graph's statistics are not enabled: %!+g", graph);
+
+	stats_array = bt_value_array_create();
+	if (!stats_array) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to create an array value.");
+		status = BT_FUNC_STATUS_MEMORY_ERROR;
+		goto end;
+	}
+
+	for (i = 0; i < graph->components->len; i++) {
+		comp_stats = create_component_statistics_value(
+			graph->components->pdata[i]);
+		if (!comp_stats) {
+			status = BT_FUNC_STATUS_MEMORY_ERROR;
+			goto end;
+		}
+
+		if (bt_value_array_append_element(stats_array, comp_stats)) {
+			BT_LIB_LOGE_APPEND_CAUSE(
+				"Failed to append an element to an array value.");
+			status = BT_FUNC_STATUS_MEMORY_ERROR;
+			goto end;
+		}
+
+		BT_VALUE_PUT_REF_AND_RESET(comp_stats);
+	}
+
+	*statistics = stats_array;
+	stats_array = NULL;
+
+end:
+	bt_value_put_ref(comp_stats);
+	bt_value_put_ref(stats_array);
+	return status;
+}
+
 BT_EXPORT
 void bt_graph_get_ref(const struct bt_graph *graph)
 {
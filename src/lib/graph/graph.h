@@ -24,6 +24,7 @@
 #include "component.h"
 #include "component-sink.h"
 #include "connection.h"
+#include "statistics.h"
 
 /* Protection: this file uses BT_LIB_LOG*() macros directly */
 #ifndef BT_LIB_LOG_SUPPORTED
@@ -91,6 +92,28 @@ struct bt_graph {
 
 	enum bt_graph_configuration_state config_state;
 
+	/*
+	 * True if the components of this graph update their
+	 * performance counters (see bt_graph_enable_statistics()).
+	 */
+	bool stats_enabled;
+
+	/* Innermost timed user method call, if any */
+	struct bt_graph_statistics_frame *stats_cur_frame;
+
+	/*
+	 * Maximum size of the memory which the components of this
+	 * graph should retain (bytes), or 0 if there's no limit (see
+	 * bt_graph_set_memory_limit()).
+	 */
+	uint64_t memory_limit;
+
+	/*
+	 * Size of the memory which the components of this graph
+	 * currently retain (bytes).
+	 */
+	uint64_t retained_memory_size;
+
 	struct {
 		GArray *source_output_port_added;
 		GArray *filter_output_port_added;
@@ -98,6 +121,13 @@ struct bt_graph {
 		GArray *sink_input_port_added;
 	} listeners;
 
+	/*
+	 * Number of objects to pre-allocate in each message pool below
+	 * when configuring this graph (see
+	 * bt_graph_set_message_pool_prewarm_count()).
+	 */
+	uint64_t msg_pool_prewarm_count;
+
 	/* Pool of `struct bt_message_event *` */
 	struct bt_object_pool event_msg_pool;
 
@@ -117,9 +147,9 @@ struct bt_graph {
 	 * notify each message that the graph is gone on graph
 	 * destruction.
 	 *
-	 * TODO: When we support a maximum size for object pools,
-	 * add a way for a message to remove itself from this
-	 * array (on destruction).
+	 * A message which one of the pools above destroys because it's
+	 * full removes itself from this array (see
+	 * bt_graph_remove_message()).
 	 */
 	GPtrArray *messages;
 };
@@ -143,6 +173,9 @@ void bt_graph_remove_connection(struct bt_graph *graph,
 void bt_graph_add_message(struct bt_graph *graph,
 		struct bt_message *msg);
 
+void bt_graph_remove_message(struct bt_graph *graph,
+		struct bt_message *msg);
+
 bool bt_graph_is_interrupted(const struct bt_graph *graph);
 
 static inline
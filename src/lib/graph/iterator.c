@@ -36,6 +36,7 @@
 #include <inttypes.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "component-class.h"
 #include "component.h"
@@ -96,6 +97,93 @@ void set_msg_iterator_state(struct bt_message_iterator *iterator,
 	iterator->state = state;
 }
 
+static
+void put_redeliver_msgs(struct bt_message_iterator *iterator)
+{
+	uint64_t i;
+
+	for (i = 0; i < iterator->pass_through.redeliver_msg_count; i++) {
+		bt_object_put_ref_no_null_check(iterator->msgs->pdata[i]);
+	}
+
+	iterator->pass_through.redeliver_msg_count = 0;
+}
+
+static
+void stop_pass_through(struct bt_message_iterator *iterator)
+{
+	if (!iterator->pass_through.upstream_msg_iter) {
+		goto end;
+	}
+
+	BT_LIB_LOGD("Stopping message iterator's pass-through: "
+		"%![iter-]+i, %![upstream-iter-]+i", iterator,
+		iterator->pass_through.upstream_msg_iter);
+
+	/* Restore user's "next" callback */
+	BT_ASSERT(iterator->pass_through.original_next_callback);
+	iterator->methods.next = iterator->pass_through.original_next_callback;
+	iterator->pass_through.original_next_callback = NULL;
+	iterator->pass_through.upstream_msg_iter = NULL;
+	iterator->pass_through.reclaim_msg_types = 0;
+
+end:
+	return;
+}
+
+/*
+ * Pushes `msg` to the auto-seek message queue of `iterator` (at its
+ * head if `at_head` is true), reporting its size as memory which the
+ * component of `iterator` retains.
+ *
+ * Estimating the size of a message walks its fields: without a graph
+ * memory limit, nothing reads the remaining memory budgets, so this
+ * function doesn't report anything.
+ */
+static
+void auto_seek_push_msg(struct bt_message_iterator *iterator,
+		const struct bt_message *msg, bool at_head)
+{
+	uint64_t size;
+
+	if (at_head) {
+		g_queue_push_head(iterator->auto_seek.msgs, (void *) msg);
+	} else {
+		g_queue_push_tail(iterator->auto_seek.msgs, (void *) msg);
+	}
+
+	if (G_LIKELY(iterator->graph->memory_limit == 0)) {
+		goto end;
+	}
+
+	size = bt_message_get_retained_memory_size(msg);
+	iterator->auto_seek.msgs_size += size;
+	bt_component_add_retained_memory_size(iterator->upstream_component,
+		size);
+
+end:
+	return;
+}
+
+/*
+ * Stops reporting the auto-seek messages of `iterator` as retained
+ * memory.
+ */
+static
+void auto_seek_release_msgs_size(struct bt_message_iterator *iterator)
+{
+	if (iterator->auto_seek.msgs_size == 0) {
+		goto end;
+	}
+
+	bt_component_remove_retained_memory_size(iterator->upstream_component,
+		iterator->auto_seek.msgs_size);
+	iterator->auto_seek.msgs_size = 0;
+
+end:
+	return;
+}
+
 static
 void bt_message_iterator_destroy(struct bt_object *obj)
 {
@@ -151,6 +239,7 @@ void bt_message_iterator_destroy(struct bt_object *obj)
 	}
 
 	if (iterator->msgs) {
+		put_redeliver_msgs(iterator);
 		g_ptr_array_free(iterator->msgs, TRUE);
 		iterator->msgs = NULL;
 	}
@@ -241,6 +330,7 @@ void bt_message_iterator_try_finalize(
 	}
 
 	g_ptr_array_set_size(iterator->upstream_msg_iters, 0);
+	stop_pass_through(iterator);
 
 	/* Detach downstream message iterator */
 	if (iterator->downstream_msg_iter) {
@@ -251,8 +341,14 @@ void bt_message_iterator_try_finalize(
 			iterator->downstream_msg_iter->upstream_msg_iters,
 			iterator);
 		BT_ASSERT(existed);
+
+		if (iterator->downstream_msg_iter->pass_through.upstream_msg_iter ==
+				iterator) {
+			stop_pass_through(iterator->downstream_msg_iter);
+		}
 	}
 
+	auto_seek_release_msgs_size(iterator);
 	iterator->upstream_component = NULL;
 	iterator->upstream_port = NULL;
 	set_msg_iterator_state(iterator,
@@ -405,6 +501,10 @@ int create_self_component_input_port_message_iterator(
 	set_msg_iterator_state(iterator,
 		BT_MESSAGE_ITERATOR_STATE_NON_INITIALIZED);
 
+	if (iterator->graph->stats_enabled) {
+		upstream_comp->stats.msg_iter_count++;
+	}
+
 	/* Copy methods from the message iterator class to the message iterator. */
 	BT_ASSERT(bt_component_class_has_message_iterator_class(upstream_comp_cls));
 	upstream_comp_cls_with_iter_cls = container_of(upstream_comp_cls,
@@ -1089,6 +1189,37 @@ void assert_post_dev_next(
 }
 #endif
 
+/*
+ * Calls the `next` method of the iterator, updating the performance
+ * counters of its upstream component.
+ */
+static
+enum bt_message_iterator_class_next_method_status
+call_iterator_next_method_with_stats(
+		struct bt_message_iterator *iterator,
+		bt_message_array_const msgs, uint64_t capacity, uint64_t *user_count)
+{
+	struct bt_component_statistics *stats =
+		&iterator->upstream_component->stats;
+	struct bt_graph_statistics_frame frame;
+	enum bt_message_iterator_class_next_method_status status;
+
+	bt_graph_statistics_frame_begin(&iterator->graph->stats_cur_frame,
+		&frame);
+	status = iterator->methods.next(iterator, msgs, capacity, user_count);
+	bt_graph_statistics_frame_end(&iterator->graph->stats_cur_frame,
+		&frame, &stats->next_incl_ns, &stats->next_excl_ns);
+	stats->next_calls++;
+
+	if (status == BT_FUNC_STATUS_OK) {
+		stats->msgs += *user_count;
+	} else if (status == BT_FUNC_STATUS_AGAIN) {
+		stats->again_count++;
+	}
+
+	return status;
+}
+
 /*
  * Call the `next` method of the iterator.  Do some validation on the returned
  * messages.
@@ -1104,7 +1235,15 @@ call_iterator_next_method(
 
 	BT_ASSERT_DBG(iterator->methods.next);
 	BT_LOGD_STR("Calling user's \"next\" method.");
-	status = iterator->methods.next(iterator, msgs, capacity, user_count);
+
+	if (G_UNLIKELY(iterator->graph->stats_enabled)) {
+		status = call_iterator_next_method_with_stats(iterator, msgs,
+			capacity, user_count);
+	} else {
+		status = iterator->methods.next(iterator, msgs, capacity,
+			user_count);
+	}
+
 	BT_LOGD("User method returned: status=%s, msg-count=%" PRIu64,
 		bt_common_func_status_string(status), *user_count);
 
@@ -1157,6 +1296,22 @@ bt_message_iterator_next(
 		"message iterator's messages: %!+i, batch-size=%u",
 		iterator, MSG_BATCH_SIZE);
 
+	if (G_UNLIKELY(iterator->pass_through.redeliver_msg_count > 0)) {
+		/*
+		 * Batch which made the downstream message iterator stop
+		 * passing through: it already went through the
+		 * post-condition checks the first time this function
+		 * returned it.
+		 */
+		BT_LIB_LOGD("Returning pass-through batch again: "
+			"%!+i, msg-count=%" PRIu64, iterator,
+			iterator->pass_through.redeliver_msg_count);
+		*user_count = iterator->pass_through.redeliver_msg_count;
+		iterator->pass_through.redeliver_msg_count = 0;
+		*msgs = (void *) iterator->msgs->pdata;
+		goto end;
+	}
+
 	/*
 	 * Call the user's "next" method to get the next messages
 	 * and status.
@@ -1242,6 +1397,24 @@ struct bt_self_component_port_output *bt_self_message_iterator_borrow_port(
 	return (void *) iterator->upstream_port;
 }
 
+BT_EXPORT
+uint64_t bt_self_message_iterator_get_needed_event_fields(
+		const struct bt_self_message_iterator *self_iterator)
+{
+	const struct bt_message_iterator *iterator =
+		(const void *) self_iterator;
+
+	BT_ASSERT_PRE_DEV_MSG_ITER_NON_NULL(iterator);
+
+	if (!iterator->connection) {
+		/* Connection is gone: the downstream hint is meaningless */
+		return BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_ALL;
+	}
+
+	BT_ASSERT_DBG(iterator->connection->downstream_port);
+	return iterator->connection->downstream_port->needed_event_fields;
+}
+
 #define CAN_SEEK_NS_FROM_ORIGIN_METHOD_NAME				\
 	"bt_message_iterator_class_can_seek_ns_from_origin_method"
 
@@ -1445,6 +1618,8 @@ bt_message_iterator_seek_beginning(struct bt_message_iterator *iterator)
 	 * messages should look like.
 	 */
 	reset_iterator_expectations(iterator);
+	stop_pass_through(iterator);
+	put_redeliver_msgs(iterator);
 
 	BT_LIB_LOGD("Calling user's \"seek beginning\" method: %!+i", iterator);
 	set_msg_iterator_state(iterator,
@@ -1845,7 +2020,7 @@ skip_msg:
 	goto end;
 
 push_msg:
-	g_queue_push_tail(iterator->auto_seek.msgs, (void *) msg);
+	auto_seek_push_msg(iterator, msg, false);
 	msg = NULL;
 
 end:
@@ -1921,8 +2096,8 @@ int find_message_ge_ns_from_origin(
 
 		for (i = 0; i < user_count; i++) {
 			if (got_first) {
-				g_queue_push_tail(iterator->auto_seek.msgs,
-					(void *) messages[i]);
+				auto_seek_push_msg(iterator, messages[i],
+					false);
 				messages[i] = NULL;
 				continue;
 			}
@@ -1979,6 +2154,8 @@ enum bt_message_iterator_class_next_method_status post_auto_seek_next(
 	BT_ASSERT(*count > 0);
 
 	if (g_queue_is_empty(iterator->auto_seek.msgs)) {
+		auto_seek_release_msgs_size(iterator);
+
 		/* No more auto-seek messages, restore user's next callback. */
 		BT_ASSERT(iterator->auto_seek.original_next_callback);
 		iterator->methods.next = iterator->auto_seek.original_next_callback;
@@ -2053,6 +2230,8 @@ bt_message_iterator_seek_ns_from_origin(
 	 * messages should look like.
 	 */
 	reset_iterator_expectations(iterator);
+	stop_pass_through(iterator);
+	put_redeliver_msgs(iterator);
 
 	/* Check if the iterator can seek by itself.  If not we'll use autoseek. */
 	if (iterator->methods.can_seek_ns_from_origin) {
@@ -2152,6 +2331,7 @@ bt_message_iterator_seek_ns_from_origin(
 				g_queue_pop_tail(iterator->auto_seek.msgs));
 		}
 
+		auto_seek_release_msgs_size(iterator);
 		stream_states = create_auto_seek_stream_states();
 		if (!stream_states) {
 			BT_LIB_LOGE_APPEND_CAUSE(
@@ -2229,7 +2409,7 @@ bt_message_iterator_seek_ns_from_origin(
 						goto end;
 					}
 
-					g_queue_push_head(iterator->auto_seek.msgs, msg);
+					auto_seek_push_msg(iterator, msg, true);
 					msg = NULL;
 					/* fall-thru */
 
@@ -2245,7 +2425,7 @@ bt_message_iterator_seek_ns_from_origin(
 						bt_message_stream_beginning_set_default_clock_snapshot(msg, raw_value);
 					}
 
-					g_queue_push_head(iterator->auto_seek.msgs, msg);
+					auto_seek_push_msg(iterator, msg, true);
 					msg = NULL;
 					break;
 				}
@@ -2303,6 +2483,107 @@ end:
 	return status;
 }
 
+/*
+ * While passing through, we replace the iterator's "next" callback
+ * with this one, which returns the messages of the upstream message
+ * iterator as is until one of them has a type to reclaim.
+ */
+static
+enum bt_message_iterator_class_next_method_status pass_through_next(
+		struct bt_message_iterator *iterator,
+		bt_message_array_const msgs, uint64_t capacity,
+		uint64_t *count)
+{
+	struct bt_message_iterator *upstream_msg_iter =
+		iterator->pass_through.upstream_msg_iter;
+	enum bt_message_iterator_class_next_method_status status;
+	bt_message_array_const upstream_msgs;
+	uint64_t upstream_count;
+	uint64_t i;
+
+	BT_ASSERT_DBG(upstream_msg_iter);
+	status = (int) bt_message_iterator_next(upstream_msg_iter,
+		&upstream_msgs, &upstream_count);
+	if (status != BT_FUNC_STATUS_OK) {
+		goto end;
+	}
+
+	BT_ASSERT_DBG(upstream_count <= capacity);
+
+	for (i = 0; i < upstream_count; i++) {
+		if (upstream_msgs[i]->type &
+				iterator->pass_through.reclaim_msg_types) {
+			break;
+		}
+	}
+
+	if (G_LIKELY(i == upstream_count)) {
+		memcpy(msgs, upstream_msgs, upstream_count * sizeof(*msgs));
+		*count = upstream_count;
+		goto end;
+	}
+
+	/*
+	 * Reclaim: keep the batch within the upstream message iterator
+	 * so that the user's "next" method gets it from there.
+	 */
+	BT_LIB_LOGD("Message iterator reclaims control from pass-through: "
+		"%![iter-]+i, %![msg-]+n", iterator, upstream_msgs[i]);
+	BT_ASSERT_DBG(upstream_msgs ==
+		(void *) upstream_msg_iter->msgs->pdata);
+	upstream_msg_iter->pass_through.redeliver_msg_count = upstream_count;
+	stop_pass_through(iterator);
+	status = iterator->methods.next(iterator, msgs, capacity, count);
+
+end:
+	return status;
+}
+
+BT_EXPORT
+void bt_self_message_iterator_set_pass_through(
+		struct bt_self_message_iterator *self_iterator,
+		struct bt_message_iterator *upstream_msg_iter,
+		uint64_t reclaim_msg_types)
+{
+	struct bt_message_iterator *iterator = (void *) self_iterator;
+
+	BT_ASSERT_PRE_MSG_ITER_NON_NULL(iterator);
+	BT_ASSERT_PRE("message-iterator-is-not-seeking",
+		iterator->state == BT_MESSAGE_ITERATOR_STATE_NON_INITIALIZED ||
+		iterator->state == BT_MESSAGE_ITERATOR_STATE_ACTIVE,
+		"Message iterator is in the wrong state: %!+i", iterator);
+	BT_ASSERT_PRE("upstream-message-iterator-is-upstream",
+		!upstream_msg_iter ||
+			upstream_msg_iter->downstream_msg_iter == iterator,
+		"Message iterator is not an upstream message iterator of "
+		"the self message iterator: %![iter-]+i, "
+		"%![upstream-iter-]+i", iterator, upstream_msg_iter);
+	BT_ASSERT_PRE("upstream-message-iterator-is-active",
+		!upstream_msg_iter ||
+			upstream_msg_iter->state ==
+				BT_MESSAGE_ITERATOR_STATE_ACTIVE,
+		"Upstream message iterator is in the wrong state: "
+		"%![upstream-iter-]+i", upstream_msg_iter);
+	stop_pass_through(iterator);
+
+	if (!upstream_msg_iter) {
+		goto end;
+	}
+
+	BT_ASSERT(!iterator->pass_through.original_next_callback);
+	iterator->pass_through.original_next_callback = iterator->methods.next;
+	iterator->pass_through.upstream_msg_iter = upstream_msg_iter;
+	iterator->pass_through.reclaim_msg_types = reclaim_msg_types;
+	iterator->methods.next =
+		(bt_message_iterator_next_method) pass_through_next;
+	BT_LIB_LOGD("Message iterator now passes through: "
+		"%![iter-]+i, %![upstream-iter-]+i, reclaim-msg-types=%" PRIx64,
+		iterator, upstream_msg_iter, reclaim_msg_types);
+
+end:
+	return;
+}
+
 BT_EXPORT
 bt_bool bt_self_message_iterator_is_interrupted(
 		const struct bt_self_message_iterator *self_msg_iter)
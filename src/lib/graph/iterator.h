@@ -146,6 +146,13 @@ struct bt_message_iterator {
 		 */
 		GQueue *msgs;
 
+		/*
+		 * Estimated size of the messages of `msgs` (bytes), which
+		 * the upstream component retains (see
+		 * bt_component_add_retained_memory_size()).
+		 */
+		uint64_t msgs_size;
+
 		/*
 		 * After auto-seeking, we replace the iterator's `next` callback
 		 * with our own, which returns the contents of the `msgs` queue.
@@ -155,6 +162,45 @@ struct bt_message_iterator {
 		void *original_next_callback;
 	} auto_seek;
 
+	/*
+	 * Data necessary for pass-through (see
+	 * bt_self_message_iterator_set_pass_through()).
+	 */
+	struct {
+		/*
+		 * Upstream message iterator of which this iterator passes
+		 * the messages through, or `NULL` if not passing through
+		 * (weak).
+		 */
+		struct bt_message_iterator *upstream_msg_iter;
+
+		/*
+		 * Bitwise OR of message types which make this iterator
+		 * stop passing through.
+		 */
+		uint64_t reclaim_msg_types;
+
+		/*
+		 * While passing through, we replace the iterator's `next`
+		 * callback with our own, which gets the messages of
+		 * `upstream_msg_iter`. This field is where we save the
+		 * original callback, so we can restore it.
+		 */
+		void *original_next_callback;
+
+		/*
+		 * Number of messages, at the beginning of `msgs`, which
+		 * the next call to bt_message_iterator_next() returns
+		 * again without calling the "next" method (owned by this
+		 * iterator until then).
+		 *
+		 * This is the batch which made the downstream message
+		 * iterator stop passing through: it gets it from its own
+		 * "next" method.
+		 */
+		uint64_t redeliver_msg_count;
+	} pass_through;
+
 	void *user_data;
 };
 
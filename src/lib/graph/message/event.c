@@ -283,6 +283,26 @@ void bt_message_event_recycle(struct bt_message *msg)
 		return;
 	}
 
+	graph = msg->graph;
+
+	if (G_UNLIKELY(bt_object_pool_is_full(&graph->event_msg_pool))) {
+		/*
+		 * The graph's event message pool is full: destroy this
+		 * message as well as its event instead of recycling the
+		 * event into its class's pool so that the memory of a
+		 * burst of events is eventually released.
+		 */
+		BT_LIB_LOGD("Event message pool is full: destroying event message: "
+			"%![msg-]+n, %![event-]+e", msg, event_msg->event);
+		graph->event_msg_pool.stats.discards++;
+		bt_graph_remove_message(graph, msg);
+		BT_ASSERT_DBG(event_msg->event);
+		bt_event_destroy(event_msg->event);
+		event_msg->event = NULL;
+		bt_message_event_destroy(msg);
+		return;
+	}
+
 	BT_LIB_LOGD("Recycling event message: %![msg-]+n, %![event-]+e",
 		msg, event_msg->event);
 	bt_message_reset(msg);
@@ -295,7 +315,6 @@ void bt_message_event_recycle(struct bt_message *msg)
 		event_msg->default_cs = NULL;
 	}
 
-	graph = msg->graph;
 	msg->graph = NULL;
 	bt_object_pool_recycle_object(&graph->event_msg_pool, msg);
 }
@@ -9,10 +9,19 @@
 #include "lib/logging.h"
 
 #include "common/assert.h"
+#include "common/common.h"
 #include "lib/assert-cond.h"
 #include <babeltrace2/graph/message.h>
 #include "lib/graph/message/message.h"
+#include "lib/graph/message/discarded-items.h"
+#include "lib/graph/message/event.h"
+#include "lib/graph/message/message-iterator-inactivity.h"
+#include "lib/graph/message/packet.h"
+#include "lib/graph/message/stream.h"
 #include "lib/graph/graph.h"
+#include "lib/trace-ir/clock-snapshot.h"
+#include "lib/trace-ir/event.h"
+#include "lib/trace-ir/field.h"
 
 void bt_message_init(struct bt_message *message,
 		enum bt_message_type type,
@@ -36,6 +45,67 @@ enum bt_message_type bt_message_get_type(
 	return message->type;
 }
 
+BT_EXPORT
+uint64_t bt_message_get_retained_memory_size(const struct bt_message *message)
+{
+	uint64_t size = 0;
+
+	BT_ASSERT_PRE_DEV_MSG_NON_NULL(message);
+
+	switch (message->type) {
+	case BT_MESSAGE_TYPE_EVENT:
+	{
+		const struct bt_message_event *event_msg = (const void *) message;
+		const struct bt_event *event = event_msg->event;
+
+		size = sizeof(*event_msg) + sizeof(*event);
+
+		if (event_msg->default_cs) {
+			size += sizeof(struct bt_clock_snapshot);
+		}
+
+		if (event->common_context_field) {
+			size += bt_field_get_memory_size(
+				event->common_context_field);
+		}
+
+		if (event->specific_context_field) {
+			size += bt_field_get_memory_size(
+				event->specific_context_field);
+		}
+
+		if (event->payload_field) {
+			size += bt_field_get_memory_size(event->payload_field);
+		}
+
+		break;
+	}
+	case BT_MESSAGE_TYPE_STREAM_BEGINNING:
+	case BT_MESSAGE_TYPE_STREAM_END:
+		size = sizeof(struct bt_message_stream) +
+			sizeof(struct bt_clock_snapshot);
+		break;
+	case BT_MESSAGE_TYPE_PACKET_BEGINNING:
+	case BT_MESSAGE_TYPE_PACKET_END:
+		size = sizeof(struct bt_message_packet) +
+			sizeof(struct bt_clock_snapshot);
+		break;
+	case BT_MESSAGE_TYPE_DISCARDED_EVENTS:
+	case BT_MESSAGE_TYPE_DISCARDED_PACKETS:
+		size = sizeof(struct bt_message_discarded_items) +
+			2 * sizeof(struct bt_clock_snapshot);
+		break;
+	case BT_MESSAGE_TYPE_MESSAGE_ITERATOR_INACTIVITY:
+		size = sizeof(struct bt_message_message_iterator_inactivity) +
+			sizeof(struct bt_clock_snapshot);
+		break;
+	default:
+		bt_common_abort();
+	}
+
+	return size;
+}
+
 void bt_message_unlink_graph(struct bt_message *msg)
 {
 	BT_ASSERT(msg);
@@ -14,6 +14,7 @@
 #include <babeltrace2/graph/self-component-port.h>
 #include "lib/object.h"
 #include "compat/compiler.h"
+#include <inttypes.h>
 
 #include "component.h"
 #include "connection.h"
@@ -62,6 +63,8 @@ struct bt_port *bt_port_create(struct bt_component *parent_component,
 
 	port->type = type;
 	port->user_data = user_data;
+	port->needed_event_fields =
+		BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_ALL;
 	bt_object_set_parent(&port->base, &parent_component->base);
 	BT_LIB_LOGI("Created port for component: "
 		"%![comp-]+c, %![port-]+p", parent_component, port);
@@ -135,6 +138,24 @@ void *bt_self_component_port_get_data(const struct bt_self_component_port *port)
 	return ((struct bt_port *) port)->user_data;
 }
 
+BT_EXPORT
+void bt_self_component_port_input_set_needed_event_fields(
+		struct bt_self_component_port_input *self_port,
+		uint64_t needed_event_fields)
+{
+	struct bt_port *port = (void *) self_port;
+
+	BT_ASSERT_PRE_PORT_NON_NULL(port);
+	BT_ASSERT_PRE("valid-needed-event-fields",
+		(needed_event_fields &
+			~(uint64_t) BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_ALL) == 0,
+		"Unknown needed event field flag: %![port-]+p, flags=%#" PRIx64,
+		port, needed_event_fields);
+	port->needed_event_fields = needed_event_fields;
+	BT_LIB_LOGD("Set input port's needed event fields: %![port-]+p",
+		port);
+}
+
 BT_EXPORT
 void bt_port_get_ref(const struct bt_port *port)
 {
@@ -16,6 +16,13 @@ struct bt_port {
 	GString *name;
 	struct bt_connection *connection;
 	void *user_data;
+
+	/*
+	 * Bitwise OR of
+	 * `enum bt_self_component_port_input_needed_event_fields`
+	 * enumerators: only meaningful for an input port.
+	 */
+	uint64_t needed_event_fields;
 };
 
 struct bt_component;
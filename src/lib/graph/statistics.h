@@ -0,0 +1,119 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2024 EfficiOS Inc.
+ */
+
+#ifndef BABELTRACE_GRAPH_STATISTICS_INTERNAL_H
+#define BABELTRACE_GRAPH_STATISTICS_INTERNAL_H
+
+#include <stdint.h>
+#include <time.h>
+
+#include "common/assert.h"
+
+/*
+ * Performance counters of a component, only updated when its graph
+ * has statistics enabled (see bt_graph_enable_statistics()).
+ *
+ * The counters of all the message iterators of a source or filter
+ * component are accumulated here: a message iterator may be destroyed
+ * before the graph ends.
+ */
+struct bt_component_statistics {
+	/* Number of created message iterators */
+	uint64_t msg_iter_count;
+
+	/* Number of "next" method calls */
+	uint64_t next_calls;
+
+	/* Number of returned messages */
+	uint64_t msgs;
+
+	/* Number of "next" method calls which returned "try again" */
+	uint64_t again_count;
+
+	/* Time spent in the "next" method, including upstream calls (ns) */
+	uint64_t next_incl_ns;
+
+	/* Time spent in the "next" method, excluding upstream calls (ns) */
+	uint64_t next_excl_ns;
+
+	/* Number of "consume" method calls */
+	uint64_t consume_calls;
+
+	/* Time spent in the "consume" method, including upstream calls (ns) */
+	uint64_t consume_incl_ns;
+
+	/* Time spent in the "consume" method, excluding upstream calls (ns) */
+	uint64_t consume_excl_ns;
+};
+
+/*
+ * A timed user method call.
+ *
+ * A graph keeps a pointer to its innermost timed call so that a nested
+ * call (an upstream "next" method call) can add its duration to its
+ * caller, which then excludes it from its own exclusive time.
+ */
+struct bt_graph_statistics_frame {
+	struct bt_graph_statistics_frame *parent;
+	uint64_t begin_ns;
+
+	/* Total duration of the nested calls (ns) */
+	uint64_t nested_ns;
+};
+
+static inline
+uint64_t bt_graph_statistics_now_ns(void)
+{
+	struct timespec ts;
+	int ret;
+
+	ret = clock_gettime(CLOCK_MONOTONIC, &ts);
+	BT_ASSERT_DBG(ret == 0);
+	(void) ret;
+	return (uint64_t) ts.tv_sec * UINT64_C(1000000000) +
+		(uint64_t) ts.tv_nsec;
+}
+
+/*
+ * Begins the timed call `frame`, making it the innermost timed call
+ * `*cur_frame`.
+ */
+static inline
+void bt_graph_statistics_frame_begin(
+		struct bt_graph_statistics_frame **cur_frame,
+		struct bt_graph_statistics_frame *frame)
+{
+	frame->parent = *cur_frame;
+	frame->nested_ns = 0;
+	*cur_frame = frame;
+	frame->begin_ns = bt_graph_statistics_now_ns();
+}
+
+/*
+ * Ends the innermost timed call `frame`, adding its inclusive and
+ * exclusive durations to `*incl_ns` and `*excl_ns`.
+ */
+static inline
+void bt_graph_statistics_frame_end(
+		struct bt_graph_statistics_frame **cur_frame,
+		struct bt_graph_statistics_frame *frame,
+		uint64_t *incl_ns, uint64_t *excl_ns)
+{
+	const uint64_t duration = bt_graph_statistics_now_ns() -
+		frame->begin_ns;
+
+	BT_ASSERT_DBG(*cur_frame == frame);
+	*cur_frame = frame->parent;
+
+	if (frame->parent) {
+		frame->parent->nested_ns += duration;
+	}
+
+	*incl_ns += duration;
+	*excl_ns += duration - frame->nested_ns;
+}
+
+#endif /* BABELTRACE_GRAPH_STATISTICS_INTERNAL_H */
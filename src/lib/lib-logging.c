@@ -50,6 +50,7 @@
 #include "trace-ir/stream.h"
 #include "trace-ir/trace-class.h"
 #include "trace-ir/trace.h"
+#include "trace-ir/utils.h"
 #include "error.h"
 
 #define LIB_LOGGING_BUF_SIZE	(4096 * 4)
@@ -127,6 +128,13 @@ static inline void format_object_pool(char **buf_ch, const char *prefix,
 	if (pool->objects) {
 		BUF_APPEND(", %scap=%u", PRFIELD(pool->objects->len));
 	}
+
+	BUF_APPEND(", %smax-size=%zu, %shits=%" PRIu64 ", "
+		"%smisses=%" PRIu64 ", %sdiscards=%" PRIu64 ", "
+		"%speak-size=%zu",
+		PRFIELD(pool->max_size), PRFIELD(pool->stats.hits),
+		PRFIELD(pool->stats.misses), PRFIELD(pool->stats.discards),
+		PRFIELD(pool->stats.peak_size));
 }
 
 static inline void format_integer_field_class(char **buf_ch, const char *prefix,
@@ -814,9 +822,18 @@ static inline void format_clock_snapshot(char **buf_ch, bool extended,
 		const char *prefix, const struct bt_clock_snapshot *clock_snapshot)
 {
 	char tmp_prefix[TMP_PREFIX_LEN];
-	BUF_APPEND(", %svalue=%" PRIu64 ", %sns-from-origin=%" PRId64,
-		PRFIELD(clock_snapshot->value_cycles),
-		PRFIELD(clock_snapshot->ns_from_origin));
+	int64_t ns_from_origin;
+
+	BUF_APPEND(", %svalue=%" PRIu64, PRFIELD(clock_snapshot->value_cycles));
+
+	if (clock_snapshot->clock_class && clock_snapshot->is_set &&
+			bt_util_ns_from_origin_clock_class(
+				clock_snapshot->clock_class,
+				clock_snapshot->value_cycles,
+				&ns_from_origin) == 0) {
+		BUF_APPEND(", %sns-from-origin=%" PRId64,
+			PRFIELD(ns_from_origin));
+	}
 
 	if (!extended) {
 		return;
@@ -1111,6 +1128,11 @@ static inline void format_port(char **buf_ch, bool extended,
 		return;
 	}
 
+	if (port->type == BT_PORT_TYPE_INPUT) {
+		BUF_APPEND(", %sneeded-event-fields=%#" PRIx64,
+			PRFIELD(port->needed_event_fields));
+	}
+
 	if (port->connection) {
 		SET_TMP_PREFIX("conn-");
 		format_connection(buf_ch, false, tmp_prefix, port->connection);
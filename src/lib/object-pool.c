@@ -8,6 +8,7 @@
 #include "lib/logging.h"
 
 #include <stdint.h>
+#include <string.h>
 #include "common/assert.h"
 #include "lib/object-pool.h"
 
@@ -33,6 +34,8 @@ int bt_object_pool_initialize(struct bt_object_pool *pool,
 	pool->funcs.destroy_object = destroy_object_func;
 	pool->data = data;
 	pool->size = 0;
+	pool->max_size = 0;
+	memset(&pool->stats, 0, sizeof(pool->stats));
 	BT_LIB_LOGD("Initialized object pool: %!+o", pool);
 	goto end;
 
@@ -64,3 +67,77 @@ void bt_object_pool_finalize(struct bt_object_pool *pool)
 		pool->objects = NULL;
 	}
 }
+
+void bt_object_pool_set_max_size(struct bt_object_pool *pool,
+		size_t max_size)
+{
+	BT_ASSERT(pool);
+	pool->max_size = max_size;
+
+	if (max_size == 0) {
+		goto end;
+	}
+
+	/* Destroy the recycled objects which exceed the new maximum */
+	while (pool->size > max_size) {
+		pool->size--;
+		pool->funcs.destroy_object(pool->objects->pdata[pool->size],
+			pool->data);
+		pool->objects->pdata[pool->size] = NULL;
+		pool->stats.discards++;
+	}
+
+	if (pool->objects->len > max_size) {
+		g_ptr_array_set_size(pool->objects, max_size);
+	}
+
+end:
+	BT_LIB_LOGD("Set object pool's maximum size: %!+o", pool);
+}
+
+int bt_object_pool_prewarm(struct bt_object_pool *pool, size_t count)
+{
+	int ret = 0;
+
+	BT_ASSERT(pool);
+
+	if (pool->max_size > 0 && count > pool->max_size) {
+		count = pool->max_size;
+	}
+
+	if (pool->size >= count) {
+		goto end;
+	}
+
+	BT_LIB_LOGD("Pre-warming object pool: %![pool-]+o, count=%zu",
+		pool, count);
+
+	/* Grow the backing array once */
+	if (pool->objects->len < count) {
+		g_ptr_array_set_size(pool->objects, count);
+	}
+
+	while (pool->size < count) {
+		struct bt_object *obj = pool->funcs.new_object(pool->data);
+
+		if (!obj) {
+			BT_LIB_LOGE_APPEND_CAUSE(
+				"Failed to allocate one object: %!+o", pool);
+			ret = -1;
+			goto end;
+		}
+
+		obj->ref_count = 1;
+		pool->objects->pdata[pool->size] = obj;
+		pool->size++;
+	}
+
+	if (pool->size > pool->stats.peak_size) {
+		pool->stats.peak_size = pool->size;
+	}
+
+	BT_LIB_LOGD("Pre-warmed object pool: %!+o", pool);
+
+end:
+	return ret;
+}
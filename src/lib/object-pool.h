@@ -30,9 +30,18 @@
  *   bt_*_recycle() function which does the necessary before calling
  *   bt_object_pool_recycle_object() with an object ready to be reused
  *   at any time.
+ *
+ * An object pool can have a maximum size (see
+ * bt_object_pool_set_max_size()): when the pool is full,
+ * bt_object_pool_recycle_object() calls the "destroy" user function
+ * instead of keeping the object so that the memory of the objects of
+ * a burst is eventually released. You can also pre-allocate objects
+ * with bt_object_pool_prewarm().
  */
 
 #include <glib.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include "lib/object.h"
 
 /* Protection: this file uses BT_LIB_LOG*() macros directly */
@@ -56,6 +65,9 @@ struct bt_object_pool {
 	 */
 	size_t size;
 
+	/* Maximum pool size, or 0 if the pool is not bounded */
+	size_t max_size;
+
 	/* User functions */
 	struct {
 		/* Allocate a new object in memory */
@@ -67,6 +79,21 @@ struct bt_object_pool {
 
 	/* User data passed to user functions */
 	void *data;
+
+	/* Statistics */
+	struct {
+		/* Number of objects taken from the pool */
+		uint64_t hits;
+
+		/* Number of objects allocated because the pool was empty */
+		uint64_t misses;
+
+		/* Number of objects destroyed because the pool was full */
+		uint64_t discards;
+
+		/* Largest pool size so far */
+		size_t peak_size;
+	} stats;
 };
 
 /*
@@ -82,6 +109,33 @@ int bt_object_pool_initialize(struct bt_object_pool *pool,
  */
 void bt_object_pool_finalize(struct bt_object_pool *pool);
 
+/*
+ * Sets the maximum size of an object pool to `max_size` (0 means no
+ * maximum), destroying the recycled objects which exceed it.
+ */
+void bt_object_pool_set_max_size(struct bt_object_pool *pool,
+		size_t max_size);
+
+/*
+ * Allocates new objects with the "new" user function and adds them to
+ * an object pool until its size is at least `count` (or its maximum
+ * size).
+ *
+ * Returns 0 on success, or -1 on memory error.
+ */
+int bt_object_pool_prewarm(struct bt_object_pool *pool, size_t count);
+
+/*
+ * Returns whether or not an object pool is full, that is, whether or
+ * not bt_object_pool_recycle_object() would destroy the object to
+ * recycle.
+ */
+static inline
+bool bt_object_pool_is_full(const struct bt_object_pool *pool)
+{
+	return pool->max_size > 0 && pool->size >= pool->max_size;
+}
+
 /*
  * Creates an object from an object pool. If the pool is empty, this
  * function calls the "new" user function to allocate a new object
@@ -104,6 +158,7 @@ void *bt_object_pool_create_object(struct bt_object_pool *pool)
 		pool->size--;
 		obj = pool->objects->pdata[pool->size];
 		pool->objects->pdata[pool->size] = NULL;
+		pool->stats.hits++;
 		goto end;
 	}
 
@@ -111,6 +166,7 @@ void *bt_object_pool_create_object(struct bt_object_pool *pool)
 	BT_LOGD("Pool is empty: allocating new object: pool-addr=%p",
 		pool);
 	obj = pool->funcs.new_object(pool->data);
+	pool->stats.misses++;
 
 end:
 	BT_LOGT("Created one object from pool: pool-addr=%p, obj-addr=%p",
@@ -121,7 +177,9 @@ end:
 /*
  * Recycles an object, that is, puts it back into the pool.
  *
- * The pool becomes the sole owner of the object to recycle.
+ * The pool becomes the sole owner of the object to recycle. If the
+ * pool is full, this function destroys the object with the "destroy"
+ * user function.
  */
 static inline
 void bt_object_pool_recycle_object(struct bt_object_pool *pool, void *obj)
@@ -133,6 +191,16 @@ void bt_object_pool_recycle_object(struct bt_object_pool *pool, void *obj)
 	BT_LOGT("Recycling object: pool-addr=%p, pool-size=%zu, pool-cap=%u, obj-addr=%p",
 		pool, pool->size, pool->objects->len, obj);
 
+	if (G_UNLIKELY(bt_object_pool_is_full(pool))) {
+		/* Pool reached its maximum size: destroy the object */
+		BT_LOGD("Object pool reached its maximum size: destroying object: "
+			"pool-addr=%p, pool-max-size=%zu, obj-addr=%p",
+			pool, pool->max_size, obj);
+		pool->stats.discards++;
+		pool->funcs.destroy_object(obj, pool->data);
+		return;
+	}
+
 	if (pool->size == pool->objects->len) {
 		/* Backing array is full: make place for recycled object */
 		BT_LOGD("Object pool is full: increasing object pool capacity: "
@@ -147,6 +215,11 @@ void bt_object_pool_recycle_object(struct bt_object_pool *pool, void *obj)
 	/* Back to the pool */
 	pool->objects->pdata[pool->size] = obj;
 	pool->size++;
+
+	if (G_UNLIKELY(pool->size > pool->stats.peak_size)) {
+		pool->stats.peak_size = pool->size;
+	}
+
 	BT_LOGT("Recycled object: pool-addr=%p, pool-size=%zu, pool-cap=%u, obj-addr=%p",
 		pool, pool->size, pool->objects->len, obj);
 }
@@ -61,9 +61,42 @@ void free_clock_snapshot(struct bt_clock_snapshot *clock_snapshot,
 static inline
 void set_base_offset(struct bt_clock_class *clock_class)
 {
+	uint64_t ns_per_cycle;
+	uint64_t max_value_ns;
+
 	clock_class->base_offset.overflows = bt_util_get_base_offset_ns(
 		clock_class->offset_seconds, clock_class->offset_cycles,
 		clock_class->frequency, &clock_class->base_offset.value_ns);
+	clock_class->ns_from_origin_kernel.ns_per_cycle = 0;
+	clock_class->ns_from_origin_kernel.max_value = 0;
+
+	if (clock_class->base_offset.overflows) {
+		goto end;
+	}
+
+	ns_per_cycle = bt_util_ns_per_cycle(clock_class->frequency);
+	if (ns_per_cycle == 0) {
+		goto end;
+	}
+
+	/*
+	 * Same limits as bt_util_ns_from_origin_inline(): the converted
+	 * value must be less than `INT64_MAX` and must not make the
+	 * result overflow once added to a positive base offset.
+	 */
+	max_value_ns = (uint64_t) INT64_MAX - 1;
+
+	if (clock_class->base_offset.value_ns > 0) {
+		max_value_ns = (uint64_t) (INT64_MAX -
+			clock_class->base_offset.value_ns);
+	}
+
+	clock_class->ns_from_origin_kernel.ns_per_cycle = ns_per_cycle;
+	clock_class->ns_from_origin_kernel.max_value =
+		max_value_ns / ns_per_cycle;
+
+end:
+	return;
 }
 
 BT_EXPORT
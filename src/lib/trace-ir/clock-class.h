@@ -73,6 +73,25 @@ struct bt_clock_class {
 		bool overflows;
 	} base_offset;
 
+	/*
+	 * Conversion kernel from a raw value (cycles) to nanoseconds
+	 * from origin, computed with `base_offset` above.
+	 *
+	 * If the frequency divides 1 GHz (a 1 GHz frequency being the
+	 * identity case) and the base offset doesn't overflow, then
+	 * `ns_per_cycle` is the number of nanoseconds per cycle and
+	 * `max_value` is the greatest raw value which doesn't overflow
+	 * once converted: a conversion is then only a comparison, a
+	 * multiplication, and an addition.
+	 *
+	 * Otherwise, `ns_per_cycle` is 0 and a conversion goes through
+	 * the general arithmetic of bt_util_ns_from_origin_inline().
+	 */
+	struct {
+		uint64_t ns_per_cycle;
+		uint64_t max_value;
+	} ns_from_origin_kernel;
+
 	/* Pool of `struct bt_clock_snapshot *` */
 	struct bt_object_pool cs_pool;
 
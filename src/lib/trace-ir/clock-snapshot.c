@@ -10,6 +10,7 @@
 #include "lib/assert-cond.h"
 #include "clock-class.h"
 #include "clock-snapshot.h"
+#include "utils.h"
 #include <babeltrace2/trace-ir/clock-snapshot.h>
 #include "compat/compiler.h"
 #include <babeltrace2/types.h>
@@ -133,18 +134,15 @@ bt_clock_snapshot_get_ns_from_origin(
 		"Value (ns) (output)");
 	BT_ASSERT_DBG(clock_snapshot->is_set);
 
-	if (clock_snapshot->ns_from_origin_overflows) {
+	if (bt_util_ns_from_origin_clock_class(clock_snapshot->clock_class,
+			clock_snapshot->value_cycles, ret_value_ns)) {
 		BT_LIB_LOGE_APPEND_CAUSE(
 			"Clock snapshot, once converted to nanoseconds from origin, "
 			"overflows the signed 64-bit integer range: "
 			"%![cs-]+k", clock_snapshot);
 		ret = BT_FUNC_STATUS_OVERFLOW_ERROR;
-		goto end;
 	}
 
-	*ret_value_ns = clock_snapshot->ns_from_origin;
-
-end:
 	return ret;
 }
 
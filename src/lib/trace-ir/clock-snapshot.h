@@ -20,8 +20,6 @@ struct bt_clock_snapshot {
 	struct bt_object base;
 	struct bt_clock_class *clock_class;
 	uint64_t value_cycles;
-	bool ns_from_origin_overflows;
-	int64_t ns_from_origin;
 	bool is_set;
 };
 
@@ -39,23 +37,18 @@ void bt_clock_snapshot_reset(struct bt_clock_snapshot *clock_snapshot)
 	clock_snapshot->is_set = false;
 }
 
-static inline
-void set_ns_from_origin(struct bt_clock_snapshot *clock_snapshot)
-{
-	if (bt_util_ns_from_origin_clock_class(clock_snapshot->clock_class,
-			clock_snapshot->value_cycles,
-			&clock_snapshot->ns_from_origin)) {
-		clock_snapshot->ns_from_origin_overflows = true;
-	}
-}
-
 static inline
 void bt_clock_snapshot_set_raw_value(struct bt_clock_snapshot *clock_snapshot,
 		uint64_t cycles)
 {
 	BT_ASSERT_DBG(clock_snapshot);
+
+	/*
+	 * The value in nanoseconds from origin is only computed on
+	 * demand by bt_clock_snapshot_get_ns_from_origin(), with the
+	 * clock class's precomputed conversion kernel.
+	 */
 	clock_snapshot->value_cycles = cycles;
-	set_ns_from_origin(clock_snapshot);
 	bt_clock_snapshot_set(clock_snapshot);
 }
 
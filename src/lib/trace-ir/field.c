@@ -274,6 +274,104 @@ end:
 	return field;
 }
 
+static
+uint64_t get_field_ptr_array_memory_size(const GPtrArray *fields)
+{
+	uint64_t size = (uint64_t) fields->len * sizeof(struct bt_field *);
+	guint i;
+
+	for (i = 0; i < fields->len; i++) {
+		size += bt_field_get_memory_size(fields->pdata[i]);
+	}
+
+	return size;
+}
+
+/*
+ * Returns an estimate of the size of the memory which `field`, including
+ * its subfields and buffers, occupies.
+ *
+ * This includes the subfields which a dynamic array field allocated
+ * beyond its current length, as well as all the option fields of a
+ * variant field, since the field keeps them.
+ */
+uint64_t bt_field_get_memory_size(const struct bt_field *field)
+{
+	uint64_t size = 0;
+
+	BT_ASSERT_DBG(field);
+
+	switch (field->class->type) {
+	case BT_FIELD_CLASS_TYPE_BOOL:
+		size = sizeof(struct bt_field_bool);
+		break;
+	case BT_FIELD_CLASS_TYPE_BIT_ARRAY:
+		size = sizeof(struct bt_field_bit_array);
+		break;
+	case BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER:
+	case BT_FIELD_CLASS_TYPE_SIGNED_INTEGER:
+	case BT_FIELD_CLASS_TYPE_UNSIGNED_ENUMERATION:
+	case BT_FIELD_CLASS_TYPE_SIGNED_ENUMERATION:
+		size = sizeof(struct bt_field_integer);
+		break;
+	case BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL:
+	case BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL:
+		size = sizeof(struct bt_field_real);
+		break;
+	case BT_FIELD_CLASS_TYPE_STRING:
+	{
+		const struct bt_field_string *string_field = (const void *) field;
+
+		size = sizeof(*string_field) + string_field->buf->len;
+		break;
+	}
+	case BT_FIELD_CLASS_TYPE_STRUCTURE:
+	{
+		const struct bt_field_structure *struct_field =
+			(const void *) field;
+
+		size = sizeof(*struct_field) +
+			get_field_ptr_array_memory_size(struct_field->fields);
+		break;
+	}
+	case BT_FIELD_CLASS_TYPE_STATIC_ARRAY:
+	case BT_FIELD_CLASS_TYPE_DYNAMIC_ARRAY_WITHOUT_LENGTH_FIELD:
+	case BT_FIELD_CLASS_TYPE_DYNAMIC_ARRAY_WITH_LENGTH_FIELD:
+	{
+		const struct bt_field_array *array_field = (const void *) field;
+
+		size = sizeof(*array_field) +
+			get_field_ptr_array_memory_size(array_field->fields);
+		break;
+	}
+	case BT_FIELD_CLASS_TYPE_OPTION_WITHOUT_SELECTOR_FIELD:
+	case BT_FIELD_CLASS_TYPE_OPTION_WITH_BOOL_SELECTOR_FIELD:
+	case BT_FIELD_CLASS_TYPE_OPTION_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD:
+	case BT_FIELD_CLASS_TYPE_OPTION_WITH_SIGNED_INTEGER_SELECTOR_FIELD:
+	{
+		const struct bt_field_option *opt_field = (const void *) field;
+
+		size = sizeof(*opt_field) +
+			bt_field_get_memory_size(opt_field->content_field);
+		break;
+	}
+	case BT_FIELD_CLASS_TYPE_VARIANT_WITHOUT_SELECTOR_FIELD:
+	case BT_FIELD_CLASS_TYPE_VARIANT_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD:
+	case BT_FIELD_CLASS_TYPE_VARIANT_WITH_SIGNED_INTEGER_SELECTOR_FIELD:
+	{
+		const struct bt_field_variant *var_field = (const void *) field;
+
+		size = sizeof(*var_field) +
+			get_field_ptr_array_memory_size(var_field->fields);
+		break;
+	}
+	default:
+		bt_common_abort();
+	}
+
+	return size;
+}
+
 static inline
 void init_field(struct bt_field *field, struct bt_field_class *fc,
 		struct bt_field_methods *methods)
@@ -161,4 +161,6 @@ struct bt_field *bt_field_create(struct bt_field_class *class);
 
 void bt_field_destroy(struct bt_field *field);
 
+uint64_t bt_field_get_memory_size(const struct bt_field *field);
+
 #endif /* BABELTRACE_TRACE_IR_FIELDS_INTERNAL_H */
@@ -18,13 +18,32 @@ struct search_query {
 	int found;
 };
 
+/*
+ * Returns the number of nanoseconds per cycle of a clock having the
+ * frequency `frequency` (Hz) if this frequency divides 1 GHz, or 0
+ * otherwise.
+ */
+static inline
+uint64_t bt_util_ns_per_cycle(uint64_t frequency)
+{
+	return UINT64_C(1000000000) % frequency == 0 ?
+		UINT64_C(1000000000) / frequency : 0;
+}
+
 static inline
 uint64_t bt_util_ns_from_value(uint64_t frequency, uint64_t value_cycles)
 {
 	uint64_t ns;
+	uint64_t ns_per_cycle = bt_util_ns_per_cycle(frequency);
 
-	if (frequency == UINT64_C(1000000000)) {
-		ns = value_cycles;
+	if (ns_per_cycle != 0) {
+		/* Exact integer conversion */
+		if (value_cycles > UINT64_MAX / ns_per_cycle) {
+			/* Overflows uint64_t */
+			ns = UINT64_C(-1);
+		} else {
+			ns = value_cycles * ns_per_cycle;
+		}
 	} else {
 		double dblres = ((1e9 * (double) value_cycles) / (double) frequency);
 
@@ -127,6 +146,20 @@ int bt_util_ns_from_origin_clock_class(const struct bt_clock_class *clock_class,
 {
 	int ret = 0;
 
+	if (G_LIKELY(clock_class->ns_from_origin_kernel.ns_per_cycle != 0)) {
+		/* Precomputed kernel: see `struct bt_clock_class` */
+		if (G_UNLIKELY(value >
+				clock_class->ns_from_origin_kernel.max_value)) {
+			ret = -1;
+			goto end;
+		}
+
+		*ns_from_origin = clock_class->base_offset.value_ns +
+			(int64_t) (value *
+				clock_class->ns_from_origin_kernel.ns_per_cycle);
+		goto end;
+	}
+
 	if (clock_class->base_offset.overflows) {
 		ret = -1;
 		goto end;
@@ -11,6 +11,7 @@
 
 #include <ctype.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <glib.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -40,6 +41,7 @@
 # include <sys/thr.h>
 #endif
 
+#include "common/align.h"
 #include "common/assert.h"
 #include "common/common.h"
 #include "common/macros.h"
@@ -166,12 +168,11 @@ void append_date_time_to_msg_buf(char ** const at, const struct timeval tv)
 }
 
 /*
- * Appends the PID and TID to `msg_buf`.
+ * Returns the ID of the current thread.
  */
-static inline
-void append_pid_tid_to_msg_buf(char ** const at)
+static
+unsigned int get_tid(void)
 {
-	const unsigned int pid = (unsigned int) getpid();
 	unsigned int tid;
 
 	/* Look at this beautiful portability */
@@ -212,6 +213,17 @@ void append_pid_tid_to_msg_buf(char ** const at)
 # error "Platform not supported"
 #endif
 
+	return tid;
+}
+
+/*
+ * Appends the PID and the TID `tid` to `msg_buf`.
+ */
+static inline
+void append_pid_tid_to_msg_buf(char ** const at, const unsigned int tid)
+{
+	const unsigned int pid = (unsigned int) getpid();
+
 	/* Append them now */
 	append_uint_to_msg_buf(at, "%u", pid);
 	append_sp_to_msg_buf(at);
@@ -219,19 +231,16 @@ void append_pid_tid_to_msg_buf(char ** const at)
 }
 
 /*
- * Writes the initial part of the log message to `msg_buf`, without the
- * message and without resetting the terminal color).
+ * Writes the header of a log message (time `tv`, thread `tid`) at
+ * `*at`, without the message and without resetting the terminal color.
  */
 static
-void common_write_init(char ** const at, const char * const file_name,
+void write_header(char ** const at, const struct timeval tv,
+		const unsigned int tid, const char * const file_name,
 		const char * const func_name, const unsigned int line_no,
 		const enum bt_log_level lvl, const char * const tag)
 {
 	const char *color_p = "";
-	struct timeval tv;
-
-	/* Get time immediately */
-	gettimeofday(&tv, 0);
 
 	/* Write the terminal color code to use, if any */
 	switch (lvl) {
@@ -256,7 +265,7 @@ void common_write_init(char ** const at, const char * const file_name,
 	append_sp_to_msg_buf(at);
 
 	/* Write PID/TID */
-	append_pid_tid_to_msg_buf(at);
+	append_pid_tid_to_msg_buf(at, tid);
 	append_sp_to_msg_buf(at);
 
 	/* Write log level letter */
@@ -277,14 +286,744 @@ void common_write_init(char ** const at, const char * const file_name,
 	append_sp_to_msg_buf(at);
 }
 
+/*
+ * Asynchronous back end
+ * ---------------------
+ *
+ * When the `BABELTRACE_LOGGING_ASYNC` environment variable is `1`, a
+ * logging statement doesn't write anything itself: it formats its
+ * message in `msg_buf` and pushes a binary record (time, level, tag,
+ * source location, and message) to the ring buffer of the current
+ * thread.
+ *
+ * A background thread drains the ring buffers of all the threads,
+ * formats the complete log lines, and writes them in batches to the
+ * standard error or to the file of which the path is the value of the
+ * `BABELTRACE_LOGGING_ASYNC_PATH` environment variable.
+ *
+ * Each ring buffer has a single producer (its thread) and a single
+ * consumer (whoever holds `async.lock`), so that pushing a record
+ * doesn't need any lock.
+ *
+ * When a ring buffer is full, the record is dropped (the background
+ * thread reports the number of dropped records), unless
+ * `BABELTRACE_LOGGING_ASYNC_OVERFLOW` is `BLOCK`, in which case the
+ * logging thread waits for the background thread to make room.
+ *
+ * Fatal records, bt_log_flush() (called by bt_common_abort()), and the
+ * library destructor flush all the ring buffers.
+ *
+ * The library destructor first stops accepting records and waits for
+ * the threads which are pushing one, then stops the background thread
+ * (which drains everything), and only then frees the ring buffers.
+ *
+ * Because this file is part of a convenience library, each shared
+ * object which contains it has its own back end state and background
+ * thread.
+ */
+#define ASYNC_ENV_VAR		"BABELTRACE_LOGGING_ASYNC"
+#define ASYNC_PATH_ENV_VAR	"BABELTRACE_LOGGING_ASYNC_PATH"
+#define ASYNC_OVERFLOW_ENV_VAR	"BABELTRACE_LOGGING_ASYNC_OVERFLOW"
+
+/* Size of the ring buffer of a thread (power of two) */
+#define ASYNC_RING_SIZE		(1024 * 1024)
+
+/* Maximum length of a record's tag, file name, and function name */
+#define ASYNC_MAX_NAME_LEN	1024
+
+/* Time to wait when there's nothing to drain (µs) */
+#define ASYNC_IDLE_SLEEP_US	1000
+
+/* Level of a padding record, which skips the end of a ring buffer */
+#define ASYNC_RECORD_PADDING	(-1)
+
+/*
+ * Maximum time the library destructor waits for the threads which are
+ * pushing a record to finish (ms)
+ */
+#define ASYNC_FINI_MAX_WAIT_MS	1000
+
+struct async_record {
+	/* Size of the whole record, including this header and padding */
+	uint32_t size;
+
+	/* Log level, or `ASYNC_RECORD_PADDING` */
+	int32_t lvl;
+
+	uint32_t line_no;
+	uint32_t msg_len;
+	uint16_t tag_len;
+	uint16_t file_name_len;
+	uint16_t func_name_len;
+	bool has_tag;
+	struct timeval tv;
+
+	/*
+	 * Followed by the tag, the file name, the function name, and
+	 * the message, without null characters.
+	 */
+};
+
+struct async_ring {
+	/* Next writing position (only written by the producer) */
+	size_t head;
+
+	/* Next reading position (only written by the consumer) */
+	size_t tail;
+
+	/* Number of records dropped since the last report */
+	unsigned long dropped;
+
+	/* ID of the producer thread */
+	unsigned int tid;
+
+	/* `ASYNC_RING_SIZE` bytes */
+	char *data;
+};
+
+enum async_overflow_policy {
+	ASYNC_OVERFLOW_POLICY_DROP,
+	ASYNC_OVERFLOW_POLICY_BLOCK,
+};
+
+static struct {
+	/*
+	 * Set by the library constructor, reset by the destructor
+	 * (atomic): the back end doesn't accept new records once this
+	 * is false.
+	 */
+	bool enabled;
+
+	/* Number of threads which are pushing a record (atomic) */
+	unsigned int producer_count;
+
+	enum async_overflow_policy overflow_policy;
+
+	/* Output file path, or `NULL` for the standard error */
+	char *path;
+
+	/* Output file descriptor */
+	int fd;
+
+	/* Protects `rings`, `thread`, and `out_buf`, and draining */
+	GMutex lock;
+
+	/*
+	 * Ring buffers (`struct async_ring *`, owned by this).
+	 *
+	 * A ring buffer remains until the library destructor runs, even
+	 * if its thread exits: Babeltrace only creates a few threads.
+	 */
+	GPtrArray *rings;
+
+	/* Background thread */
+	GThread *thread;
+
+	/* True to make the background thread stop (atomic) */
+	bool stop;
+
+	/* Formatted log lines to write */
+	char out_buf[64 * 1024];
+	size_t out_buf_len;
+} async;
+
+/* Ring buffer of the current thread, or `NULL` if not created yet */
+static __thread struct async_ring *async_thread_ring;
+
+/*
+ * Information about the log statement which is being formatted in
+ * `msg_buf` when the asynchronous back end is enabled.
+ */
+static __thread struct {
+	bool is_async;
+	struct timeval tv;
+	const char *file_name;
+	const char *func_name;
+	unsigned int line_no;
+	enum bt_log_level lvl;
+	const char *tag;
+} pending_record;
+
+/*
+ * Writes the formatted log lines of `async.out_buf` to the output.
+ *
+ * `async.lock` must be held.
+ */
+static
+void async_write_out_buf(void)
+{
+	const char *at = async.out_buf;
+	size_t rem = async.out_buf_len;
+
+	while (rem > 0) {
+		const ssize_t ret = write(async.fd, at, rem);
+
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			/* Nowhere to report this: give up */
+			break;
+		}
+
+		at += ret;
+		rem -= (size_t) ret;
+	}
+
+	async.out_buf_len = 0;
+}
+
+/*
+ * Makes sure that `async.out_buf` has at least `len` available bytes.
+ *
+ * `async.lock` must be held.
+ */
+static
+char *async_reserve_out_buf(const size_t len)
+{
+	BT_ASSERT_DBG(len <= sizeof(async.out_buf));
+
+	if (sizeof(async.out_buf) - async.out_buf_len < len) {
+		async_write_out_buf();
+	}
+
+	return &async.out_buf[async.out_buf_len];
+}
+
+/*
+ * Copies `len` bytes of `src` to `dst` as a null-terminated string.
+ */
+static inline
+const char *async_copy_name(char * const dst, const char * const src,
+		const size_t len)
+{
+	memcpy(dst, src, len);
+	dst[len] = '\0';
+	return dst;
+}
+
+/*
+ * Formats the log line of the record `rec` of `ring` into
+ * `async.out_buf`.
+ *
+ * `async.lock` must be held.
+ */
+static
+void async_format_record(const struct async_ring * const ring,
+		const struct async_record * const rec)
+{
+	char tag[ASYNC_MAX_NAME_LEN + 1];
+	char file_name[ASYNC_MAX_NAME_LEN + 1];
+	char func_name[ASYNC_MAX_NAME_LEN + 1];
+	const char *data = (const char *) (rec + 1);
+	char *at;
+	char *begin;
+
+	async_copy_name(tag, data, rec->tag_len);
+	data += rec->tag_len;
+	async_copy_name(file_name, data, rec->file_name_len);
+	data += rec->file_name_len;
+	async_copy_name(func_name, data, rec->func_name_len);
+	data += rec->func_name_len;
+
+	/* The header, without the names, is less than 256 bytes */
+	begin = async_reserve_out_buf(rec->size + 256);
+	at = begin;
+	write_header(&at, rec->tv, ring->tid, file_name, func_name,
+		rec->line_no, (enum bt_log_level) rec->lvl,
+		rec->has_tag ? tag : NULL);
+	memcpy(at, data, rec->msg_len);
+	at += rec->msg_len;
+	append_str_to_msg_buf(&at, bt_common_color_reset());
+	append_char_to_msg_buf(&at, '\n');
+	async.out_buf_len += at - begin;
+}
+
+/*
+ * Formats a warning about `count` dropped records of `ring` into
+ * `async.out_buf`.
+ *
+ * `async.lock` must be held.
+ */
+static
+void async_format_dropped_warning(const struct async_ring * const ring,
+		const unsigned long count)
+{
+	char *begin = async_reserve_out_buf(512);
+	char *at = begin;
+	struct timeval tv;
+
+	gettimeofday(&tv, 0);
+	write_header(&at, tv, ring->tid, __FILE__, __func__, __LINE__,
+		BT_LOG_WARNING, "LOGGING");
+	at += sprintf(at, "Dropped %lu log records: ring buffer is full.",
+		count);
+	append_str_to_msg_buf(&at, bt_common_color_reset());
+	append_char_to_msg_buf(&at, '\n');
+	async.out_buf_len += at - begin;
+}
+
+/*
+ * Formats all the available records of `ring` into `async.out_buf`.
+ *
+ * Returns whether or not there was anything to drain.
+ *
+ * `async.lock` must be held.
+ */
+static
+bool async_drain_ring(struct async_ring * const ring)
+{
+	const size_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+	const unsigned long dropped = __atomic_exchange_n(&ring->dropped, 0,
+		__ATOMIC_RELAXED);
+	size_t tail = ring->tail;
+	const bool drained = tail != head || dropped > 0;
+
+	while (tail != head) {
+		const size_t offset = tail & (ASYNC_RING_SIZE - 1);
+		const struct async_record *rec;
+
+		if (ASYNC_RING_SIZE - offset < sizeof(*rec)) {
+			/* Not even room for a padding record: skip */
+			tail += ASYNC_RING_SIZE - offset;
+			continue;
+		}
+
+		rec = (const void *) &ring->data[offset];
+
+		if (rec->lvl != ASYNC_RECORD_PADDING) {
+			async_format_record(ring, rec);
+		}
+
+		tail += rec->size;
+
+		/* Make room for the producer as soon as possible */
+		__atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+	}
+
+	if (dropped > 0) {
+		async_format_dropped_warning(ring, dropped);
+	}
+
+	return drained;
+}
+
+/*
+ * Drains all the ring buffers and writes the resulting log lines.
+ *
+ * Returns whether or not there was anything to drain.
+ *
+ * `async.lock` must be held.
+ */
+static
+bool async_drain_all(void)
+{
+	bool drained = false;
+	guint i;
+
+	for (i = 0; i < async.rings->len; i++) {
+		drained |= async_drain_ring(async.rings->pdata[i]);
+	}
+
+	async_write_out_buf();
+	return drained;
+}
+
+static
+gpointer async_thread_func(gpointer data __attribute__((unused)))
+{
+	while (true) {
+		/* Read this first to drain everything once it's set */
+		const bool stop = __atomic_load_n(&async.stop,
+			__ATOMIC_ACQUIRE);
+		bool drained;
+
+		g_mutex_lock(&async.lock);
+		drained = async_drain_all();
+		g_mutex_unlock(&async.lock);
+
+		if (stop) {
+			break;
+		}
+
+		if (!drained) {
+			g_usleep(ASYNC_IDLE_SLEEP_US);
+		}
+	}
+
+	return NULL;
+}
+
+static
+void async_ring_destroy(gpointer data)
+{
+	struct async_ring * const ring = data;
+
+	g_free(ring->data);
+	g_free(ring);
+}
+
+/*
+ * Returns the ring buffer of the current thread, creating it (and
+ * starting the background thread) if needed.
+ *
+ * Returns `NULL` on error.
+ */
+static
+struct async_ring *async_get_thread_ring(void)
+{
+	struct async_ring *ring = async_thread_ring;
+
+	if (G_LIKELY(ring)) {
+		goto end;
+	}
+
+	ring = g_try_new0(struct async_ring, 1);
+	if (!ring) {
+		goto end;
+	}
+
+	ring->data = g_try_malloc(ASYNC_RING_SIZE);
+	if (!ring->data) {
+		goto error;
+	}
+
+	ring->tid = get_tid();
+	g_mutex_lock(&async.lock);
+
+	if (!async.thread) {
+		if (async.path) {
+			async.fd = open(async.path,
+				O_WRONLY | O_CREAT | O_APPEND, 0644);
+			if (async.fd < 0) {
+				/* Fall back to the standard error */
+				async.fd = STDERR_FILENO;
+			}
+		}
+
+		async.thread = g_thread_try_new("bt-log-async",
+			async_thread_func, NULL, NULL);
+		if (!async.thread) {
+			g_mutex_unlock(&async.lock);
+			goto error;
+		}
+	}
+
+	g_ptr_array_add(async.rings, ring);
+	g_mutex_unlock(&async.lock);
+	async_thread_ring = ring;
+	goto end;
+
+error:
+	if (ring) {
+		async_ring_destroy(ring);
+		ring = NULL;
+	}
+
+end:
+	return ring;
+}
+
+/*
+ * Reserves `size` contiguous bytes in `ring`, setting `*pos` to their
+ * position.
+ *
+ * Returns false if `ring` is full.
+ */
+static
+bool async_ring_reserve(struct async_ring * const ring, const size_t size,
+		size_t * const pos)
+{
+	size_t head = ring->head;
+	const size_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+	const size_t offset = head & (ASYNC_RING_SIZE - 1);
+	const size_t contig_size = ASYNC_RING_SIZE - offset;
+	const size_t needed_size = size <= contig_size ? size :
+		contig_size + size;
+
+	if (ASYNC_RING_SIZE - (head - tail) < needed_size) {
+		return false;
+	}
+
+	if (size > contig_size) {
+		/* Records are contiguous: skip the end of the ring */
+		if (contig_size >= sizeof(struct async_record)) {
+			struct async_record * const pad =
+				(void *) &ring->data[offset];
+
+			pad->size = (uint32_t) contig_size;
+			pad->lvl = ASYNC_RECORD_PADDING;
+		}
+
+		head += contig_size;
+	}
+
+	*pos = head;
+	return true;
+}
+
+/*
+ * Pushes a record of which the message is the `msg_len` bytes of `msg`
+ * to the ring buffer of the current thread, using `pending_record`.
+ */
+static
+void async_push_record(const char * const msg, const size_t msg_len)
+{
+	const char * const tag = pending_record.tag;
+	const size_t tag_len = tag ?
+		MIN(strlen(tag), ASYNC_MAX_NAME_LEN) : 0;
+	const size_t file_name_len = MIN(strlen(pending_record.file_name),
+		ASYNC_MAX_NAME_LEN);
+	const size_t func_name_len = MIN(strlen(pending_record.func_name),
+		ASYNC_MAX_NAME_LEN);
+	const size_t size = BT_ALIGN(sizeof(struct async_record) +
+		tag_len + file_name_len + func_name_len + msg_len,
+		(size_t) 8);
+	struct async_ring *ring;
+	struct async_record *rec;
+	size_t pos;
+	char *at;
+
+	/*
+	 * Register as a producer before checking `async.enabled` so
+	 * that the library destructor, which resets `async.enabled`
+	 * before waiting for the producers, doesn't free the ring
+	 * buffers while this function uses them.
+	 */
+	__atomic_add_fetch(&async.producer_count, 1, __ATOMIC_SEQ_CST);
+
+	if (!__atomic_load_n(&async.enabled, __ATOMIC_SEQ_CST)) {
+		/* Library destructor is running or already ran: lost */
+		goto end;
+	}
+
+	ring = async_get_thread_ring();
+	if (!ring) {
+		/* Cannot push anything: lost */
+		goto end;
+	}
+
+	while (!async_ring_reserve(ring, size, &pos)) {
+		if (async.overflow_policy == ASYNC_OVERFLOW_POLICY_DROP ||
+				__atomic_load_n(&async.stop, __ATOMIC_ACQUIRE)) {
+			__atomic_add_fetch(&ring->dropped, 1, __ATOMIC_RELAXED);
+			goto end;
+		}
+
+		/* Wait for the background thread to make room */
+		g_usleep(100);
+	}
+
+	rec = (void *) &ring->data[pos & (ASYNC_RING_SIZE - 1)];
+	rec->size = (uint32_t) size;
+	rec->lvl = (int32_t) pending_record.lvl;
+	rec->line_no = pending_record.line_no;
+	rec->msg_len = (uint32_t) msg_len;
+	rec->tag_len = (uint16_t) tag_len;
+	rec->file_name_len = (uint16_t) file_name_len;
+	rec->func_name_len = (uint16_t) func_name_len;
+	rec->has_tag = tag != NULL;
+	rec->tv = pending_record.tv;
+	at = (char *) (rec + 1);
+	memcpy(at, tag, tag_len);
+	at += tag_len;
+	memcpy(at, pending_record.file_name, file_name_len);
+	at += file_name_len;
+	memcpy(at, pending_record.func_name, func_name_len);
+	at += func_name_len;
+	memcpy(at, msg, msg_len);
+
+	/* Publish */
+	__atomic_store_n(&ring->head, pos + size, __ATOMIC_RELEASE);
+
+	if (pending_record.lvl >= BT_LOG_FATAL) {
+		/* The process is most probably about to abort */
+		bt_log_flush();
+	}
+
+end:
+	__atomic_sub_fetch(&async.producer_count, 1, __ATOMIC_RELEASE);
+}
+
+void bt_log_flush(void)
+{
+	unsigned int i;
+
+	if (!__atomic_load_n(&async.enabled, __ATOMIC_SEQ_CST)) {
+		goto end;
+	}
+
+	/*
+	 * Don't wait forever: this may be called while aborting, maybe
+	 * from the background thread itself.
+	 */
+	for (i = 0; i < 100; i++) {
+		if (g_mutex_trylock(&async.lock)) {
+			/* The library destructor may have freed them */
+			if (async.rings) {
+				(void) async_drain_all();
+			}
+
+			g_mutex_unlock(&async.lock);
+			break;
+		}
+
+		g_usleep(1000);
+	}
+
+end:
+	return;
+}
+
+static
+void __attribute__((constructor)) async_init(void)
+{
+	const char *val = getenv(ASYNC_ENV_VAR);
+
+	if (!val || strcmp(val, "1") != 0) {
+		goto end;
+	}
+
+	val = getenv(ASYNC_OVERFLOW_ENV_VAR);
+	if (val && strcmp(val, "BLOCK") == 0) {
+		async.overflow_policy = ASYNC_OVERFLOW_POLICY_BLOCK;
+	}
+
+	val = getenv(ASYNC_PATH_ENV_VAR);
+	if (val && !bt_common_is_setuid_setgid()) {
+		async.path = g_strdup(val);
+	}
+
+	async.fd = STDERR_FILENO;
+	async.rings = g_ptr_array_new_with_free_func(async_ring_destroy);
+	__atomic_store_n(&async.enabled, true, __ATOMIC_SEQ_CST);
+
+end:
+	return;
+}
+
+static
+void __attribute__((destructor)) async_fini(void)
+{
+	GThread *thread;
+	unsigned int i;
+	bool producers_done;
+
+	if (!__atomic_load_n(&async.enabled, __ATOMIC_SEQ_CST)) {
+		goto end;
+	}
+
+	/*
+	 * Stop accepting records: from now on, new log statements write
+	 * synchronously.
+	 */
+	__atomic_store_n(&async.enabled, false, __ATOMIC_SEQ_CST);
+
+	/*
+	 * Wait for the threads which are still pushing a record. The
+	 * background thread keeps draining meanwhile, so that a thread
+	 * which waits for room (`BLOCK` policy) makes progress.
+	 */
+	for (i = 0; i < ASYNC_FINI_MAX_WAIT_MS; i++) {
+		if (__atomic_load_n(&async.producer_count,
+				__ATOMIC_SEQ_CST) == 0) {
+			break;
+		}
+
+		g_usleep(1000);
+	}
+
+	producers_done = __atomic_load_n(&async.producer_count,
+		__ATOMIC_SEQ_CST) == 0;
+
+	/* The background thread drains everything before exiting */
+	__atomic_store_n(&async.stop, true, __ATOMIC_RELEASE);
+	g_mutex_lock(&async.lock);
+	thread = async.thread;
+	async.thread = NULL;
+	g_mutex_unlock(&async.lock);
+
+	if (thread) {
+		g_thread_join(thread);
+	}
+
+	if (!producers_done) {
+		/*
+		 * A thread may still write to its ring buffer: leak the
+		 * ring buffers and the output file descriptor rather
+		 * than freeing them under its feet. The process is
+		 * exiting anyway.
+		 */
+		goto end;
+	}
+
+	g_mutex_lock(&async.lock);
+	g_ptr_array_free(async.rings, TRUE);
+	async.rings = NULL;
+	g_mutex_unlock(&async.lock);
+
+	if (async.fd != STDERR_FILENO) {
+		(void) close(async.fd);
+	}
+
+	g_free(async.path);
+	async.path = NULL;
+
+end:
+	return;
+}
+
+/*
+ * Writes the initial part of the log message to `msg_buf`, without the
+ * message and without resetting the terminal color).
+ *
+ * With the asynchronous back end, only saves the log statement's
+ * information in `pending_record`: the background thread writes the
+ * header.
+ */
+static
+void common_write_init(char ** const at, const char * const file_name,
+		const char * const func_name, const unsigned int line_no,
+		const enum bt_log_level lvl, const char * const tag)
+{
+	struct timeval tv;
+
+	/* Get time immediately */
+	gettimeofday(&tv, 0);
+
+	if (__atomic_load_n(&async.enabled, __ATOMIC_RELAXED)) {
+		pending_record.is_async = true;
+		pending_record.tv = tv;
+		pending_record.file_name = file_name;
+		pending_record.func_name = func_name;
+		pending_record.line_no = line_no;
+		pending_record.lvl = lvl;
+		pending_record.tag = tag;
+		return;
+	}
+
+	pending_record.is_async = false;
+	write_header(at, tv, get_tid(), file_name, func_name, line_no, lvl,
+		tag);
+}
+
 /*
  * Writes the final part of the log message to `msg_buf` (resets the
  * terminal color and appends a newline), and then writes the whole log
  * message to the standard error.
+ *
+ * With the asynchronous back end, pushes the message of `msg_buf` as a
+ * record instead.
  */
 static
 void common_write_fini(char ** const at)
 {
+	if (pending_record.is_async) {
+		async_push_record(msg_buf, *at - msg_buf);
+		return;
+	}
+
 	append_str_to_msg_buf(at, bt_common_color_reset());
 	append_char_to_msg_buf(at, '\n');
 	(void) write(STDERR_FILENO, msg_buf, *at - msg_buf);
@@ -163,6 +163,15 @@ void bt_log_write_errno_printf(const char *file_name, const char *func_name,
 		const char *init_msg,
 		const char *fmt, ...) _BT_LOG_PRINTFLIKE(7, 8);
 
+/*
+ * Writes all the pending log messages of the asynchronous back end
+ * (see the `BABELTRACE_LOGGING_ASYNC` environment variable), if it's
+ * enabled, before returning.
+ *
+ * Does nothing with the default (synchronous) back end.
+ */
+void bt_log_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -74,6 +74,7 @@ enum bfcr_state
     BFCR_STATE_ALIGN_COMPOUND,
     BFCR_STATE_READ_BASIC_BEGIN,
     BFCR_STATE_READ_BASIC_CONTINUE,
+    BFCR_STATE_READ_TEXT,
     BFCR_STATE_DONE,
 };
 
@@ -109,6 +110,13 @@ struct bt_bfcr
     /* Current byte order (copied to last_bo after a successful read) */
     enum ctf_byte_order cur_bo;
 
+    /*
+     * True if the current text array or sequence field contains a
+     * null byte which was already read: its remaining bytes are
+     * skipped.
+     */
+    bool text_done;
+
     /* Stitch buffer infos */
     struct
     {
@@ -168,6 +176,8 @@ static inline const char *bfcr_state_string(enum bfcr_state state)
         return "READ_BASIC_BEGIN";
     case BFCR_STATE_READ_BASIC_CONTINUE:
         return "READ_BASIC_CONTINUE";
+    case BFCR_STATE_READ_TEXT:
+        return "READ_TEXT";
     case BFCR_STATE_DONE:
         return "DONE";
     }
@@ -855,6 +865,70 @@ end:
     return status;
 }
 
+/*
+ * Reads as many bytes as possible of the current text array or
+ * sequence field at once, calling the "text" user function with the
+ * bytes preceding its first null byte.
+ */
+static inline enum bt_bfcr_status read_text_state(struct bt_bfcr *bfcr)
+{
+    struct stack_entry *top = stack_top(bfcr->stack);
+    size_t available_bytes;
+    const uint8_t *first_chr;
+    enum bt_bfcr_status status = BT_BFCR_STATUS_OK;
+
+    BT_ASSERT_DBG(top->index < top->base_len);
+
+    if (!at_least_one_bit_left(bfcr)) {
+        BT_COMP_LOGT("Reached end of data: bfcr-addr=%p", bfcr);
+        status = BT_BFCR_STATUS_EOF;
+        goto end;
+    }
+
+    BT_ASSERT_DBG(buf_at_from_addr(bfcr) % 8 == 0);
+    available_bytes =
+        MIN(BITS_TO_BYTES_FLOOR(available_bits(bfcr)), (size_t) (top->base_len - top->index));
+    BT_ASSERT_DBG(bfcr->buf.addr);
+    first_chr = &bfcr->buf.addr[BITS_TO_BYTES_FLOOR(buf_at_from_addr(bfcr))];
+
+    if (!bfcr->text_done) {
+        const uint8_t *result = (const uint8_t *) memchr(first_chr, '\0', available_bytes);
+        size_t len = result ? (size_t) (result - first_chr) : available_bytes;
+
+        if (len > 0) {
+            BT_COMP_LOGT("Calling user function (text).");
+            status = bfcr->user.cbs.classes.text((const char *) first_chr, len, top->base_class,
+                                                 bfcr->user.data);
+            BT_COMP_LOGT("User function returned: status=%s", bt_bfcr_status_string(status));
+            if (status != BT_BFCR_STATUS_OK) {
+                BT_COMP_LOGW("User function failed: "
+                             "bfcr-addr=%p, status=%s",
+                             bfcr, bt_bfcr_status_string(status));
+                goto end;
+            }
+        }
+
+        if (result) {
+            /* Found the null character: skip the remaining bytes */
+            bfcr->text_done = true;
+        }
+    }
+
+    consume_bits(bfcr, BYTES_TO_BITS(available_bytes));
+    top->index += available_bytes;
+    bfcr->last_bo = CTF_BYTE_ORDER_UNKNOWN;
+
+    if (top->index < top->base_len) {
+        /* Need more data */
+        status = BT_BFCR_STATUS_EOF;
+    } else {
+        bfcr->state = BFCR_STATE_NEXT_FIELD;
+    }
+
+end:
+    return status;
+}
+
 static inline enum bt_bfcr_status read_basic_begin_state(struct bt_bfcr *bfcr)
 {
     enum bt_bfcr_status status;
@@ -1012,6 +1086,16 @@ static inline enum bt_bfcr_status next_field_state(struct bt_bfcr *bfcr)
     {
         ctf_field_class_array_base *array_fc = ctf_field_class_as_array_base(top->base_class);
 
+        if (array_fc->is_text && bfcr->user.cbs.classes.text) {
+            /* Read the bytes of the text array/sequence at once */
+            if (top->index == 0) {
+                bfcr->text_done = false;
+            }
+
+            bfcr->state = BFCR_STATE_READ_TEXT;
+            goto end;
+        }
+
         next_field_class = array_fc->elem_fc;
         break;
     }
@@ -1092,6 +1176,9 @@ static inline enum bt_bfcr_status handle_state(struct bt_bfcr *bfcr)
     case BFCR_STATE_READ_BASIC_CONTINUE:
         status = read_basic_continue_state(bfcr);
         break;
+    case BFCR_STATE_READ_TEXT:
+        status = read_text_state(bfcr);
+        break;
     case BFCR_STATE_DONE:
         break;
     }
@@ -179,6 +179,27 @@ struct bt_bfcr_cbs
          */
         enum bt_bfcr_status (*string_end)(struct ctf_field_class *cls, void *data);
 
+        /**
+         * Called when bytes of a text array or sequence class
+         * are decoded (between a call to
+         * bt_bfcr_cbs::classes::compound_begin() and a call to
+         * bt_bfcr_cbs::classes::compound_end() for this class),
+         * up to its first null byte, if any.
+         *
+         * If this is set, the class reader doesn't call
+         * bt_bfcr_cbs::classes::unsigned_int() for each element
+         * of a text array or sequence class.
+         *
+         * @param value		Bytes (\em not null-terminated)
+         * @param len		Number of bytes
+         * @param class		Text array or sequence class
+         * @param data		User data
+         * @returns		#BT_BFCR_STATUS_OK or
+         *			#BT_BFCR_STATUS_ERROR
+         */
+        enum bt_bfcr_status (*text)(const char *value, size_t len, struct ctf_field_class *cls,
+                                    void *data);
+
         /**
          * Called when a compound class begins.
          *
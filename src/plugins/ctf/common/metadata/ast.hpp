@@ -117,7 +117,7 @@ enum ctf_typespec
 struct ctf_node
 {
     /*
-     * Parent node is only set on demand by specific visitor.
+     * Parent node is only set on demand by the semantic validator.
      */
     struct ctf_node *parent;
     struct bt_list_head siblings;
@@ -369,8 +369,6 @@ int ctf_visitor_generate_ir_visit_node(struct ctf_visitor_generate_ir *visitor,
 
 int ctf_visitor_semantic_check(int depth, struct ctf_node *node, struct meta_log_config *log_cfg);
 
-int ctf_visitor_parent_links(int depth, struct ctf_node *node, struct meta_log_config *log_cfg);
-
 static inline char *ctf_ast_concatenate_unary_strings(struct bt_list_head *head)
 {
     int i = 0;
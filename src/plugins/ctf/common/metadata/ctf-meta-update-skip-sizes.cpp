@@ -0,0 +1,149 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS, Inc.
+ */
+
+#include <stdint.h>
+
+#include "common/align.h"
+
+#include "ctf-meta-visitors.hpp"
+
+/*
+ * Returns the offset (bits) following a field of class `fc` which
+ * starts at the offset `at` (bits, relative to an offset aligned to the
+ * alignment of the root field class), or -1 if the layout of `fc` isn't
+ * fixed or if the message iterator needs the decoded value of one of
+ * its fields.
+ */
+static int64_t field_class_end_offset(struct ctf_field_class *fc, int64_t at)
+{
+    uint64_t i;
+
+    switch (fc->type) {
+    case CTF_FIELD_CLASS_TYPE_INT:
+    case CTF_FIELD_CLASS_TYPE_ENUM:
+    {
+        struct ctf_field_class_int *int_fc = ctf_field_class_as_int(fc);
+
+        if (int_fc->meaning != CTF_FIELD_CLASS_MEANING_NONE || int_fc->mapped_clock_class ||
+            int_fc->storing_index >= 0) {
+            at = -1;
+            break;
+        }
+
+        at = BT_ALIGN(at, (int64_t) fc->alignment) + int_fc->base.size;
+        break;
+    }
+    case CTF_FIELD_CLASS_TYPE_FLOAT:
+    {
+        struct ctf_field_class_float *float_fc = ctf_field_class_as_float(fc);
+
+        at = BT_ALIGN(at, (int64_t) fc->alignment) + float_fc->base.size;
+        break;
+    }
+    case CTF_FIELD_CLASS_TYPE_STRUCT:
+    {
+        struct ctf_field_class_struct *struct_fc = ctf_field_class_as_struct(fc);
+
+        at = BT_ALIGN(at, (int64_t) fc->alignment);
+
+        for (i = 0; i < struct_fc->members->len; i++) {
+            struct ctf_named_field_class *named_fc =
+                ctf_field_class_struct_borrow_member_by_index(struct_fc, i);
+
+            at = field_class_end_offset(named_fc->fc, at);
+            if (at < 0) {
+                break;
+            }
+        }
+
+        break;
+    }
+    case CTF_FIELD_CLASS_TYPE_ARRAY:
+    {
+        struct ctf_field_class_array *array_fc = ctf_field_class_as_array(fc);
+        struct ctf_field_class *elem_fc = array_fc->base.elem_fc;
+        int64_t elem_size;
+        int64_t elem_stride;
+
+        at = BT_ALIGN(at, (int64_t) fc->alignment);
+
+        if (array_fc->length == 0) {
+            break;
+        }
+
+        /*
+         * All the elements start at an offset aligned to the
+         * alignment of the element field class, so they all have
+         * the same size.
+         */
+        elem_size = field_class_end_offset(elem_fc, 0);
+        if (elem_size < 0) {
+            at = -1;
+            break;
+        }
+
+        elem_stride = BT_ALIGN(elem_size, (int64_t) elem_fc->alignment);
+        if (elem_stride > 0 && array_fc->length - 1 > (uint64_t) (INT64_MAX / 2 / elem_stride)) {
+            at = -1;
+            break;
+        }
+
+        at += (int64_t) (array_fc->length - 1) * elem_stride + elem_size;
+        break;
+    }
+    case CTF_FIELD_CLASS_TYPE_STRING:
+    case CTF_FIELD_CLASS_TYPE_SEQUENCE:
+    case CTF_FIELD_CLASS_TYPE_VARIANT:
+        at = -1;
+        break;
+    default:
+        bt_common_abort();
+    }
+
+    return at;
+}
+
+static void update_skip_size(struct ctf_field_class *fc)
+{
+    struct ctf_field_class_struct *struct_fc;
+
+    if (!fc || fc->type != CTF_FIELD_CLASS_TYPE_STRUCT) {
+        return;
+    }
+
+    struct_fc = ctf_field_class_as_struct(fc);
+    struct_fc->skip_size = field_class_end_offset(fc, 0);
+}
+
+int ctf_trace_class_update_skip_sizes(struct ctf_trace_class *ctf_tc)
+{
+    uint64_t i;
+
+    for (i = 0; i < ctf_tc->stream_classes->len; i++) {
+        ctf_stream_class *sc = (ctf_stream_class *) ctf_tc->stream_classes->pdata[i];
+        uint64_t j;
+
+        /*
+         * Always update the event common context field class: a new
+         * event class may need the value of one of its integer
+         * fields (see ctf_trace_class_update_value_storing_indexes()).
+         */
+        update_skip_size(sc->event_common_context_fc);
+
+        for (j = 0; j < sc->event_classes->len; j++) {
+            struct ctf_event_class *ec = (ctf_event_class *) sc->event_classes->pdata[j];
+
+            if (ec->is_translated) {
+                continue;
+            }
+
+            update_skip_size(ec->spec_context_fc);
+            update_skip_size(ec->payload_fc);
+        }
+    }
+
+    return 0;
+}
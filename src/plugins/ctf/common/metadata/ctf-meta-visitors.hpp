@@ -32,6 +32,8 @@ int ctf_trace_class_update_alignments(struct ctf_trace_class *ctf_tc);
 
 int ctf_trace_class_update_value_storing_indexes(struct ctf_trace_class *ctf_tc);
 
+int ctf_trace_class_update_skip_sizes(struct ctf_trace_class *ctf_tc);
+
 int ctf_trace_class_update_stream_class_config(struct ctf_trace_class *ctf_tc);
 
 int ctf_trace_class_validate(struct ctf_trace_class *ctf_tc, struct meta_log_config *log_cfg);
@@ -177,6 +177,16 @@ struct ctf_field_class_struct
 
     /* Array of `struct ctf_named_field_class` */
     GArray *members;
+
+    /*
+     * Size (bits) of a dynamic scope field of this class, from an
+     * offset aligned to its alignment, when the message iterator may
+     * skip it without decoding it, or -1.
+     *
+     * Only set for the event common context, specific context, and
+     * payload field classes: see ctf_trace_class_update_skip_sizes().
+     */
+    int64_t skip_size;
 };
 
 struct ctf_field_path
@@ -541,6 +551,7 @@ static inline struct ctf_field_class_struct *ctf_field_class_struct_create(void)
     fc->members = g_array_new(FALSE, TRUE, sizeof(struct ctf_named_field_class));
     BT_ASSERT(fc->members);
     fc->base.is_compound = true;
+    fc->skip_size = -1;
     return fc;
 }
 
@@ -4716,6 +4716,13 @@ int ctf_visitor_generate_ir_visit_node(struct ctf_visitor_generate_ir *ctx, stru
         goto end;
     }
 
+    /* Update skip sizes of event dynamic scopes */
+    ret = ctf_trace_class_update_skip_sizes(ctx->ctf_tc);
+    if (ret) {
+        ret = -EINVAL;
+        goto end;
+    }
+
     /* Validate what we have so far */
     ret = ctf_trace_class_validate(ctx->ctf_tc, &ctx->log_cfg);
     if (ret) {
@@ -22,6 +22,21 @@
 static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
                                        struct meta_log_config *log_cfg);
 
+/*
+ * Links `node` to its parent node `parent`, and then checks `node`.
+ *
+ * The semantic check is a top-down walk which only reads the parent
+ * links of the current node and of its ancestors: setting the parent
+ * link of each child right before visiting it makes a separate parent
+ * link pass over the whole AST unnecessary.
+ */
+static inline int check_child_node(int depth, struct ctf_node *parent, struct ctf_node *node,
+                                   struct meta_log_config *log_cfg)
+{
+    node->parent = parent;
+    return _ctf_visitor_semantic_check(depth, node, log_cfg);
+}
+
 static int ctf_visitor_unary_expression(int, struct ctf_node *node, struct meta_log_config *log_cfg)
 {
     struct ctf_node *iter;
@@ -360,7 +375,7 @@ static int ctf_visitor_field_class_declarator(int depth, struct ctf_node *node,
     }
 
     bt_list_for_each_entry (iter, &node->u.field_class_declarator.pointers, siblings) {
-        ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+        ret = check_child_node(depth + 1, node, iter, log_cfg);
         if (ret)
             return ret;
     }
@@ -371,8 +386,9 @@ static int ctf_visitor_field_class_declarator(int depth, struct ctf_node *node,
     case TYPEDEC_NESTED:
     {
         if (node->u.field_class_declarator.u.nested.field_class_declarator) {
-            ret = _ctf_visitor_semantic_check(
-                depth + 1, node->u.field_class_declarator.u.nested.field_class_declarator, log_cfg);
+            ret = check_child_node(
+                depth + 1, node, node->u.field_class_declarator.u.nested.field_class_declarator,
+                log_cfg);
             if (ret)
                 return ret;
         }
@@ -385,7 +401,7 @@ static int ctf_visitor_field_class_declarator(int depth, struct ctf_node *node,
                         node_type(iter));
                     return -EINVAL;
                 }
-                ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+                ret = check_child_node(depth + 1, node, iter, log_cfg);
                 if (ret)
                     return ret;
             }
@@ -398,8 +414,8 @@ static int ctf_visitor_field_class_declarator(int depth, struct ctf_node *node,
             }
         }
         if (node->u.field_class_declarator.bitfield_len) {
-            ret = _ctf_visitor_semantic_check(depth + 1,
-                                              node->u.field_class_declarator.bitfield_len, log_cfg);
+            ret = check_child_node(
+                depth + 1, node, node->u.field_class_declarator.bitfield_len, log_cfg);
             if (ret)
                 return ret;
         }
@@ -439,22 +455,22 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
     switch (node->type) {
     case NODE_ROOT:
         bt_list_for_each_entry (iter, &node->u.root.declaration_list, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
         bt_list_for_each_entry (iter, &node->u.root.trace, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
         bt_list_for_each_entry (iter, &node->u.root.stream, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
         bt_list_for_each_entry (iter, &node->u.root.event, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -469,7 +485,7 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
         }
 
         bt_list_for_each_entry (iter, &node->u.event.declaration_list, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -483,7 +499,7 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
         }
 
         bt_list_for_each_entry (iter, &node->u.stream.declaration_list, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -497,7 +513,7 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
         }
 
         bt_list_for_each_entry (iter, &node->u.env.declaration_list, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -511,7 +527,7 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
         }
 
         bt_list_for_each_entry (iter, &node->u.trace.declaration_list, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -525,7 +541,7 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
         }
 
         bt_list_for_each_entry (iter, &node->u.clock.declaration_list, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -539,7 +555,7 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
         }
 
         bt_list_for_each_entry (iter, &node->u.callsite.declaration_list, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -580,12 +596,12 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
 
         depth++;
         bt_list_for_each_entry (iter, &node->u.ctf_expression.left, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
         bt_list_for_each_entry (iter, &node->u.ctf_expression.right, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -628,12 +644,12 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
         }
 
         depth++;
-        ret = _ctf_visitor_semantic_check(
-            depth + 1, node->u.field_class_def.field_class_specifier_list, log_cfg);
+        ret = check_child_node(
+            depth + 1, node, node->u.field_class_def.field_class_specifier_list, log_cfg);
         if (ret)
             return ret;
         bt_list_for_each_entry (iter, &node->u.field_class_def.field_class_declarators, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -651,14 +667,14 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
         }
 
         depth++;
-        ret = _ctf_visitor_semantic_check(
-            depth + 1, node->u.field_class_alias_target.field_class_specifier_list, log_cfg);
+        ret = check_child_node(
+            depth + 1, node, node->u.field_class_alias_target.field_class_specifier_list, log_cfg);
         if (ret)
             return ret;
         nr_declarators = 0;
         bt_list_for_each_entry (iter, &node->u.field_class_alias_target.field_class_declarators,
                                 siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
             nr_declarators++;
@@ -685,14 +701,14 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
         }
 
         depth++;
-        ret = _ctf_visitor_semantic_check(
-            depth + 1, node->u.field_class_alias_name.field_class_specifier_list, log_cfg);
+        ret = check_child_node(
+            depth + 1, node, node->u.field_class_alias_name.field_class_specifier_list, log_cfg);
         if (ret)
             return ret;
         nr_declarators = 0;
         bt_list_for_each_entry (iter, &node->u.field_class_alias_name.field_class_declarators,
                                 siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
             nr_declarators++;
@@ -740,10 +756,10 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
             goto errinval;
         }
 
-        ret = _ctf_visitor_semantic_check(depth + 1, node->u.field_class_alias.target, log_cfg);
+        ret = check_child_node(depth + 1, node, node->u.field_class_alias.target, log_cfg);
         if (ret)
             return ret;
-        ret = _ctf_visitor_semantic_check(depth + 1, node->u.field_class_alias.alias, log_cfg);
+        ret = check_child_node(depth + 1, node, node->u.field_class_alias.alias, log_cfg);
         if (ret)
             return ret;
         break;
@@ -783,7 +799,7 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
             goto errperm;
         }
         bt_list_for_each_entry (iter, &node->u.floating_point.expressions, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -797,7 +813,7 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
         }
 
         bt_list_for_each_entry (iter, &node->u.integer.expressions, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -814,7 +830,7 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
         }
 
         bt_list_for_each_entry (iter, &node->u.string.expressions, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -863,7 +879,7 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
         }
 
         bt_list_for_each_entry (iter, &node->u.enumerator.values, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -880,12 +896,12 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
         }
 
         depth++;
-        ret = _ctf_visitor_semantic_check(depth + 1, node->u._enum.container_field_class, log_cfg);
+        ret = check_child_node(depth + 1, node, node->u._enum.container_field_class, log_cfg);
         if (ret)
             return ret;
 
         bt_list_for_each_entry (iter, &node->u._enum.enumerator_list, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -899,13 +915,14 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
         default:
             goto errinval;
         }
-        ret = _ctf_visitor_semantic_check(
-            depth + 1, node->u.struct_or_variant_declaration.field_class_specifier_list, log_cfg);
+        ret = check_child_node(
+            depth + 1, node, node->u.struct_or_variant_declaration.field_class_specifier_list,
+            log_cfg);
         if (ret)
             return ret;
         bt_list_for_each_entry (
             iter, &node->u.struct_or_variant_declaration.field_class_declarators, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -921,7 +938,7 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
             goto errperm;
         }
         bt_list_for_each_entry (iter, &node->u.variant.declaration_list, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -938,7 +955,7 @@ static int _ctf_visitor_semantic_check(int depth, struct ctf_node *node,
             goto errperm;
         }
         bt_list_for_each_entry (iter, &node->u._struct.declaration_list, siblings) {
-            ret = _ctf_visitor_semantic_check(depth + 1, iter, log_cfg);
+            ret = check_child_node(depth + 1, node, iter, log_cfg);
             if (ret)
                 return ret;
         }
@@ -969,28 +986,19 @@ int ctf_visitor_semantic_check(int depth, struct ctf_node *node, struct meta_log
     int ret = 0;
 
     /*
-     * First make sure we create the parent links for all children. Let's
-     * take the safe route and recreate them at each validation, just in
-     * case the structure has changed.
+     * The semantic check sets the parent links of the nodes it visits
+     * as it goes (see check_child_node()) and skips the top-level nodes
+     * which the IR generator already visited, so that, on incremental
+     * metadata append, only the new declarations are linked and
+     * checked.
      */
-    ret = ctf_visitor_parent_links(depth, node, log_cfg);
-    if (ret) {
-        _BT_COMP_LOGE_APPEND_CAUSE_LINENO(node->lineno,
-                                          "Cannot create parent links in metadata's AST: "
-                                          "ret=%d",
-                                          ret);
-        goto end;
-    }
-
     ret = _ctf_visitor_semantic_check(depth, node, log_cfg);
     if (ret) {
         _BT_COMP_LOGE_APPEND_CAUSE_LINENO(node->lineno,
                                           "Cannot check metadata's AST semantics: "
                                           "ret=%d",
                                           ret);
-        goto end;
     }
 
-end:
     return ret;
 }
@@ -20,6 +20,7 @@
 #define BT_LOG_TAG            "PLUGIN/CTF/MSG-ITER"
 #include "logging/comp-logging.h"
 
+#include "common/align.h"
 #include "common/assert.h"
 #include "common/common.h"
 
@@ -85,6 +86,7 @@ enum state
     STATE_DSCOPE_EVENT_SPEC_CONTEXT_CONTINUE,
     STATE_DSCOPE_EVENT_PAYLOAD_BEGIN,
     STATE_DSCOPE_EVENT_PAYLOAD_CONTINUE,
+    STATE_SKIP_DSCOPE,
     STATE_EMIT_MSG_EVENT,
     STATE_EMIT_QUEUED_MSG_EVENT,
     STATE_SKIP_PACKET_PADDING,
@@ -128,14 +130,31 @@ struct ctf_msg_iter
     bt_field *cur_dscope_field;
 
     /*
-     * True if we're done filling a string field from a text
-     * array/sequence payload.
+     * True to set IR fields: false when the current dynamic scope has
+     * no IR field (`cur_dscope_field` is `NULL`).
      */
-    bool done_filling_string;
+    bool set_ir_fields;
+
+    /*
+     * Bitwise OR of `bt_self_component_port_input_needed_event_fields`
+     * enumerators: the event dynamic scopes to decode into IR fields.
+     *
+     * The other ones are skipped without decoding them when their
+     * layout is fixed (see skip_dscope_state()).
+     */
+    uint64_t needed_event_fields;
+
+    /* Current dynamic scope skipping, for `STATE_SKIP_DSCOPE` */
+    struct
+    {
+        /* Bits left to skip */
+        size_t bits_left;
+
+        /* State once the dynamic scope field is skipped */
+        enum state done_state;
+    } skip_dscope;
 
     /* Trace and classes */
-    /* True to set IR fields */
-    bool set_ir_fields;
 
     struct
     {
@@ -307,6 +326,8 @@ static inline const char *state_string(enum state state)
         return "DSCOPE_EVENT_PAYLOAD_BEGIN";
     case STATE_DSCOPE_EVENT_PAYLOAD_CONTINUE:
         return "DSCOPE_EVENT_PAYLOAD_CONTINUE";
+    case STATE_SKIP_DSCOPE:
+        return "SKIP_DSCOPE";
     case STATE_EMIT_MSG_EVENT:
         return "EMIT_MSG_EVENT";
     case STATE_EMIT_QUEUED_MSG_EVENT:
@@ -562,6 +583,7 @@ read_dscope_begin_state(struct ctf_msg_iter *msg_it, struct ctf_field_class *dsc
     size_t consumed_bits;
 
     msg_it->cur_dscope_field = dscope_field;
+    msg_it->set_ir_fields = dscope_field != NULL;
     BT_COMP_LOGT("Starting BFCR: msg-it-addr=%p, bfcr-addr=%p, fc-addr=%p", msg_it, msg_it->bfcr,
                  dscope_fc);
     consumed_bits = bt_bfcr_start(msg_it->bfcr, dscope_fc, msg_it->buf.addr, msg_it->buf.at,
@@ -1285,6 +1307,40 @@ end:
     return status;
 }
 
+/*
+ * If the layout of the event dynamic scope field class `dscope_fc` is
+ * fixed, makes `msg_it` skip its field without decoding it, then go to
+ * the state `done_state`, and returns true.
+ *
+ * Only call this when `msg_it` doesn't need to set the IR fields of
+ * this dynamic scope.
+ */
+static bool begin_skip_dscope(struct ctf_msg_iter *msg_it, struct ctf_field_class *dscope_fc,
+                              enum state done_state)
+{
+    struct ctf_field_class_struct *struct_fc;
+    size_t at;
+
+    if (dscope_fc->type != CTF_FIELD_CLASS_TYPE_STRUCT) {
+        return false;
+    }
+
+    struct_fc = ctf_field_class_as_struct(dscope_fc);
+    if (struct_fc->skip_size < 0) {
+        return false;
+    }
+
+    /* Like BFCR, align from the beginning of the packet */
+    at = packet_at(msg_it);
+    msg_it->skip_dscope.bits_left =
+        BT_ALIGN(at, (size_t) dscope_fc->alignment) - at + (size_t) struct_fc->skip_size;
+    msg_it->skip_dscope.done_state = done_state;
+    msg_it->state = STATE_SKIP_DSCOPE;
+    BT_COMP_LOGT("Skipping dynamic scope field: msg-it-addr=%p, fc-addr=%p, size=%zu", msg_it,
+                 dscope_fc, msg_it->skip_dscope.bits_left);
+    return true;
+}
+
 static enum ctf_msg_iter_status read_event_common_context_begin_state(struct ctf_msg_iter *msg_it)
 {
     enum ctf_msg_iter_status status = CTF_MSG_ITER_STATUS_OK;
@@ -1297,10 +1353,13 @@ static enum ctf_msg_iter_status read_event_common_context_begin_state(struct ctf
         goto end;
     }
 
-    if (event_common_context_fc->in_ir && !msg_it->dry_run) {
+    if (event_common_context_fc->in_ir && !msg_it->dry_run &&
+        (msg_it->needed_event_fields & BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_COMMON_CONTEXT)) {
         BT_ASSERT_DBG(!msg_it->dscopes.event_common_context);
         msg_it->dscopes.event_common_context = bt_event_borrow_common_context_field(msg_it->event);
         BT_ASSERT_DBG(msg_it->dscopes.event_common_context);
+    } else if (begin_skip_dscope(msg_it, event_common_context_fc, STATE_DSCOPE_EVENT_SPEC_CONTEXT_BEGIN)) {
+        goto end;
     }
 
     BT_COMP_LOGT("Decoding event common context field: "
@@ -1342,10 +1401,13 @@ static enum ctf_msg_iter_status read_event_spec_context_begin_state(struct ctf_m
         goto end;
     }
 
-    if (event_spec_context_fc->in_ir && !msg_it->dry_run) {
+    if (event_spec_context_fc->in_ir && !msg_it->dry_run &&
+        (msg_it->needed_event_fields & BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_SPECIFIC_CONTEXT)) {
         BT_ASSERT_DBG(!msg_it->dscopes.event_spec_context);
         msg_it->dscopes.event_spec_context = bt_event_borrow_specific_context_field(msg_it->event);
         BT_ASSERT_DBG(msg_it->dscopes.event_spec_context);
+    } else if (begin_skip_dscope(msg_it, event_spec_context_fc, STATE_DSCOPE_EVENT_PAYLOAD_BEGIN)) {
+        goto end;
     }
 
     BT_COMP_LOGT("Decoding event specific context field: "
@@ -1388,10 +1450,13 @@ static enum ctf_msg_iter_status read_event_payload_begin_state(struct ctf_msg_it
         goto end;
     }
 
-    if (event_payload_fc->in_ir && !msg_it->dry_run) {
+    if (event_payload_fc->in_ir && !msg_it->dry_run &&
+        (msg_it->needed_event_fields & BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_PAYLOAD)) {
         BT_ASSERT_DBG(!msg_it->dscopes.event_payload);
         msg_it->dscopes.event_payload = bt_event_borrow_payload_field(msg_it->event);
         BT_ASSERT_DBG(msg_it->dscopes.event_payload);
+    } else if (begin_skip_dscope(msg_it, event_payload_fc, STATE_EMIT_MSG_EVENT)) {
+        goto end;
     }
 
     BT_COMP_LOGT("Decoding event payload field: "
@@ -1422,6 +1487,29 @@ static enum ctf_msg_iter_status read_event_payload_continue_state(struct ctf_msg
     return read_dscope_continue_state(msg_it, STATE_EMIT_MSG_EVENT);
 }
 
+static enum ctf_msg_iter_status skip_dscope_state(struct ctf_msg_iter *msg_it)
+{
+    enum ctf_msg_iter_status status = CTF_MSG_ITER_STATUS_OK;
+
+    while (msg_it->skip_dscope.bits_left > 0) {
+        size_t bits_to_consume;
+
+        status = buf_ensure_available_bits(msg_it);
+        if (status != CTF_MSG_ITER_STATUS_OK) {
+            goto end;
+        }
+
+        bits_to_consume = MIN(buf_available_bits(msg_it), msg_it->skip_dscope.bits_left);
+        buf_consume_bits(msg_it, bits_to_consume);
+        msg_it->skip_dscope.bits_left -= bits_to_consume;
+    }
+
+    msg_it->state = msg_it->skip_dscope.done_state;
+
+end:
+    return status;
+}
+
 static enum ctf_msg_iter_status skip_packet_padding_state(struct ctf_msg_iter *msg_it)
 {
     enum ctf_msg_iter_status status = CTF_MSG_ITER_STATUS_OK;
@@ -1628,6 +1716,9 @@ static inline enum ctf_msg_iter_status handle_state(struct ctf_msg_iter *msg_it)
     case STATE_DSCOPE_EVENT_PAYLOAD_CONTINUE:
         status = read_event_payload_continue_state(msg_it);
         break;
+    case STATE_SKIP_DSCOPE:
+        status = skip_dscope_state(msg_it);
+        break;
     case STATE_EMIT_MSG_EVENT:
         msg_it->state = STATE_DSCOPE_EVENT_HEADER_BEGIN;
         break;
@@ -1876,7 +1967,7 @@ update_def_clock:
         bt_g_array_index(msg_it->stored_values, uint64_t, (uint64_t) int_fc->storing_index) = value;
     }
 
-    if (G_UNLIKELY(!fc->in_ir || msg_it->dry_run)) {
+    if (G_UNLIKELY(!fc->in_ir || !msg_it->set_ir_fields)) {
         goto end;
     }
 
@@ -1892,58 +1983,6 @@ end:
     return status;
 }
 
-static enum bt_bfcr_status bfcr_unsigned_int_char_cb(uint64_t value, struct ctf_field_class *fc,
-                                                     void *data)
-{
-    int ret;
-    ctf_msg_iter *msg_it = (ctf_msg_iter *) data;
-    bt_self_component *self_comp = msg_it->self_comp;
-    enum bt_bfcr_status status = BT_BFCR_STATUS_OK;
-    bt_field *string_field = NULL;
-    char str[2] = {'\0', '\0'};
-
-    BT_COMP_LOGT("Unsigned integer character function called from BFCR: "
-                 "msg-it-addr=%p, bfcr-addr=%p, fc-addr=%p, "
-                 "fc-type=%d, fc-in-ir=%d, value=%" PRIu64,
-                 msg_it, msg_it->bfcr, fc, fc->type, fc->in_ir, value);
-
-    ctf_field_class_int *int_fc = ctf_field_class_as_int(fc);
-    BT_ASSERT_DBG(int_fc->meaning == CTF_FIELD_CLASS_MEANING_NONE);
-    BT_ASSERT_DBG(!int_fc->mapped_clock_class);
-    BT_ASSERT_DBG(int_fc->storing_index < 0);
-
-    if (G_UNLIKELY(!fc->in_ir || msg_it->dry_run)) {
-        goto end;
-    }
-
-    if (msg_it->done_filling_string) {
-        goto end;
-    }
-
-    if (value == 0) {
-        msg_it->done_filling_string = true;
-        goto end;
-    }
-
-    string_field = stack_top(msg_it->stack)->base;
-    BT_ASSERT_DBG(bt_field_get_class_type(string_field) == BT_FIELD_CLASS_TYPE_STRING);
-
-    /* Append character */
-    str[0] = (char) value;
-    ret = bt_field_string_append_with_length(string_field, str, 1);
-    if (ret) {
-        BT_COMP_LOGE_APPEND_CAUSE(self_comp,
-                                  "Cannot append character to string field's value: "
-                                  "msg-it-addr=%p, field-addr=%p, ret=%d",
-                                  msg_it, string_field, ret);
-        status = BT_BFCR_STATUS_ERROR;
-        goto end;
-    }
-
-end:
-    return status;
-}
-
 static enum bt_bfcr_status bfcr_signed_int_cb(int64_t value, struct ctf_field_class *fc, void *data)
 {
     enum bt_bfcr_status status = BT_BFCR_STATUS_OK;
@@ -1964,7 +2003,7 @@ static enum bt_bfcr_status bfcr_signed_int_cb(int64_t value, struct ctf_field_cl
             (uint64_t) value;
     }
 
-    if (G_UNLIKELY(!fc->in_ir || msg_it->dry_run)) {
+    if (G_UNLIKELY(!fc->in_ir || !msg_it->set_ir_fields)) {
         goto end;
     }
 
@@ -1993,7 +2032,7 @@ static enum bt_bfcr_status bfcr_floating_point_cb(double value, struct ctf_field
                  "fc-type=%d, fc-in-ir=%d, value=%f",
                  msg_it, msg_it->bfcr, fc, fc->type, fc->in_ir, value);
 
-    if (G_UNLIKELY(!fc->in_ir || msg_it->dry_run)) {
+    if (G_UNLIKELY(!fc->in_ir || !msg_it->set_ir_fields)) {
         goto end;
     }
 
@@ -2024,7 +2063,7 @@ static enum bt_bfcr_status bfcr_string_begin_cb(struct ctf_field_class *fc, void
                  "fc-type=%d, fc-in-ir=%d",
                  msg_it, msg_it->bfcr, fc, fc->type, fc->in_ir);
 
-    if (G_UNLIKELY(!fc->in_ir || msg_it->dry_run)) {
+    if (G_UNLIKELY(!fc->in_ir || !msg_it->set_ir_fields)) {
         goto end;
     }
 
@@ -2059,7 +2098,7 @@ static enum bt_bfcr_status bfcr_string_cb(const char *value, size_t len, struct
                  "fc-type=%d, fc-in-ir=%d, string-length=%zu",
                  msg_it, msg_it->bfcr, fc, fc->type, fc->in_ir, len);
 
-    if (G_UNLIKELY(!fc->in_ir || msg_it->dry_run)) {
+    if (G_UNLIKELY(!fc->in_ir || !msg_it->set_ir_fields)) {
         goto end;
     }
 
@@ -2091,7 +2130,7 @@ static enum bt_bfcr_status bfcr_string_end_cb(struct ctf_field_class *fc, void *
                  "fc-type=%d, fc-in-ir=%d",
                  msg_it, msg_it->bfcr, fc, fc->type, fc->in_ir);
 
-    if (G_UNLIKELY(!fc->in_ir || msg_it->dry_run)) {
+    if (G_UNLIKELY(!fc->in_ir || !msg_it->set_ir_fields)) {
         goto end;
     }
 
@@ -2105,6 +2144,42 @@ end:
     return BT_BFCR_STATUS_OK;
 }
 
+static enum bt_bfcr_status bfcr_text_cb(const char *value, size_t len, struct ctf_field_class *fc,
+                                        void *data)
+{
+    enum bt_bfcr_status status = BT_BFCR_STATUS_OK;
+    bt_field *string_field = NULL;
+    ctf_msg_iter *msg_it = (ctf_msg_iter *) data;
+    bt_self_component *self_comp = msg_it->self_comp;
+    int ret;
+
+    BT_COMP_LOGT("Text function called from BFCR: "
+                 "msg-it-addr=%p, bfcr-addr=%p, fc-addr=%p, "
+                 "fc-type=%d, fc-in-ir=%d, length=%zu",
+                 msg_it, msg_it->bfcr, fc, fc->type, fc->in_ir, len);
+
+    if (G_UNLIKELY(!fc->in_ir || !msg_it->set_ir_fields)) {
+        goto end;
+    }
+
+    string_field = stack_top(msg_it->stack)->base;
+    BT_ASSERT_DBG(bt_field_get_class_type(string_field) == BT_FIELD_CLASS_TYPE_STRING);
+
+    /* Append bytes */
+    ret = bt_field_string_append_with_length(string_field, value, len);
+    if (ret) {
+        BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+                                  "Cannot append bytes to string field's value: "
+                                  "msg-it-addr=%p, field-addr=%p, length=%zu, ret=%d",
+                                  msg_it, string_field, len, ret);
+        status = BT_BFCR_STATUS_ERROR;
+        goto end;
+    }
+
+end:
+    return status;
+}
+
 static enum bt_bfcr_status bfcr_compound_begin_cb(struct ctf_field_class *fc, void *data)
 {
     ctf_msg_iter *msg_it = (ctf_msg_iter *) data;
@@ -2115,7 +2190,7 @@ static enum bt_bfcr_status bfcr_compound_begin_cb(struct ctf_field_class *fc, vo
                  "fc-type=%d, fc-in-ir=%d",
                  msg_it, msg_it->bfcr, fc, fc->type, fc->in_ir);
 
-    if (G_UNLIKELY(!fc->in_ir || msg_it->dry_run)) {
+    if (G_UNLIKELY(!fc->in_ir || !msg_it->set_ir_fields)) {
         goto end;
     }
 
@@ -2134,17 +2209,15 @@ static enum bt_bfcr_status bfcr_compound_begin_cb(struct ctf_field_class *fc, vo
     stack_push(msg_it->stack, field);
 
     /*
-     * Change BFCR "unsigned int" callback if it's a text
-     * array/sequence.
+     * Clear the destination string field if it's a text
+     * array/sequence: bfcr_text_cb() appends to it.
      */
     if (fc->type == CTF_FIELD_CLASS_TYPE_ARRAY || fc->type == CTF_FIELD_CLASS_TYPE_SEQUENCE) {
         ctf_field_class_array_base *array_fc = ctf_field_class_as_array_base(fc);
 
         if (array_fc->is_text) {
             BT_ASSERT_DBG(bt_field_get_class_type(field) == BT_FIELD_CLASS_TYPE_STRING);
-            msg_it->done_filling_string = false;
             bt_field_string_clear(field);
-            bt_bfcr_set_unsigned_int_cb(msg_it->bfcr, bfcr_unsigned_int_char_cb);
         }
     }
 
@@ -2161,27 +2234,13 @@ static enum bt_bfcr_status bfcr_compound_end_cb(struct ctf_field_class *fc, void
                  "fc-type=%d, fc-in-ir=%d",
                  msg_it, msg_it->bfcr, fc, fc->type, fc->in_ir);
 
-    if (G_UNLIKELY(!fc->in_ir || msg_it->dry_run)) {
+    if (G_UNLIKELY(!fc->in_ir || !msg_it->set_ir_fields)) {
         goto end;
     }
 
     BT_ASSERT_DBG(!stack_empty(msg_it->stack));
     BT_ASSERT_DBG(bt_field_borrow_class_const(stack_top(msg_it->stack)->base) == fc->ir_fc);
 
-    /*
-     * Reset BFCR "unsigned int" callback if it's a text
-     * array/sequence.
-     */
-    if (fc->type == CTF_FIELD_CLASS_TYPE_ARRAY || fc->type == CTF_FIELD_CLASS_TYPE_SEQUENCE) {
-        ctf_field_class_array_base *array_fc = ctf_field_class_as_array_base(fc);
-
-        if (array_fc->is_text) {
-            BT_ASSERT_DBG(bt_field_get_class_type(stack_top(msg_it->stack)->base) ==
-                          BT_FIELD_CLASS_TYPE_STRING);
-            bt_bfcr_set_unsigned_int_cb(msg_it->bfcr, bfcr_unsigned_int_cb);
-        }
-    }
-
     /* Pop stack */
     stack_pop(msg_it->stack);
 
@@ -2206,7 +2265,7 @@ static int64_t bfcr_get_sequence_length_cb(struct ctf_field_class *fc, void *dat
     length =
         (uint64_t) bt_g_array_index(msg_it->stored_values, uint64_t, seq_fc->stored_length_index);
 
-    if (G_UNLIKELY(msg_it->dry_run)) {
+    if (G_UNLIKELY(!msg_it->set_ir_fields)) {
         goto end;
     }
 
@@ -2295,7 +2354,7 @@ bfcr_borrow_variant_selected_field_class_cb(struct ctf_field_class *fc, void *da
     selected_option =
         ctf_field_class_variant_borrow_option_by_index(var_fc, (uint64_t) option_index);
 
-    if (selected_option->fc->in_ir && !msg_it->dry_run) {
+    if (selected_option->fc->in_ir && msg_it->set_ir_fields) {
         bt_field *var_field = stack_top(msg_it->stack)->base;
 
         ret = bt_field_variant_select_option_by_index(var_field, option_index);
@@ -2605,6 +2664,7 @@ struct ctf_msg_iter *ctf_msg_iter_create(struct ctf_trace_class *tc, size_t max_
                 .string_begin = bfcr_string_begin_cb,
                 .string = bfcr_string_cb,
                 .string_end = bfcr_string_end_cb,
+                .text = bfcr_text_cb,
                 .compound_begin = bfcr_compound_begin_cb,
                 .compound_end = bfcr_compound_end_cb,
             },
@@ -2641,6 +2701,13 @@ struct ctf_msg_iter *ctf_msg_iter_create(struct ctf_trace_class *tc, size_t max_
     msg_it->stack = stack_new(msg_it);
     msg_it->stored_values = g_array_new(FALSE, TRUE, sizeof(uint64_t));
     g_array_set_size(msg_it->stored_values, tc->stored_value_count);
+    msg_it->needed_event_fields = BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_ALL;
+
+    if (self_msg_iter) {
+        /* Hint from the downstream component */
+        msg_it->needed_event_fields =
+            bt_self_message_iterator_get_needed_event_fields(self_msg_iter);
+    }
 
     if (!msg_it->stack) {
         BT_COMP_LOGE_APPEND_CAUSE(self_comp, "Failed to create field stack.");
@@ -2873,6 +2940,7 @@ static enum ctf_msg_iter_status decode_until_state(struct ctf_msg_iter *msg_it,
         case STATE_DSCOPE_EVENT_SPEC_CONTEXT_CONTINUE:
         case STATE_DSCOPE_EVENT_PAYLOAD_BEGIN:
         case STATE_DSCOPE_EVENT_PAYLOAD_CONTINUE:
+        case STATE_SKIP_DSCOPE:
         case STATE_EMIT_MSG_EVENT:
         case STATE_EMIT_QUEUED_MSG_EVENT:
         case STATE_SKIP_PACKET_PADDING:
@@ -2989,6 +3057,17 @@ ctf_msg_iter_get_packet_properties(struct ctf_msg_iter *msg_it,
         goto end;
     }
 
+    ctf_msg_iter_get_cur_packet_properties(msg_it, props);
+
+end:
+    return status;
+}
+
+void ctf_msg_iter_get_cur_packet_properties(struct ctf_msg_iter *msg_it,
+                                            struct ctf_msg_iter_packet_properties *props)
+{
+    BT_ASSERT_DBG(msg_it);
+    BT_ASSERT_DBG(props);
     props->exp_packet_total_size = msg_it->cur_exp_packet_total_size;
     props->exp_packet_content_size = msg_it->cur_exp_packet_content_size;
     props->stream_class_id = (uint64_t) msg_it->cur_stream_class_id;
@@ -2997,9 +3076,6 @@ ctf_msg_iter_get_packet_properties(struct ctf_msg_iter *msg_it,
     props->snapshots.packets = msg_it->snapshots.packets;
     props->snapshots.beginning_clock = msg_it->snapshots.beginning_clock;
     props->snapshots.end_clock = msg_it->snapshots.end_clock;
-
-end:
-    return status;
 }
 
 void ctf_msg_iter_set_dry_run(struct ctf_msg_iter *msg_it, bool val)
@@ -276,6 +276,14 @@ enum ctf_msg_iter_status
 ctf_msg_iter_get_packet_properties(struct ctf_msg_iter *msg_it,
                                    struct ctf_msg_iter_packet_properties *props);
 
+/*
+ * Like ctf_msg_iter_get_packet_properties(), but doesn't decode
+ * anything: only call this once ctf_msg_iter_get_next_message()
+ * returned the packet beginning message of the current packet.
+ */
+void ctf_msg_iter_get_cur_packet_properties(struct ctf_msg_iter *msg_it,
+                                            struct ctf_msg_iter_packet_properties *props);
+
 enum ctf_msg_iter_status
 ctf_msg_iter_curr_packet_first_event_clock_snapshot(struct ctf_msg_iter *msg_it,
                                                     uint64_t *first_event_cs);
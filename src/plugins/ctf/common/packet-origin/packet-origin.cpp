@@ -0,0 +1,129 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS, Inc.
+ */
+
+#include <glib.h>
+
+#include "common/assert.h"
+
+#include "packet-origin.hpp"
+
+/* Protects `origins` and `enable_count` */
+G_LOCK_DEFINE_STATIC(origins);
+
+/* Number of ctf_packet_origin_enable() calls not yet cancelled */
+static unsigned int enable_count;
+
+/*
+ * Hash table of `const bt_packet *` (owned by the hash table) to
+ * `struct ctf_packet_origin *` (owned by the hash table); `NULL` until
+ * the first registration.
+ */
+static GHashTable *origins;
+
+static void put_packet_ref(gpointer packet)
+{
+    bt_packet_put_ref((const bt_packet *) packet);
+}
+
+void ctf_packet_origin_enable(void)
+{
+    G_LOCK(origins);
+    enable_count++;
+    G_UNLOCK(origins);
+}
+
+void ctf_packet_origin_disable(void)
+{
+    G_LOCK(origins);
+    BT_ASSERT(enable_count > 0);
+    enable_count--;
+    G_UNLOCK(origins);
+}
+
+bool ctf_packet_origin_is_enabled(void)
+{
+    bool enabled;
+
+    G_LOCK(origins);
+    enabled = enable_count > 0;
+    G_UNLOCK(origins);
+    return enabled;
+}
+
+void ctf_packet_origin_register(const bt_packet *packet, const struct ctf_packet_origin *origin)
+{
+    struct ctf_packet_origin *origin_copy = g_new(struct ctf_packet_origin, 1);
+
+    BT_ASSERT(packet);
+    BT_ASSERT(origin);
+    BT_ASSERT(origin_copy);
+    *origin_copy = *origin;
+    bt_packet_get_ref(packet);
+
+    G_LOCK(origins);
+
+    if (!origins) {
+        origins = g_hash_table_new_full(g_direct_hash, g_direct_equal, put_packet_ref, g_free);
+        BT_ASSERT(origins);
+    }
+
+    g_hash_table_replace(origins, (gpointer) packet, origin_copy);
+    G_UNLOCK(origins);
+}
+
+void ctf_packet_origin_complete(const bt_packet *packet, uint64_t event_count, uint64_t end_cs)
+{
+    struct ctf_packet_origin *origin;
+
+    G_LOCK(origins);
+
+    if (!origins) {
+        goto end;
+    }
+
+    origin = (struct ctf_packet_origin *) g_hash_table_lookup(origins, packet);
+    if (origin) {
+        origin->event_count = event_count;
+        origin->end_cs = end_cs;
+        origin->is_complete = true;
+    }
+
+end:
+    G_UNLOCK(origins);
+}
+
+void ctf_packet_origin_unregister(const bt_packet *packet)
+{
+    G_LOCK(origins);
+
+    if (origins) {
+        g_hash_table_remove(origins, packet);
+    }
+
+    G_UNLOCK(origins);
+}
+
+bool ctf_packet_origin_lookup(const bt_packet *packet, struct ctf_packet_origin *origin)
+{
+    bool found = false;
+    struct ctf_packet_origin *registered_origin;
+
+    G_LOCK(origins);
+
+    if (!origins) {
+        goto end;
+    }
+
+    registered_origin = (struct ctf_packet_origin *) g_hash_table_lookup(origins, packet);
+    if (registered_origin) {
+        *origin = *registered_origin;
+        found = true;
+    }
+
+end:
+    G_UNLOCK(origins);
+    return found;
+}
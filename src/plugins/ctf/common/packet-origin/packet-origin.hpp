@@ -0,0 +1,133 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS, Inc.
+ */
+
+#ifndef CTF_PACKET_ORIGIN_H
+#define CTF_PACKET_ORIGIN_H
+
+#include <stdint.h>
+
+#include <babeltrace2/babeltrace.h>
+
+/*
+ * Packet origin registry.
+ *
+ * A `src.ctf.fs` message iterator registers the origin of each packet
+ * which it reads from an uncompressed data stream file: where the
+ * packet's data is and what the messages of this packet looked like
+ * when the message iterator emitted them.
+ *
+ * A `sink.ctf.fs` component (same plugin, thus same registry) which
+ * receives the messages of such a packet may copy the packet's data
+ * verbatim instead of encoding its events again, provided that it
+ * received the packet intact (same events and clock snapshots). Its
+ * output trace then has the original metadata, `metadata_text`.
+ *
+ * A message iterator only registers the packets of which the trace IR
+ * classes map 1:1 to `metadata_text`: it doesn't register any packet
+ * when its component alters the clock classes (clock class offset or
+ * forced Unix epoch origin parameters).
+ *
+ * The registry holds a reference on each registered packet so that
+ * the library cannot recycle a registered packet object for another
+ * packet.
+ *
+ * Registering origins has a cost (a global lock, a reference and a hash
+ * table insertion for each packet, and the metadata text), so a
+ * `src.ctf.fs` message iterator only registers them when some
+ * `sink.ctf.fs` component enabled the registry when it was created
+ * (see ctf_packet_origin_enable()).
+ *
+ * All the functions below are thread-safe.
+ */
+struct ctf_packet_origin
+{
+    /*
+     * Data stream file path (weak: belongs to the registering
+     * component, which exists as long as its graph exists).
+     */
+    const char *path;
+
+    /* Offset of the packet within the data stream file (bytes) */
+    uint64_t offset;
+
+    /* Total size of the packet (bytes) */
+    uint64_t size;
+
+    /* Content size of the packet (bits) */
+    uint64_t content_size_bits;
+
+    /*
+     * Values of the discarded events counter and sequence number
+     * fields of the packet context (`UINT64_C(-1)` if not available)
+     */
+    uint64_t discarded_events;
+    uint64_t seq_num;
+
+    /*
+     * Plain text of the metadata of the packet's trace (weak, like
+     * `path` above).
+     */
+    const char *metadata_text;
+
+    /*
+     * Values of the default clock snapshots of the packet beginning
+     * and end messages (`UINT64_C(-1)` if not available).
+     */
+    uint64_t beginning_cs;
+    uint64_t end_cs;
+
+    /* Number of events of the packet, once `is_complete` is true */
+    uint64_t event_count;
+
+    /* True once the source emitted the packet end message */
+    bool is_complete;
+};
+
+/*
+ * Enables the registry until a matching call to
+ * ctf_packet_origin_disable().
+ *
+ * Call this before creating the message iterators which need
+ * registered packet origins.
+ */
+void ctf_packet_origin_enable(void);
+
+/*
+ * Cancels one call to ctf_packet_origin_enable().
+ */
+void ctf_packet_origin_disable(void);
+
+/*
+ * Returns whether or not some component enabled the registry with
+ * ctf_packet_origin_enable().
+ */
+bool ctf_packet_origin_is_enabled(void);
+
+/*
+ * Registers the origin `origin` of the packet `packet`, replacing any
+ * existing registration of this packet.
+ */
+void ctf_packet_origin_register(const bt_packet *packet, const struct ctf_packet_origin *origin);
+
+/*
+ * Marks the registered packet `packet`, if any, as complete, setting
+ * its event count and end clock snapshot value.
+ */
+void ctf_packet_origin_complete(const bt_packet *packet, uint64_t event_count, uint64_t end_cs);
+
+/*
+ * Unregisters the packet `packet`, if registered, releasing the
+ * registry's reference on it.
+ */
+void ctf_packet_origin_unregister(const bt_packet *packet);
+
+/*
+ * Copies the registered origin of the packet `packet` to `*origin` and
+ * returns true, or returns false if `packet` isn't registered.
+ */
+bool ctf_packet_origin_lookup(const bt_packet *packet, struct ctf_packet_origin *origin);
+
+#endif /* CTF_PACKET_ORIGIN_H */
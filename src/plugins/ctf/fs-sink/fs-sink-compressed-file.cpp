@@ -0,0 +1,234 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS, Inc.
+ */
+
+#include <errno.h>
+#include <glib.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef BT_ENABLE_ZSTD
+# include <zstd.h>
+#endif
+
+#include <babeltrace2/babeltrace.h>
+
+#define BT_COMP_LOG_SELF_COMP (cfile->self_comp)
+#define BT_LOG_OUTPUT_LEVEL   (cfile->log_level)
+#define BT_LOG_TAG            "PLUGIN/SINK.CTF.FS/COMPRESSED-FILE"
+#include "logging/comp-logging.h"
+
+#include "common/assert.h"
+#include "common/common.h"
+#include "compat/endian.h" /* IWYU pragma: keep  */
+
+#include "../fs-src/compressed-file.hpp"
+#include "fs-sink-compressed-file.hpp"
+
+bool fs_sink_compressed_file_is_supported(void)
+{
+#ifdef BT_ENABLE_ZSTD
+    return true;
+#else
+    return false;
+#endif
+}
+
+void fs_sink_compressed_file_destroy(struct fs_sink_compressed_file *cfile)
+{
+    if (!cfile) {
+        goto end;
+    }
+
+    if (cfile->fp) {
+        if (fclose(cfile->fp)) {
+            BT_COMP_LOGE_ERRNO("Cannot close compressed file", ": path=\"%s\"", cfile->path->str);
+        }
+    }
+
+    if (cfile->path) {
+        g_string_free(cfile->path, TRUE);
+    }
+
+    if (cfile->seek_table) {
+        g_byte_array_free(cfile->seek_table, TRUE);
+    }
+
+    if (cfile->buf) {
+        g_byte_array_free(cfile->buf, TRUE);
+    }
+
+#ifdef BT_ENABLE_ZSTD
+    ZSTD_freeCCtx((ZSTD_CCtx *) cfile->cctx);
+#endif
+
+    g_free(cfile);
+
+end:
+    return;
+}
+
+struct fs_sink_compressed_file *fs_sink_compressed_file_create(const char *path,
+                                                               bt_logging_level log_level,
+                                                               bt_self_component *self_comp)
+{
+    struct fs_sink_compressed_file *cfile = g_new0(struct fs_sink_compressed_file, 1);
+
+    if (!cfile) {
+        goto end;
+    }
+
+    cfile->log_level = log_level;
+    cfile->self_comp = self_comp;
+    cfile->path = g_string_new(path);
+    BT_ASSERT(cfile->path);
+    cfile->seek_table = g_byte_array_new();
+    BT_ASSERT(cfile->seek_table);
+    cfile->buf = g_byte_array_new();
+    BT_ASSERT(cfile->buf);
+
+#ifdef BT_ENABLE_ZSTD
+    cfile->cctx = ZSTD_createCCtx();
+    if (!cfile->cctx) {
+        BT_COMP_LOGE_STR("Failed to create a zstd compression context.");
+        goto error;
+    }
+#else
+    BT_COMP_LOGE("Cannot write compressed data stream file: "
+                 "Babeltrace was built without zstd support: path=\"%s\"",
+                 path);
+    goto error;
+#endif
+
+    cfile->fp = fopen(path, "wb");
+    if (!cfile->fp) {
+        BT_COMP_LOGE_ERRNO("Cannot open compressed file for writing", ": path=\"%s\"", path);
+        goto error;
+    }
+
+    goto end;
+
+error:
+    fs_sink_compressed_file_destroy(cfile);
+    cfile = NULL;
+
+end:
+    return cfile;
+}
+
+static void append_le32(GByteArray *array, uint32_t val)
+{
+    val = htole32(val);
+    g_byte_array_append(array, (const guint8 *) &val, sizeof(val));
+}
+
+static int write_bytes(struct fs_sink_compressed_file *cfile, const void *data, size_t len)
+{
+    int ret = 0;
+
+    if (fwrite(data, 1, len, cfile->fp) != len) {
+        BT_COMP_LOGE_ERRNO("Cannot write compressed file", ": path=\"%s\", size=%zu",
+                           cfile->path->str, len);
+        ret = -1;
+    }
+
+    return ret;
+}
+
+int fs_sink_compressed_file_write_frame(struct fs_sink_compressed_file *cfile, const uint8_t *data,
+                                        size_t len)
+{
+    int ret = 0;
+
+#ifdef BT_ENABLE_ZSTD
+    size_t zstd_ret;
+
+    BT_ASSERT(cfile->fp);
+
+    /* Seek table entries are 32-bit */
+    if (len > UINT32_MAX || cfile->frame_count == UINT32_MAX) {
+        BT_COMP_LOGE("Cannot compress frame: packet is too large or too many packets: "
+                     "path=\"%s\", size=%zu, frame-count=%" PRIu32,
+                     cfile->path->str, len, cfile->frame_count);
+        ret = -1;
+        goto end;
+    }
+
+    g_byte_array_set_size(cfile->buf, ZSTD_compressBound(len));
+    zstd_ret = ZSTD_compressCCtx((ZSTD_CCtx *) cfile->cctx, cfile->buf->data, cfile->buf->len,
+                                 data, len, ZSTD_CLEVEL_DEFAULT);
+    if (ZSTD_isError(zstd_ret)) {
+        BT_COMP_LOGE("Cannot compress frame: path=\"%s\", size=%zu: %s", cfile->path->str, len,
+                     ZSTD_getErrorName(zstd_ret));
+        ret = -1;
+        goto end;
+    }
+
+    ret = write_bytes(cfile, cfile->buf->data, zstd_ret);
+    if (ret) {
+        goto end;
+    }
+
+    BT_COMP_LOGD("Wrote compressed frame: path=\"%s\", size=%zu, compressed-size=%zu",
+                 cfile->path->str, len, zstd_ret);
+    append_le32(cfile->seek_table, (uint32_t) zstd_ret);
+    append_le32(cfile->seek_table, (uint32_t) len);
+    cfile->frame_count++;
+
+end:
+#else
+    (void) data;
+    (void) len;
+
+    /* fs_sink_compressed_file_create() fails without zstd support */
+    bt_common_abort();
+#endif
+
+    return ret;
+}
+
+int fs_sink_compressed_file_close(struct fs_sink_compressed_file *cfile)
+{
+    int ret = 0;
+    GByteArray *table = NULL;
+
+    BT_ASSERT(cfile->fp);
+
+    if (cfile->frame_count == 0) {
+        /* Keep an empty file, which `src.ctf.fs` ignores */
+        goto end;
+    }
+
+    table = g_byte_array_new();
+    BT_ASSERT(table);
+
+    /* Skippable frame header */
+    append_le32(table, CTF_FS_ZST_SKIPPABLE_MAGIC);
+    append_le32(table, cfile->seek_table->len + CTF_FS_ZST_SEEK_FOOTER_SIZE);
+
+    /* Entries */
+    g_byte_array_append(table, cfile->seek_table->data, cfile->seek_table->len);
+
+    /* Footer (no checksums) */
+    append_le32(table, cfile->frame_count);
+    g_byte_array_append(table, (const guint8 *) "\0", 1);
+    append_le32(table, CTF_FS_ZST_SEEKABLE_MAGIC);
+    ret = write_bytes(cfile, table->data, table->len);
+
+end:
+    if (fclose(cfile->fp)) {
+        BT_COMP_LOGE_ERRNO("Cannot close compressed file", ": path=\"%s\"", cfile->path->str);
+        ret = -1;
+    }
+
+    cfile->fp = NULL;
+
+    if (table) {
+        g_byte_array_free(table, TRUE);
+    }
+
+    return ret;
+}
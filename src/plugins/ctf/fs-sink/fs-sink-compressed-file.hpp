@@ -0,0 +1,74 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGIN_CTF_FS_SINK_FS_SINK_COMPRESSED_FILE_H
+#define BABELTRACE_PLUGIN_CTF_FS_SINK_FS_SINK_COMPRESSED_FILE_H
+
+#include <glib.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <babeltrace2/babeltrace.h>
+
+/*
+ * Writer of a compressed data stream file which `src.ctf.fs` can read
+ * (see `fs-src/compressed-file.hpp`).
+ *
+ * Each packet is an independent zstd frame, and the file ends with the
+ * seek table (the frame index) of the zstd seekable format.
+ */
+struct fs_sink_compressed_file
+{
+    bt_logging_level log_level;
+
+    /* Weak */
+    bt_self_component *self_comp;
+
+    /* Path of the compressed file */
+    GString *path;
+
+    /* Owned by this */
+    FILE *fp;
+
+    /* Seek table entries, serialized */
+    GByteArray *seek_table;
+
+    /* Number of frames written so far */
+    uint32_t frame_count;
+
+    /* Compressed data of the current frame */
+    GByteArray *buf;
+
+    /* Compression context, owned by this */
+    void *cctx;
+};
+
+/*
+ * Returns whether or not this build can write compressed data stream
+ * files.
+ */
+bool fs_sink_compressed_file_is_supported(void);
+
+struct fs_sink_compressed_file *fs_sink_compressed_file_create(const char *path,
+                                                               bt_logging_level log_level,
+                                                               bt_self_component *self_comp);
+
+/*
+ * Compresses the `len` bytes at `data` as a new frame and appends it
+ * to the compressed file.
+ */
+int fs_sink_compressed_file_write_frame(struct fs_sink_compressed_file *cfile, const uint8_t *data,
+                                        size_t len);
+
+/*
+ * Appends the seek table to the compressed file (only if it contains
+ * at least one frame) and closes it.
+ */
+int fs_sink_compressed_file_close(struct fs_sink_compressed_file *cfile);
+
+void fs_sink_compressed_file_destroy(struct fs_sink_compressed_file *cfile);
+
+#endif /* BABELTRACE_PLUGIN_CTF_FS_SINK_FS_SINK_COMPRESSED_FILE_H */
@@ -4,8 +4,11 @@
  * Copyright 2019 Philippe Proulx <pproulx@efficios.com>
  */
 
+#include <fcntl.h>
 #include <glib.h>
+#include <glib/gstdio.h>
 #include <stdio.h>
+#include <unistd.h>
 
 #include <babeltrace2/babeltrace.h>
 
@@ -18,20 +21,78 @@
 #include "compat/endian.h" /* IWYU pragma: keep  */
 #include "ctfser/ctfser.h"
 
+#include "../common/packet-origin/packet-origin.hpp"
+#include "../fs-src/compressed-file.hpp"
+#include "../fs-src/lttng-index.hpp"
+#include "fs-sink-compressed-file.hpp"
 #include "fs-sink-ctf-meta.hpp"
 #include "fs-sink-stream.hpp"
 #include "fs-sink-trace.hpp"
 #include "fs-sink.hpp"
 #include "translate-trace-ir-to-ctf-ir.hpp"
 
+static void put_deferred_events(struct fs_sink_stream *stream)
+{
+    guint i;
+
+    for (i = 0; i < stream->packet_state.deferred_events->len; i++) {
+        bt_message_put_ref(g_array_index(stream->packet_state.deferred_events,
+                                         struct fs_sink_stream_deferred_event, i)
+                               .msg);
+    }
+
+    g_array_set_size(stream->packet_state.deferred_events, 0);
+}
+
 void fs_sink_stream_destroy(struct fs_sink_stream *stream)
 {
     if (!stream) {
         goto end;
     }
 
+    if (stream->packet_state.deferred_events) {
+        put_deferred_events(stream);
+        g_array_free(stream->packet_state.deferred_events, TRUE);
+        stream->packet_state.deferred_events = NULL;
+    }
+
+    if (stream->copy_src.fd >= 0) {
+        if (close(stream->copy_src.fd)) {
+            BT_COMP_LOGW_ERRNO("Cannot close data stream file", ": path=\"%s\"",
+                               stream->copy_src.path);
+        }
+
+        stream->copy_src.fd = -1;
+    }
+
     bt_ctfser_fini(&stream->ctfser);
 
+    if (stream->index_fp) {
+        if (fclose(stream->index_fp)) {
+            BT_COMP_LOGE_ERRNO("Cannot close index file", ": stream-file-name=%s",
+                               stream->file_name->str);
+        }
+
+        stream->index_fp = NULL;
+    }
+
+    if (stream->compressed_file) {
+        GString *path = g_string_new(stream->trace->path->str);
+
+        BT_ASSERT(path);
+        g_string_append_printf(path, "/%s", stream->file_name->str);
+
+        /* The uncompressed stream file isn't needed anymore */
+        if (fs_sink_compressed_file_close(stream->compressed_file) == 0 && g_unlink(path->str)) {
+            BT_COMP_LOGE_ERRNO("Cannot remove uncompressed stream file", ": path=\"%s\"",
+                               path->str);
+        }
+
+        fs_sink_compressed_file_destroy(stream->compressed_file);
+        stream->compressed_file = NULL;
+        g_string_free(path, TRUE);
+    }
+
     if (stream->file_name) {
         g_string_free(stream->file_name, TRUE);
         stream->file_name = NULL;
@@ -121,6 +182,55 @@ static void set_stream_file_name(struct fs_sink_stream *stream)
     stream->file_name = make_unique_stream_file_name(stream->trace, base_name);
 }
 
+static int open_index_file(struct fs_sink_stream *stream)
+{
+    int ret = 0;
+    GString *path = NULL;
+    struct ctf_packet_index_file_hdr hdr;
+
+    if (!stream->sc->packets_have_ts_begin || !stream->sc->packets_have_ts_end) {
+        /* `src.ctf.fs` can't use an index without packet times */
+        BT_COMP_LOGI("Not writing an index file for stream: "
+                     "packets have no beginning or end time: stream-file-name=%s",
+                     stream->file_name->str);
+        goto end;
+    }
+
+    path = g_string_new(stream->trace->path->str);
+    BT_ASSERT(path);
+    g_string_append(path, "/index");
+    ret = g_mkdir_with_parents(path->str, 0755);
+    if (ret) {
+        BT_COMP_LOGE_ERRNO("Cannot create index directory", ": path=\"%s\"", path->str);
+        goto end;
+    }
+
+    g_string_append_printf(path, "/%s.idx", stream->file_name->str);
+    stream->index_fp = fopen(path->str, "wb");
+    if (!stream->index_fp) {
+        BT_COMP_LOGE_ERRNO("Cannot open index file for writing", ": path=\"%s\"", path->str);
+        ret = -1;
+        goto end;
+    }
+
+    hdr.magic = htobe32(CTF_INDEX_MAGIC);
+    hdr.index_major = htobe32(CTF_INDEX_MAJOR);
+    hdr.index_minor = htobe32(CTF_INDEX_MINOR);
+    hdr.packet_index_len = htobe32(sizeof(struct ctf_packet_index));
+    if (fwrite(&hdr, sizeof(hdr), 1, stream->index_fp) != 1) {
+        BT_COMP_LOGE_ERRNO("Cannot write index file header", ": path=\"%s\"", path->str);
+        ret = -1;
+        goto end;
+    }
+
+end:
+    if (path) {
+        g_string_free(path, TRUE);
+    }
+
+    return ret;
+}
+
 struct fs_sink_stream *fs_sink_stream_create(struct fs_sink_trace *trace,
                                              const bt_stream *ir_stream)
 {
@@ -140,6 +250,14 @@ struct fs_sink_stream *fs_sink_stream_create(struct fs_sink_trace *trace,
     stream->prev_packet_state.end_cs = UINT64_C(-1);
     stream->prev_packet_state.discarded_events_counter = UINT64_C(-1);
     stream->prev_packet_state.seq_num = UINT64_C(-1);
+    stream->copy_src.fd = -1;
+
+    if (trace->fs_sink->copy_packets) {
+        stream->packet_state.deferred_events =
+            g_array_new(FALSE, FALSE, sizeof(struct fs_sink_stream_deferred_event));
+        BT_ASSERT(stream->packet_state.deferred_events);
+    }
+
     ret = try_translate_stream_class_trace_ir_to_ctf_ir(
         trace->fs_sink, trace->trace, bt_stream_borrow_class_const(ir_stream), &stream->sc);
     if (ret) {
@@ -153,6 +271,22 @@ struct fs_sink_stream *fs_sink_stream_create(struct fs_sink_trace *trace,
         goto error;
     }
 
+    if (trace->fs_sink->compress) {
+        g_string_append(path, CTF_FS_COMPRESSED_FILE_SUFFIX);
+        stream->compressed_file = fs_sink_compressed_file_create(path->str, stream->log_level,
+                                                                 trace->fs_sink->self_comp);
+        if (!stream->compressed_file) {
+            goto error;
+        }
+    }
+
+    if (trace->fs_sink->write_index) {
+        ret = open_index_file(stream);
+        if (ret) {
+            goto error;
+        }
+    }
+
     g_hash_table_insert(trace->streams, (gpointer) ir_stream, stream);
     goto end;
 
@@ -549,27 +683,11 @@ end:
     return ret;
 }
 
-int fs_sink_stream_open_packet(struct fs_sink_stream *stream, const bt_clock_snapshot *cs,
-                               const bt_packet *packet)
+static int write_packet_header(struct fs_sink_stream *stream)
 {
     int ret;
     uint64_t i;
 
-    BT_ASSERT(!stream->packet_state.is_open);
-    bt_packet_put_ref(stream->packet_state.packet);
-    stream->packet_state.packet = packet;
-    bt_packet_get_ref(stream->packet_state.packet);
-    if (cs) {
-        stream->packet_state.beginning_cs = bt_clock_snapshot_get_value(cs);
-    }
-
-    /* Open packet */
-    ret = bt_ctfser_open_packet(&stream->ctfser);
-    if (ret) {
-        /* bt_ctfser_open_packet() logs errors */
-        goto end;
-    }
-
     /* Packet header: magic */
     ret = bt_ctfser_write_byte_aligned_unsigned_int(&stream->ctfser, UINT64_C(0xc1fc1fc1), 8, 32,
                                                     BYTE_ORDER);
@@ -614,8 +732,112 @@ int fs_sink_stream_open_packet(struct fs_sink_stream *stream, const bt_clock_sna
     stream->packet_state.context_offset_bits =
         bt_ctfser_get_offset_in_current_packet_bits(&stream->ctfser);
 
+end:
+    return ret;
+}
+
+/*
+ * Writes the packet header and context of the current packet, starting
+ * at the current offset of `stream->ctfser` (beginning of the packet).
+ */
+static int write_packet_beginning(struct fs_sink_stream *stream)
+{
+    int ret;
+
+    ret = write_packet_header(stream);
+    if (ret) {
+        goto end;
+    }
+
     /* Write packet context just to advance to content (first event) */
     ret = write_packet_context(stream);
+
+end:
+    return ret;
+}
+
+/*
+ * Makes the component defer the writing of the current packet, of which
+ * the trace IR packet is `packet` (may be `NULL`), until its end if it
+ * may copy its original data.
+ *
+ * A packet which a `src.ctf.fs` message iterator didn't read, or of
+ * which the beginning time isn't the original one (for example,
+ * because a trimmer filter component cut it), cannot be copied:
+ * if it's the first packet of its trace, then the trace contains
+ * encoded packets.
+ */
+static int try_defer_packet(struct fs_sink_stream *stream, const bt_packet *packet)
+{
+    int ret = 0;
+    struct ctf_packet_origin origin;
+    const bool may_copy = packet && ctf_packet_origin_lookup(packet, &origin) &&
+                          origin.beginning_cs == stream->packet_state.beginning_cs;
+
+    switch (stream->trace->copy_packets) {
+    case FS_SINK_TRACE_COPY_PACKETS_NO:
+        goto end;
+    case FS_SINK_TRACE_COPY_PACKETS_UNKNOWN:
+        if (!may_copy) {
+            fs_sink_trace_set_copy_packets(stream->trace, NULL);
+            goto end;
+        }
+
+        break;
+    case FS_SINK_TRACE_COPY_PACKETS_YES:
+        if (!may_copy) {
+            BT_COMP_LOGE("Cannot copy packet which a `src.ctf.fs` message iterator didn't read, "
+                         "or which was altered, to a trace with copied packets: "
+                         "stream-file-name=%s",
+                         stream->file_name->str);
+            ret = -1;
+            goto end;
+        }
+
+        break;
+    }
+
+    stream->packet_state.is_deferred = true;
+    stream->packet_state.deferred_event_count = 0;
+
+end:
+    return ret;
+}
+
+int fs_sink_stream_open_packet(struct fs_sink_stream *stream, const bt_clock_snapshot *cs,
+                               const bt_packet *packet)
+{
+    int ret = 0;
+
+    BT_ASSERT(!stream->packet_state.is_open);
+    bt_packet_put_ref(stream->packet_state.packet);
+    stream->packet_state.packet = packet;
+    bt_packet_get_ref(stream->packet_state.packet);
+    if (cs) {
+        stream->packet_state.beginning_cs = bt_clock_snapshot_get_value(cs);
+    }
+
+    if (stream->trace->fs_sink->copy_packets) {
+        ret = try_defer_packet(stream, packet);
+        if (ret) {
+            goto end;
+        }
+
+        if (stream->packet_state.is_deferred) {
+            /* Wait for the end of the packet to know if it's intact */
+            stream->packet_state.is_open = true;
+            goto end;
+        }
+    }
+
+    /* Open packet */
+    ret = bt_ctfser_open_packet(&stream->ctfser);
+    if (ret) {
+        /* bt_ctfser_open_packet() logs errors */
+        goto end;
+    }
+
+    ret = write_packet_beginning(stream);
     if (ret) {
         goto end;
     }
@@ -626,9 +848,250 @@ end:
     return ret;
 }
 
+
+/*
+ * Returns whether or not the current (deferred) packet is the packet
+ * which a `src.ctf.fs` message iterator read, with all its events and
+ * its original beginning and end times, setting `*origin` to its
+ * origin if so.
+ */
+static bool deferred_packet_is_intact(struct fs_sink_stream *stream,
+                                      struct ctf_packet_origin *origin)
+{
+    if (!ctf_packet_origin_lookup(stream->packet_state.packet, origin)) {
+        /* The source doesn't keep the origin of this packet anymore */
+        return false;
+    }
+
+    return origin->is_complete &&
+           origin->event_count == stream->packet_state.deferred_event_count &&
+           origin->beginning_cs == stream->packet_state.beginning_cs &&
+           origin->end_cs == stream->packet_state.end_cs;
+}
+
+/*
+ * Opens a packet, copying the original data of the current packet from
+ * `origin` as is, and sets the content and total sizes of the current
+ * packet to the original ones.
+ */
+static int copy_packet(struct fs_sink_stream *stream, const struct ctf_packet_origin *origin)
+{
+    int ret = 0;
+
+    if (stream->copy_src.fd < 0 || strcmp(stream->copy_src.path, origin->path) != 0) {
+        if (stream->copy_src.fd >= 0) {
+            (void) close(stream->copy_src.fd);
+        }
+
+        stream->copy_src.path = origin->path;
+        stream->copy_src.fd = open(origin->path, O_RDONLY);
+        if (stream->copy_src.fd < 0) {
+            BT_COMP_LOGE_ERRNO("Cannot open data stream file to copy packet", ": path=\"%s\"",
+                               origin->path);
+            ret = -1;
+            goto end;
+        }
+    }
+
+    ret = bt_ctfser_open_packet_copy(&stream->ctfser, stream->copy_src.fd, origin->offset,
+                                     origin->size);
+    if (ret) {
+        BT_COMP_LOGE("Cannot copy packet: stream-file-name=%s, src-path=\"%s\", "
+                     "src-offset=%" PRIu64 ", size=%" PRIu64,
+                     stream->file_name->str, origin->path, origin->offset, origin->size);
+        goto end;
+    }
+
+    /* Original packet header and context: nothing to rewrite */
+    stream->packet_state.content_size = origin->content_size_bits;
+    stream->packet_state.total_size = origin->size * 8;
+
+    /* For the index entry */
+    if (origin->discarded_events != UINT64_C(-1)) {
+        stream->packet_state.discarded_events_counter = origin->discarded_events;
+    }
+
+    if (origin->seq_num != UINT64_C(-1)) {
+        stream->packet_state.seq_num = origin->seq_num;
+    }
+
+    BT_COMP_LOGI("Copied packet verbatim: stream-file-name=%s, src-path=\"%s\", "
+                 "src-offset=%" PRIu64 ", size=%" PRIu64,
+                 stream->file_name->str, origin->path, origin->offset, origin->size);
+
+end:
+    return ret;
+}
+
+/*
+ * Writes the packet header and context of the current packet, which
+ * `stream->ctfser` just opened, and then encodes its deferred events.
+ */
+static int encode_deferred_events(struct fs_sink_stream *stream)
+{
+    int ret;
+    guint i;
+
+    ret = write_packet_beginning(stream);
+    if (ret) {
+        goto end;
+    }
+
+    for (i = 0; i < stream->packet_state.deferred_events->len; i++) {
+        const struct fs_sink_stream_deferred_event *deferred_event =
+            &g_array_index(stream->packet_state.deferred_events,
+                           struct fs_sink_stream_deferred_event, i);
+        const bt_clock_snapshot *cs = NULL;
+
+        if (stream->sc->default_clock_class) {
+            cs = bt_message_event_borrow_default_clock_snapshot_const(deferred_event->msg);
+        }
+
+        ret = fs_sink_stream_write_event(
+            stream, cs, bt_message_event_borrow_event_const(deferred_event->msg),
+            deferred_event->ec);
+        if (ret) {
+            goto end;
+        }
+    }
+
+end:
+    return ret;
+}
+
+int fs_sink_stream_defer_event(struct fs_sink_stream *stream, const bt_message *msg,
+                               struct fs_sink_ctf_event_class *ec)
+{
+    int ret = 0;
+    struct fs_sink_stream_deferred_event deferred_event;
+
+    BT_ASSERT_DBG(stream->packet_state.is_deferred);
+    stream->packet_state.deferred_event_count++;
+
+    if (stream->trace->copy_packets == FS_SINK_TRACE_COPY_PACKETS_YES) {
+        /* The component copies the packet or fails: nothing to keep */
+        if (G_UNLIKELY(stream->packet_state.deferred_events->len > 0)) {
+            put_deferred_events(stream);
+        }
+
+        goto end;
+    }
+
+    deferred_event.msg = msg;
+    deferred_event.ec = ec;
+    bt_message_get_ref(msg);
+    g_array_append_val(stream->packet_state.deferred_events, deferred_event);
+
+    if (G_LIKELY(stream->packet_state.deferred_events->len < FS_SINK_STREAM_MAX_DEFERRED_EVENTS)) {
+        goto end;
+    }
+
+    /*
+     * Too many events to keep: give up copying packets, encoding the
+     * events of this packet so far and the next ones as usual.
+     */
+    if (stream->trace->copy_packets == FS_SINK_TRACE_COPY_PACKETS_UNKNOWN) {
+        fs_sink_trace_set_copy_packets(stream->trace, NULL);
+    }
+
+    BT_COMP_LOGI("Too many deferred events: encoding the events of the packet instead of "
+                 "copying it: stream-file-name=%s, deferred-event-count=%u",
+                 stream->file_name->str, stream->packet_state.deferred_events->len);
+    ret = bt_ctfser_open_packet(&stream->ctfser);
+
+    /* bt_ctfser_open_packet() logs errors */
+    if (!ret) {
+        ret = encode_deferred_events(stream);
+    }
+
+    put_deferred_events(stream);
+    stream->packet_state.is_deferred = false;
+
+end:
+    return ret;
+}
+
+/*
+ * Opens the current (deferred) packet, either copying its original
+ * data or encoding its deferred events, and releases its deferred
+ * events.
+ *
+ * The first packet of a trace which the component writes decides
+ * whether the trace contains copied packets or encoded ones (see
+ * fs_sink_trace_set_copy_packets()). Therefore, once a trace contains
+ * copied packets, an altered packet (missing events or different
+ * times, for example because of a filter upstream) is an error.
+ *
+ * Sets `*copied` to whether or not the component copied the packet.
+ */
+static int write_deferred_packet(struct fs_sink_stream *stream, bool *copied)
+{
+    int ret;
+    struct ctf_packet_origin origin;
+    const bool is_intact = deferred_packet_is_intact(stream, &origin);
+
+    *copied = false;
+
+    if (stream->trace->copy_packets == FS_SINK_TRACE_COPY_PACKETS_UNKNOWN) {
+        fs_sink_trace_set_copy_packets(stream->trace, is_intact ? origin.metadata_text : NULL);
+    }
+
+    if (stream->trace->copy_packets == FS_SINK_TRACE_COPY_PACKETS_YES) {
+        if (!is_intact) {
+            BT_COMP_LOGE("Cannot copy altered packet to a trace with copied packets: "
+                         "stream-file-name=%s, event-count=%" PRIu64,
+                         stream->file_name->str, stream->packet_state.deferred_event_count);
+            ret = -1;
+            goto end;
+        }
+
+        ret = copy_packet(stream, &origin);
+        *copied = ret == 0;
+        goto end;
+    }
+
+    ret = bt_ctfser_open_packet(&stream->ctfser);
+    if (ret) {
+        goto end;
+    }
+
+    ret = encode_deferred_events(stream);
+
+end:
+    put_deferred_events(stream);
+    stream->packet_state.is_deferred = false;
+    return ret;
+}
+
+static int write_index_entry(struct fs_sink_stream *stream)
+{
+    int ret = 0;
+    struct ctf_packet_index entry;
+
+    entry.offset = htobe64(bt_ctfser_get_current_packet_offset_bytes(&stream->ctfser));
+    entry.packet_size = htobe64(stream->packet_state.total_size);
+    entry.content_size = htobe64(stream->packet_state.content_size);
+    entry.timestamp_begin = htobe64(stream->packet_state.beginning_cs);
+    entry.timestamp_end = htobe64(stream->packet_state.end_cs);
+    entry.events_discarded = htobe64(
+        stream->sc->has_discarded_events ? stream->packet_state.discarded_events_counter : 0);
+    entry.stream_id = htobe64(bt_stream_class_get_id(stream->sc->ir_sc));
+    entry.stream_instance_id = htobe64(bt_stream_get_id(stream->ir_stream));
+    entry.packet_seq_num = htobe64(stream->packet_state.seq_num);
+
+    if (fwrite(&entry, sizeof(entry), 1, stream->index_fp) != 1) {
+        BT_COMP_LOGE_ERRNO("Cannot write index entry", ": stream-file-name=%s",
+                           stream->file_name->str);
+        ret = -1;
+    }
+
+    return ret;
+}
+
 int fs_sink_stream_close_packet(struct fs_sink_stream *stream, const bt_clock_snapshot *cs)
 {
     int ret;
+    bool copied = false;
 
     BT_ASSERT(stream->packet_state.is_open);
 
@@ -636,21 +1099,48 @@ int fs_sink_stream_close_packet(struct fs_sink_stream *stream, const bt_clock_sn
         stream->packet_state.end_cs = bt_clock_snapshot_get_value(cs);
     }
 
-    stream->packet_state.content_size =
-        bt_ctfser_get_offset_in_current_packet_bits(&stream->ctfser);
-    stream->packet_state.total_size = (stream->packet_state.content_size + 7) & ~UINT64_C(7);
+    if (stream->packet_state.is_deferred) {
+        ret = write_deferred_packet(stream, &copied);
+        if (ret) {
+            goto end;
+        }
+    }
 
-    /* Rewrite packet context */
-    bt_ctfser_set_offset_in_current_packet_bits(&stream->ctfser,
-                                                stream->packet_state.context_offset_bits);
-    ret = write_packet_context(stream);
-    if (ret) {
-        goto end;
+    if (!copied) {
+        stream->packet_state.content_size =
+            bt_ctfser_get_offset_in_current_packet_bits(&stream->ctfser);
+        stream->packet_state.total_size =
+            (stream->packet_state.content_size + 7) & ~UINT64_C(7);
+
+        /* Rewrite packet context */
+        bt_ctfser_set_offset_in_current_packet_bits(&stream->ctfser,
+                                                    stream->packet_state.context_offset_bits);
+        ret = write_packet_context(stream);
+        if (ret) {
+            goto end;
+        }
     }
 
     /* Close packet */
     bt_ctfser_close_current_packet(&stream->ctfser, stream->packet_state.total_size / 8);
 
+    if (stream->index_fp) {
+        ret = write_index_entry(stream);
+        if (ret) {
+            goto end;
+        }
+    }
+
+    if (stream->compressed_file) {
+        /* Closed packet remains mapped until the next one opens */
+        ret = fs_sink_compressed_file_write_frame(
+            stream->compressed_file, bt_ctfser_get_current_packet_addr(&stream->ctfser),
+            stream->packet_state.total_size / 8);
+        if (ret) {
+            goto end;
+        }
+    }
+
     /* Partially copy current packet state to previous packet state */
     stream->prev_packet_state.end_cs = stream->packet_state.end_cs;
     stream->prev_packet_state.discarded_events_counter =
@@ -9,11 +9,28 @@
 
 #include <glib.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #include <babeltrace2/babeltrace.h>
 
 #include "ctfser/ctfser.h"
 
+/*
+ * Maximum number of event messages of which a stream defers the
+ * encoding (see fs_sink_stream_defer_event()): they hold their events
+ * in memory.
+ */
+#define FS_SINK_STREAM_MAX_DEFERRED_EVENTS 16384
+
+/* Event message of which a stream defers the encoding */
+struct fs_sink_stream_deferred_event
+{
+    /* Owned by this */
+    const bt_message *msg;
+
+    struct fs_sink_ctf_event_class *ec;
+};
+
 struct fs_sink_stream
 {
     bt_logging_level log_level;
@@ -23,6 +40,36 @@ struct fs_sink_stream
     /* Stream's file name */
     GString *file_name;
 
+    /*
+     * LTTng index file (`index/NAME.idx`) of the stream file, owned
+     * by this; `NULL` if the component doesn't write one for this
+     * stream.
+     */
+    FILE *index_fp;
+
+    /*
+     * Compressed stream file (`NAME.zst`), owned by this; `NULL` if
+     * the component doesn't compress stream files.
+     *
+     * In this case, `ctfser` above still writes the uncompressed
+     * stream file, from which this compresses each closed packet,
+     * and which fs_sink_stream_destroy() removes.
+     */
+    struct fs_sink_compressed_file *compressed_file;
+
+    /*
+     * Data stream file from which the component last copied a
+     * packet (see fs_sink_stream_close_packet()): `fd` is -1 and
+     * `path` is `NULL` if none.
+     */
+    struct
+    {
+        int fd;
+
+        /* Weak */
+        const char *path;
+    } copy_src;
+
     /* Weak */
     const bt_stream *ir_stream;
 
@@ -82,6 +129,31 @@ struct fs_sink_stream
          * or if the trace IR stream does not support packets.
          */
         const bt_packet *packet;
+
+        /*
+         * True if the component defers the encoding of the
+         * current packet until its end to possibly copy its
+         * original data instead (see packet-origin.hpp).
+         *
+         * In this case, `ctfser` above doesn't have any opened
+         * packet until fs_sink_stream_close_packet().
+         */
+        bool is_deferred;
+
+        /*
+         * Number of event messages of the current packet when
+         * `is_deferred` is true.
+         */
+        uint64_t deferred_event_count;
+
+        /*
+         * Array of `struct fs_sink_stream_deferred_event`: event
+         * messages of the current packet when `is_deferred` is
+         * true, unless the trace already contains copied packets
+         * (then the component only counts them: it cannot encode
+         * them anyway).
+         */
+        GArray *deferred_events;
     } packet_state;
 
     /* Previous packet's state */
@@ -165,6 +237,20 @@ void fs_sink_stream_destroy(struct fs_sink_stream *stream);
 int fs_sink_stream_write_event(struct fs_sink_stream *stream, const bt_clock_snapshot *cs,
                                const bt_event *event, struct fs_sink_ctf_event_class *ec);
 
+/*
+ * Defers the encoding of the event of the event message `msg` until
+ * the end of the current packet (only valid when
+ * `stream->packet_state.is_deferred` is true).
+ *
+ * Once the current packet has `FS_SINK_STREAM_MAX_DEFERRED_EVENTS`
+ * deferred events, if the trace of `stream` doesn't already contain
+ * copied packets, this function makes it contain encoded packets,
+ * encodes the deferred events, and stops deferring:
+ * `stream->packet_state.is_deferred` becomes false.
+ */
+int fs_sink_stream_defer_event(struct fs_sink_stream *stream, const bt_message *msg,
+                               struct fs_sink_ctf_event_class *ec);
+
 int fs_sink_stream_open_packet(struct fs_sink_stream *stream, const bt_clock_snapshot *cs,
                                const bt_packet *packet);
 
@@ -483,7 +483,15 @@ void fs_sink_trace_destroy(struct fs_sink_trace *trace)
 
     tsdl = g_string_new(NULL);
     BT_ASSERT(tsdl);
-    translate_trace_ctf_ir_to_tsdl(trace->trace, tsdl);
+
+    if (trace->metadata_text) {
+        /* Copied packets: original metadata */
+        g_string_assign(tsdl, trace->metadata_text);
+        g_free(trace->metadata_text);
+        trace->metadata_text = NULL;
+    } else {
+        translate_trace_ctf_ir_to_tsdl(trace->trace, tsdl);
+    }
 
     BT_ASSERT(trace->metadata_path);
     fh = fopen(trace->metadata_path->str, "wb");
@@ -566,6 +574,14 @@ struct fs_sink_trace *fs_sink_trace_create(struct fs_sink_comp *fs_sink, const b
         goto error;
     }
 
+    if (fs_sink->copy_packets && bt_trace_get_uuid(ir_trace)) {
+        /*
+         * Keep the original UUID so that the packet headers of
+         * copied packets remain valid.
+         */
+        bt_uuid_copy(trace->trace->uuid, bt_trace_get_uuid(ir_trace));
+    }
+
     trace->path = make_trace_path(trace, fs_sink->output_dir_path->str);
     BT_ASSERT(trace->path);
     ret = g_mkdir_with_parents(trace->path->str, 0755);
@@ -597,3 +613,28 @@ error:
 end:
     return trace;
 }
+
+void fs_sink_trace_set_copy_packets(struct fs_sink_trace *trace, const char *metadata_text)
+{
+    BT_ASSERT(trace->copy_packets == FS_SINK_TRACE_COPY_PACKETS_UNKNOWN);
+
+    if (!metadata_text) {
+        trace->copy_packets = FS_SINK_TRACE_COPY_PACKETS_NO;
+        BT_COMP_LOGI("Encoding the packets of trace: trace-path=\"%s\"", trace->path->str);
+        return;
+    }
+
+    trace->copy_packets = FS_SINK_TRACE_COPY_PACKETS_YES;
+
+    /* A packetized metadata stream has no plain text signature */
+    if (g_str_has_prefix(metadata_text, "/* CTF ")) {
+        trace->metadata_text = g_strdup(metadata_text);
+    } else {
+        trace->metadata_text = g_strconcat("/* CTF 1.8 */\n\n", metadata_text, NULL);
+    }
+
+    BT_ASSERT(trace->metadata_text);
+    BT_COMP_LOGI("Copying the packets of trace with its original metadata: "
+                 "trace-path=\"%s\"",
+                 trace->path->str);
+}
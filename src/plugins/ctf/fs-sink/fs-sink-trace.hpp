@@ -11,6 +11,13 @@
 
 #include <babeltrace2/babeltrace.h>
 
+enum fs_sink_trace_copy_packets
+{
+    FS_SINK_TRACE_COPY_PACKETS_UNKNOWN,
+    FS_SINK_TRACE_COPY_PACKETS_YES,
+    FS_SINK_TRACE_COPY_PACKETS_NO,
+};
+
 struct fs_sink_trace
 {
     bt_logging_level log_level;
@@ -46,10 +53,38 @@ struct fs_sink_trace
      * `struct fs_sink_stream *` (owned by hash table).
      */
     GHashTable *streams;
+
+    /*
+     * Whether this trace contains copied packets (see
+     * fs_sink_trace_set_copy_packets()) or encoded ones; unknown
+     * until this component writes its first packet.
+     */
+    enum fs_sink_trace_copy_packets copy_packets;
+
+    /*
+     * Original metadata text of the copied packets when
+     * `copy_packets` is `FS_SINK_TRACE_COPY_PACKETS_YES`, written
+     * instead of the translated metadata (owned by this).
+     */
+    gchar *metadata_text;
 };
 
 struct fs_sink_trace *fs_sink_trace_create(struct fs_sink_comp *fs_sink, const bt_trace *ir_trace);
 
 void fs_sink_trace_destroy(struct fs_sink_trace *trace);
 
+/*
+ * Decides, once for `trace`, whether it contains copied packets or
+ * encoded ones.
+ *
+ * If `metadata_text` isn't `NULL`, `trace` only contains packets which
+ * this component copies verbatim from the same `src.ctf.fs` trace, of
+ * which the original metadata text is `metadata_text`: this component
+ * writes it as is, instead of translating the trace IR classes, so
+ * that it describes the original packet headers and contexts.
+ *
+ * Otherwise, `trace` only contains encoded packets.
+ */
+void fs_sink_trace_set_copy_packets(struct fs_sink_trace *trace, const char *metadata_text);
+
 #endif /* BABELTRACE_PLUGIN_CTF_FS_SINK_FS_SINK_TRACE_H */
@@ -19,6 +19,8 @@
 
 #include "plugins/common/param-validation/param-validation.h"
 
+#include "../common/packet-origin/packet-origin.hpp"
+#include "fs-sink-compressed-file.hpp"
 #include "fs-sink-ctf-meta.hpp"
 #include "fs-sink-stream.hpp"
 #include "fs-sink-trace.hpp"
@@ -58,6 +60,12 @@ static bt_param_validation_map_value_entry_descr fs_sink_params_descr[] = {
      bt_param_validation_value_descr::makeBool()},
     {"quiet", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
      bt_param_validation_value_descr::makeBool()},
+    {"write-index", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeBool()},
+    {"compress", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeBool()},
+    {"copy-packets", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeBool()},
     BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END};
 
 static bt_component_class_initialize_method_status configure_component(struct fs_sink_comp *fs_sink,
@@ -102,6 +110,29 @@ static bt_component_class_initialize_method_status configure_component(struct fs
         fs_sink->quiet = (bool) bt_value_bool_get(value);
     }
 
+    value = bt_value_map_borrow_entry_value_const(params, "write-index");
+    if (value) {
+        fs_sink->write_index = (bool) bt_value_bool_get(value);
+    }
+
+    value = bt_value_map_borrow_entry_value_const(params, "compress");
+    if (value) {
+        fs_sink->compress = (bool) bt_value_bool_get(value);
+    }
+
+    value = bt_value_map_borrow_entry_value_const(params, "copy-packets");
+    if (value) {
+        fs_sink->copy_packets = (bool) bt_value_bool_get(value);
+    }
+
+    if (fs_sink->compress && !fs_sink_compressed_file_is_supported()) {
+        BT_COMP_LOGE_APPEND_CAUSE(fs_sink->self_comp,
+                                  "Cannot compress stream files: "
+                                  "Babeltrace was built without zstd support.");
+        status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+        goto end;
+    }
+
     status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
 
 end:
@@ -126,6 +157,11 @@ static void destroy_fs_sink_comp(struct fs_sink_comp *fs_sink)
     }
 
     BT_MESSAGE_ITERATOR_PUT_REF_AND_RESET(fs_sink->upstream_iter);
+
+    if (fs_sink->packet_origin_enabled) {
+        ctf_packet_origin_disable();
+    }
+
     g_free(fs_sink);
 
 end:
@@ -308,6 +344,18 @@ handle_event_msg(struct fs_sink_comp *fs_sink, const bt_message *msg)
     }
 
     BT_ASSERT_DBG(stream->packet_state.is_open);
+
+    if (stream->packet_state.is_deferred) {
+        /* Encoded (or not) when closing the packet */
+        ret = fs_sink_stream_defer_event(stream, msg, ec);
+        if (G_UNLIKELY(ret)) {
+            BT_COMP_LOGE_APPEND_CAUSE(fs_sink->self_comp, "Failed to write deferred events.");
+            status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_ERROR;
+        }
+
+        goto end;
+    }
+
     ret = fs_sink_stream_write_event(stream, cs, ir_event, ec);
     if (G_UNLIKELY(ret)) {
         BT_COMP_LOGE_APPEND_CAUSE(fs_sink->self_comp, "Failed to write event.");
@@ -1018,6 +1066,15 @@ ctf_fs_sink_graph_is_configured(bt_self_component_sink *self_comp)
     fs_sink_comp *fs_sink = (fs_sink_comp *) bt_self_component_get_data(
         bt_self_component_sink_as_self_component(self_comp));
 
+    if (fs_sink->copy_packets) {
+        /*
+         * Make the upstream `src.ctf.fs` message iterators, which
+         * the following call creates, register their packet origins.
+         */
+        ctf_packet_origin_enable();
+        fs_sink->packet_origin_enabled = true;
+    }
+
     msg_iter_status = bt_message_iterator_create_from_sink_component(
         self_comp, bt_self_component_sink_borrow_input_port_by_name(self_comp, in_port_name),
         &fs_sink->upstream_iter);
@@ -36,6 +36,31 @@ struct fs_sink_comp
     /* True to completely ignore discarded packets messages */
     bool ignore_discarded_packets;
 
+    /*
+     * True to write an LTTng index file (`index/NAME.idx`) for each
+     * stream file.
+     */
+    bool write_index;
+
+    /*
+     * True to compress each stream file (`NAME.zst`, one zstd frame
+     * per packet).
+     */
+    bool compress;
+
+    /*
+     * True to copy the data of intact packets coming from a
+     * `src.ctf.fs` component verbatim instead of encoding their
+     * events again, when possible (see packet-origin.hpp).
+     */
+    bool copy_packets;
+
+    /*
+     * True if this component enabled the packet origin registry
+     * (see ctf_packet_origin_enable()).
+     */
+    bool packet_origin_enabled;
+
     /*
      * True to make the component quiet (nothing printed to the
      * standard output).
@@ -0,0 +1,400 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS, Inc.
+ */
+
+#include <errno.h>
+#include <glib.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef BT_ENABLE_ZSTD
+# include <zstd.h>
+#endif
+
+#define BT_COMP_LOG_SELF_COMP (cfile->self_comp)
+#define BT_LOG_OUTPUT_LEVEL   (cfile->log_level)
+#define BT_LOG_TAG            "PLUGIN/SRC.CTF.FS/COMPRESSED-FILE"
+#include "logging/comp-logging.h"
+
+#include "common/assert.h"
+#include "common/common.h"
+#include "compat/endian.h" /* IWYU pragma: keep  */
+
+#include "compressed-file.hpp"
+#include "fs.hpp"
+
+bool ctf_fs_compressed_file_path_is_compressed(const char *path)
+{
+    return g_str_has_suffix(path, CTF_FS_COMPRESSED_FILE_SUFFIX);
+}
+
+static int read_at(struct ctf_fs_compressed_file *cfile, uint64_t offset, void *buf, size_t len)
+{
+    int ret = 0;
+
+    if (fseeko(cfile->file->fp, (off_t) offset, SEEK_SET)) {
+        BT_COMP_LOGE("Cannot seek file \"%s\" (%p) to offset %" PRIu64 ": %s",
+                     cfile->file->path->str, cfile->file->fp, offset, strerror(errno));
+        ret = -1;
+        goto end;
+    }
+
+    if (fread(buf, 1, len, cfile->file->fp) != len) {
+        BT_COMP_LOGE("Cannot read %zu bytes at offset %" PRIu64 " of file \"%s\" (%p)", len,
+                     offset, cfile->file->path->str, cfile->file->fp);
+        ret = -1;
+        goto end;
+    }
+
+end:
+    return ret;
+}
+
+static uint32_t get_le32(const uint8_t *buf)
+{
+    uint32_t val;
+
+    memcpy(&val, buf, sizeof(val));
+    return le32toh(val);
+}
+
+/*
+ * Reads the seek table at the end of the file and fills
+ * `cfile->frames`.
+ */
+static int read_seek_table(struct ctf_fs_compressed_file *cfile)
+{
+    int ret = 0;
+    uint8_t footer[CTF_FS_ZST_SEEK_FOOTER_SIZE];
+    uint8_t *entries = NULL;
+    uint64_t file_size = (uint64_t) cfile->file->size;
+    uint64_t frame_count, entry_size, table_size, entries_size;
+    uint64_t compressed_offset = 0;
+    uint64_t offset = 0;
+    uint8_t descriptor;
+    uint64_t i;
+
+    if (file_size < CTF_FS_ZST_FRAME_HEADER_SIZE + CTF_FS_ZST_SEEK_FOOTER_SIZE) {
+        BT_COMP_LOGE("Compressed file is too small to contain a seek table: "
+                     "path=\"%s\", size=%" PRIu64,
+                     cfile->file->path->str, file_size);
+        goto error;
+    }
+
+    if (read_at(cfile, file_size - CTF_FS_ZST_SEEK_FOOTER_SIZE, footer, sizeof(footer))) {
+        goto error;
+    }
+
+    if (get_le32(&footer[5]) != CTF_FS_ZST_SEEKABLE_MAGIC) {
+        BT_COMP_LOGE("Compressed file is not in the zstd seekable format: "
+                     "path=\"%s\"",
+                     cfile->file->path->str);
+        goto error;
+    }
+
+    frame_count = get_le32(&footer[0]);
+    descriptor = footer[4];
+
+    if (descriptor & CTF_FS_ZST_SEEK_RESERVED_BITS) {
+        BT_COMP_LOGE("Invalid seek table descriptor: path=\"%s\", descriptor=%#x",
+                     cfile->file->path->str, descriptor);
+        goto error;
+    }
+
+    entry_size = CTF_FS_ZST_SEEK_ENTRY_SIZE;
+    if (descriptor & CTF_FS_ZST_SEEK_CHECKSUM_FLAG) {
+        /* Skip each entry's checksum */
+        entry_size += 4;
+    }
+
+    entries_size = frame_count * entry_size;
+    table_size = CTF_FS_ZST_FRAME_HEADER_SIZE + entries_size + CTF_FS_ZST_SEEK_FOOTER_SIZE;
+
+    if (table_size > file_size) {
+        BT_COMP_LOGE("Seek table is larger than the compressed file: "
+                     "path=\"%s\", frame-count=%" PRIu64 ", file-size=%" PRIu64,
+                     cfile->file->path->str, frame_count, file_size);
+        goto error;
+    }
+
+    /* Seek table's skippable frame header followed with its entries */
+    entries = (uint8_t *) g_malloc(CTF_FS_ZST_FRAME_HEADER_SIZE + entries_size);
+    if (!entries) {
+        BT_COMP_LOGE_STR("Failed to allocate seek table buffer.");
+        goto error;
+    }
+
+    if (read_at(cfile, file_size - table_size, entries,
+                CTF_FS_ZST_FRAME_HEADER_SIZE + entries_size)) {
+        goto error;
+    }
+
+    if (get_le32(&entries[0]) != CTF_FS_ZST_SKIPPABLE_MAGIC ||
+        get_le32(&entries[4]) != entries_size + CTF_FS_ZST_SEEK_FOOTER_SIZE) {
+        BT_COMP_LOGE("Invalid seek table frame header: path=\"%s\"", cfile->file->path->str);
+        goto error;
+    }
+
+    for (i = 0; i < frame_count; i++) {
+        const uint8_t *entry = &entries[CTF_FS_ZST_FRAME_HEADER_SIZE + i * entry_size];
+        struct ctf_fs_compressed_frame frame;
+
+        frame.compressed_offset = compressed_offset;
+        frame.compressed_size = get_le32(&entry[0]);
+        frame.offset = offset;
+        frame.size = get_le32(&entry[4]);
+        compressed_offset += frame.compressed_size;
+        offset += frame.size;
+
+        if (frame.size == 0) {
+            /* Nothing to read in an empty frame */
+            continue;
+        }
+
+        g_array_append_val(cfile->frames, frame);
+    }
+
+    if (compressed_offset != file_size - table_size) {
+        BT_COMP_LOGE("Seek table doesn't describe the whole compressed file: "
+                     "path=\"%s\", frames-size=%" PRIu64 ", expected-size=%" PRIu64,
+                     cfile->file->path->str, compressed_offset, file_size - table_size);
+        goto error;
+    }
+
+    cfile->size = offset;
+    BT_COMP_LOGI("Read compressed file's seek table: path=\"%s\", frame-count=%" PRIu64
+                 ", compressed-size=%" PRIu64 ", size=%" PRIu64,
+                 cfile->file->path->str, frame_count, file_size, cfile->size);
+    goto end;
+
+error:
+    ret = -1;
+
+end:
+    g_free(entries);
+    return ret;
+}
+
+void ctf_fs_compressed_file_destroy(struct ctf_fs_compressed_file *cfile)
+{
+    if (!cfile) {
+        return;
+    }
+
+    if (cfile->frames) {
+        g_array_free(cfile->frames, TRUE);
+    }
+
+    if (cfile->compressed_buf) {
+        g_byte_array_free(cfile->compressed_buf, TRUE);
+    }
+
+    if (cfile->buf) {
+        g_byte_array_free(cfile->buf, TRUE);
+    }
+
+#ifdef BT_ENABLE_ZSTD
+    ZSTD_freeDCtx((ZSTD_DCtx *) cfile->dctx);
+#endif
+
+    g_free(cfile);
+}
+
+struct ctf_fs_compressed_file *ctf_fs_compressed_file_create(struct ctf_fs_file *file,
+                                                             bt_logging_level log_level,
+                                                             bt_self_component *self_comp)
+{
+    struct ctf_fs_compressed_file *cfile = g_new0(struct ctf_fs_compressed_file, 1);
+
+    if (!cfile) {
+        goto error;
+    }
+
+    cfile->log_level = log_level;
+    cfile->self_comp = self_comp;
+    cfile->file = file;
+    cfile->cur_frame_index = G_MAXUINT;
+
+#ifdef BT_ENABLE_ZSTD
+    cfile->frames = g_array_new(FALSE, FALSE, sizeof(struct ctf_fs_compressed_frame));
+    if (!cfile->frames) {
+        BT_COMP_LOGE_STR("Failed to allocate a GArray.");
+        goto error;
+    }
+
+    cfile->compressed_buf = g_byte_array_new();
+    if (!cfile->compressed_buf) {
+        BT_COMP_LOGE_STR("Failed to allocate a GByteArray.");
+        goto error;
+    }
+
+    cfile->buf = g_byte_array_new();
+    if (!cfile->buf) {
+        BT_COMP_LOGE_STR("Failed to allocate a GByteArray.");
+        goto error;
+    }
+
+    cfile->dctx = ZSTD_createDCtx();
+    if (!cfile->dctx) {
+        BT_COMP_LOGE_STR("Failed to create a zstd decompression context.");
+        goto error;
+    }
+
+    if (read_seek_table(cfile)) {
+        goto error;
+    }
+
+    goto end;
+#else
+    BT_COMP_LOGE("Cannot read compressed data stream file: "
+                 "Babeltrace was built without zstd support: path=\"%s\"",
+                 file->path->str);
+    goto error;
+#endif
+
+error:
+    ctf_fs_compressed_file_destroy(cfile);
+    cfile = NULL;
+
+end:
+    return cfile;
+}
+
+/*
+ * Returns the index of the frame containing the decompressed data at
+ * `offset`.
+ */
+static guint find_frame(struct ctf_fs_compressed_file *cfile, uint64_t offset)
+{
+    guint low = 0;
+    guint high = cfile->frames->len;
+
+    BT_ASSERT_DBG(offset < cfile->size);
+
+    /* Most reads are sequential: try the current frame and the next one first */
+    if (cfile->cur_frame_index != G_MAXUINT) {
+        guint i;
+
+        for (i = cfile->cur_frame_index; i < MIN(cfile->cur_frame_index + 2, high); i++) {
+            const struct ctf_fs_compressed_frame *frame =
+                &g_array_index(cfile->frames, struct ctf_fs_compressed_frame, i);
+
+            if (offset >= frame->offset && offset < frame->offset + frame->size) {
+                return i;
+            }
+        }
+    }
+
+    /* Find the last frame of which the offset is less than or equal to `offset` */
+    while (high - low > 1) {
+        const guint mid = low + (high - low) / 2;
+
+        if (g_array_index(cfile->frames, struct ctf_fs_compressed_frame, mid).offset <= offset) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+#ifdef BT_ENABLE_ZSTD
+static int decompress_frame(struct ctf_fs_compressed_file *cfile, guint frame_index)
+{
+    int ret = 0;
+    const struct ctf_fs_compressed_frame *frame =
+        &g_array_index(cfile->frames, struct ctf_fs_compressed_frame, frame_index);
+    size_t zstd_ret;
+
+    BT_COMP_LOGD("Decompressing frame: path=\"%s\", index=%u, compressed-offset=%" PRIu64
+                 ", compressed-size=%" PRIu32 ", offset=%" PRIu64 ", size=%" PRIu32,
+                 cfile->file->path->str, frame_index, frame->compressed_offset,
+                 frame->compressed_size, frame->offset, frame->size);
+    g_byte_array_set_size(cfile->compressed_buf, frame->compressed_size);
+
+    if (read_at(cfile, frame->compressed_offset, cfile->compressed_buf->data,
+                frame->compressed_size)) {
+        goto error;
+    }
+
+    g_byte_array_set_size(cfile->buf, frame->size);
+    zstd_ret = ZSTD_decompressDCtx((ZSTD_DCtx *) cfile->dctx, cfile->buf->data, frame->size,
+                                   cfile->compressed_buf->data, frame->compressed_size);
+    if (ZSTD_isError(zstd_ret)) {
+        BT_COMP_LOGE("Cannot decompress frame: path=\"%s\", index=%u: %s",
+                     cfile->file->path->str, frame_index, ZSTD_getErrorName(zstd_ret));
+        goto error;
+    }
+
+    if (zstd_ret != frame->size) {
+        BT_COMP_LOGE("Unexpected decompressed frame size: path=\"%s\", index=%u, "
+                     "expected-size=%" PRIu32 ", size=%zu",
+                     cfile->file->path->str, frame_index, frame->size, zstd_ret);
+        goto error;
+    }
+
+    cfile->cur_frame_index = frame_index;
+    goto end;
+
+error:
+    cfile->cur_frame_index = G_MAXUINT;
+    ret = -1;
+
+end:
+    return ret;
+}
+#endif
+
+int ctf_fs_compressed_file_map(struct ctf_fs_compressed_file *cfile, off_t offset,
+                               const uint8_t **addr, off_t *frame_offset, size_t *len)
+{
+    int ret = 0;
+    const struct ctf_fs_compressed_frame *frame;
+    guint frame_index;
+
+    BT_ASSERT(offset >= 0);
+    frame_index = find_frame(cfile, (uint64_t) offset);
+
+    if (frame_index != cfile->cur_frame_index) {
+#ifdef BT_ENABLE_ZSTD
+        ret = decompress_frame(cfile, frame_index);
+        if (ret) {
+            goto end;
+        }
+#else
+        /* ctf_fs_compressed_file_create() fails without zstd support */
+        bt_common_abort();
+#endif
+    }
+
+    frame = &g_array_index(cfile->frames, struct ctf_fs_compressed_frame, frame_index);
+    *addr = cfile->buf->data;
+    *frame_offset = (off_t) frame->offset;
+    *len = frame->size;
+
+end:
+    return ret;
+}
+
+void ctf_fs_compressed_file_get_compressed_range(struct ctf_fs_compressed_file *cfile,
+                                                 off_t offset, off_t len,
+                                                 off_t *compressed_offset, off_t *compressed_len)
+{
+    const struct ctf_fs_compressed_frame *first_frame;
+    const struct ctf_fs_compressed_frame *last_frame;
+
+    BT_ASSERT(offset >= 0);
+    BT_ASSERT(len > 0);
+    first_frame = &g_array_index(cfile->frames, struct ctf_fs_compressed_frame,
+                                 find_frame(cfile, (uint64_t) offset));
+    last_frame = &g_array_index(cfile->frames, struct ctf_fs_compressed_frame,
+                                find_frame(cfile, (uint64_t) (offset + len - 1)));
+    *compressed_offset = (off_t) first_frame->compressed_offset;
+    *compressed_len =
+        (off_t) (last_frame->compressed_offset + last_frame->compressed_size) - *compressed_offset;
+}
@@ -0,0 +1,127 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS, Inc.
+ */
+
+#ifndef CTF_FS_COMPRESSED_FILE_H
+#define CTF_FS_COMPRESSED_FILE_H
+
+#include <glib.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <babeltrace2/babeltrace.h>
+
+/*
+ * Suffix of a compressed data stream file name.
+ *
+ * A compressed data stream file is a data stream file compressed with
+ * zstd using the seekable format (a sequence of independent zstd
+ * frames followed by a seek table, see
+ * <https://github.com/facebook/zstd/blob/dev/contrib/seekable_format/zstd_seekable_compression_format.md>).
+ *
+ * All the offsets of the data stream (packet index entries, for
+ * example) are offsets within its decompressed data.
+ */
+#define CTF_FS_COMPRESSED_FILE_SUFFIX ".zst"
+
+/* zstd seekable format constants (seek table at the end of the file) */
+#define CTF_FS_ZST_SEEKABLE_MAGIC     0x8F92EAB1
+#define CTF_FS_ZST_SKIPPABLE_MAGIC    0x184D2A5E
+#define CTF_FS_ZST_FRAME_HEADER_SIZE  8
+#define CTF_FS_ZST_SEEK_ENTRY_SIZE    8
+#define CTF_FS_ZST_SEEK_FOOTER_SIZE   9
+#define CTF_FS_ZST_SEEK_CHECKSUM_FLAG 0x80
+#define CTF_FS_ZST_SEEK_RESERVED_BITS 0x7c
+
+struct ctf_fs_compressed_frame
+{
+    /* Offset of the frame within the compressed file, in bytes. */
+    uint64_t compressed_offset;
+
+    /* Size of the frame within the compressed file, in bytes. */
+    uint32_t compressed_size;
+
+    /* Offset of the frame's data within the decompressed data, in bytes. */
+    uint64_t offset;
+
+    /* Size of the frame's decompressed data, in bytes. */
+    uint32_t size;
+};
+
+struct ctf_fs_compressed_file
+{
+    bt_logging_level log_level;
+
+    /* Weak */
+    bt_self_component *self_comp;
+
+    /* Weak */
+    struct ctf_fs_file *file;
+
+    /*
+     * Array of `struct ctf_fs_compressed_frame`, owned by this.
+     *
+     * Frames are sorted by offset and none of them is empty: this is
+     * the seek table of the compressed file.
+     */
+    GArray *frames;
+
+    /* Total size of the decompressed data, in bytes. */
+    uint64_t size;
+
+    /* Decompression context, owned by this. */
+    void *dctx;
+
+    /* Compressed data of the frame to decompress, owned by this. */
+    GByteArray *compressed_buf;
+
+    /* Decompressed data of the current frame, owned by this. */
+    GByteArray *buf;
+
+    /* Index of the frame of which `buf` contains the data, or `G_MAXUINT`. */
+    guint cur_frame_index;
+};
+
+/*
+ * Returns whether or not `path` is the path of a compressed data
+ * stream file.
+ */
+bool ctf_fs_compressed_file_path_is_compressed(const char *path);
+
+/*
+ * Creates a compressed data stream file reader for the opened file
+ * `file`, reading its seek table.
+ */
+struct ctf_fs_compressed_file *ctf_fs_compressed_file_create(struct ctf_fs_file *file,
+                                                             bt_logging_level log_level,
+                                                             bt_self_component *self_comp);
+
+void ctf_fs_compressed_file_destroy(struct ctf_fs_compressed_file *cfile);
+
+/*
+ * Decompresses, if not already done, the frame containing the
+ * decompressed data at `offset` and sets `*addr`, `*frame_offset`, and
+ * `*len` to the address, offset, and size of its decompressed data.
+ *
+ * `*addr` remains valid until the next call to this function or until
+ * `cfile` is destroyed.
+ *
+ * `offset` must be less than `cfile->size`.
+ *
+ * Returns 0 on success.
+ */
+int ctf_fs_compressed_file_map(struct ctf_fs_compressed_file *cfile, off_t offset,
+                               const uint8_t **addr, off_t *frame_offset, size_t *len);
+
+/*
+ * Sets `*compressed_offset` and `*compressed_len` to the range of the
+ * compressed file holding the `len` bytes of decompressed data starting
+ * at `offset`.
+ */
+void ctf_fs_compressed_file_get_compressed_range(struct ctf_fs_compressed_file *cfile,
+                                                 off_t offset, off_t len,
+                                                 off_t *compressed_offset, off_t *compressed_len);
+
+#endif /* CTF_FS_COMPRESSED_FILE_H */
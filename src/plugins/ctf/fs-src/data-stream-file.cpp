@@ -21,9 +21,11 @@
 
 #include "common/assert.h"
 #include "compat/endian.h" /* IWYU pragma: keep  */
-#include "compat/mman.h"   /* IWYU pragma: keep  */
+#include "compat/fcntl.h"
+#include "compat/mman.h" /* IWYU pragma: keep  */
 
 #include "../common/msg-iter/msg-iter.hpp"
+#include "compressed-file.hpp"
 #include "data-stream-file.hpp"
 #include "file.hpp"
 #include "fs.hpp"
@@ -59,6 +61,13 @@ static enum ctf_msg_iter_medium_status ds_file_munmap(struct ctf_fs_ds_file *ds_
         goto end;
     }
 
+    if (ds_file->compressed_file) {
+        /* The compressed file reader owns the decompressed data */
+        ds_file->mmap_addr = NULL;
+        status = CTF_MSG_ITER_MEDIUM_STATUS_OK;
+        goto end;
+    }
+
     if (bt_munmap(ds_file->mmap_addr, ds_file->mmap_len)) {
         BT_COMP_LOGE_ERRNO("Cannot memory-unmap file",
                            ": address=%p, size=%zu, file_path=\"%s\", file=%p", ds_file->mmap_addr,
@@ -114,6 +123,29 @@ static enum ctf_msg_iter_medium_status ds_file_mmap(struct ctf_fs_ds_file *ds_fi
         goto end;
     }
 
+    if (ds_file->compressed_file) {
+        /* The current mapping is the decompressed data of a whole frame */
+        const uint8_t *frame_addr;
+
+        if (ctf_fs_compressed_file_map(ds_file->compressed_file, requested_offset_in_file,
+                                       &frame_addr, &ds_file->mmap_offset_in_file,
+                                       &ds_file->mmap_len)) {
+            BT_COMP_LOGE("Cannot decompress data of file \"%s\" (%p) at offset %jd",
+                         ds_file->file->path->str, ds_file->file->fp,
+                         (intmax_t) requested_offset_in_file);
+            ds_file->mmap_offset_in_file = 0;
+            ds_file->mmap_len = 0;
+            status = CTF_MSG_ITER_MEDIUM_STATUS_ERROR;
+            goto end;
+        }
+
+        ds_file->mmap_addr = (void *) frame_addr;
+        ds_file->request_offset_in_mapping =
+            requested_offset_in_file - ds_file->mmap_offset_in_file;
+        status = CTF_MSG_ITER_MEDIUM_STATUS_OK;
+        goto end;
+    }
+
     /*
      * Compute a mapping that has the required alignment properties and
      * contains `requested_offset_in_file`.
@@ -143,6 +175,46 @@ end:
     return status;
 }
 
+/*
+ * Advise the system to start reading the `len` bytes of `ds_file` starting at
+ * `offset_in_file` in the background.
+ *
+ * Return the number of bytes of the file which this function advised to read.
+ * A prefetching failure is never fatal: this function returns 0 in that case.
+ */
+static off_t ds_file_prefetch(struct ctf_fs_ds_file *ds_file, off_t offset_in_file, off_t len)
+{
+    bt_self_component *self_comp = ds_file->self_comp;
+    bt_logging_level log_level = ds_file->log_level;
+    int ret;
+
+    if (offset_in_file >= ds_file->file->size) {
+        len = 0;
+        goto end;
+    }
+
+    len = MIN(len, ds_file->file->size - offset_in_file);
+
+    if (ds_file->compressed_file) {
+        /* Prefetch the compressed frames holding this region instead */
+        ctf_fs_compressed_file_get_compressed_range(ds_file->compressed_file, offset_in_file, len,
+                                                    &offset_in_file, &len);
+    }
+
+    /* posix_fadvise() returns the error number instead of setting `errno` */
+    ret = bt_posix_fadvise_willneed(fileno(ds_file->file->fp), offset_in_file, len);
+    if (ret) {
+        BT_COMP_LOGD("Cannot advise to prefetch region of file \"%s\" (%p) at offset %jd "
+                     "(size %jd): %s",
+                     ds_file->file->path->str, ds_file->file->fp, (intmax_t) offset_in_file,
+                     (intmax_t) len, strerror(ret));
+        len = 0;
+    }
+
+end:
+    return len;
+}
+
 /*
  * Change the mapping of the file to read the region that follows the current
  * mapping.
@@ -293,6 +365,32 @@ struct ctf_fs_ds_group_medops_data
     /* Weak, for context / logging / appending causes. */
     bt_self_message_iterator *self_msg_iter;
     bt_logging_level log_level;
+
+    /*
+     * Maximum number of packets, including the one we're about to
+     * read, of which to advise the system to read the data in the
+     * background (0 means no prefetching).
+     */
+    uint64_t prefetch_depth;
+
+    /*
+     * Index (as in element rank) of the first index entry of which we
+     * didn't advise the system to read the data yet.
+     */
+    guint next_prefetch_index_entry_index;
+
+    /* Prefetching statistics, logged on destruction. */
+    struct
+    {
+        /* Packets of which we advised to read the data before reading them */
+        uint64_t hits;
+
+        /* Packets of which we didn't advise to read the data before reading them */
+        uint64_t misses;
+
+        /* Number of bytes of which we advised to read the data */
+        uint64_t bytes;
+    } prefetch_stats;
 };
 
 static enum ctf_msg_iter_medium_status medop_group_request_bytes(size_t request_sz,
@@ -359,6 +457,46 @@ end:
     return status;
 }
 
+/*
+ * Advise the system to read the data of the next packets of the
+ * current data stream file in the background, up to
+ * `data->prefetch_depth` packets starting with the one we're about to
+ * read, `data->next_index_entry_index`.
+ */
+static void ds_group_medops_prefetch(struct ctf_fs_ds_group_medops_data *data)
+{
+    GPtrArray *entries = data->ds_file_group->index->entries;
+    const guint cur_index = data->next_index_entry_index;
+    const guint end_index = data->prefetch_depth >= entries->len - cur_index ?
+                                entries->len :
+                                cur_index + (guint) data->prefetch_depth;
+    struct ctf_fs_ds_index_entry *cur_entry =
+        (struct ctf_fs_ds_index_entry *) g_ptr_array_index(entries, cur_index);
+    guint i;
+
+    if (data->next_prefetch_index_entry_index > cur_index) {
+        data->prefetch_stats.hits++;
+    } else {
+        data->prefetch_stats.misses++;
+        data->next_prefetch_index_entry_index = cur_index;
+    }
+
+    for (i = data->next_prefetch_index_entry_index; i < end_index; i++) {
+        struct ctf_fs_ds_index_entry *entry =
+            (struct ctf_fs_ds_index_entry *) g_ptr_array_index(entries, i);
+
+        /* We only have a file descriptor for the current data stream file. */
+        if (entry->path != cur_entry->path && strcmp(entry->path, cur_entry->path) != 0) {
+            break;
+        }
+
+        data->prefetch_stats.bytes +=
+            ds_file_prefetch(data->file, entry->offset, entry->packet_size);
+    }
+
+    data->next_prefetch_index_entry_index = i;
+}
+
 static enum ctf_msg_iter_medium_status medop_group_switch_packet(void *void_data)
 {
     struct ctf_fs_ds_group_medops_data *data = (struct ctf_fs_ds_group_medops_data *) void_data;
@@ -384,6 +522,10 @@ static enum ctf_msg_iter_medium_status medop_group_switch_packet(void *void_data
         goto end;
     }
 
+    if (data->prefetch_depth > 0) {
+        ds_group_medops_prefetch(data);
+    }
+
     data->next_index_entry_index++;
 
     status = CTF_MSG_ITER_MEDIUM_STATUS_OK;
@@ -397,6 +539,18 @@ void ctf_fs_ds_group_medops_data_destroy(struct ctf_fs_ds_group_medops_data *dat
         goto end;
     }
 
+    if (data->prefetch_stats.hits + data->prefetch_stats.misses > 0) {
+        bt_self_component *self_comp = bt_self_message_iterator_borrow_component(data->self_msg_iter);
+        bt_logging_level log_level = data->log_level;
+
+        BT_COMP_LOGI("Data stream file group's prefetching statistics: "
+                     "stream-id=%" PRIu64 ", depth=%" PRIu64 ", hits=%" PRIu64
+                     ", misses=%" PRIu64 ", advised-bytes=%" PRIu64,
+                     data->ds_file_group->stream_id, data->prefetch_depth,
+                     data->prefetch_stats.hits, data->prefetch_stats.misses,
+                     data->prefetch_stats.bytes);
+    }
+
     ctf_fs_ds_file_destroy(data->file);
 
     g_free(data);
@@ -407,7 +561,7 @@ end:
 
 enum ctf_msg_iter_medium_status ctf_fs_ds_group_medops_data_create(
     struct ctf_fs_ds_file_group *ds_file_group, bt_self_message_iterator *self_msg_iter,
-    bt_logging_level log_level, struct ctf_fs_ds_group_medops_data **out)
+    uint64_t prefetch_depth, bt_logging_level log_level, struct ctf_fs_ds_group_medops_data **out)
 {
     struct ctf_fs_ds_group_medops_data *data;
     enum ctf_msg_iter_medium_status status;
@@ -428,6 +582,7 @@ enum ctf_msg_iter_medium_status ctf_fs_ds_group_medops_data_create(
     data->ds_file_group = ds_file_group;
     data->self_msg_iter = self_msg_iter;
     data->log_level = log_level;
+    data->prefetch_depth = prefetch_depth;
 
     /*
      * No need to prepare the first file.  ctf_msg_iter will call
@@ -449,6 +604,24 @@ end:
 void ctf_fs_ds_group_medops_data_reset(struct ctf_fs_ds_group_medops_data *data)
 {
     data->next_index_entry_index = 0;
+    data->next_prefetch_index_entry_index = 0;
+}
+
+struct ctf_fs_ds_index_entry *
+ctf_fs_ds_group_medops_data_borrow_cur_index_entry(struct ctf_fs_ds_group_medops_data *data)
+{
+    if (data->next_index_entry_index == 0) {
+        /* Not reading any packet yet */
+        return NULL;
+    }
+
+    return (struct ctf_fs_ds_index_entry *) g_ptr_array_index(data->ds_file_group->index->entries,
+                                                              data->next_index_entry_index - 1);
+}
+
+bool ctf_fs_ds_group_medops_data_cur_file_is_compressed(struct ctf_fs_ds_group_medops_data *data)
+{
+    return data->file && data->file->compressed_file;
 }
 
 struct ctf_msg_iter_medium_ops ctf_fs_ds_group_medops = {
@@ -534,6 +707,11 @@ static struct ctf_fs_ds_index *build_index_from_idx_file(struct ctf_fs_ds_file *
         goto error;
     }
 
+    if (ds_file->compressed_file) {
+        /* The index of `name.zst` is `index/name.idx` */
+        basename[strlen(basename) - strlen(CTF_FS_COMPRESSED_FILE_SUFFIX)] = '\0';
+    }
+
     directory = g_path_get_dirname(ds_file->file->path->str);
     if (!directory) {
         BT_COMP_LOGE("Cannot get dirname of datastream file %s", ds_file->file->path->str);
@@ -876,6 +1054,17 @@ struct ctf_fs_ds_file *ctf_fs_ds_file_create(struct ctf_fs_trace *ctf_fs_trace,
         goto error;
     }
 
+    if (ctf_fs_compressed_file_path_is_compressed(path)) {
+        ds_file->compressed_file =
+            ctf_fs_compressed_file_create(ds_file->file, log_level, ds_file->self_comp);
+        if (!ds_file->compressed_file) {
+            goto error;
+        }
+
+        /* From now on, the file's size is the size of its decompressed data */
+        ds_file->file->size = (off_t) ds_file->compressed_file->size;
+    }
+
     ds_file->mmap_max_len = offset_align * 2048;
 
     goto end;
@@ -943,6 +1132,7 @@ void ctf_fs_ds_file_destroy(struct ctf_fs_ds_file *ds_file)
 
     bt_stream_put_ref(ds_file->stream);
     (void) ds_file_munmap(ds_file);
+    ctf_fs_compressed_file_destroy(ds_file->compressed_file);
 
     if (ds_file->file) {
         ctf_fs_file_destroy(ds_file->file);
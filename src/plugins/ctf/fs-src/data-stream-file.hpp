@@ -39,6 +39,15 @@ struct ctf_fs_ds_file
     /* Owned by this */
     bt_stream *stream;
 
+    /*
+     * Owned by this, `NULL` if the file isn't compressed.
+     *
+     * When set, the current "mapping" is the decompressed data of a
+     * single compressed frame, and all the offsets below are offsets
+     * within the decompressed data.
+     */
+    struct ctf_fs_compressed_file *compressed_file;
+
     void *mmap_addr;
 
     /*
@@ -91,12 +100,36 @@ extern struct ctf_msg_iter_medium_ops ctf_fs_ds_file_medops;
  */
 extern struct ctf_msg_iter_medium_ops ctf_fs_ds_group_medops;
 
+/*
+ * Prefetching: while reading the packets of a ctf_fs_ds_file_group,
+ * the medops advise the system to read the data of the next
+ * `prefetch_depth` packets (including the current one) in the
+ * background, as long as they're in the current data stream file.
+ *
+ * The medops data logs prefetching statistics (INFO level) when
+ * destroyed.
+ */
+#define CTF_FS_DS_GROUP_DEFAULT_PREFETCH_DEPTH 4
+
 enum ctf_msg_iter_medium_status ctf_fs_ds_group_medops_data_create(
     struct ctf_fs_ds_file_group *ds_file_group, bt_self_message_iterator *self_msg_iter,
-    bt_logging_level log_level, struct ctf_fs_ds_group_medops_data **out);
+    uint64_t prefetch_depth, bt_logging_level log_level, struct ctf_fs_ds_group_medops_data **out);
 
 void ctf_fs_ds_group_medops_data_reset(struct ctf_fs_ds_group_medops_data *data);
 
+/*
+ * Returns the index entry of the packet which the medops currently
+ * read, or `NULL` if they didn't start reading a packet yet.
+ */
+struct ctf_fs_ds_index_entry *
+ctf_fs_ds_group_medops_data_borrow_cur_index_entry(struct ctf_fs_ds_group_medops_data *data);
+
+/*
+ * Returns whether or not the data stream file which the medops
+ * currently read is compressed.
+ */
+bool ctf_fs_ds_group_medops_data_cur_file_is_compressed(struct ctf_fs_ds_group_medops_data *data);
+
 void ctf_fs_ds_group_medops_data_destroy(struct ctf_fs_ds_group_medops_data *data);
 
 #endif /* CTF_FS_DS_FILE_H */
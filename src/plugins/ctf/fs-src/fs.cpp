@@ -25,6 +25,7 @@
 
 #include "../common/metadata/ctf-meta-configure-ir-trace.hpp"
 #include "../common/msg-iter/msg-iter.hpp"
+#include "../common/packet-origin/packet-origin.hpp"
 #include "data-stream-file.hpp"
 #include "file.hpp"
 #include "fs.hpp"
@@ -40,12 +41,124 @@ struct tracer_info
     int64_t patch;
 };
 
+/*
+ * Maximum number of packets of which a message iterator keeps the
+ * origin registered (see packet-origin.hpp).
+ *
+ * A downstream `sink.ctf.fs` component needs the origin of a packet
+ * until it receives its packet end message, that is, at most a few
+ * message batches after this message iterator emitted it.
+ */
+#define CTF_FS_PACKET_ORIGIN_WINDOW 16
+
+static void unregister_packet_origins(struct ctf_fs_msg_iter_data *msg_iter_data)
+{
+    const bt_packet *packet;
+
+    while ((packet = (const bt_packet *) g_queue_pop_head(msg_iter_data->registered_packets))) {
+        ctf_packet_origin_unregister(packet);
+    }
+
+    msg_iter_data->cur_registered_packet = NULL;
+}
+
+static void register_packet_origin(struct ctf_fs_msg_iter_data *msg_iter_data,
+                                   const bt_message *msg)
+{
+    const bt_packet *packet = bt_message_packet_beginning_borrow_packet_const(msg);
+    const bt_stream_class *sc = bt_stream_borrow_class_const(bt_packet_borrow_stream_const(packet));
+    struct ctf_fs_ds_index_entry *index_entry;
+    struct ctf_msg_iter_packet_properties props;
+    struct ctf_packet_origin origin = {};
+
+    msg_iter_data->cur_registered_packet = NULL;
+    msg_iter_data->cur_packet_event_count = 0;
+    index_entry =
+        ctf_fs_ds_group_medops_data_borrow_cur_index_entry(msg_iter_data->msg_iter_medops_data);
+
+    /* Only uncompressed packet data can be copied as is */
+    if (!index_entry ||
+        ctf_fs_ds_group_medops_data_cur_file_is_compressed(msg_iter_data->msg_iter_medops_data)) {
+        return;
+    }
+
+    if (g_queue_get_length(msg_iter_data->registered_packets) == CTF_FS_PACKET_ORIGIN_WINDOW) {
+        ctf_packet_origin_unregister(
+            (const bt_packet *) g_queue_pop_head(msg_iter_data->registered_packets));
+    }
+
+    ctf_msg_iter_get_cur_packet_properties(msg_iter_data->msg_iter, &props);
+    origin.path = index_entry->path;
+    origin.offset = index_entry->offset;
+    origin.size = index_entry->packet_size;
+    origin.content_size_bits = props.exp_packet_content_size >= 0 ?
+                                   (uint64_t) props.exp_packet_content_size :
+                                   index_entry->packet_size * 8;
+    origin.discarded_events = props.snapshots.discarded_events;
+    origin.seq_num = props.snapshots.packets;
+    origin.metadata_text = msg_iter_data->ds_file_group->ctf_fs_trace->metadata->text;
+    origin.beginning_cs = UINT64_C(-1);
+    origin.end_cs = UINT64_C(-1);
+
+    if (bt_stream_class_packets_have_beginning_default_clock_snapshot(sc)) {
+        origin.beginning_cs = bt_clock_snapshot_get_value(
+            bt_message_packet_beginning_borrow_default_clock_snapshot_const(msg));
+    }
+
+    ctf_packet_origin_register(packet, &origin);
+    g_queue_push_tail(msg_iter_data->registered_packets, (gpointer) packet);
+    msg_iter_data->cur_registered_packet = packet;
+}
+
+static void complete_packet_origin(struct ctf_fs_msg_iter_data *msg_iter_data,
+                                   const bt_message *msg)
+{
+    const bt_packet *packet = bt_message_packet_end_borrow_packet_const(msg);
+    const bt_stream_class *sc = bt_stream_borrow_class_const(bt_packet_borrow_stream_const(packet));
+    uint64_t end_cs = UINT64_C(-1);
+
+    if (packet != msg_iter_data->cur_registered_packet) {
+        return;
+    }
+
+    if (bt_stream_class_packets_have_end_default_clock_snapshot(sc)) {
+        end_cs = bt_clock_snapshot_get_value(
+            bt_message_packet_end_borrow_default_clock_snapshot_const(msg));
+    }
+
+    ctf_packet_origin_complete(packet, msg_iter_data->cur_packet_event_count, end_cs);
+    msg_iter_data->cur_registered_packet = NULL;
+}
+
+static inline void track_packet_origin(struct ctf_fs_msg_iter_data *msg_iter_data,
+                                       const bt_message *msg)
+{
+    switch (bt_message_get_type(msg)) {
+    case BT_MESSAGE_TYPE_EVENT:
+        msg_iter_data->cur_packet_event_count++;
+        break;
+    case BT_MESSAGE_TYPE_PACKET_BEGINNING:
+        register_packet_origin(msg_iter_data, msg);
+        break;
+    case BT_MESSAGE_TYPE_PACKET_END:
+        complete_packet_origin(msg_iter_data, msg);
+        break;
+    default:
+        break;
+    }
+}
+
 static void ctf_fs_msg_iter_data_destroy(struct ctf_fs_msg_iter_data *msg_iter_data)
 {
     if (!msg_iter_data) {
         return;
     }
 
+    if (msg_iter_data->registered_packets) {
+        unregister_packet_origins(msg_iter_data);
+        g_queue_free(msg_iter_data->registered_packets);
+    }
+
     if (msg_iter_data->msg_iter) {
         ctf_msg_iter_destroy(msg_iter_data->msg_iter);
     }
@@ -69,6 +182,10 @@ ctf_fs_iterator_next_one(struct ctf_fs_msg_iter_data *msg_iter_data, const bt_me
     switch (msg_iter_status) {
     case CTF_MSG_ITER_STATUS_OK:
         /* Cool, message has been written to *out_msg. */
+        if (msg_iter_data->registered_packets) {
+            track_packet_origin(msg_iter_data, *out_msg);
+        }
+
         status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
         break;
 
@@ -173,6 +290,10 @@ ctf_fs_iterator_seek_beginning(bt_self_message_iterator *it)
     ctf_msg_iter_reset(msg_iter_data->msg_iter);
     ctf_fs_ds_group_medops_data_reset(msg_iter_data->msg_iter_medops_data);
 
+    if (msg_iter_data->registered_packets) {
+        unregister_packet_origins(msg_iter_data);
+    }
+
     return BT_MESSAGE_ITERATOR_CLASS_SEEK_BEGINNING_METHOD_STATUS_OK;
 }
 
@@ -226,9 +347,27 @@ ctf_fs_iterator_init(bt_self_message_iterator *self_msg_iter,
     msg_iter_data->self_msg_iter = self_msg_iter;
     msg_iter_data->ds_file_group = port_data->ds_file_group;
 
-    medium_status =
-        ctf_fs_ds_group_medops_data_create(msg_iter_data->ds_file_group, self_msg_iter, log_level,
-                                           &msg_iter_data->msg_iter_medops_data);
+    if (ctf_packet_origin_is_enabled() &&
+        !port_data->ctf_fs->metadata_config.force_clock_class_origin_unix_epoch &&
+        port_data->ctf_fs->metadata_config.clock_class_offset_s == 0 &&
+        port_data->ctf_fs->metadata_config.clock_class_offset_ns == 0) {
+        /*
+         * A downstream `sink.ctf.fs` component may copy packets,
+         * writing the original metadata: only if the trace IR
+         * clock classes are the original ones.
+         */
+        if (ctf_fs_metadata_load_text(self_comp, msg_iter_data->ds_file_group->ctf_fs_trace)) {
+            BT_COMP_LOGE_APPEND_CAUSE(self_comp, "Cannot load the plain text of the metadata.");
+            status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+            goto error;
+        }
+
+        msg_iter_data->registered_packets = g_queue_new();
+    }
+
+    medium_status = ctf_fs_ds_group_medops_data_create(
+        msg_iter_data->ds_file_group, self_msg_iter, port_data->ctf_fs->prefetch_depth, log_level,
+        &msg_iter_data->msg_iter_medops_data);
     BT_ASSERT(medium_status == CTF_MSG_ITER_MEDIUM_STATUS_OK ||
               medium_status == CTF_MSG_ITER_MEDIUM_STATUS_ERROR ||
               medium_status == CTF_MSG_ITER_MEDIUM_STATUS_MEMORY_ERROR);
@@ -339,6 +478,7 @@ struct ctf_fs_component *ctf_fs_component_create(bt_logging_level log_level)
     }
 
     ctf_fs->log_level = log_level;
+    ctf_fs->prefetch_depth = CTF_FS_DS_GROUP_DEFAULT_PREFETCH_DEPTH;
     ctf_fs->port_data = g_ptr_array_new_with_free_func(port_data_destroy_notifier);
     if (!ctf_fs->port_data) {
         goto error;
@@ -2200,6 +2340,8 @@ static bt_param_validation_map_value_entry_descr fs_params_entries_descr[] = {
      bt_param_validation_value_descr::makeSignedInteger()},
     {"force-clock-class-origin-unix-epoch", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
      bt_param_validation_value_descr::makeBool()},
+    {"prefetch-depth", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeUnsignedInteger()},
     BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END};
 
 bool read_src_fs_parameters(const bt_value *params, const bt_value **inputs,
@@ -2240,6 +2382,12 @@ bool read_src_fs_parameters(const bt_value *params, const bt_value **inputs,
         ctf_fs->metadata_config.force_clock_class_origin_unix_epoch = bt_value_bool_get(value);
     }
 
+    /* prefetch-depth parameter */
+    value = bt_value_map_borrow_entry_value_const(params, "prefetch-depth");
+    if (value) {
+        ctf_fs->prefetch_depth = bt_value_integer_unsigned_get(value);
+    }
+
     /* trace-name parameter */
     *trace_name = bt_value_map_borrow_entry_value_const(params, "trace-name");
 
@@ -31,6 +31,10 @@ struct ctf_fs_file
     /* Owned by this */
     FILE *fp;
 
+    /*
+     * Size of the file, or size of its decompressed data if it's a
+     * compressed data stream file.
+     */
     off_t size;
 };
 
@@ -45,7 +49,10 @@ struct ctf_fs_metadata
     /* Weak (owned by `decoder` above) */
     struct ctf_trace_class *tc;
 
-    /* Owned by this */
+    /*
+     * Plain text of the metadata stream, or `NULL` if not loaded
+     * (see ctf_fs_metadata_load_text()); owned by this
+     */
     char *text;
 
     int bo;
@@ -62,6 +69,13 @@ struct ctf_fs_component
     struct ctf_fs_trace *trace;
 
     struct ctf_fs_metadata_config metadata_config;
+
+    /*
+     * Number of packets, including the current one, of which a
+     * message iterator advises the system to read the data in the
+     * background (`prefetch-depth` parameter; 0 means no prefetching).
+     */
+    uint64_t prefetch_depth;
 };
 
 struct ctf_fs_trace
@@ -192,6 +206,25 @@ struct ctf_fs_msg_iter_data
     const struct bt_error *next_saved_error;
 
     struct ctf_fs_ds_group_medops_data *msg_iter_medops_data;
+
+    /*
+     * Packets (`const bt_packet *`) of which this message iterator
+     * registered the origin (see packet-origin.hpp), oldest first, or
+     * `NULL` if this message iterator doesn't register packet origins
+     * (the packet origin registry wasn't enabled when it was created).
+     *
+     * The packet origin registry owns those packets.
+     */
+    GQueue *registered_packets;
+
+    /*
+     * Current packet if this message iterator registered its origin,
+     * or `NULL` (weak).
+     */
+    const bt_packet *cur_registered_packet;
+
+    /* Number of event messages of the current packet so far */
+    uint64_t cur_packet_event_count;
 };
 
 bt_component_class_initialize_method_status
@@ -251,6 +284,8 @@ void ctf_fs_destroy(struct ctf_fs_component *ctf_fs);
  *  - The mandatory `paths` parameter is returned in `*paths`.
  *  - The optional `clock-class-offset-s` and `clock-class-offset-ns`, if
  *    present, are recorded in the `ctf_fs` structure.
+ *  - The optional `prefetch-depth` parameter, if present, is recorded in
+ *    the `ctf_fs` structure.
  *  - The optional `trace-name` parameter is returned in `*trace_name` if
  *    present, else `*trace_name` is set to NULL.
  *
@@ -8,6 +8,7 @@
 #include <glib.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <babeltrace2/babeltrace.h>
 
@@ -122,6 +123,59 @@ end:
     return ret;
 }
 
+int ctf_fs_metadata_load_text(bt_self_component *self_comp, struct ctf_fs_trace *ctf_fs_trace)
+{
+    int ret = 0;
+    struct ctf_fs_file *file = NULL;
+    struct ctf_metadata_decoder *decoder = NULL;
+    bt_logging_level log_level = ctf_fs_trace->log_level;
+
+    /* Only keep the plain text: the trace class already exists */
+    ctf_metadata_decoder_config decoder_config {};
+    decoder_config.log_level = ctf_fs_trace->log_level;
+    decoder_config.self_comp = self_comp;
+    decoder_config.keep_plain_text = true;
+
+    if (ctf_fs_trace->metadata->text) {
+        goto end;
+    }
+
+    file = get_file(ctf_fs_trace->path->str, log_level, self_comp);
+    if (!file) {
+        BT_COMP_LOGE("Cannot create metadata file object.");
+        ret = -1;
+        goto end;
+    }
+
+    decoder = ctf_metadata_decoder_create(&decoder_config);
+    if (!decoder) {
+        BT_COMP_LOGE("Cannot create metadata decoder object.");
+        ret = -1;
+        goto end;
+    }
+
+    ret = ctf_metadata_decoder_append_content(decoder, file->fp);
+    if (ret) {
+        BT_COMP_LOGE("Cannot update metadata decoder's content.");
+        goto end;
+    }
+
+    ctf_fs_trace->metadata->text = strdup(ctf_metadata_decoder_get_text(decoder));
+    if (!ctf_fs_trace->metadata->text) {
+        BT_COMP_LOGE("Cannot copy metadata text.");
+        ret = -1;
+        goto end;
+    }
+
+end:
+    if (decoder) {
+        ctf_metadata_decoder_destroy(decoder);
+    }
+
+    ctf_fs_file_destroy(file);
+    return ret;
+}
+
 int ctf_fs_metadata_init(struct ctf_fs_metadata *)
 {
     /* Nothing to initialize for the moment. */
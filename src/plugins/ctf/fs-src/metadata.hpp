@@ -27,6 +27,15 @@ void ctf_fs_metadata_fini(struct ctf_fs_metadata *metadata);
 int ctf_fs_metadata_set_trace_class(bt_self_component *self_comp, struct ctf_fs_trace *ctf_fs_trace,
                                     struct ctf_fs_metadata_config *config);
 
+/*
+ * Sets the `text` member of the metadata of `ctf_fs_trace` to the plain
+ * text of its metadata stream, if not already done.
+ *
+ * Decoding the metadata stream of a trace doesn't keep its plain text:
+ * only the packet origin registry (see packet-origin.hpp) needs it.
+ */
+int ctf_fs_metadata_load_text(bt_self_component *self_comp, struct ctf_fs_trace *ctf_fs_trace);
+
 FILE *ctf_fs_metadata_open_file(const char *trace_path, bt_logging_level log_level,
                                 bt_self_component_class *comp_class);
 
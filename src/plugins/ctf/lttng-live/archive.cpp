@@ -0,0 +1,484 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS, Inc.
+ */
+
+#include <errno.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define BT_COMP_LOG_SELF_COMP self_comp
+#define BT_LOG_OUTPUT_LEVEL   log_level
+#define BT_LOG_TAG            "PLUGIN/SRC.CTF.LTTNG-LIVE/ARCHIVE"
+#include "logging/comp-logging.h"
+
+#include "common/assert.h"
+#include "compat/endian.h" /* IWYU pragma: keep  */
+
+#include "../fs-src/lttng-index.hpp"
+#include "archive.hpp"
+
+static const char *borrow_archive_path(struct lttng_live_trace *trace)
+{
+    GString *archive_path =
+        trace->session->lttng_live_msg_iter->lttng_live_comp->params.archive_path;
+
+    return archive_path ? archive_path->str : NULL;
+}
+
+/*
+ * Returns whether or not the relay daemon's stream path `path_name`
+ * may name a directory within the archive path: it must be relative
+ * and must not contain any `..` component.
+ */
+static bool path_name_is_safe(const char *path_name)
+{
+    bool is_safe = true;
+    gchar **components;
+    gchar **component;
+
+    if (path_name[0] == '\0' || g_path_is_absolute(path_name)) {
+        is_safe = false;
+        goto end;
+    }
+
+    components = g_strsplit_set(path_name, "/\\", -1);
+    BT_ASSERT(components);
+
+    for (component = components; *component; component++) {
+        if (strcmp(*component, "..") == 0) {
+            is_safe = false;
+            break;
+        }
+    }
+
+    g_strfreev(components);
+
+end:
+    return is_safe;
+}
+
+/*
+ * Creates a new directory of which the path is `path`, or, if it
+ * already exists, `path` followed with `-N`, where `N` is the lowest
+ * number for which the directory doesn't exist, also creating its
+ * parent directories, and sets `path` to the path of the new
+ * directory.
+ *
+ * This never reuses an existing directory, so that an archive never
+ * overwrites the files of a previous one.
+ */
+static int create_fresh_dir(GString *path, bt_logging_level log_level,
+                            bt_self_component *self_comp)
+{
+    gchar *parent_path = g_path_get_dirname(path->str);
+    GString *base_path = g_string_new(path->str);
+    unsigned int suffix = 1;
+    int ret = 0;
+
+    BT_ASSERT(parent_path);
+    BT_ASSERT(base_path);
+
+    if (g_mkdir_with_parents(parent_path, 0755)) {
+        BT_COMP_LOGE_APPEND_CAUSE_ERRNO(self_comp, "Cannot create archive directory",
+                                        ": path=\"%s\"", parent_path);
+        ret = -1;
+        goto end;
+    }
+
+    while (g_mkdir(path->str, 0755)) {
+        if (errno != EEXIST) {
+            BT_COMP_LOGE_APPEND_CAUSE_ERRNO(self_comp, "Cannot create archive trace directory",
+                                            ": path=\"%s\"", path->str);
+            ret = -1;
+            goto end;
+        }
+
+        g_string_printf(path, "%s-%u", base_path->str, suffix);
+        suffix++;
+    }
+
+end:
+    g_string_free(base_path, TRUE);
+    g_free(parent_path);
+    return ret;
+}
+
+int lttng_live_archive_trace_open(struct lttng_live_trace *trace, const char *path_name)
+{
+    bt_logging_level log_level = trace->log_level;
+    bt_self_component *self_comp = trace->self_comp;
+    const char *archive_path = borrow_archive_path(trace);
+    GString *metadata_path = NULL;
+    int ret = 0;
+
+    if (!archive_path || trace->archive.path) {
+        goto end;
+    }
+
+    trace->archive.path = g_string_new(archive_path);
+    BT_ASSERT(trace->archive.path);
+
+    if (path_name_is_safe(path_name)) {
+        g_string_append_printf(trace->archive.path, "/%s", path_name);
+    } else {
+        /* Absolute path (for example): don't mirror it */
+        g_string_append_printf(trace->archive.path, "/trace-%" PRIu64 "-%" PRIu64,
+                               trace->session->id, trace->id);
+    }
+
+    ret = create_fresh_dir(trace->archive.path, log_level, self_comp);
+    if (ret) {
+        goto end;
+    }
+
+    metadata_path = g_string_new(trace->archive.path->str);
+    BT_ASSERT(metadata_path);
+    g_string_append(metadata_path, "/index");
+
+    if (g_mkdir(metadata_path->str, 0755)) {
+        BT_COMP_LOGE_APPEND_CAUSE_ERRNO(self_comp, "Cannot create archive index directory",
+                                        ": path=\"%s\"", metadata_path->str);
+        ret = -1;
+        goto end;
+    }
+
+    g_string_assign(metadata_path, trace->archive.path->str);
+    g_string_append(metadata_path, "/metadata");
+    trace->archive.metadata_fp = g_fopen(metadata_path->str, "wb");
+    if (!trace->archive.metadata_fp) {
+        BT_COMP_LOGE_APPEND_CAUSE_ERRNO(self_comp, "Cannot open archive metadata file",
+                                        ": path=\"%s\"", metadata_path->str);
+        ret = -1;
+        goto end;
+    }
+
+    BT_COMP_LOGI("Archiving live trace: trace-id=%" PRIu64 ", path=\"%s\"", trace->id,
+                 trace->archive.path->str);
+
+end:
+    if (metadata_path) {
+        g_string_free(metadata_path, TRUE);
+    }
+
+    return ret;
+}
+
+void lttng_live_archive_trace_close(struct lttng_live_trace *trace)
+{
+    bt_logging_level log_level = trace->log_level;
+    bt_self_component *self_comp = trace->self_comp;
+
+    if (trace->archive.metadata_fp) {
+        if (fclose(trace->archive.metadata_fp)) {
+            BT_COMP_LOGW_ERRNO("Cannot close archive metadata file", ": path=\"%s\"",
+                               trace->archive.path->str);
+        }
+
+        trace->archive.metadata_fp = NULL;
+    }
+
+    if (trace->archive.path) {
+        g_string_free(trace->archive.path, TRUE);
+        trace->archive.path = NULL;
+    }
+}
+
+int lttng_live_archive_trace_append_metadata(struct lttng_live_trace *trace, const char *buf,
+                                             size_t len)
+{
+    bt_logging_level log_level = trace->log_level;
+    bt_self_component *self_comp = trace->self_comp;
+    int ret = 0;
+
+    if (!trace->archive.metadata_fp) {
+        goto end;
+    }
+
+    if (fwrite(buf, 1, len, trace->archive.metadata_fp) != len ||
+        fflush(trace->archive.metadata_fp)) {
+        BT_COMP_LOGE_APPEND_CAUSE_ERRNO(self_comp, "Cannot write archive metadata file",
+                                        ": path=\"%s\"", trace->archive.path->str);
+        ret = -1;
+    }
+
+end:
+    return ret;
+}
+
+static bool stream_file_name_exists(struct lttng_live_trace *trace, const char *name)
+{
+    guint i;
+
+    for (i = 0; i < trace->stream_iterators->len; i++) {
+        struct lttng_live_stream_iterator *stream =
+            (lttng_live_stream_iterator *) g_ptr_array_index(trace->stream_iterators, i);
+
+        if (stream->archive.file_name && strcmp(stream->archive.file_name->str, name) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static GString *make_unique_stream_file_name(struct lttng_live_trace *trace,
+                                             const char *channel_name)
+{
+    GString *base = g_string_new(channel_name[0] == '\0' ? "stream" : channel_name);
+    GString *name;
+    unsigned int suffix = 0;
+    gsize i;
+
+    BT_ASSERT(base);
+
+    for (i = 0; i < base->len; i++) {
+        if (base->str[i] == '/' || base->str[i] == '\\') {
+            base->str[i] = '_';
+        }
+    }
+
+    name = g_string_new(base->str);
+    BT_ASSERT(name);
+
+    while (stream_file_name_exists(trace, name->str) || strcmp(name->str, "metadata") == 0) {
+        g_string_printf(name, "%s-%u", base->str, suffix);
+        suffix++;
+    }
+
+    g_string_free(base, TRUE);
+    return name;
+}
+
+int lttng_live_archive_stream_open(struct lttng_live_stream_iterator *stream,
+                                   const char *channel_name)
+{
+    bt_logging_level log_level = stream->log_level;
+    bt_self_component *self_comp = stream->self_comp;
+    struct lttng_live_trace *trace = stream->trace;
+    GString *path = NULL;
+    struct ctf_packet_index_file_hdr hdr;
+    int ret = 0;
+
+    if (!trace->archive.path) {
+        goto end;
+    }
+
+    BT_ASSERT(!stream->archive.file_name);
+    stream->archive.file_name = make_unique_stream_file_name(trace, channel_name);
+    path = g_string_new(trace->archive.path->str);
+    BT_ASSERT(path);
+    g_string_append_printf(path, "/%s", stream->archive.file_name->str);
+    stream->archive.fp = g_fopen(path->str, "wb");
+    if (!stream->archive.fp) {
+        BT_COMP_LOGE_APPEND_CAUSE_ERRNO(self_comp, "Cannot open archive data stream file",
+                                        ": path=\"%s\"", path->str);
+        ret = -1;
+        goto end;
+    }
+
+    g_string_printf(path, "%s/index/%s.idx", trace->archive.path->str,
+                    stream->archive.file_name->str);
+    stream->archive.index_fp = g_fopen(path->str, "wb");
+    if (!stream->archive.index_fp) {
+        BT_COMP_LOGE_APPEND_CAUSE_ERRNO(self_comp, "Cannot open archive index file",
+                                        ": path=\"%s\"", path->str);
+        ret = -1;
+        goto end;
+    }
+
+    /*
+     * The index reply of the relay daemon doesn't contain the stream
+     * instance ID and packet sequence number fields of a CTF index
+     * 1.1 entry: write CTF index 1.0 entries.
+     */
+    hdr.magic = htobe32(CTF_INDEX_MAGIC);
+    hdr.index_major = htobe32(1);
+    hdr.index_minor = htobe32(0);
+    hdr.packet_index_len = htobe32(CTF_INDEX_1_0_SIZE);
+    if (fwrite(&hdr, sizeof(hdr), 1, stream->archive.index_fp) != 1) {
+        BT_COMP_LOGE_APPEND_CAUSE_ERRNO(self_comp, "Cannot write archive index file header",
+                                        ": path=\"%s\"", path->str);
+        ret = -1;
+        goto end;
+    }
+
+end:
+    if (path) {
+        g_string_free(path, TRUE);
+    }
+
+    return ret;
+}
+
+/*
+ * Removes the bytes of the current, incomplete packet of `stream` from
+ * its data stream file.
+ */
+static int discard_packet(struct lttng_live_stream_iterator *stream)
+{
+    bt_logging_level log_level = stream->log_level;
+    bt_self_component *self_comp = stream->self_comp;
+    int ret = 0;
+
+    BT_ASSERT(stream->archive.packet_is_open);
+    BT_COMP_LOGD("Discarding incomplete archived packet: stream-file-name=%s, "
+                 "packet-offset=%" PRIu64 ", written-size=%" PRIu64,
+                 stream->archive.file_name->str, stream->archive.packet_offset,
+                 stream->archive.packet_written);
+    stream->archive.packet_is_open = false;
+
+    if (stream->archive.packet_written == 0) {
+        goto end;
+    }
+
+    if (fflush(stream->archive.fp) ||
+        ftruncate(fileno(stream->archive.fp), (off_t) stream->archive.packet_offset) ||
+        fseeko(stream->archive.fp, (off_t) stream->archive.packet_offset, SEEK_SET)) {
+        BT_COMP_LOGE_APPEND_CAUSE_ERRNO(self_comp,
+                                        "Cannot discard incomplete archived packet",
+                                        ": stream-file-name=%s", stream->archive.file_name->str);
+        ret = -1;
+    }
+
+end:
+    return ret;
+}
+
+void lttng_live_archive_stream_close(struct lttng_live_stream_iterator *stream)
+{
+    bt_logging_level log_level = stream->log_level;
+    bt_self_component *self_comp = stream->self_comp;
+
+    if (stream->archive.fp) {
+        if (stream->archive.packet_is_open && discard_packet(stream)) {
+            /* Not fatal at this point */
+            bt_current_thread_clear_error();
+        }
+
+        if (fclose(stream->archive.fp)) {
+            BT_COMP_LOGW_ERRNO("Cannot close archive data stream file", ": stream-file-name=%s",
+                               stream->archive.file_name->str);
+        }
+
+        stream->archive.fp = NULL;
+    }
+
+    if (stream->archive.index_fp) {
+        if (fclose(stream->archive.index_fp)) {
+            BT_COMP_LOGW_ERRNO("Cannot close archive index file", ": stream-file-name=%s",
+                               stream->archive.file_name->str);
+        }
+
+        stream->archive.index_fp = NULL;
+    }
+
+    if (stream->archive.file_name) {
+        g_string_free(stream->archive.file_name, TRUE);
+        stream->archive.file_name = NULL;
+    }
+}
+
+int lttng_live_archive_stream_begin_packet(struct lttng_live_stream_iterator *stream,
+                                           const struct packet_index *index)
+{
+    int ret = 0;
+
+    if (!stream->archive.fp) {
+        goto end;
+    }
+
+    if (stream->archive.packet_is_open) {
+        ret = discard_packet(stream);
+        if (ret) {
+            goto end;
+        }
+    }
+
+    stream->archive.packet_index = *index;
+    stream->archive.packet_written = 0;
+    stream->archive.packet_is_open = true;
+
+end:
+    return ret;
+}
+
+static int write_index_entry(struct lttng_live_stream_iterator *stream)
+{
+    bt_logging_level log_level = stream->log_level;
+    bt_self_component *self_comp = stream->self_comp;
+    const struct packet_index *index = &stream->archive.packet_index;
+    struct ctf_packet_index entry;
+    int ret = 0;
+
+    BT_ASSERT(stream->ctf_stream_class_id.is_set);
+    entry.offset = htobe64(stream->archive.packet_offset);
+    entry.packet_size = htobe64(index->packet_size);
+    entry.content_size = htobe64(index->content_size);
+    entry.timestamp_begin = htobe64(index->ts_cycles.timestamp_begin);
+    entry.timestamp_end = htobe64(index->ts_cycles.timestamp_end);
+    entry.events_discarded = htobe64(index->events_discarded);
+    entry.stream_id = htobe64(stream->ctf_stream_class_id.value);
+
+    if (fwrite(&entry, CTF_INDEX_1_0_SIZE, 1, stream->archive.index_fp) != 1 ||
+        fflush(stream->archive.index_fp)) {
+        BT_COMP_LOGE_APPEND_CAUSE_ERRNO(self_comp, "Cannot write archive index entry",
+                                        ": stream-file-name=%s", stream->archive.file_name->str);
+        ret = -1;
+    }
+
+    return ret;
+}
+
+int lttng_live_archive_stream_append_bytes(struct lttng_live_stream_iterator *stream,
+                                           const uint8_t *buf, uint64_t len)
+{
+    bt_logging_level log_level = stream->log_level;
+    bt_self_component *self_comp = stream->self_comp;
+    int ret = 0;
+
+    if (!stream->archive.fp) {
+        goto end;
+    }
+
+    BT_ASSERT(stream->archive.packet_is_open);
+
+    if (fwrite(buf, 1, len, stream->archive.fp) != len) {
+        BT_COMP_LOGE_APPEND_CAUSE_ERRNO(self_comp, "Cannot write archive data stream file",
+                                        ": stream-file-name=%s", stream->archive.file_name->str);
+        ret = -1;
+        goto end;
+    }
+
+    stream->archive.packet_written += len;
+    BT_ASSERT(stream->archive.packet_written <=
+              stream->archive.packet_index.packet_size / CHAR_BIT);
+
+    if (stream->archive.packet_written < stream->archive.packet_index.packet_size / CHAR_BIT) {
+        goto end;
+    }
+
+    /* Complete packet: make it visible to offline readers */
+    if (fflush(stream->archive.fp)) {
+        BT_COMP_LOGE_APPEND_CAUSE_ERRNO(self_comp, "Cannot write archive data stream file",
+                                        ": stream-file-name=%s", stream->archive.file_name->str);
+        ret = -1;
+        goto end;
+    }
+
+    ret = write_index_entry(stream);
+    if (ret) {
+        goto end;
+    }
+
+    stream->archive.packet_offset += stream->archive.packet_written;
+    stream->archive.packet_is_open = false;
+
+end:
+    return ret;
+}
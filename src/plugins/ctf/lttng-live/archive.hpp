@@ -0,0 +1,84 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS, Inc.
+ */
+
+#ifndef LTTNG_LIVE_ARCHIVE_H
+#define LTTNG_LIVE_ARCHIVE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lttng-live.hpp"
+
+/*
+ * Trace archiving.
+ *
+ * When the component has an `archive-path` parameter, a live message
+ * iterator writes, as it receives them, the metadata and the packets of
+ * each trace to a local CTF trace directory, with LTTng index files,
+ * within this path.
+ *
+ * The data stream files only contain complete packets: the archive
+ * discards the bytes of a packet which the message iterator didn't
+ * completely receive.
+ *
+ * Unless specified otherwise, all the functions below do nothing when
+ * the component has no `archive-path` parameter, and return 0 on
+ * success or -1 on error, appending an error cause.
+ */
+
+/*
+ * Creates the directory of the trace `trace`, if not already done,
+ * using the relay daemon's stream path `path_name` to name it, and
+ * opens its metadata file.
+ *
+ * If this directory already exists, for example from a previous
+ * session, then this function creates a new one with a `-N` suffix
+ * instead of overwriting its files.
+ */
+int lttng_live_archive_trace_open(struct lttng_live_trace *trace, const char *path_name);
+
+/*
+ * Closes the files of the trace `trace`.
+ */
+void lttng_live_archive_trace_close(struct lttng_live_trace *trace);
+
+/*
+ * Appends the metadata text `buf` of length `len` bytes to the metadata
+ * file of the trace `trace`.
+ */
+int lttng_live_archive_trace_append_metadata(struct lttng_live_trace *trace, const char *buf,
+                                             size_t len);
+
+/*
+ * Opens the data stream and index files of the live stream iterator
+ * `stream`, named after the relay daemon's channel name
+ * `channel_name`, within the directory of its trace.
+ */
+int lttng_live_archive_stream_open(struct lttng_live_stream_iterator *stream,
+                                   const char *channel_name);
+
+/*
+ * Closes the files of the live stream iterator `stream`, discarding
+ * its current packet if it's incomplete.
+ */
+void lttng_live_archive_stream_close(struct lttng_live_stream_iterator *stream);
+
+/*
+ * Starts archiving the packet of which the index is `index` for the
+ * live stream iterator `stream`.
+ */
+int lttng_live_archive_stream_begin_packet(struct lttng_live_stream_iterator *stream,
+                                           const struct packet_index *index);
+
+/*
+ * Appends the received bytes `buf` of length `len` bytes to the
+ * current packet of the live stream iterator `stream`, writing its
+ * index entry once the packet is complete.
+ */
+int lttng_live_archive_stream_append_bytes(struct lttng_live_stream_iterator *stream,
+                                           const uint8_t *buf, uint64_t len);
+
+#endif /* LTTNG_LIVE_ARCHIVE_H */
@@ -24,10 +24,20 @@
 #include "compat/mman.h" /* IWYU pragma: keep  */
 
 #include "../common/msg-iter/msg-iter.hpp"
+#include "archive.hpp"
 #include "data-stream.hpp"
 
 #define STREAM_NAME_PREFIX "stream-"
 
+/*
+ * Maximum number of bytes to fetch with a single
+ * `LTTNG_VIEWER_GET_PACKET` command in whole packet mode.
+ *
+ * This bounds the size of the buffer of a live stream iterator: the
+ * rest of a larger packet takes more than one round trip.
+ */
+#define MAX_WHOLE_PACKET_FETCH_SIZE (64 * 1024 * 1024)
+
 static enum ctf_msg_iter_medium_status medop_request_bytes(size_t request_sz, uint8_t **buffer_addr,
                                                            size_t *buffer_sz, void *data)
 {
@@ -54,10 +64,63 @@ static enum ctf_msg_iter_medium_status medop_request_bytes(size_t request_sz, ui
         goto end;
     }
 
-    read_len = MIN(request_sz, stream->buflen);
-    read_len = MIN(read_len, len_left);
+    if (live_msg_iter->lttng_live_comp->params.whole_packets) {
+        /*
+         * Fetch the rest of the current packet with a single round
+         * trip, growing the buffer of this stream if needed: the
+         * message iterator accepts a buffer larger than what it
+         * requested.
+         */
+        read_len = MIN(len_left, MAX_WHOLE_PACKET_FETCH_SIZE);
+
+        if (read_len > stream->buflen) {
+            bt_logging_level log_level = stream->log_level;
+            bt_self_component *self_comp = stream->self_comp;
+
+            if (read_len - stream->buflen >
+                bt_self_component_get_remaining_memory_budget(self_comp)) {
+                /*
+                 * Growing the buffer would exceed the memory limit
+                 * of the graph: fetch the packet in chunks of the
+                 * current buffer size instead.
+                 */
+                BT_COMP_LOGD("Not growing live stream iterator buffer: "
+                             "no memory budget left: "
+                             "stream-name=\"%s\", size=%zu, needed-size=%" PRIu64,
+                             stream->name->str, stream->buflen, read_len);
+                read_len = stream->buflen;
+            } else {
+                BT_COMP_LOGD("Growing live stream iterator buffer: "
+                             "stream-name=\"%s\", old-size=%zu, new-size=%" PRIu64,
+                             stream->name->str, stream->buflen, read_len);
+                g_free(stream->buf);
+                bt_self_component_remove_retained_memory_size(self_comp, stream->buflen);
+                stream->buflen = 0;
+                stream->buf = g_try_new(uint8_t, read_len);
+                if (!stream->buf) {
+                    BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+                                              "Failed to allocate live stream iterator buffer");
+                    status = CTF_MSG_ITER_MEDIUM_STATUS_ERROR;
+                    goto end;
+                }
+
+                stream->buflen = read_len;
+                bt_self_component_add_retained_memory_size(self_comp, stream->buflen);
+            }
+        }
+    } else {
+        read_len = MIN(request_sz, stream->buflen);
+        read_len = MIN(read_len, len_left);
+    }
+
     status = lttng_live_get_stream_bytes(live_msg_iter, stream, stream->buf, stream->offset,
                                          read_len, &recv_len);
+    if (status == CTF_MSG_ITER_MEDIUM_STATUS_OK &&
+        lttng_live_archive_stream_append_bytes(stream, stream->buf, recv_len)) {
+        status = CTF_MSG_ITER_MEDIUM_STATUS_ERROR;
+        goto end;
+    }
+
     *buffer_addr = stream->buf;
     *buffer_sz = recv_len;
     stream->offset += recv_len;
@@ -229,6 +292,7 @@ lttng_live_stream_iterator_create(struct lttng_live_session *session, uint64_t c
     }
 
     stream_iter->buflen = lttng_live->max_query_size;
+    bt_self_component_add_retained_memory_size(self_comp, stream_iter->buflen);
     stream_iter->name = g_string_new(NULL);
     if (!stream_iter->name) {
         BT_COMP_LOGE_APPEND_CAUSE(self_comp, "Failed to allocate live stream iterator name buffer");
@@ -263,7 +327,14 @@ void lttng_live_stream_iterator_destroy(struct lttng_live_stream_iterator *strea
     if (stream_iter->msg_iter) {
         ctf_msg_iter_destroy(stream_iter->msg_iter);
     }
+    lttng_live_archive_stream_close(stream_iter);
     g_free(stream_iter->buf);
+
+    if (stream_iter->buflen > 0) {
+        bt_self_component_remove_retained_memory_size(stream_iter->self_comp,
+                                                      stream_iter->buflen);
+    }
+
     if (stream_iter->name) {
         g_string_free(stream_iter->name, TRUE);
     }
@@ -27,6 +27,7 @@
 #include "data-stream.hpp"
 #include "lttng-live.hpp"
 #include "metadata.hpp"
+#include "archive.hpp"
 
 #define MAX_QUERY_SIZE                     (256 * 1024)
 #define URL_PARAM                          "url"
@@ -35,6 +36,8 @@
 #define SESS_NOT_FOUND_ACTION_CONTINUE_STR "continue"
 #define SESS_NOT_FOUND_ACTION_FAIL_STR     "fail"
 #define SESS_NOT_FOUND_ACTION_END_STR      "end"
+#define ARCHIVE_PATH_PARAM                 "archive-path"
+#define WHOLE_PACKETS_PARAM                "whole-packets"
 
 #define print_dbg(fmt, ...) BT_COMP_LOGD(fmt, ##__VA_ARGS__)
 
@@ -153,6 +156,7 @@ static void lttng_live_destroy_trace(struct lttng_live_trace *trace)
     BT_TRACE_CLASS_PUT_REF_AND_RESET(trace->trace_class);
 
     lttng_live_metadata_fini(trace);
+    lttng_live_archive_trace_close(trace);
     g_free(trace);
 }
 
@@ -423,6 +427,11 @@ static enum lttng_live_iterator_status lttng_live_iterator_next_handle_one_no_da
     lttng_live_stream->offset = index.offset;
     lttng_live_stream->len = index.packet_size / CHAR_BIT;
 
+    if (lttng_live_archive_stream_begin_packet(lttng_live_stream, &index)) {
+        ret = LTTNG_LIVE_ITERATOR_STATUS_ERROR;
+        goto end;
+    }
+
     BT_COMP_LOGD("Setting live stream reading info: stream-name=\"%s\", "
                  "viewer-stream-id=%" PRIu64 ", stream-base-offset=%" PRIu64
                  ", stream-offset=%" PRIu64 ", stream-len=%" PRIu64,
@@ -2052,6 +2061,9 @@ static void lttng_live_component_destroy_data(struct lttng_live_component *lttng
     if (lttng_live->params.url) {
         g_string_free(lttng_live->params.url, TRUE);
     }
+    if (lttng_live->params.archive_path) {
+        g_string_free(lttng_live->params.archive_path, TRUE);
+    }
     g_free(lttng_live);
 }
 
@@ -2098,6 +2110,10 @@ static struct bt_param_validation_map_value_entry_descr params_descr[] = {
      bt_param_validation_value_descr::makeArray(1, 1, inputs_elem_descr)},
     {SESS_NOT_FOUND_ACTION_PARAM, BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
      bt_param_validation_value_descr::makeString(sess_not_found_action_choices)},
+    {ARCHIVE_PATH_PARAM, BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeString()},
+    {WHOLE_PACKETS_PARAM, BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeBool()},
     BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END};
 
 static bt_component_class_initialize_method_status
@@ -2153,6 +2169,20 @@ lttng_live_component_create(const bt_value *params, bt_logging_level log_level,
         lttng_live->params.sess_not_found_act = SESSION_NOT_FOUND_ACTION_CONTINUE;
     }
 
+    value = bt_value_map_borrow_entry_value_const(params, WHOLE_PACKETS_PARAM);
+    if (value) {
+        lttng_live->params.whole_packets = bt_value_bool_get(value);
+    }
+
+    value = bt_value_map_borrow_entry_value_const(params, ARCHIVE_PATH_PARAM);
+    if (value) {
+        lttng_live->params.archive_path = g_string_new(bt_value_string_get(value));
+        if (!lttng_live->params.archive_path) {
+            status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+            goto error;
+        }
+    }
+
     status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
     goto end;
 
@@ -13,6 +13,7 @@
 
 #include <glib.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #include <babeltrace2/babeltrace.h>
 
@@ -99,7 +100,15 @@ struct lttng_live_stream_iterator
     /* Timestamp in nanoseconds of the current message (current_msg). */
     int64_t current_msg_ts_ns;
 
-    /* Owned by this. */
+    /*
+     * Owned by this.
+     *
+     * With the `whole-packets` parameter, this buffer grows to the
+     * size of the largest packet of the stream, within the memory
+     * budget of the graph, and is reused for the following packets.
+     *
+     * The component reports `buflen` as retained memory.
+     */
     uint8_t *buf;
     size_t buflen;
 
@@ -107,6 +116,32 @@ struct lttng_live_stream_iterator
     GString *name;
 
     bool has_stream_hung_up;
+
+    /*
+     * Archiving state (see `archive.hpp`): all `NULL`/zero when the
+     * component has no `archive-path` parameter.
+     */
+    struct
+    {
+        /* Data stream file name within the trace directory (owned by this) */
+        GString *file_name;
+
+        /* Data stream and index files (owned by this) */
+        FILE *fp;
+        FILE *index_fp;
+
+        /* Offset of the current packet within the data stream file (bytes) */
+        uint64_t packet_offset;
+
+        /* Number of bytes of the current packet written so far */
+        uint64_t packet_written;
+
+        /* Index of the current packet */
+        struct packet_index packet_index;
+
+        /* True if the current packet isn't completely written yet */
+        bool packet_is_open;
+    } archive;
 };
 
 struct lttng_live_metadata
@@ -167,6 +202,19 @@ struct lttng_live_trace
     GPtrArray *stream_iterators;
 
     enum lttng_live_metadata_stream_state metadata_stream_state;
+
+    /*
+     * Archiving state (see `archive.hpp`): all `NULL` when the component
+     * has no `archive-path` parameter.
+     */
+    struct
+    {
+        /* Trace directory path (owned by this) */
+        GString *path;
+
+        /* Metadata file (owned by this) */
+        FILE *metadata_fp;
+    } archive;
 };
 
 struct lttng_live_session
@@ -215,6 +263,19 @@ struct lttng_live_component
     {
         GString *url;
         enum session_not_found_action sess_not_found_act;
+
+        /*
+         * True to fetch the rest of the current packet with a single
+         * `LTTNG_VIEWER_GET_PACKET` command instead of chunks of at
+         * most `max_query_size` bytes.
+         */
+        bool whole_packets;
+
+        /*
+         * Directory in which to archive the received traces, or
+         * `NULL`.
+         */
+        GString *archive_path;
     } params;
 
     size_t max_query_size;
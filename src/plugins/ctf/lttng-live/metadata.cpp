@@ -22,6 +22,7 @@
 
 #include "../common/metadata/ctf-meta-configure-ir-trace.hpp"
 #include "../common/metadata/decoder.hpp"
+#include "archive.hpp"
 #include "metadata.hpp"
 
 #define TSDL_MAGIC 0x75d11d57
@@ -217,6 +218,10 @@ enum lttng_live_iterator_status lttng_live_metadata_update(struct lttng_live_tra
         goto end;
     }
 
+    if (lttng_live_archive_trace_append_metadata(trace, metadata_buf, len_read)) {
+        goto error;
+    }
+
     /*
      * Open a new reading file handle on the `metadata_buf` and pass it to
      * the metadata decoder.
@@ -19,6 +19,7 @@
 #include "common/common.h"
 #include "compat/endian.h" /* IWYU pragma: keep  */
 
+#include "archive.hpp"
 #include "data-stream.hpp"
 #include "lttng-live.hpp"
 #include "lttng-viewer-abi.hpp"
@@ -1012,6 +1013,13 @@ static enum lttng_live_viewer_status receive_streams(struct lttng_live_session *
                 goto end;
             }
             session->lazy_stream_msg_init = true;
+
+            if (lttng_live_archive_trace_open(
+                    lttng_live_session_borrow_or_create_trace_by_id(session, ctf_trace_id),
+                    stream.path_name)) {
+                status = LTTNG_LIVE_VIEWER_STATUS_ERROR;
+                goto end;
+            }
         } else {
             BT_COMP_LOGI("    stream %" PRIu64 " : %s/%s", stream_id, stream.path_name,
                          stream.channel_name);
@@ -1022,6 +1030,12 @@ static enum lttng_live_viewer_status receive_streams(struct lttng_live_session *
                 status = LTTNG_LIVE_VIEWER_STATUS_ERROR;
                 goto end;
             }
+
+            if (lttng_live_archive_trace_open(live_stream->trace, stream.path_name) ||
+                lttng_live_archive_stream_open(live_stream, stream.channel_name)) {
+                status = LTTNG_LIVE_VIEWER_STATUS_ERROR;
+                goto end;
+            }
         }
     }
     status = LTTNG_LIVE_VIEWER_STATUS_OK;
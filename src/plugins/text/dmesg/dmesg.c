@@ -13,14 +13,17 @@
 #include "dmesg.h"
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include <ctype.h>
+#include <errno.h>
 #include <stdio.h>
+#include <time.h>
+#include <unistd.h>
 #include "common/common.h"
 #include "common/assert.h"
 #include <babeltrace2/babeltrace.h>
 #include "compat/utc.h"
-#include "compat/stdio.h"
 #include <glib.h>
 #include "plugins/common/param-validation/param-validation.h"
 
@@ -29,6 +32,9 @@
 #define NSEC_PER_SEC 1000000000ULL
 #define USEC_PER_SEC 1000000UL
 
+/* Initial size of the input buffer of a message iterator */
+#define READ_BUF_INIT_SIZE (256 * 1024)
+
 struct dmesg_component;
 
 struct dmesg_msg_iter {
@@ -37,9 +43,32 @@ struct dmesg_msg_iter {
 	/* Weak */
 	bt_self_message_iterator *self_msg_iter;
 
-	char *linebuf;
-	size_t linebuf_len;
 	FILE *fp;
+
+	/*
+	 * Input buffer: the bytes which are read from `fp` but not
+	 * consumed yet are `buf[buf_begin..buf_end)`.
+	 *
+	 * The buffer grows when a single line doesn't fit.
+	 */
+	char *buf;
+	size_t buf_size;
+	size_t buf_begin;
+	size_t buf_end;
+
+	/* True when `fp` reached its end (never set in follow mode) */
+	bool eof;
+
+	/*
+	 * Result of the last bt_timegm() call for a human-readable
+	 * timestamp: consecutive lines very often share the same second.
+	 */
+	struct {
+		bool valid;
+		int year, mon, mday, hour, min, sec;
+		time_t ep_sec;
+	} timegm_cache;
+
 	bt_message *tmp_event_msg;
 	uint64_t last_clock_value;
 
@@ -58,6 +87,7 @@ struct dmesg_component {
 		GString *path;
 		bt_bool read_from_stdin;
 		bt_bool no_timestamp;
+		bt_bool follow;
 	} params;
 
 	bt_self_component_source *self_comp_src;
@@ -198,6 +228,7 @@ end:
 
 static
 struct bt_param_validation_map_value_entry_descr dmesg_params[] = {
+	{ "follow", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
 	{ "no-extract-timestamp", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
 	{ "path", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_STRING } },
 	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
@@ -209,6 +240,7 @@ bt_component_class_initialize_method_status handle_params(
 		const bt_value *params)
 {
 	const bt_value *no_timestamp = NULL;
+	const bt_value *follow = NULL;
 	const bt_value *path = NULL;
 	bt_component_class_initialize_method_status status;
 	enum bt_param_validation_status validation_status;
@@ -233,6 +265,11 @@ bt_component_class_initialize_method_status handle_params(
 			bt_value_bool_get(no_timestamp);
 	}
 
+	follow = bt_value_map_borrow_entry_value_const(params, "follow");
+	if (follow) {
+		dmesg_comp->params.follow = bt_value_bool_get(follow);
+	}
+
 	path = bt_value_map_borrow_entry_value_const(params, "path");
 	if (path) {
 		const char *path_str = bt_value_string_get(path);
@@ -242,6 +279,13 @@ bt_component_class_initialize_method_status handle_params(
 		dmesg_comp->params.read_from_stdin = true;
 	}
 
+	if (dmesg_comp->params.follow && dmesg_comp->params.read_from_stdin) {
+		BT_COMP_LOGE_APPEND_CAUSE(dmesg_comp->self_comp,
+			"The `follow` parameter requires the `path` parameter.");
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto end;
+	}
+
 	status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
 end:
 	g_free(validate_error);
@@ -443,16 +487,164 @@ void dmesg_finalize(bt_self_component_source *self_comp)
 		bt_self_component_source_as_self_component(self_comp)));
 }
 
+/*
+ * Scans an unsigned decimal integer at `*pos`, not going past `end`,
+ * skipping leading blanks like the `%u` conversion of scanf() does.
+ *
+ * On success, sets `*val`, moves `*pos` after the last digit, and
+ * returns true.
+ */
+static
+bool scan_uint(const char **pos, const char *end, uint64_t *val)
+{
+	const char *ch = *pos;
+	const char *digits;
+	uint64_t v = 0;
+
+	while (ch < end && (*ch == ' ' || *ch == '\t')) {
+		ch++;
+	}
+
+	digits = ch;
+
+	while (ch < end && *ch >= '0' && *ch <= '9') {
+		unsigned int digit = *ch - '0';
+
+		if (v > (UINT64_MAX - digit) / 10) {
+			/* Overflow */
+			return false;
+		}
+
+		v = v * 10 + digit;
+		ch++;
+	}
+
+	if (ch == digits) {
+		return false;
+	}
+
+	*val = v;
+	*pos = ch;
+	return true;
+}
+
+/*
+ * Scans the character `c` at `*pos`, not going past `end`.
+ *
+ * On success, moves `*pos` after `c` and returns true.
+ */
+static inline
+bool scan_char(const char **pos, const char *end, char c)
+{
+	if (*pos < end && **pos == c) {
+		(*pos)++;
+		return true;
+	}
+
+	return false;
+}
+
+static
+time_t cached_timegm(struct dmesg_msg_iter *msg_iter, struct tm *ti)
+{
+	if (!msg_iter->timegm_cache.valid ||
+			msg_iter->timegm_cache.sec != ti->tm_sec ||
+			msg_iter->timegm_cache.min != ti->tm_min ||
+			msg_iter->timegm_cache.hour != ti->tm_hour ||
+			msg_iter->timegm_cache.mday != ti->tm_mday ||
+			msg_iter->timegm_cache.mon != ti->tm_mon ||
+			msg_iter->timegm_cache.year != ti->tm_year) {
+		/* bt_timegm() may normalize `*ti`: update the key first */
+		msg_iter->timegm_cache.year = ti->tm_year;
+		msg_iter->timegm_cache.mon = ti->tm_mon;
+		msg_iter->timegm_cache.mday = ti->tm_mday;
+		msg_iter->timegm_cache.hour = ti->tm_hour;
+		msg_iter->timegm_cache.min = ti->tm_min;
+		msg_iter->timegm_cache.sec = ti->tm_sec;
+		msg_iter->timegm_cache.ep_sec = bt_timegm(ti);
+		msg_iter->timegm_cache.valid = true;
+	}
+
+	return msg_iter->timegm_cache.ep_sec;
+}
+
+/*
+ * Scans the timestamp prefix of the line `line` (`len` bytes), which
+ * is either `[SEC.USEC]` or `[YYYY-MM-DD HH:MM:SS.MSEC]`.
+ *
+ * On success, sets `*ts` (ns) and `*after` (first character after the
+ * closing bracket), and returns true.
+ */
+static
+bool scan_timestamp(struct dmesg_msg_iter *msg_iter, const char *line,
+		size_t len, uint64_t *ts, const char **after)
+{
+	const char *end = line + len;
+	const char *ch = line;
+	uint64_t sec, usec, msec;
+	uint64_t year, mon, mday, hour, min;
+	time_t ep_sec;
+	struct tm ti;
+
+	if (!scan_char(&ch, end, '[')) {
+		return false;
+	}
+
+	/* `[SEC.USEC]` */
+	if (scan_uint(&ch, end, &sec) && scan_char(&ch, end, '.')) {
+		if (!scan_uint(&ch, end, &usec) || !scan_char(&ch, end, ']')) {
+			return false;
+		}
+
+		/*
+		 * The clock class we use has a 1 GHz frequency: convert
+		 * from µs to ns.
+		 */
+		*ts = (sec * USEC_PER_SEC + usec) * NSEC_PER_USEC;
+		*after = ch;
+		return true;
+	}
+
+	/* `[YYYY-MM-DD HH:MM:SS.MSEC]` */
+	ch = line + 1;
+
+	if (!scan_uint(&ch, end, &year) || !scan_char(&ch, end, '-') ||
+			!scan_uint(&ch, end, &mon) || !scan_char(&ch, end, '-') ||
+			!scan_uint(&ch, end, &mday) ||
+			!scan_uint(&ch, end, &hour) || !scan_char(&ch, end, ':') ||
+			!scan_uint(&ch, end, &min) || !scan_char(&ch, end, ':') ||
+			!scan_uint(&ch, end, &sec) || !scan_char(&ch, end, '.') ||
+			!scan_uint(&ch, end, &msec) || !scan_char(&ch, end, ']')) {
+		return false;
+	}
+
+	memset(&ti, 0, sizeof(ti));
+	ti.tm_year = (int) year - 1900;	/* From 1900 */
+	ti.tm_mon = (int) mon - 1;	/* 0 to 11 */
+	ti.tm_mday = (int) mday;
+	ti.tm_hour = (int) hour;
+	ti.tm_min = (int) min;
+	ti.tm_sec = (int) sec;
+
+	ep_sec = cached_timegm(msg_iter, &ti);
+	if (ep_sec != (time_t) -1) {
+		*ts = (uint64_t) ep_sec * NSEC_PER_SEC + msec * NSEC_PER_MSEC;
+	} else {
+		*ts = 0;
+	}
+
+	*after = ch;
+	return true;
+}
+
 static
 bt_message *create_init_event_msg_from_line(
 		struct dmesg_msg_iter *msg_iter,
-		const char *line, const char **new_start)
+		const char *line, size_t len, const char **new_start)
 {
 	bt_event *event;
 	bt_message *msg = NULL;
 	bool has_timestamp = false;
-	unsigned long sec, usec, msec;
-	unsigned int year, mon, mday, hour, min;
 	uint64_t ts = 0;
 	int ret = 0;
 	struct dmesg_component *dmesg_comp = msg_iter->dmesg_comp;
@@ -464,45 +656,11 @@ bt_message *create_init_event_msg_from_line(
 	}
 
 	/* Extract time from input line */
-	if (sscanf(line, "[%lu.%lu] ", &sec, &usec) == 2) {
-		ts = (uint64_t) sec * USEC_PER_SEC + (uint64_t) usec;
-
-		/*
-		 * The clock class we use has a 1 GHz frequency: convert
-		 * from µs to ns.
-		 */
-		ts *= NSEC_PER_USEC;
-		has_timestamp = true;
-	} else if (sscanf(line, "[%u-%u-%u %u:%u:%lu.%lu] ",
-			&year, &mon, &mday, &hour, &min,
-			&sec, &msec) == 7) {
-		time_t ep_sec;
-		struct tm ti;
-
-		memset(&ti, 0, sizeof(ti));
-		ti.tm_year = year - 1900;	/* From 1900 */
-		ti.tm_mon = mon - 1;		/* 0 to 11 */
-		ti.tm_mday = mday;
-		ti.tm_hour = hour;
-		ti.tm_min = min;
-		ti.tm_sec = sec;
-
-		ep_sec = bt_timegm(&ti);
-		if (ep_sec != (time_t) -1) {
-			ts = (uint64_t) ep_sec * NSEC_PER_SEC
-				+ (uint64_t) msec * NSEC_PER_MSEC;
-		}
-
+	if (scan_timestamp(msg_iter, line, len, &ts, new_start)) {
 		has_timestamp = true;
-	}
 
-	if (has_timestamp) {
 		/* Set new start for the message portion of the line */
-		*new_start = strchr(line, ']');
-		BT_ASSERT_DBG(*new_start);
-		(*new_start)++;
-
-		if ((*new_start)[0] == ' ') {
+		if (*new_start < line + len && (*new_start)[0] == ' ') {
 			(*new_start)++;
 		}
 	}
@@ -548,11 +706,10 @@ end:
 
 static
 int fill_event_payload_from_line(struct dmesg_component *dmesg_comp,
-		const char *line, bt_event *event)
+		const char *line, size_t len, bt_event *event)
 {
 	bt_field *ep_field = NULL;
 	bt_field *str_field = NULL;
-	size_t len;
 	int ret;
 
 	ep_field = bt_event_borrow_payload_field(event);
@@ -565,12 +722,6 @@ int fill_event_payload_from_line(struct dmesg_component *dmesg_comp,
 		goto error;
 	}
 
-	len = strlen(line);
-	if (line[len - 1] == '\n') {
-		/* Do not include the newline character in the payload */
-		len--;
-	}
-
 	bt_field_string_clear(str_field);
 	ret = bt_field_string_append_with_length(str_field, line, len);
 	if (ret) {
@@ -590,7 +741,8 @@ end:
 
 static
 bt_message *create_msg_from_line(
-		struct dmesg_msg_iter *dmesg_msg_iter, const char *line)
+		struct dmesg_msg_iter *dmesg_msg_iter, const char *line,
+		size_t len)
 {
 	struct dmesg_component *dmesg_comp = dmesg_msg_iter->dmesg_comp;
 	bt_event *event = NULL;
@@ -599,7 +751,7 @@ bt_message *create_msg_from_line(
 	int ret;
 
 	msg = create_init_event_msg_from_line(dmesg_msg_iter,
-		line, &new_start);
+		line, len, &new_start);
 	if (!msg) {
 		BT_COMP_LOGE_APPEND_CAUSE(dmesg_comp->self_comp,
 			"Cannot create and initialize event message from line.");
@@ -608,7 +760,8 @@ bt_message *create_msg_from_line(
 
 	event = bt_message_event_borrow_event(msg);
 	BT_ASSERT_DBG(event);
-	ret = fill_event_payload_from_line(dmesg_comp, new_start, event);
+	ret = fill_event_payload_from_line(dmesg_comp, new_start,
+		line + len - new_start, event);
 	if (ret) {
 		BT_COMP_LOGE_APPEND_CAUSE(dmesg_comp->self_comp,
 			"Cannot fill event payload field from line: ret=%d", ret);
@@ -643,12 +796,10 @@ void destroy_dmesg_msg_iter(struct dmesg_msg_iter *dmesg_msg_iter)
 	}
 
 	bt_message_put_ref(dmesg_msg_iter->tmp_event_msg);
-	free(dmesg_msg_iter->linebuf);
+	g_free(dmesg_msg_iter->buf);
 	g_free(dmesg_msg_iter);
 }
 
-
-
 bt_message_iterator_class_initialize_method_status dmesg_msg_iter_init(
 		bt_self_message_iterator *self_msg_iter,
 		bt_self_message_iterator_configuration *config __attribute__((unused)),
@@ -706,12 +857,127 @@ void dmesg_msg_iter_finalize(
 		priv_msg_iter));
 }
 
+enum read_line_status {
+	READ_LINE_STATUS_OK,
+	READ_LINE_STATUS_EOF,
+	READ_LINE_STATUS_ERROR,
+	READ_LINE_STATUS_MEMORY_ERROR,
+};
+
+/*
+ * Sets `*line` and `*len` to the next line of the input, without its
+ * newline character.
+ *
+ * `*line` remains valid until the next call.
+ *
+ * This function reads the input with large read() calls, which don't
+ * block until the buffer is full when the input is a pipe, instead of
+ * going through the C standard library for each line.
+ *
+ * In follow mode, a last line without a newline character is not
+ * complete yet: it remains in the buffer and this function returns
+ * `READ_LINE_STATUS_EOF` until the rest of the line is available.
+ */
+static
+enum read_line_status read_line(struct dmesg_msg_iter *dmesg_msg_iter,
+		const char **line, size_t *len)
+{
+	struct dmesg_component *dmesg_comp = dmesg_msg_iter->dmesg_comp;
+	enum read_line_status status;
+	const char *nl;
+
+	while (true) {
+		char *begin = dmesg_msg_iter->buf + dmesg_msg_iter->buf_begin;
+		size_t avail = dmesg_msg_iter->buf_end -
+			dmesg_msg_iter->buf_begin;
+		ssize_t read_len;
+
+		nl = avail > 0 ? memchr(begin, '\n', avail) : NULL;
+		if (nl) {
+			*line = begin;
+			*len = nl - begin;
+			dmesg_msg_iter->buf_begin += *len + 1;
+			status = READ_LINE_STATUS_OK;
+			goto end;
+		}
+
+		if (dmesg_msg_iter->eof) {
+			if (avail == 0) {
+				status = READ_LINE_STATUS_EOF;
+				goto end;
+			}
+
+			/* Last line without a newline character */
+			*line = begin;
+			*len = avail;
+			dmesg_msg_iter->buf_begin = dmesg_msg_iter->buf_end;
+			status = READ_LINE_STATUS_OK;
+			goto end;
+		}
+
+		/* Move the incomplete line to the beginning of the buffer */
+		if (dmesg_msg_iter->buf_begin > 0) {
+			memmove(dmesg_msg_iter->buf, begin, avail);
+			dmesg_msg_iter->buf_begin = 0;
+			dmesg_msg_iter->buf_end = avail;
+		}
+
+		if (dmesg_msg_iter->buf_end == dmesg_msg_iter->buf_size) {
+			size_t new_size = dmesg_msg_iter->buf_size == 0 ?
+				READ_BUF_INIT_SIZE :
+				dmesg_msg_iter->buf_size * 2;
+			char *new_buf = g_try_realloc(dmesg_msg_iter->buf,
+				new_size);
+
+			if (!new_buf) {
+				BT_COMP_LOGE_APPEND_CAUSE(dmesg_comp->self_comp,
+					"Failed to grow input buffer: size=%zu",
+					new_size);
+				status = READ_LINE_STATUS_MEMORY_ERROR;
+				goto end;
+			}
+
+			dmesg_msg_iter->buf = new_buf;
+			dmesg_msg_iter->buf_size = new_size;
+		}
+
+		read_len = read(fileno(dmesg_msg_iter->fp),
+			dmesg_msg_iter->buf + dmesg_msg_iter->buf_end,
+			dmesg_msg_iter->buf_size - dmesg_msg_iter->buf_end);
+		if (read_len < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			BT_COMP_LOGE_APPEND_CAUSE_ERRNO(dmesg_comp->self_comp,
+				"Cannot read input", ".");
+			status = READ_LINE_STATUS_ERROR;
+			goto end;
+		} else if (read_len == 0) {
+			if (dmesg_comp->params.follow) {
+				/* The file may grow later */
+				status = READ_LINE_STATUS_EOF;
+				goto end;
+			}
+
+			dmesg_msg_iter->eof = true;
+			continue;
+		}
+
+		dmesg_msg_iter->buf_end += read_len;
+	}
+
+end:
+	return status;
+}
+
 static
 bt_message_iterator_class_next_method_status dmesg_msg_iter_next_one(
 		struct dmesg_msg_iter *dmesg_msg_iter,
 		bt_message **msg)
 {
-	ssize_t len;
+	const char *line;
+	size_t len;
 	struct dmesg_component *dmesg_comp;
 	bt_message_iterator_class_next_method_status status;
 
@@ -730,37 +996,39 @@ bt_message_iterator_class_next_method_status dmesg_msg_iter_next_one(
 	}
 
 	while (true) {
-		const char *ch;
+		size_t i;
 		bool only_spaces = true;
 
-		len = bt_getline(&dmesg_msg_iter->linebuf,
-			&dmesg_msg_iter->linebuf_len, dmesg_msg_iter->fp);
-		if (len < 0) {
-			if (errno == EINVAL) {
-				status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+		switch (read_line(dmesg_msg_iter, &line, &len)) {
+		case READ_LINE_STATUS_OK:
+			break;
+		case READ_LINE_STATUS_EOF:
+			if (dmesg_comp->params.follow) {
+				/* Try again once the file grows */
+				status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN;
 				goto end;
-			} else if (errno == ENOMEM) {
-				status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_MEMORY_ERROR;
+			} else if (dmesg_msg_iter->state == STATE_EMIT_STREAM_BEGINNING) {
+				/* Stream did not even begin */
+				status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_END;
 				goto end;
 			} else {
-				if (dmesg_msg_iter->state == STATE_EMIT_STREAM_BEGINNING) {
-					/* Stream did not even begin */
-					status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_END;
-					goto end;
-				} else {
-					/* End stream now */
-					dmesg_msg_iter->state =
-						STATE_EMIT_STREAM_END;
-					goto handle_state;
-				}
+				/* End stream now */
+				dmesg_msg_iter->state = STATE_EMIT_STREAM_END;
+				goto handle_state;
 			}
+		case READ_LINE_STATUS_ERROR:
+			status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+			goto end;
+		case READ_LINE_STATUS_MEMORY_ERROR:
+			status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_MEMORY_ERROR;
+			goto end;
+		default:
+			bt_common_abort();
 		}
 
-		BT_ASSERT_DBG(dmesg_msg_iter->linebuf);
-
 		/* Ignore empty lines, once trimmed */
-		for (ch = dmesg_msg_iter->linebuf; *ch != '\0'; ch++) {
-			if (!isspace((unsigned char) *ch)) {
+		for (i = 0; i < len; i++) {
+			if (!isspace((unsigned char) line[i])) {
 				only_spaces = false;
 				break;
 			}
@@ -772,12 +1040,12 @@ bt_message_iterator_class_next_method_status dmesg_msg_iter_next_one(
 	}
 
 	dmesg_msg_iter->tmp_event_msg = create_msg_from_line(
-		dmesg_msg_iter, dmesg_msg_iter->linebuf);
+		dmesg_msg_iter, line, len);
 	if (!dmesg_msg_iter->tmp_event_msg) {
 		BT_COMP_LOGE_APPEND_CAUSE(dmesg_comp->self_comp,
 			"Cannot create event message from line: "
-			"dmesg-comp-addr=%p, line=\"%s\"", dmesg_comp,
-			dmesg_msg_iter->linebuf);
+			"dmesg-comp-addr=%p, line=\"%.*s\"", dmesg_comp,
+			(int) len, line);
 		status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
 		goto end;
 	}
@@ -884,10 +1152,27 @@ dmesg_msg_iter_seek_beginning(
 	struct dmesg_msg_iter *dmesg_msg_iter =
 		bt_self_message_iterator_get_data(self_msg_iter);
 
-	BT_ASSERT(!dmesg_msg_iter->dmesg_comp->params.read_from_stdin);
+	struct dmesg_component *dmesg_comp = dmesg_msg_iter->dmesg_comp;
+	bt_message_iterator_class_seek_beginning_method_status status =
+		BT_MESSAGE_ITERATOR_CLASS_SEEK_BEGINNING_METHOD_STATUS_OK;
+
+	BT_ASSERT(!dmesg_comp->params.read_from_stdin);
+
+	if (lseek(fileno(dmesg_msg_iter->fp), 0, SEEK_SET) < 0) {
+		BT_COMP_LOGE_APPEND_CAUSE_ERRNO(dmesg_comp->self_comp,
+			"Cannot seek the beginning of the input file",
+			": path=\"%s\"", dmesg_comp->params.path->str);
+		status = BT_MESSAGE_ITERATOR_CLASS_SEEK_BEGINNING_METHOD_STATUS_ERROR;
+		goto end;
+	}
 
+	dmesg_msg_iter->buf_begin = 0;
+	dmesg_msg_iter->buf_end = 0;
+	dmesg_msg_iter->eof = false;
 	BT_MESSAGE_PUT_REF_AND_RESET(dmesg_msg_iter->tmp_event_msg);
 	dmesg_msg_iter->last_clock_value = 0;
 	dmesg_msg_iter->state = STATE_EMIT_STREAM_BEGINNING;
-	return BT_MESSAGE_ITERATOR_CLASS_SEEK_BEGINNING_METHOD_STATUS_OK;
+
+end:
+	return status;
 }
@@ -206,14 +206,18 @@ counter_graph_is_configured(
 		msg_iter_status;
 	struct counter *counter;
 	bt_message_iterator *iterator;
+	bt_self_component_port_input *in_port;
 
 	counter = bt_self_component_get_data(
 		bt_self_component_sink_as_self_component(comp));
 	BT_ASSERT(counter);
+	in_port = bt_self_component_sink_borrow_input_port_by_name(comp,
+		in_port_name);
 
+	/* Only counting messages: no event field is needed */
+	bt_self_component_port_input_set_needed_event_fields(in_port, 0);
 	msg_iter_status = bt_message_iterator_create_from_sink_component(
-		comp, bt_self_component_sink_borrow_input_port_by_name(comp,
-			in_port_name), &iterator);
+		comp, in_port, &iterator);
 	if (msg_iter_status != BT_MESSAGE_ITERATOR_CREATE_FROM_SINK_COMPONENT_STATUS_OK) {
 		status = (int) msg_iter_status;
 		goto end;
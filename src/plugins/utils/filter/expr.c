@@ -0,0 +1,1389 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS Inc.
+ */
+
+#include "expr.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "common/common.h"
+#include "common/assert.h"
+#include <babeltrace2/babeltrace.h>
+#include <glib.h>
+
+enum filter_node_type {
+	/* Constant (`value` member) */
+	FILTER_NODE_TYPE_CONST,
+
+	/* `left` AND `right` */
+	FILTER_NODE_TYPE_AND,
+
+	/* `left` OR `right` */
+	FILTER_NODE_TYPE_OR,
+
+	/* NOT `left` */
+	FILTER_NODE_TYPE_NOT,
+
+	/* Name pattern matching */
+	FILTER_NODE_TYPE_NAME,
+
+	/* Field comparison, as parsed */
+	FILTER_NODE_TYPE_FIELD,
+
+	/* Field comparison with a resolved field path (residual only) */
+	FILTER_NODE_TYPE_RESOLVED_FIELD,
+};
+
+enum filter_name {
+	FILTER_NAME_EVENT,
+	FILTER_NAME_STREAM,
+	FILTER_NAME_TRACE,
+};
+
+enum filter_scope {
+	FILTER_SCOPE_PACKET_CONTEXT,
+	FILTER_SCOPE_COMMON_CONTEXT,
+	FILTER_SCOPE_SPECIFIC_CONTEXT,
+	FILTER_SCOPE_PAYLOAD,
+};
+
+enum filter_op {
+	FILTER_OP_EQ,
+	FILTER_OP_NE,
+	FILTER_OP_LT,
+	FILTER_OP_LE,
+	FILTER_OP_GT,
+	FILTER_OP_GE,
+};
+
+enum filter_literal_type {
+	FILTER_LITERAL_TYPE_SINT,
+
+	/* Only for values greater than `INT64_MAX` */
+	FILTER_LITERAL_TYPE_UINT,
+
+	FILTER_LITERAL_TYPE_REAL,
+	FILTER_LITERAL_TYPE_STRING,
+};
+
+struct filter_literal {
+	enum filter_literal_type type;
+
+	union {
+		int64_t sint;
+		uint64_t uint;
+		double real;
+	} value;
+
+	/* Normalized star globbing pattern (`FILTER_LITERAL_TYPE_STRING`) */
+	GString *str;
+};
+
+enum filter_field_kind {
+	FILTER_FIELD_KIND_BOOL,
+	FILTER_FIELD_KIND_UINT,
+	FILTER_FIELD_KIND_SINT,
+	FILTER_FIELD_KIND_SINGLE,
+	FILTER_FIELD_KIND_DOUBLE,
+	FILTER_FIELD_KIND_STRING,
+};
+
+/* Result of comparing a field value with a literal: unordered */
+#define CMP_UNORDERED	2
+
+struct filter_node {
+	enum filter_node_type type;
+
+	/* `FILTER_NODE_TYPE_CONST` */
+	bool value;
+
+	/*
+	 * Operands (owned): `FILTER_NODE_TYPE_AND` and
+	 * `FILTER_NODE_TYPE_OR` (both), `FILTER_NODE_TYPE_NOT` (`left`).
+	 */
+	struct filter_node *left;
+	struct filter_node *right;
+
+	/* `FILTER_NODE_TYPE_NAME` */
+	enum filter_name name;
+
+	/* `FILTER_NODE_TYPE_FIELD` */
+	enum filter_scope scope;
+
+	/* Array of `char *` (member names, `FILTER_NODE_TYPE_FIELD`) */
+	GPtrArray *path;
+
+	/* `FILTER_NODE_TYPE_NAME` and `FILTER_NODE_TYPE_FIELD` */
+	enum filter_op op;
+	struct filter_literal literal;
+
+	/*
+	 * `FILTER_NODE_TYPE_RESOLVED_FIELD`: parsed field comparison
+	 * node (weak), member indexes (array of `uint64_t`) from the
+	 * root field of its scope, and kind of the compared field.
+	 */
+	const struct filter_node *field_node;
+	GArray *indexes;
+	enum filter_field_kind field_kind;
+};
+
+struct filter_expr {
+	struct filter_node *root;
+
+	/* Bitwise OR of the needed event field enumerators */
+	uint64_t needed_event_fields;
+};
+
+enum token_type {
+	TOKEN_TYPE_END,
+	TOKEN_TYPE_IDENT,
+	TOKEN_TYPE_STRING,
+	TOKEN_TYPE_NUMBER,
+	TOKEN_TYPE_LPAREN,
+	TOKEN_TYPE_RPAREN,
+	TOKEN_TYPE_LBRACKET,
+	TOKEN_TYPE_RBRACKET,
+	TOKEN_TYPE_COMMA,
+	TOKEN_TYPE_DOT,
+	TOKEN_TYPE_NOT,
+	TOKEN_TYPE_AND,
+	TOKEN_TYPE_OR,
+	TOKEN_TYPE_EQ,
+	TOKEN_TYPE_NE,
+	TOKEN_TYPE_LT,
+	TOKEN_TYPE_LE,
+	TOKEN_TYPE_GT,
+	TOKEN_TYPE_GE,
+};
+
+struct parser {
+	/* Whole expression */
+	const char *str;
+
+	/* Position following the current token */
+	const char *at;
+
+	/* Current token */
+	enum token_type token;
+	const char *token_begin;
+	size_t token_len;
+
+	/* Value of the current string or number token */
+	GString *token_str;
+	struct filter_literal token_number;
+
+	/* Error message (empty if none) */
+	GString *error;
+
+	uint64_t needed_event_fields;
+};
+
+static
+void set_error(struct parser *parser, const char *fmt, ...)
+{
+	va_list args;
+
+	if (parser->error->len > 0) {
+		/* Keep the first error */
+		return;
+	}
+
+	g_string_printf(parser->error, "At offset %td: ",
+		parser->token_begin - parser->str);
+	va_start(args, fmt);
+	g_string_append_vprintf(parser->error, fmt, args);
+	va_end(args);
+}
+
+static
+void destroy_node(struct filter_node *node)
+{
+	if (!node) {
+		return;
+	}
+
+	destroy_node(node->left);
+	destroy_node(node->right);
+
+	if (node->path) {
+		g_ptr_array_free(node->path, TRUE);
+	}
+
+	if (node->literal.str) {
+		g_string_free(node->literal.str, TRUE);
+	}
+
+	if (node->indexes) {
+		g_array_free(node->indexes, TRUE);
+	}
+
+	g_free(node);
+}
+
+static
+struct filter_node *create_node(enum filter_node_type type)
+{
+	struct filter_node *node = g_new0(struct filter_node, 1);
+
+	node->type = type;
+	return node;
+}
+
+static
+struct filter_node *create_const_node(bool value)
+{
+	struct filter_node *node = create_node(FILTER_NODE_TYPE_CONST);
+
+	node->value = value;
+	return node;
+}
+
+static
+struct filter_node *create_binary_node(enum filter_node_type type,
+		struct filter_node *left, struct filter_node *right)
+{
+	struct filter_node *node = create_node(type);
+
+	node->left = left;
+	node->right = right;
+	return node;
+}
+
+static inline
+bool is_ident_first_char(char ch)
+{
+	return g_ascii_isalpha(ch) || ch == '_';
+}
+
+static inline
+bool is_ident_char(char ch)
+{
+	return g_ascii_isalnum(ch) || ch == '_';
+}
+
+static
+bool lex_string(struct parser *parser)
+{
+	const char *at = parser->at + 1;
+
+	g_string_truncate(parser->token_str, 0);
+
+	while (*at != '"') {
+		if (*at == '\0') {
+			set_error(parser, "Unterminated string literal.");
+			return false;
+		}
+
+		if (at[0] == '\\' && at[1] == '"') {
+			g_string_append_c(parser->token_str, '"');
+			at += 2;
+			continue;
+		}
+
+		/* Keep other escape sequences for pattern matching */
+		if (at[0] == '\\' && at[1] != '\0') {
+			g_string_append_len(parser->token_str, at, 2);
+			at += 2;
+			continue;
+		}
+
+		g_string_append_c(parser->token_str, *at);
+		at++;
+	}
+
+	parser->token = TOKEN_TYPE_STRING;
+	parser->at = at + 1;
+	return true;
+}
+
+static
+bool lex_number(struct parser *parser)
+{
+	const char *begin = parser->at;
+	struct filter_literal *lit = &parser->token_number;
+	char *int_end;
+	char *real_end;
+	double real;
+	int int_errno;
+
+	real = g_ascii_strtod(begin, &real_end);
+	errno = 0;
+
+	if (*begin == '-') {
+		lit->type = FILTER_LITERAL_TYPE_SINT;
+		lit->value.sint = g_ascii_strtoll(begin, &int_end, 0);
+	} else {
+		uint64_t uint = g_ascii_strtoull(begin, &int_end, 0);
+
+		if (uint > INT64_MAX) {
+			lit->type = FILTER_LITERAL_TYPE_UINT;
+			lit->value.uint = uint;
+		} else {
+			lit->type = FILTER_LITERAL_TYPE_SINT;
+			lit->value.sint = (int64_t) uint;
+		}
+	}
+
+	int_errno = errno;
+
+	if (real_end > int_end) {
+		lit->type = FILTER_LITERAL_TYPE_REAL;
+		lit->value.real = real;
+		parser->at = real_end;
+	} else {
+		if (int_errno == ERANGE) {
+			set_error(parser, "Integer literal is out of range.");
+			return false;
+		}
+
+		parser->at = int_end;
+	}
+
+	if (is_ident_char(*parser->at) || *parser->at == '.') {
+		set_error(parser, "Invalid number literal.");
+		return false;
+	}
+
+	parser->token = TOKEN_TYPE_NUMBER;
+	return true;
+}
+
+/*
+ * Reads the next token of `parser`.
+ */
+static
+bool next_token(struct parser *parser)
+{
+	const char *at = parser->at;
+	bool ret = true;
+
+	while (g_ascii_isspace(*at)) {
+		at++;
+	}
+
+	parser->token_begin = at;
+	parser->at = at + 1;
+
+	switch (*at) {
+	case '\0':
+		parser->token = TOKEN_TYPE_END;
+		parser->at = at;
+		break;
+	case '(':
+		parser->token = TOKEN_TYPE_LPAREN;
+		break;
+	case ')':
+		parser->token = TOKEN_TYPE_RPAREN;
+		break;
+	case '[':
+		parser->token = TOKEN_TYPE_LBRACKET;
+		break;
+	case ']':
+		parser->token = TOKEN_TYPE_RBRACKET;
+		break;
+	case ',':
+		parser->token = TOKEN_TYPE_COMMA;
+		break;
+	case '.':
+		parser->token = TOKEN_TYPE_DOT;
+		break;
+	case '!':
+		if (at[1] == '=') {
+			parser->token = TOKEN_TYPE_NE;
+			parser->at = at + 2;
+		} else {
+			parser->token = TOKEN_TYPE_NOT;
+		}
+
+		break;
+	case '&':
+		if (at[1] != '&') {
+			set_error(parser, "Expecting `&&`.");
+			ret = false;
+			goto end;
+		}
+
+		parser->token = TOKEN_TYPE_AND;
+		parser->at = at + 2;
+		break;
+	case '|':
+		if (at[1] != '|') {
+			set_error(parser, "Expecting `||`.");
+			ret = false;
+			goto end;
+		}
+
+		parser->token = TOKEN_TYPE_OR;
+		parser->at = at + 2;
+		break;
+	case '=':
+		if (at[1] != '=') {
+			set_error(parser, "Expecting `==`.");
+			ret = false;
+			goto end;
+		}
+
+		parser->token = TOKEN_TYPE_EQ;
+		parser->at = at + 2;
+		break;
+	case '<':
+		if (at[1] == '=') {
+			parser->token = TOKEN_TYPE_LE;
+			parser->at = at + 2;
+		} else {
+			parser->token = TOKEN_TYPE_LT;
+		}
+
+		break;
+	case '>':
+		if (at[1] == '=') {
+			parser->token = TOKEN_TYPE_GE;
+			parser->at = at + 2;
+		} else {
+			parser->token = TOKEN_TYPE_GT;
+		}
+
+		break;
+	case '"':
+		parser->at = at;
+		ret = lex_string(parser);
+		break;
+	default:
+		if (g_ascii_isdigit(*at) ||
+				(*at == '-' && g_ascii_isdigit(at[1]))) {
+			parser->at = at;
+			ret = lex_number(parser);
+		} else if (is_ident_first_char(*at)) {
+			while (is_ident_char(*parser->at)) {
+				parser->at++;
+			}
+
+			parser->token = TOKEN_TYPE_IDENT;
+		} else {
+			set_error(parser, "Unexpected character `%c`.", *at);
+			ret = false;
+		}
+	}
+
+end:
+	parser->token_len = parser->at - parser->token_begin;
+	return ret;
+}
+
+static inline
+bool token_is_ident(struct parser *parser, const char *ident)
+{
+	return parser->token == TOKEN_TYPE_IDENT &&
+		parser->token_len == strlen(ident) &&
+		strncmp(parser->token_begin, ident, parser->token_len) == 0;
+}
+
+static
+bool token_to_op(struct parser *parser, enum filter_op *op)
+{
+	switch (parser->token) {
+	case TOKEN_TYPE_EQ:
+		*op = FILTER_OP_EQ;
+		break;
+	case TOKEN_TYPE_NE:
+		*op = FILTER_OP_NE;
+		break;
+	case TOKEN_TYPE_LT:
+		*op = FILTER_OP_LT;
+		break;
+	case TOKEN_TYPE_LE:
+		*op = FILTER_OP_LE;
+		break;
+	case TOKEN_TYPE_GT:
+		*op = FILTER_OP_GT;
+		break;
+	case TOKEN_TYPE_GE:
+		*op = FILTER_OP_GE;
+		break;
+	default:
+		set_error(parser, "Expecting a comparison operator.");
+		return false;
+	}
+
+	return true;
+}
+
+static
+void set_string_literal(struct filter_literal *lit, const char *str)
+{
+	lit->type = FILTER_LITERAL_TYPE_STRING;
+	lit->str = g_string_new(str);
+	bt_common_normalize_star_glob_pattern(lit->str->str);
+	g_string_set_size(lit->str, strlen(lit->str->str));
+}
+
+/*
+ * Parses the literal of a field comparison into `lit`.
+ */
+static
+bool parse_field_literal(struct parser *parser, enum filter_op op,
+		struct filter_literal *lit)
+{
+	if (parser->token == TOKEN_TYPE_STRING) {
+		if (op != FILTER_OP_EQ && op != FILTER_OP_NE) {
+			set_error(parser,
+				"Only `==` and `!=` can compare with a string literal.");
+			return false;
+		}
+
+		set_string_literal(lit, parser->token_str->str);
+	} else if (parser->token == TOKEN_TYPE_NUMBER) {
+		*lit = parser->token_number;
+	} else if (token_is_ident(parser, "true") ||
+			token_is_ident(parser, "false")) {
+		lit->type = FILTER_LITERAL_TYPE_SINT;
+		lit->value.sint = token_is_ident(parser, "true");
+	} else {
+		set_error(parser, "Expecting a literal.");
+		return false;
+	}
+
+	return next_token(parser);
+}
+
+static
+bool parse_number(struct parser *parser, struct filter_literal *lit)
+{
+	if (parser->token != TOKEN_TYPE_NUMBER) {
+		set_error(parser, "Expecting a number literal.");
+		return false;
+	}
+
+	*lit = parser->token_number;
+	return next_token(parser);
+}
+
+static
+bool expect_token(struct parser *parser, enum token_type type,
+		const char *what)
+{
+	if (parser->token != type) {
+		set_error(parser, "Expecting `%s`.", what);
+		return false;
+	}
+
+	return next_token(parser);
+}
+
+static
+struct filter_node *create_field_node(enum filter_scope scope,
+		GPtrArray *path, enum filter_op op)
+{
+	struct filter_node *node = create_node(FILTER_NODE_TYPE_FIELD);
+	guint i;
+
+	node->scope = scope;
+	node->op = op;
+	node->path = g_ptr_array_new_with_free_func(g_free);
+
+	for (i = 0; i < path->len; i++) {
+		g_ptr_array_add(node->path, g_strdup(path->pdata[i]));
+	}
+
+	return node;
+}
+
+/*
+ * Parses a field comparison, the current token being its scope name.
+ */
+static
+struct filter_node *parse_field_comparison(struct parser *parser,
+		enum filter_scope scope)
+{
+	struct filter_node *node = NULL;
+	GPtrArray *path = g_ptr_array_new_with_free_func(g_free);
+	enum filter_op op;
+
+	if (!next_token(parser)) {
+		goto error;
+	}
+
+	do {
+		if (!expect_token(parser, TOKEN_TYPE_DOT, ".")) {
+			goto error;
+		}
+
+		if (parser->token != TOKEN_TYPE_IDENT) {
+			set_error(parser, "Expecting a member name.");
+			goto error;
+		}
+
+		g_ptr_array_add(path,
+			g_strndup(parser->token_begin, parser->token_len));
+
+		if (!next_token(parser)) {
+			goto error;
+		}
+	} while (parser->token == TOKEN_TYPE_DOT);
+
+	if (token_is_ident(parser, "in")) {
+		/* `in [LOWER, UPPER]` is `>= LOWER && <= UPPER` */
+		struct filter_node *lower;
+		struct filter_node *upper;
+
+		lower = create_field_node(scope, path, FILTER_OP_GE);
+		upper = create_field_node(scope, path, FILTER_OP_LE);
+		node = create_binary_node(FILTER_NODE_TYPE_AND, lower, upper);
+
+		if (!next_token(parser) ||
+				!expect_token(parser, TOKEN_TYPE_LBRACKET, "[") ||
+				!parse_number(parser, &lower->literal) ||
+				!expect_token(parser, TOKEN_TYPE_COMMA, ",") ||
+				!parse_number(parser, &upper->literal) ||
+				!expect_token(parser, TOKEN_TYPE_RBRACKET, "]")) {
+			goto error;
+		}
+	} else {
+		if (!token_to_op(parser, &op)) {
+			goto error;
+		}
+
+		node = create_field_node(scope, path, op);
+
+		if (!next_token(parser) ||
+				!parse_field_literal(parser, op, &node->literal)) {
+			goto error;
+		}
+	}
+
+	switch (scope) {
+	case FILTER_SCOPE_COMMON_CONTEXT:
+		parser->needed_event_fields |=
+			BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_COMMON_CONTEXT;
+		break;
+	case FILTER_SCOPE_SPECIFIC_CONTEXT:
+		parser->needed_event_fields |=
+			BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_SPECIFIC_CONTEXT;
+		break;
+	case FILTER_SCOPE_PAYLOAD:
+		parser->needed_event_fields |=
+			BT_SELF_COMPONENT_PORT_INPUT_NEEDED_EVENT_FIELDS_PAYLOAD;
+		break;
+	default:
+		break;
+	}
+
+	goto end;
+
+error:
+	destroy_node(node);
+	node = NULL;
+
+end:
+	g_ptr_array_free(path, TRUE);
+	return node;
+}
+
+/*
+ * Parses a name comparison, the current token being the comparison
+ * operator.
+ */
+static
+struct filter_node *parse_name_comparison(struct parser *parser,
+		enum filter_name name)
+{
+	struct filter_node *node = create_node(FILTER_NODE_TYPE_NAME);
+
+	node->name = name;
+
+	if (parser->token == TOKEN_TYPE_EQ) {
+		node->op = FILTER_OP_EQ;
+	} else if (parser->token == TOKEN_TYPE_NE) {
+		node->op = FILTER_OP_NE;
+	} else {
+		set_error(parser, "Expecting `==` or `!=`.");
+		goto error;
+	}
+
+	if (!next_token(parser)) {
+		goto error;
+	}
+
+	if (parser->token != TOKEN_TYPE_STRING) {
+		set_error(parser, "Expecting a string literal.");
+		goto error;
+	}
+
+	set_string_literal(&node->literal, parser->token_str->str);
+
+	if (!next_token(parser)) {
+		goto error;
+	}
+
+	goto end;
+
+error:
+	destroy_node(node);
+	node = NULL;
+
+end:
+	return node;
+}
+
+static
+struct filter_node *parse_or(struct parser *parser);
+
+static
+struct filter_node *parse_primary(struct parser *parser)
+{
+	struct filter_node *node = NULL;
+
+	if (parser->token == TOKEN_TYPE_LPAREN) {
+		if (!next_token(parser)) {
+			goto end;
+		}
+
+		node = parse_or(parser);
+		if (!node) {
+			goto end;
+		}
+
+		if (!expect_token(parser, TOKEN_TYPE_RPAREN, ")")) {
+			destroy_node(node);
+			node = NULL;
+		}
+	} else if (token_is_ident(parser, "true") ||
+			token_is_ident(parser, "false")) {
+		node = create_const_node(token_is_ident(parser, "true"));
+
+		if (!next_token(parser)) {
+			destroy_node(node);
+			node = NULL;
+		}
+	} else if (token_is_ident(parser, "name")) {
+		if (next_token(parser)) {
+			node = parse_name_comparison(parser, FILTER_NAME_EVENT);
+		}
+	} else if (token_is_ident(parser, "stream") ||
+			token_is_ident(parser, "trace")) {
+		enum filter_name name = token_is_ident(parser, "stream") ?
+			FILTER_NAME_STREAM : FILTER_NAME_TRACE;
+
+		if (!next_token(parser) ||
+				!expect_token(parser, TOKEN_TYPE_DOT, ".")) {
+			goto end;
+		}
+
+		if (!token_is_ident(parser, "name")) {
+			set_error(parser, "Expecting `name`.");
+			goto end;
+		}
+
+		if (next_token(parser)) {
+			node = parse_name_comparison(parser, name);
+		}
+	} else if (token_is_ident(parser, "packet_context")) {
+		node = parse_field_comparison(parser,
+			FILTER_SCOPE_PACKET_CONTEXT);
+	} else if (token_is_ident(parser, "common_context")) {
+		node = parse_field_comparison(parser,
+			FILTER_SCOPE_COMMON_CONTEXT);
+	} else if (token_is_ident(parser, "specific_context")) {
+		node = parse_field_comparison(parser,
+			FILTER_SCOPE_SPECIFIC_CONTEXT);
+	} else if (token_is_ident(parser, "payload")) {
+		node = parse_field_comparison(parser, FILTER_SCOPE_PAYLOAD);
+	} else if (parser->token == TOKEN_TYPE_END) {
+		set_error(parser, "Unexpected end of expression.");
+	} else {
+		set_error(parser, "Unexpected token `%.*s`.",
+			(int) parser->token_len, parser->token_begin);
+	}
+
+end:
+	return node;
+}
+
+static
+struct filter_node *parse_not(struct parser *parser)
+{
+	struct filter_node *operand;
+
+	if (parser->token != TOKEN_TYPE_NOT) {
+		return parse_primary(parser);
+	}
+
+	if (!next_token(parser)) {
+		return NULL;
+	}
+
+	operand = parse_not(parser);
+	if (!operand) {
+		return NULL;
+	}
+
+	return create_binary_node(FILTER_NODE_TYPE_NOT, operand, NULL);
+}
+
+static
+struct filter_node *parse_and(struct parser *parser)
+{
+	struct filter_node *node = parse_not(parser);
+
+	while (node && parser->token == TOKEN_TYPE_AND) {
+		struct filter_node *right;
+
+		if (!next_token(parser)) {
+			goto error;
+		}
+
+		right = parse_not(parser);
+		if (!right) {
+			goto error;
+		}
+
+		node = create_binary_node(FILTER_NODE_TYPE_AND, node, right);
+	}
+
+	return node;
+
+error:
+	destroy_node(node);
+	return NULL;
+}
+
+static
+struct filter_node *parse_or(struct parser *parser)
+{
+	struct filter_node *node = parse_and(parser);
+
+	while (node && parser->token == TOKEN_TYPE_OR) {
+		struct filter_node *right;
+
+		if (!next_token(parser)) {
+			goto error;
+		}
+
+		right = parse_and(parser);
+		if (!right) {
+			goto error;
+		}
+
+		node = create_binary_node(FILTER_NODE_TYPE_OR, node, right);
+	}
+
+	return node;
+
+error:
+	destroy_node(node);
+	return NULL;
+}
+
+struct filter_expr *filter_expr_parse(const char *str, GString *error)
+{
+	struct parser parser = {
+		.str = str,
+		.at = str,
+		.token_str = g_string_new(NULL),
+		.error = error,
+	};
+	struct filter_node *root = NULL;
+	struct filter_expr *expr = NULL;
+
+	BT_ASSERT(str);
+	BT_ASSERT(error);
+	g_string_truncate(error, 0);
+
+	if (!next_token(&parser)) {
+		goto end;
+	}
+
+	root = parse_or(&parser);
+	if (!root) {
+		goto end;
+	}
+
+	if (parser.token != TOKEN_TYPE_END) {
+		set_error(&parser, "Unexpected token `%.*s`.",
+			(int) parser.token_len, parser.token_begin);
+		destroy_node(root);
+		goto end;
+	}
+
+	expr = g_new0(struct filter_expr, 1);
+	expr->root = root;
+	expr->needed_event_fields = parser.needed_event_fields;
+
+end:
+	g_string_free(parser.token_str, TRUE);
+	return expr;
+}
+
+void filter_expr_destroy(struct filter_expr *expr)
+{
+	if (!expr) {
+		return;
+	}
+
+	destroy_node(expr->root);
+	g_free(expr);
+}
+
+uint64_t filter_expr_get_needed_event_fields(const struct filter_expr *expr)
+{
+	BT_ASSERT(expr);
+	return expr->needed_event_fields;
+}
+
+static
+bool match_name(const struct filter_node *node, const char *name)
+{
+	bool match = false;
+
+	if (name) {
+		match = bt_common_star_glob_match(node->literal.str->str,
+			node->literal.str->len, name, strlen(name));
+	}
+
+	return node->op == FILTER_OP_EQ ? match : !match;
+}
+
+static
+const char *borrow_name(const struct filter_node *node,
+		const bt_stream *stream, const bt_event_class *event_class)
+{
+	switch (node->name) {
+	case FILTER_NAME_EVENT:
+		return bt_event_class_get_name(event_class);
+	case FILTER_NAME_STREAM:
+		return bt_stream_get_name(stream);
+	case FILTER_NAME_TRACE:
+		return bt_trace_get_name(bt_stream_borrow_trace_const(stream));
+	default:
+		bt_common_abort();
+	}
+}
+
+static
+const bt_field_class *borrow_scope_field_class(enum filter_scope scope,
+		const bt_stream *stream, const bt_event_class *event_class)
+{
+	const bt_stream_class *stream_class = bt_stream_borrow_class_const(stream);
+
+	switch (scope) {
+	case FILTER_SCOPE_PACKET_CONTEXT:
+		return bt_stream_class_borrow_packet_context_field_class_const(
+			stream_class);
+	case FILTER_SCOPE_COMMON_CONTEXT:
+		return bt_stream_class_borrow_event_common_context_field_class_const(
+			stream_class);
+	case FILTER_SCOPE_SPECIFIC_CONTEXT:
+		return bt_event_class_borrow_specific_context_field_class_const(
+			event_class);
+	case FILTER_SCOPE_PAYLOAD:
+		return bt_event_class_borrow_payload_field_class_const(
+			event_class);
+	default:
+		bt_common_abort();
+	}
+}
+
+/*
+ * Returns the index of the member named `name` of the structure field
+ * class `fc`, or -1 if there's none.
+ */
+static
+int64_t find_member_index(const bt_field_class *fc, const char *name)
+{
+	uint64_t count = bt_field_class_structure_get_member_count(fc);
+	uint64_t i;
+
+	for (i = 0; i < count; i++) {
+		const bt_field_class_structure_member *member =
+			bt_field_class_structure_borrow_member_by_index_const(fc, i);
+
+		if (strcmp(bt_field_class_structure_member_get_name(member),
+				name) == 0) {
+			return (int64_t) i;
+		}
+	}
+
+	return -1;
+}
+
+/*
+ * Resolves the field comparison node `node` for the event class
+ * `event_class` within the stream `stream`.
+ *
+ * Returns a constant false node if the field doesn't exist or if its
+ * type isn't compatible with the literal.
+ */
+static
+struct filter_node *resolve_field_node(const struct filter_node *node,
+		const bt_stream *stream, const bt_event_class *event_class)
+{
+	struct filter_node *resolved = NULL;
+	const bt_field_class *fc;
+	bt_field_class_type fc_type;
+	GArray *indexes = NULL;
+	enum filter_field_kind kind;
+	guint i;
+
+	fc = borrow_scope_field_class(node->scope, stream, event_class);
+	if (!fc) {
+		goto no_field;
+	}
+
+	indexes = g_array_sized_new(FALSE, FALSE, sizeof(uint64_t),
+		node->path->len);
+
+	for (i = 0; i < node->path->len; i++) {
+		int64_t index;
+		uint64_t uindex;
+
+		if (bt_field_class_get_type(fc) != BT_FIELD_CLASS_TYPE_STRUCTURE) {
+			goto no_field;
+		}
+
+		index = find_member_index(fc, node->path->pdata[i]);
+		if (index < 0) {
+			goto no_field;
+		}
+
+		uindex = (uint64_t) index;
+		g_array_append_val(indexes, uindex);
+		fc = bt_field_class_structure_member_borrow_field_class_const(
+			bt_field_class_structure_borrow_member_by_index_const(fc,
+				uindex));
+	}
+
+	fc_type = bt_field_class_get_type(fc);
+
+	if (fc_type == BT_FIELD_CLASS_TYPE_BOOL) {
+		kind = FILTER_FIELD_KIND_BOOL;
+	} else if (bt_field_class_type_is(fc_type,
+			BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER)) {
+		kind = FILTER_FIELD_KIND_UINT;
+	} else if (bt_field_class_type_is(fc_type,
+			BT_FIELD_CLASS_TYPE_SIGNED_INTEGER)) {
+		kind = FILTER_FIELD_KIND_SINT;
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL) {
+		kind = FILTER_FIELD_KIND_SINGLE;
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL) {
+		kind = FILTER_FIELD_KIND_DOUBLE;
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_STRING) {
+		kind = FILTER_FIELD_KIND_STRING;
+	} else {
+		goto no_field;
+	}
+
+	if ((kind == FILTER_FIELD_KIND_STRING) !=
+			(node->literal.type == FILTER_LITERAL_TYPE_STRING)) {
+		goto no_field;
+	}
+
+	resolved = create_node(FILTER_NODE_TYPE_RESOLVED_FIELD);
+	resolved->field_node = node;
+	resolved->indexes = indexes;
+	resolved->field_kind = kind;
+	goto end;
+
+no_field:
+	if (indexes) {
+		g_array_free(indexes, TRUE);
+	}
+
+	resolved = create_const_node(false);
+
+end:
+	return resolved;
+}
+
+/*
+ * Partially evaluates `node` for the event class `event_class` within
+ * the stream `stream`, returning a new node.
+ */
+static
+struct filter_node *compile_node(const struct filter_node *node,
+		const bt_stream *stream, const bt_event_class *event_class)
+{
+	struct filter_node *left;
+	struct filter_node *right;
+
+	switch (node->type) {
+	case FILTER_NODE_TYPE_CONST:
+		return create_const_node(node->value);
+	case FILTER_NODE_TYPE_AND:
+	case FILTER_NODE_TYPE_OR:
+	{
+		/* Value which decides the outcome by itself */
+		bool absorbing = node->type == FILTER_NODE_TYPE_OR;
+
+		left = compile_node(node->left, stream, event_class);
+		if (left->type == FILTER_NODE_TYPE_CONST) {
+			if (left->value == absorbing) {
+				return left;
+			}
+
+			destroy_node(left);
+			return compile_node(node->right, stream, event_class);
+		}
+
+		right = compile_node(node->right, stream, event_class);
+		if (right->type == FILTER_NODE_TYPE_CONST) {
+			if (right->value == absorbing) {
+				destroy_node(left);
+				return right;
+			}
+
+			destroy_node(right);
+			return left;
+		}
+
+		return create_binary_node(node->type, left, right);
+	}
+	case FILTER_NODE_TYPE_NOT:
+		left = compile_node(node->left, stream, event_class);
+		if (left->type == FILTER_NODE_TYPE_CONST) {
+			left->value = !left->value;
+			return left;
+		}
+
+		return create_binary_node(FILTER_NODE_TYPE_NOT, left, NULL);
+	case FILTER_NODE_TYPE_NAME:
+		return create_const_node(match_name(node,
+			borrow_name(node, stream, event_class)));
+	case FILTER_NODE_TYPE_FIELD:
+		return resolve_field_node(node, stream, event_class);
+	default:
+		bt_common_abort();
+	}
+}
+
+struct filter_decision *filter_expr_compile(const struct filter_expr *expr,
+		const bt_stream *stream, const bt_event_class *event_class)
+{
+	struct filter_decision *decision = g_new0(struct filter_decision, 1);
+	struct filter_node *residual;
+
+	BT_ASSERT(expr);
+	BT_ASSERT(stream);
+	BT_ASSERT(event_class);
+	residual = compile_node(expr->root, stream, event_class);
+
+	if (residual->type == FILTER_NODE_TYPE_CONST) {
+		decision->type = residual->value ?
+			FILTER_DECISION_TYPE_ACCEPT :
+			FILTER_DECISION_TYPE_REJECT;
+		destroy_node(residual);
+	} else {
+		decision->type = FILTER_DECISION_TYPE_EVALUATE;
+		decision->residual = residual;
+	}
+
+	return decision;
+}
+
+void filter_decision_destroy(struct filter_decision *decision)
+{
+	if (!decision) {
+		return;
+	}
+
+	destroy_node(decision->residual);
+	g_free(decision);
+}
+
+static inline
+int compare_reals(double a, double b)
+{
+	if (a < b) {
+		return -1;
+	} else if (a > b) {
+		return 1;
+	} else if (a == b) {
+		return 0;
+	}
+
+	/* At least one NaN */
+	return CMP_UNORDERED;
+}
+
+static inline
+int compare_uint(uint64_t value, const struct filter_literal *lit)
+{
+	switch (lit->type) {
+	case FILTER_LITERAL_TYPE_SINT:
+		if (lit->value.sint < 0) {
+			return 1;
+		}
+
+		return value < (uint64_t) lit->value.sint ? -1 :
+			value > (uint64_t) lit->value.sint;
+	case FILTER_LITERAL_TYPE_UINT:
+		return value < lit->value.uint ? -1 : value > lit->value.uint;
+	case FILTER_LITERAL_TYPE_REAL:
+		return compare_reals((double) value, lit->value.real);
+	default:
+		bt_common_abort();
+	}
+}
+
+static inline
+int compare_sint(int64_t value, const struct filter_literal *lit)
+{
+	switch (lit->type) {
+	case FILTER_LITERAL_TYPE_SINT:
+		return value < lit->value.sint ? -1 : value > lit->value.sint;
+	case FILTER_LITERAL_TYPE_UINT:
+		/* Literal is greater than `INT64_MAX` */
+		return -1;
+	case FILTER_LITERAL_TYPE_REAL:
+		return compare_reals((double) value, lit->value.real);
+	default:
+		bt_common_abort();
+	}
+}
+
+static inline
+int compare_real(double value, const struct filter_literal *lit)
+{
+	switch (lit->type) {
+	case FILTER_LITERAL_TYPE_SINT:
+		return compare_reals(value, (double) lit->value.sint);
+	case FILTER_LITERAL_TYPE_UINT:
+		return compare_reals(value, (double) lit->value.uint);
+	case FILTER_LITERAL_TYPE_REAL:
+		return compare_reals(value, lit->value.real);
+	default:
+		bt_common_abort();
+	}
+}
+
+static inline
+bool op_result(enum filter_op op, int cmp)
+{
+	switch (op) {
+	case FILTER_OP_EQ:
+		return cmp == 0;
+	case FILTER_OP_NE:
+		return cmp != 0;
+	case FILTER_OP_LT:
+		return cmp == -1;
+	case FILTER_OP_LE:
+		return cmp == -1 || cmp == 0;
+	case FILTER_OP_GT:
+		return cmp == 1;
+	case FILTER_OP_GE:
+		return cmp == 1 || cmp == 0;
+	default:
+		bt_common_abort();
+	}
+}
+
+static
+const bt_field *borrow_scope_field(enum filter_scope scope,
+		const bt_event *event)
+{
+	switch (scope) {
+	case FILTER_SCOPE_PACKET_CONTEXT:
+	{
+		const bt_packet *packet = bt_event_borrow_packet_const(event);
+
+		return packet ? bt_packet_borrow_context_field_const(packet) :
+			NULL;
+	}
+	case FILTER_SCOPE_COMMON_CONTEXT:
+		return bt_event_borrow_common_context_field_const(event);
+	case FILTER_SCOPE_SPECIFIC_CONTEXT:
+		return bt_event_borrow_specific_context_field_const(event);
+	case FILTER_SCOPE_PAYLOAD:
+		return bt_event_borrow_payload_field_const(event);
+	default:
+		bt_common_abort();
+	}
+}
+
+static
+bool evaluate_field(const struct filter_node *node, const bt_event *event)
+{
+	const struct filter_node *field_node = node->field_node;
+	const struct filter_literal *lit = &field_node->literal;
+	const bt_field *field;
+	guint i;
+	int cmp;
+
+	field = borrow_scope_field(field_node->scope, event);
+	if (!field) {
+		return false;
+	}
+
+	for (i = 0; i < node->indexes->len; i++) {
+		field = bt_field_structure_borrow_member_field_by_index_const(
+			field, bt_g_array_index(node->indexes, uint64_t, i));
+	}
+
+	switch (node->field_kind) {
+	case FILTER_FIELD_KIND_BOOL:
+		cmp = compare_uint(bt_field_bool_get_value(field) ? 1 : 0, lit);
+		break;
+	case FILTER_FIELD_KIND_UINT:
+		cmp = compare_uint(bt_field_integer_unsigned_get_value(field),
+			lit);
+		break;
+	case FILTER_FIELD_KIND_SINT:
+		cmp = compare_sint(bt_field_integer_signed_get_value(field),
+			lit);
+		break;
+	case FILTER_FIELD_KIND_SINGLE:
+		cmp = compare_real(
+			(double) bt_field_real_single_precision_get_value(field),
+			lit);
+		break;
+	case FILTER_FIELD_KIND_DOUBLE:
+		cmp = compare_real(
+			bt_field_real_double_precision_get_value(field), lit);
+		break;
+	case FILTER_FIELD_KIND_STRING:
+	{
+		bool match = bt_common_star_glob_match(lit->str->str,
+			lit->str->len, bt_field_string_get_value(field),
+			bt_field_string_get_length(field));
+
+		return field_node->op == FILTER_OP_EQ ? match : !match;
+	}
+	default:
+		bt_common_abort();
+	}
+
+	return op_result(field_node->op, cmp);
+}
+
+static
+bool evaluate_node(const struct filter_node *node, const bt_event *event)
+{
+	switch (node->type) {
+	case FILTER_NODE_TYPE_CONST:
+		return node->value;
+	case FILTER_NODE_TYPE_AND:
+		return evaluate_node(node->left, event) &&
+			evaluate_node(node->right, event);
+	case FILTER_NODE_TYPE_OR:
+		return evaluate_node(node->left, event) ||
+			evaluate_node(node->right, event);
+	case FILTER_NODE_TYPE_NOT:
+		return !evaluate_node(node->left, event);
+	case FILTER_NODE_TYPE_RESOLVED_FIELD:
+		return evaluate_field(node, event);
+	default:
+		bt_common_abort();
+	}
+}
+
+bool filter_decision_evaluate(const struct filter_decision *decision,
+		const bt_event *event)
+{
+	BT_ASSERT_DBG(decision->type == FILTER_DECISION_TYPE_EVALUATE);
+	return evaluate_node(decision->residual, event);
+}
@@ -0,0 +1,84 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_FILTER_EXPR_H
+#define BABELTRACE_PLUGINS_UTILS_FILTER_EXPR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <glib.h>
+#include <babeltrace2/babeltrace.h>
+
+/* Parsed filter expression */
+struct filter_expr;
+
+/* Expression node (opaque) */
+struct filter_node;
+
+enum filter_decision_type {
+	/* Accept all the events of the event class */
+	FILTER_DECISION_TYPE_ACCEPT,
+
+	/* Reject all the events of the event class */
+	FILTER_DECISION_TYPE_REJECT,
+
+	/* Evaluate the residual expression for each event */
+	FILTER_DECISION_TYPE_EVALUATE,
+};
+
+/*
+ * Decision of a filter expression for the events of a given event
+ * class within a given stream.
+ */
+struct filter_decision {
+	enum filter_decision_type type;
+
+	/*
+	 * Residual expression, with resolved field paths (owned by this;
+	 * `FILTER_DECISION_TYPE_EVALUATE` only).
+	 */
+	struct filter_node *residual;
+};
+
+/*
+ * Parses the filter expression `str`.
+ *
+ * On error, returns `NULL` and sets `error` to the error message.
+ */
+struct filter_expr *filter_expr_parse(const char *str, GString *error);
+
+void filter_expr_destroy(struct filter_expr *expr);
+
+/*
+ * Returns the event fields which `expr` refers to, a bitwise OR of
+ * `bt_self_component_port_input_needed_event_fields` enumerators.
+ */
+uint64_t filter_expr_get_needed_event_fields(const struct filter_expr *expr);
+
+/*
+ * Compiles `expr` for the events of the event class `event_class`
+ * within the stream `stream`.
+ *
+ * The names of the event class, of the stream, and of its trace are
+ * known at this point, as well as the field classes of the event
+ * class: the returned decision only contains a residual expression
+ * when the outcome depends on event field values.
+ *
+ * `expr` must exist as long as the returned decision exists.
+ */
+struct filter_decision *filter_expr_compile(const struct filter_expr *expr,
+		const bt_stream *stream, const bt_event_class *event_class);
+
+void filter_decision_destroy(struct filter_decision *decision);
+
+/*
+ * Evaluates the residual expression of `decision` for the event
+ * `event`.
+ */
+bool filter_decision_evaluate(const struct filter_decision *decision,
+		const bt_event *event);
+
+#endif /* BABELTRACE_PLUGINS_UTILS_FILTER_EXPR_H */
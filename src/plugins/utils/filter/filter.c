@@ -0,0 +1,547 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS Inc.
+ */
+
+#define BT_COMP_LOG_SELF_COMP (filter_comp->self_comp)
+#define BT_LOG_OUTPUT_LEVEL (filter_comp->log_level)
+#define BT_LOG_TAG "PLUGIN/FLT.UTILS.FILTER"
+#include "logging/comp-logging.h"
+
+#include "filter.h"
+#include "expr.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "common/common.h"
+#include "common/assert.h"
+#include <babeltrace2/babeltrace.h>
+#include <glib.h>
+#include "plugins/common/param-validation/param-validation.h"
+
+static const char * const in_port_name = "in";
+
+struct filter_comp {
+	bt_logging_level log_level;
+	bt_self_component *self_comp;
+	bt_self_component_filter *self_comp_filter;
+
+	/* Owned by this */
+	struct filter_expr *expr;
+};
+
+struct filter_stream_state {
+	/* Owned by this */
+	const bt_stream *stream;
+
+	/*
+	 * `const bt_event_class *` (weak) ->
+	 * `struct filter_decision *` (owned by this)
+	 */
+	GHashTable *decisions;
+};
+
+struct filter_iterator {
+	/* Weak */
+	struct filter_comp *filter_comp;
+
+	/* Owned by this */
+	bt_message_iterator *upstream_iter;
+
+	/*
+	 * Current upstream message batch: the messages at and after
+	 * `upstream_msg_index` aren't consumed yet (this owns their
+	 * references).
+	 */
+	bt_message_array_const upstream_msgs;
+	uint64_t upstream_msg_count;
+	uint64_t upstream_msg_index;
+
+	/*
+	 * `const bt_stream *` (weak, the stream state owns a reference) ->
+	 * `struct filter_stream_state *` (owned by this)
+	 */
+	GHashTable *stream_states;
+
+	/* Stream state of the last event message (weak) */
+	struct filter_stream_state *last_stream_state;
+
+	uint64_t accepted_event_count;
+	uint64_t rejected_event_count;
+};
+
+static
+void destroy_filter_comp(struct filter_comp *filter_comp)
+{
+	if (!filter_comp) {
+		return;
+	}
+
+	filter_expr_destroy(filter_comp->expr);
+	g_free(filter_comp);
+}
+
+static
+struct bt_param_validation_map_value_entry_descr filter_params[] = {
+	{ "expression", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_MANDATORY, { .type = BT_VALUE_TYPE_STRING } },
+	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
+};
+
+static
+bt_component_class_initialize_method_status init_filter_comp_from_params(
+		struct filter_comp *filter_comp, const bt_value *params)
+{
+	bt_component_class_initialize_method_status status;
+	enum bt_param_validation_status validation_status;
+	gchar *validate_error = NULL;
+	GString *parse_error = NULL;
+	const char *expr_str;
+
+	validation_status = bt_param_validation_validate(params,
+		filter_params, &validate_error);
+	if (validation_status == BT_PARAM_VALIDATION_STATUS_MEMORY_ERROR) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto end;
+	} else if (validation_status == BT_PARAM_VALIDATION_STATUS_VALIDATION_ERROR) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		BT_COMP_LOGE_APPEND_CAUSE(filter_comp->self_comp, "%s",
+			validate_error);
+		goto end;
+	}
+
+	expr_str = bt_value_string_get(
+		bt_value_map_borrow_entry_value_const(params, "expression"));
+	parse_error = g_string_new(NULL);
+	filter_comp->expr = filter_expr_parse(expr_str, parse_error);
+	if (!filter_comp->expr) {
+		BT_COMP_LOGE_APPEND_CAUSE(filter_comp->self_comp,
+			"Invalid `expression` parameter: %s: expr=\"%s\"",
+			parse_error->str, expr_str);
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto end;
+	}
+
+	BT_COMP_LOGI("Parsed filter expression: expr=\"%s\", "
+		"needed-event-fields=%#" PRIx64, expr_str,
+		filter_expr_get_needed_event_fields(filter_comp->expr));
+	status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
+
+end:
+	g_free(validate_error);
+
+	if (parse_error) {
+		g_string_free(parse_error, TRUE);
+	}
+
+	return status;
+}
+
+bt_component_class_initialize_method_status filter_init(
+		bt_self_component_filter *self_comp_flt,
+		bt_self_component_filter_configuration *config __attribute__((unused)),
+		const bt_value *params,
+		void *init_method_data __attribute__((unused)))
+{
+	bt_component_class_initialize_method_status status;
+	bt_self_component_add_port_status add_port_status;
+	struct filter_comp *filter_comp = g_new0(struct filter_comp, 1);
+	bt_self_component *self_comp =
+		bt_self_component_filter_as_self_component(self_comp_flt);
+
+	if (!filter_comp) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	}
+
+	filter_comp->log_level = bt_component_get_logging_level(
+		bt_self_component_as_component(self_comp));
+	filter_comp->self_comp = self_comp;
+	filter_comp->self_comp_filter = self_comp_flt;
+
+	add_port_status = bt_self_component_filter_add_input_port(
+		self_comp_flt, in_port_name, NULL, NULL);
+	if (add_port_status != BT_SELF_COMPONENT_ADD_PORT_STATUS_OK) {
+		status = (int) add_port_status;
+		goto error;
+	}
+
+	add_port_status = bt_self_component_filter_add_output_port(
+		self_comp_flt, "out", NULL, NULL);
+	if (add_port_status != BT_SELF_COMPONENT_ADD_PORT_STATUS_OK) {
+		status = (int) add_port_status;
+		goto error;
+	}
+
+	status = init_filter_comp_from_params(filter_comp, params);
+	if (status != BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK) {
+		goto error;
+	}
+
+	bt_self_component_set_data(self_comp, filter_comp);
+	goto end;
+
+error:
+	destroy_filter_comp(filter_comp);
+
+end:
+	return status;
+}
+
+void filter_finalize(bt_self_component_filter *self_comp)
+{
+	destroy_filter_comp(bt_self_component_get_data(
+		bt_self_component_filter_as_self_component(self_comp)));
+}
+
+static
+void destroy_filter_stream_state(struct filter_stream_state *sstate)
+{
+	if (!sstate) {
+		return;
+	}
+
+	if (sstate->decisions) {
+		g_hash_table_destroy(sstate->decisions);
+	}
+
+	bt_stream_put_ref(sstate->stream);
+	g_free(sstate);
+}
+
+/*
+ * Puts the references of the messages of the current upstream batch
+ * which `filter_it` didn't consume.
+ */
+static
+void discard_upstream_msgs(struct filter_iterator *filter_it)
+{
+	for (; filter_it->upstream_msg_index < filter_it->upstream_msg_count;
+			filter_it->upstream_msg_index++) {
+		bt_message_put_ref(
+			filter_it->upstream_msgs[filter_it->upstream_msg_index]);
+	}
+
+	filter_it->upstream_msg_count = 0;
+	filter_it->upstream_msg_index = 0;
+}
+
+/*
+ * Forgets all the stream states of `filter_it`, for example after a
+ * seek operation.
+ */
+static
+void reset_stream_states(struct filter_iterator *filter_it)
+{
+	filter_it->last_stream_state = NULL;
+	g_hash_table_remove_all(filter_it->stream_states);
+}
+
+static
+void destroy_filter_iterator(struct filter_iterator *filter_it)
+{
+	if (!filter_it) {
+		return;
+	}
+
+	discard_upstream_msgs(filter_it);
+	bt_message_iterator_put_ref(filter_it->upstream_iter);
+
+	if (filter_it->stream_states) {
+		g_hash_table_destroy(filter_it->stream_states);
+	}
+
+	g_free(filter_it);
+}
+
+bt_message_iterator_class_initialize_method_status filter_msg_iter_init(
+		bt_self_message_iterator *self_msg_iter,
+		bt_self_message_iterator_configuration *config,
+		bt_self_component_port_output *self_port __attribute__((unused)))
+{
+	bt_message_iterator_class_initialize_method_status status;
+	bt_message_iterator_create_from_message_iterator_status
+		msg_iter_status;
+	struct filter_iterator *filter_it;
+	bt_self_component_port_input *in_port;
+	struct filter_comp *filter_comp = bt_self_component_get_data(
+		bt_self_message_iterator_borrow_component(self_msg_iter));
+
+	BT_ASSERT(filter_comp);
+	filter_it = g_new0(struct filter_iterator, 1);
+	if (!filter_it) {
+		status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	}
+
+	filter_it->filter_comp = filter_comp;
+	filter_it->stream_states = g_hash_table_new_full(g_direct_hash,
+		g_direct_equal, NULL,
+		(GDestroyNotify) destroy_filter_stream_state);
+	if (!filter_it->stream_states) {
+		status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	}
+
+	/*
+	 * Upstream components only need to decode the event fields which
+	 * the expression refers to, in addition to the ones which the
+	 * downstream component needs.
+	 */
+	in_port = bt_self_component_filter_borrow_input_port_by_name(
+		filter_comp->self_comp_filter, in_port_name);
+	bt_self_component_port_input_set_needed_event_fields(in_port,
+		bt_self_message_iterator_get_needed_event_fields(self_msg_iter) |
+		filter_expr_get_needed_event_fields(filter_comp->expr));
+	msg_iter_status = bt_message_iterator_create_from_message_iterator(
+		self_msg_iter, in_port, &filter_it->upstream_iter);
+	if (msg_iter_status != BT_MESSAGE_ITERATOR_CREATE_FROM_MESSAGE_ITERATOR_STATUS_OK) {
+		status = (int) msg_iter_status;
+		goto error;
+	}
+
+	/* Discarding messages doesn't change the order of the others */
+	bt_self_message_iterator_configuration_set_can_seek_forward(config,
+		bt_message_iterator_can_seek_forward(filter_it->upstream_iter));
+	bt_self_message_iterator_set_data(self_msg_iter, filter_it);
+	status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_OK;
+	goto end;
+
+error:
+	destroy_filter_iterator(filter_it);
+
+end:
+	return status;
+}
+
+void filter_msg_iter_finalize(bt_self_message_iterator *self_msg_iter)
+{
+	struct filter_iterator *filter_it =
+		bt_self_message_iterator_get_data(self_msg_iter);
+	struct filter_comp *filter_comp;
+
+	BT_ASSERT(filter_it);
+	filter_comp = filter_it->filter_comp;
+	BT_COMP_LOGI("Filtered event messages: accepted-count=%" PRIu64 ", "
+		"rejected-count=%" PRIu64, filter_it->accepted_event_count,
+		filter_it->rejected_event_count);
+	destroy_filter_iterator(filter_it);
+}
+
+static
+struct filter_stream_state *borrow_stream_state(
+		struct filter_iterator *filter_it, const bt_stream *stream)
+{
+	struct filter_stream_state *sstate =
+		g_hash_table_lookup(filter_it->stream_states, stream);
+
+	if (G_UNLIKELY(!sstate)) {
+		sstate = g_new0(struct filter_stream_state, 1);
+		sstate->stream = stream;
+		bt_stream_get_ref(stream);
+		sstate->decisions = g_hash_table_new_full(g_direct_hash,
+			g_direct_equal, NULL,
+			(GDestroyNotify) filter_decision_destroy);
+		g_hash_table_insert(filter_it->stream_states, (gpointer) stream,
+			sstate);
+	}
+
+	return sstate;
+}
+
+static
+const char *decision_type_string(enum filter_decision_type type)
+{
+	switch (type) {
+	case FILTER_DECISION_TYPE_ACCEPT:
+		return "ACCEPT";
+	case FILTER_DECISION_TYPE_REJECT:
+		return "REJECT";
+	case FILTER_DECISION_TYPE_EVALUATE:
+		return "EVALUATE";
+	default:
+		bt_common_abort();
+	}
+}
+
+/*
+ * Returns whether or not `filter_it` accepts the event message `msg`.
+ *
+ * The expression is compiled once per (stream, event class) pair: most
+ * of the time, the decision doesn't depend on the event fields at all.
+ */
+static inline
+bool accept_event_msg(struct filter_iterator *filter_it,
+		const bt_message *msg)
+{
+	const bt_event *event = bt_message_event_borrow_event_const(msg);
+	const bt_stream *stream = bt_event_borrow_stream_const(event);
+	const bt_event_class *event_class = bt_event_borrow_class_const(event);
+	struct filter_stream_state *sstate = filter_it->last_stream_state;
+	struct filter_decision *decision;
+
+	if (G_UNLIKELY(!sstate || sstate->stream != stream)) {
+		sstate = borrow_stream_state(filter_it, stream);
+		filter_it->last_stream_state = sstate;
+	}
+
+	decision = g_hash_table_lookup(sstate->decisions, event_class);
+	if (G_UNLIKELY(!decision)) {
+		struct filter_comp *filter_comp = filter_it->filter_comp;
+
+		decision = filter_expr_compile(filter_comp->expr, stream,
+			event_class);
+		g_hash_table_insert(sstate->decisions, (gpointer) event_class,
+			decision);
+		BT_COMP_LOGD("Compiled filter expression: "
+			"stream-id=%" PRIu64 ", event-class-id=%" PRIu64 ", "
+			"event-class-name=\"%s\", decision=%s",
+			bt_stream_get_id(stream), bt_event_class_get_id(event_class),
+			bt_event_class_get_name(event_class),
+			decision_type_string(decision->type));
+	}
+
+	switch (decision->type) {
+	case FILTER_DECISION_TYPE_ACCEPT:
+		return true;
+	case FILTER_DECISION_TYPE_REJECT:
+		return false;
+	case FILTER_DECISION_TYPE_EVALUATE:
+		return filter_decision_evaluate(decision, event);
+	default:
+		bt_common_abort();
+	}
+}
+
+bt_message_iterator_class_next_method_status filter_msg_iter_next(
+		bt_self_message_iterator *self_msg_iter,
+		bt_message_array_const msgs, uint64_t capacity,
+		uint64_t *count)
+{
+	struct filter_iterator *filter_it =
+		bt_self_message_iterator_get_data(self_msg_iter);
+	bt_message_iterator_class_next_method_status status =
+		BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+	uint64_t i = 0;
+
+	BT_ASSERT_DBG(filter_it);
+
+	while (i < capacity) {
+		const bt_message *msg;
+
+		if (filter_it->upstream_msg_index ==
+				filter_it->upstream_msg_count) {
+			bt_message_iterator_next_status upstream_status;
+
+			if (i > 0) {
+				/* Return what we have without blocking */
+				break;
+			}
+
+			upstream_status = bt_message_iterator_next(
+				filter_it->upstream_iter,
+				&filter_it->upstream_msgs,
+				&filter_it->upstream_msg_count);
+			if (upstream_status != BT_MESSAGE_ITERATOR_NEXT_STATUS_OK) {
+				filter_it->upstream_msg_count = 0;
+				filter_it->upstream_msg_index = 0;
+				status = (int) upstream_status;
+				goto end;
+			}
+
+			filter_it->upstream_msg_index = 0;
+		}
+
+		msg = filter_it->upstream_msgs[filter_it->upstream_msg_index];
+		filter_it->upstream_msg_index++;
+
+		switch (bt_message_get_type(msg)) {
+		case BT_MESSAGE_TYPE_EVENT:
+			if (!accept_event_msg(filter_it, msg)) {
+				filter_it->rejected_event_count++;
+				bt_message_put_ref(msg);
+				continue;
+			}
+
+			filter_it->accepted_event_count++;
+			break;
+		case BT_MESSAGE_TYPE_STREAM_END:
+		{
+			const bt_stream *stream =
+				bt_message_stream_end_borrow_stream_const(msg);
+
+			if (filter_it->last_stream_state &&
+					filter_it->last_stream_state->stream == stream) {
+				filter_it->last_stream_state = NULL;
+			}
+
+			g_hash_table_remove(filter_it->stream_states, stream);
+			break;
+		}
+		default:
+			break;
+		}
+
+		msgs[i] = msg;
+		i++;
+	}
+
+	*count = i;
+
+end:
+	return status;
+}
+
+bt_message_iterator_class_can_seek_beginning_method_status
+filter_msg_iter_can_seek_beginning(
+		bt_self_message_iterator *self_msg_iter, bt_bool *can_seek)
+{
+	struct filter_iterator *filter_it =
+		bt_self_message_iterator_get_data(self_msg_iter);
+
+	BT_ASSERT(filter_it);
+	return (int) bt_message_iterator_can_seek_beginning(
+		filter_it->upstream_iter, can_seek);
+}
+
+bt_message_iterator_class_seek_beginning_method_status
+filter_msg_iter_seek_beginning(bt_self_message_iterator *self_msg_iter)
+{
+	struct filter_iterator *filter_it =
+		bt_self_message_iterator_get_data(self_msg_iter);
+
+	BT_ASSERT(filter_it);
+	discard_upstream_msgs(filter_it);
+	reset_stream_states(filter_it);
+	return (int) bt_message_iterator_seek_beginning(
+		filter_it->upstream_iter);
+}
+
+bt_message_iterator_class_can_seek_ns_from_origin_method_status
+filter_msg_iter_can_seek_ns_from_origin(
+		bt_self_message_iterator *self_msg_iter,
+		int64_t ns_from_origin, bt_bool *can_seek)
+{
+	struct filter_iterator *filter_it =
+		bt_self_message_iterator_get_data(self_msg_iter);
+
+	BT_ASSERT(filter_it);
+	return (int) bt_message_iterator_can_seek_ns_from_origin(
+		filter_it->upstream_iter, ns_from_origin, can_seek);
+}
+
+bt_message_iterator_class_seek_ns_from_origin_method_status
+filter_msg_iter_seek_ns_from_origin(
+		bt_self_message_iterator *self_msg_iter,
+		int64_t ns_from_origin)
+{
+	struct filter_iterator *filter_it =
+		bt_self_message_iterator_get_data(self_msg_iter);
+
+	BT_ASSERT(filter_it);
+	discard_upstream_msgs(filter_it);
+	reset_stream_states(filter_it);
+	return (int) bt_message_iterator_seek_ns_from_origin(
+		filter_it->upstream_iter, ns_from_origin);
+}
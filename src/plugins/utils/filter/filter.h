@@ -0,0 +1,57 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_FILTER_H
+#define BABELTRACE_PLUGINS_UTILS_FILTER_H
+
+#include <babeltrace2/babeltrace.h>
+#include "common/macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bt_component_class_initialize_method_status filter_init(
+		bt_self_component_filter *self_comp,
+		bt_self_component_filter_configuration *config,
+		const bt_value *params, void *init_method_data);
+
+void filter_finalize(bt_self_component_filter *self_comp);
+
+bt_message_iterator_class_initialize_method_status filter_msg_iter_init(
+		bt_self_message_iterator *self_msg_iter,
+		bt_self_message_iterator_configuration *config,
+		bt_self_component_port_output *self_port);
+
+void filter_msg_iter_finalize(bt_self_message_iterator *self_msg_iter);
+
+bt_message_iterator_class_next_method_status filter_msg_iter_next(
+		bt_self_message_iterator *self_msg_iter,
+		bt_message_array_const msgs, uint64_t capacity,
+		uint64_t *count);
+
+bt_message_iterator_class_can_seek_beginning_method_status
+filter_msg_iter_can_seek_beginning(
+		bt_self_message_iterator *self_msg_iter, bt_bool *can_seek);
+
+bt_message_iterator_class_seek_beginning_method_status
+filter_msg_iter_seek_beginning(bt_self_message_iterator *self_msg_iter);
+
+bt_message_iterator_class_can_seek_ns_from_origin_method_status
+filter_msg_iter_can_seek_ns_from_origin(
+		bt_self_message_iterator *self_msg_iter,
+		int64_t ns_from_origin, bt_bool *can_seek);
+
+bt_message_iterator_class_seek_ns_from_origin_method_status
+filter_msg_iter_seek_ns_from_origin(
+		bt_self_message_iterator *self_msg_iter,
+		int64_t ns_from_origin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BABELTRACE_PLUGINS_UTILS_FILTER_H */
@@ -0,0 +1,1822 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS Inc.
+ */
+
+#define BT_COMP_LOG_SELF_COMP (ipc_sink->self_comp)
+#define BT_LOG_OUTPUT_LEVEL (ipc_sink->log_level)
+#define BT_LOG_TAG "PLUGIN/SINK.UTILS.IPC"
+#include "logging/comp-logging.h"
+
+#include "ipc-sink.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include "common/common.h"
+#include "common/assert.h"
+#include "common/uuid.h"
+#include <babeltrace2/babeltrace.h>
+#include <glib.h>
+#include "plugins/common/param-validation/param-validation.h"
+
+#include "ipc.h"
+
+/*
+ * Record payloads (see `ipc.h` for the primitive encodings):
+ *
+ * `IPC_TAG_TRACE_CLASS`:
+ *     uint ID, value user attributes.
+ *
+ * `IPC_TAG_CLOCK_CLASS`:
+ *     uint ID, opt-string name, opt-string description, uint frequency,
+ *     uint precision, sint offset (seconds), uint offset (cycles), u8
+ *     origin is Unix epoch, opt-uuid UUID, value user attributes.
+ *
+ * `IPC_TAG_STREAM_CLASS`:
+ *     uint ID, uint trace class ID, uint stream class ID (numeric ID of
+ *     the original stream class), opt-string name, uint default clock
+ *     class ID (0 for none), uint flags (`IPC_SC_FLAG_*`), optional
+ *     packet context field class, optional event common context field
+ *     class, value user attributes.
+ *
+ * `IPC_TAG_EVENT_CLASS`:
+ *     uint ID, uint stream class ID, uint event class ID (numeric ID
+ *     of the original event class), opt-string name, uint log level
+ *     plus one (0 for none), opt-string EMF URI, optional specific
+ *     context field class, optional payload field class, value user
+ *     attributes.
+ *
+ * `IPC_TAG_TRACE`:
+ *     uint ID, uint trace class ID, opt-string name, opt-uuid UUID,
+ *     uint environment entry count, (string name, value) environment
+ *     entries, value user attributes.
+ *
+ * `IPC_TAG_STREAM`:
+ *     uint ID, uint trace ID, uint stream class ID, uint stream ID
+ *     (numeric ID of the original stream), opt-string name, value user
+ *     attributes.
+ *
+ * `IPC_TAG_MSG_STREAM_BEGINNING` and `IPC_TAG_MSG_STREAM_END`:
+ *     uint stream ID, then, if the stream class has a default clock
+ *     class, u8 clock snapshot is known and, if so, sint clock
+ *     snapshot.
+ *
+ * `IPC_TAG_MSG_PACKET_BEGINNING` and `IPC_TAG_MSG_PACKET_END`:
+ *     uint stream ID, sint clock snapshot if the packets of the stream
+ *     class have one, then, for a packet beginning message, the packet
+ *     context field if the stream class has a packet context field
+ *     class.
+ *
+ * `IPC_TAG_MSG_EVENT`:
+ *     uint stream ID, uint event class ID, sint clock snapshot if the
+ *     stream class has a default clock class, then the event common
+ *     context, specific context, and payload fields, each one if its
+ *     class exists.
+ *
+ * `IPC_TAG_MSG_DISCARDED_EVENTS` and `IPC_TAG_MSG_DISCARDED_PACKETS`:
+ *     uint stream ID, sint beginning and end clock snapshots if the
+ *     stream class requires them, u8 has count and, if so, uint count.
+ *
+ * `IPC_TAG_MSG_ITER_INACTIVITY`:
+ *     uint clock class ID, uint clock snapshot value.
+ *
+ * A serialized field class is a uint type (one of `enum ipc_fc_type`)
+ * and a value user attributes, followed with:
+ *
+ * Bit array:
+ *     uint length.
+ *
+ * Integer:
+ *     uint field value range, uint preferred display base.
+ *
+ * Enumeration:
+ *     Like an integer, then uint mapping count and, for each mapping,
+ *     string label and ranges.
+ *
+ * Structure:
+ *     uint member count and, for each member, string name, field
+ *     class, and value user attributes.
+ *
+ * Static array:
+ *     Element field class, uint length.
+ *
+ * Dynamic array:
+ *     uint length field class ordinal if any, element field class.
+ *
+ * Option:
+ *     uint selector field class ordinal if any, u8 selector is
+ *     reversed (boolean selector) or ranges (integer selector) if any,
+ *     content field class.
+ *
+ * Variant:
+ *     uint selector field class ordinal if any, uint option count and,
+ *     for each option, string name, ranges (integer selector) if any,
+ *     field class, and value user attributes.
+ *
+ * Ranges are a uint range count followed with (lower, upper) uint or
+ * sint pairs.
+ */
+
+/* Flush the current batch once it's at least this large (bytes) */
+#define IPC_BATCH_SIZE		(64 * 1024)
+
+struct ipc_sink_trace_class {
+	uint64_t id;
+
+	/*
+	 * `const bt_field_class *` (weak) to field class ordinal plus
+	 * one
+	 */
+	GHashTable *fc_ordinals;
+
+	uint64_t next_fc_ordinal;
+};
+
+struct ipc_sink_stream {
+	uint64_t id;
+
+	/* Last encoded clock snapshot value */
+	uint64_t last_cs;
+};
+
+struct ipc_sink {
+	bt_logging_level log_level;
+	bt_self_component *self_comp;
+	bt_message_iterator *msg_iter;
+
+	/* Output file descriptor (-1 if closed) */
+	int fd;
+
+	/* True if the component owns `fd` (not the standard output) */
+	bool owns_fd;
+
+	/* Records of the current batch */
+	GByteArray *batch;
+
+	/*
+	 * Interned objects: each table holds a reference on its keys so
+	 * that their addresses remain unique. The value of an entry is
+	 * its ID (`GUINT_TO_POINTER()`) unless specified otherwise.
+	 */
+
+	/* Values are `struct ipc_sink_trace_class *` (owned) */
+	GHashTable *trace_classes;
+
+	GHashTable *clock_classes;
+	GHashTable *stream_classes;
+	GHashTable *event_classes;
+	GHashTable *traces;
+
+	/*
+	 * Values are `struct ipc_sink_stream *` (owned); an entry exists
+	 * between the stream beginning and end messages.
+	 */
+	GHashTable *streams;
+
+	/* Next stream ID (streams are removed from `streams`) */
+	uint64_t next_stream_id;
+};
+
+/* Field class serialization context */
+struct fc_encode_ctx {
+	struct ipc_sink_trace_class *tc;
+
+	/* Stream class of the field class */
+	const bt_stream_class *sc;
+
+	/* Event class of the field class, if any */
+	const bt_event_class *ec;
+};
+
+static
+struct bt_param_validation_map_value_entry_descr ipc_sink_params[] = {
+	{ "path", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_MANDATORY, { .type = BT_VALUE_TYPE_STRING } },
+	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
+};
+
+static
+void destroy_trace_class(struct ipc_sink_trace_class *tc)
+{
+	if (tc->fc_ordinals) {
+		g_hash_table_destroy(tc->fc_ordinals);
+	}
+
+	g_free(tc);
+}
+
+static
+void put_trace_class_ref(gpointer obj)
+{
+	bt_trace_class_put_ref(obj);
+}
+
+static
+void put_clock_class_ref(gpointer obj)
+{
+	bt_clock_class_put_ref(obj);
+}
+
+static
+void put_stream_class_ref(gpointer obj)
+{
+	bt_stream_class_put_ref(obj);
+}
+
+static
+void put_event_class_ref(gpointer obj)
+{
+	bt_event_class_put_ref(obj);
+}
+
+static
+void put_trace_ref(gpointer obj)
+{
+	bt_trace_put_ref(obj);
+}
+
+static
+void put_stream_ref(gpointer obj)
+{
+	bt_stream_put_ref(obj);
+}
+
+static
+void destroy_ipc_sink(struct ipc_sink *ipc_sink)
+{
+	if (!ipc_sink) {
+		return;
+	}
+
+	if (ipc_sink->owns_fd && ipc_sink->fd >= 0) {
+		close(ipc_sink->fd);
+	}
+
+	if (ipc_sink->batch) {
+		g_byte_array_free(ipc_sink->batch, TRUE);
+	}
+
+	if (ipc_sink->streams) {
+		g_hash_table_destroy(ipc_sink->streams);
+	}
+
+	if (ipc_sink->traces) {
+		g_hash_table_destroy(ipc_sink->traces);
+	}
+
+	if (ipc_sink->event_classes) {
+		g_hash_table_destroy(ipc_sink->event_classes);
+	}
+
+	if (ipc_sink->stream_classes) {
+		g_hash_table_destroy(ipc_sink->stream_classes);
+	}
+
+	if (ipc_sink->clock_classes) {
+		g_hash_table_destroy(ipc_sink->clock_classes);
+	}
+
+	if (ipc_sink->trace_classes) {
+		g_hash_table_destroy(ipc_sink->trace_classes);
+	}
+
+	bt_message_iterator_put_ref(ipc_sink->msg_iter);
+	g_free(ipc_sink);
+}
+
+/*
+ * Writes the `len` bytes of `buf` to the output file descriptor.
+ *
+ * This blocks until the reader consumes enough data, which is how the
+ * sink applies back-pressure to its upstream components.
+ */
+static
+int write_all(struct ipc_sink *ipc_sink, const uint8_t *buf, size_t len)
+{
+	int ret = 0;
+
+	while (len > 0) {
+		ssize_t written = write(ipc_sink->fd, buf, len);
+
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			BT_COMP_LOGE_APPEND_CAUSE_ERRNO(ipc_sink->self_comp,
+				"Cannot write to output", ": fd=%d, len=%zu",
+				ipc_sink->fd, len);
+			ret = -1;
+			goto end;
+		}
+
+		buf += written;
+		len -= written;
+	}
+
+end:
+	return ret;
+}
+
+/*
+ * Writes the current batch, if not empty, to the output file
+ * descriptor.
+ */
+static
+int flush_batch(struct ipc_sink *ipc_sink)
+{
+	GByteArray *batch = ipc_sink->batch;
+	GByteArray *prefix = NULL;
+	int ret = 0;
+
+	if (batch->len == 0) {
+		goto end;
+	}
+
+	prefix = g_byte_array_sized_new(IPC_UINT_MAX_LEN);
+	if (!prefix) {
+		BT_COMP_LOGE_APPEND_CAUSE(ipc_sink->self_comp,
+			"Failed to allocate a GByteArray.");
+		ret = -1;
+		goto end;
+	}
+
+	ipc_write_uint(prefix, batch->len);
+	ret = write_all(ipc_sink, prefix->data, prefix->len);
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_all(ipc_sink, batch->data, batch->len);
+	if (ret) {
+		goto end;
+	}
+
+	BT_COMP_LOGD("Wrote batch: len=%u", batch->len);
+	g_byte_array_set_size(batch, 0);
+
+end:
+	if (prefix) {
+		g_byte_array_free(prefix, TRUE);
+	}
+
+	return ret;
+}
+
+static
+void write_uuid(GByteArray *out, const uint8_t *uuid)
+{
+	if (!uuid) {
+		ipc_write_u8(out, 0);
+		return;
+	}
+
+	ipc_write_u8(out, 1);
+	g_byte_array_append(out, uuid, BT_UUID_LEN);
+}
+
+static
+int write_value(struct ipc_sink *ipc_sink, const bt_value *value);
+
+static
+bt_value_map_foreach_entry_const_func_status write_map_entry(
+		const char *key, const bt_value *value, void *user_data)
+{
+	struct ipc_sink *ipc_sink = user_data;
+
+	ipc_write_string(ipc_sink->batch, key);
+
+	if (write_value(ipc_sink, value)) {
+		return BT_VALUE_MAP_FOREACH_ENTRY_CONST_FUNC_STATUS_ERROR;
+	}
+
+	return BT_VALUE_MAP_FOREACH_ENTRY_CONST_FUNC_STATUS_OK;
+}
+
+static
+int write_value(struct ipc_sink *ipc_sink, const bt_value *value)
+{
+	GByteArray *out = ipc_sink->batch;
+	uint64_t i;
+	int ret = 0;
+
+	switch (bt_value_get_type(value)) {
+	case BT_VALUE_TYPE_NULL:
+		ipc_write_uint(out, IPC_VALUE_TYPE_NULL);
+		break;
+	case BT_VALUE_TYPE_BOOL:
+		ipc_write_uint(out, IPC_VALUE_TYPE_BOOL);
+		ipc_write_u8(out, bt_value_bool_get(value));
+		break;
+	case BT_VALUE_TYPE_UNSIGNED_INTEGER:
+		ipc_write_uint(out, IPC_VALUE_TYPE_UNSIGNED_INTEGER);
+		ipc_write_uint(out, bt_value_integer_unsigned_get(value));
+		break;
+	case BT_VALUE_TYPE_SIGNED_INTEGER:
+		ipc_write_uint(out, IPC_VALUE_TYPE_SIGNED_INTEGER);
+		ipc_write_sint(out, bt_value_integer_signed_get(value));
+		break;
+	case BT_VALUE_TYPE_REAL:
+		ipc_write_uint(out, IPC_VALUE_TYPE_REAL);
+		ipc_write_double(out, bt_value_real_get(value));
+		break;
+	case BT_VALUE_TYPE_STRING:
+		ipc_write_uint(out, IPC_VALUE_TYPE_STRING);
+		ipc_write_string(out, bt_value_string_get(value));
+		break;
+	case BT_VALUE_TYPE_ARRAY:
+		ipc_write_uint(out, IPC_VALUE_TYPE_ARRAY);
+		ipc_write_uint(out, bt_value_array_get_length(value));
+
+		for (i = 0; i < bt_value_array_get_length(value); i++) {
+			ret = write_value(ipc_sink,
+				bt_value_array_borrow_element_by_index_const(
+					value, i));
+			if (ret) {
+				goto end;
+			}
+		}
+
+		break;
+	case BT_VALUE_TYPE_MAP:
+		ipc_write_uint(out, IPC_VALUE_TYPE_MAP);
+		ipc_write_uint(out, bt_value_map_get_size(value));
+
+		if (bt_value_map_foreach_entry_const(value, write_map_entry,
+				ipc_sink) != BT_VALUE_MAP_FOREACH_ENTRY_CONST_STATUS_OK) {
+			ret = -1;
+			goto end;
+		}
+
+		break;
+	default:
+		bt_common_abort();
+	}
+
+end:
+	return ret;
+}
+
+/*
+ * Returns the root field class of the scope `scope` within the context
+ * `ctx`.
+ */
+static
+const bt_field_class *borrow_scope_fc(const struct fc_encode_ctx *ctx,
+		bt_field_path_scope scope)
+{
+	switch (scope) {
+	case BT_FIELD_PATH_SCOPE_PACKET_CONTEXT:
+		return bt_stream_class_borrow_packet_context_field_class_const(
+			ctx->sc);
+	case BT_FIELD_PATH_SCOPE_EVENT_COMMON_CONTEXT:
+		return bt_stream_class_borrow_event_common_context_field_class_const(
+			ctx->sc);
+	case BT_FIELD_PATH_SCOPE_EVENT_SPECIFIC_CONTEXT:
+		return ctx->ec ?
+			bt_event_class_borrow_specific_context_field_class_const(
+				ctx->ec) : NULL;
+	case BT_FIELD_PATH_SCOPE_EVENT_PAYLOAD:
+		return ctx->ec ?
+			bt_event_class_borrow_payload_field_class_const(
+				ctx->ec) : NULL;
+	default:
+		return NULL;
+	}
+}
+
+/*
+ * Returns the field class which the field path `field_path` locates
+ * within the context `ctx`, or `NULL` if not found.
+ */
+static
+const bt_field_class *resolve_field_path(const struct fc_encode_ctx *ctx,
+		const bt_field_path *field_path)
+{
+	const bt_field_class *fc = borrow_scope_fc(ctx,
+		bt_field_path_get_root_scope(field_path));
+	uint64_t i;
+
+	for (i = 0; fc && i < bt_field_path_get_item_count(field_path); i++) {
+		const bt_field_path_item *item =
+			bt_field_path_borrow_item_by_index_const(field_path, i);
+		bt_field_class_type fc_type = bt_field_class_get_type(fc);
+
+		switch (bt_field_path_item_get_type(item)) {
+		case BT_FIELD_PATH_ITEM_TYPE_INDEX:
+		{
+			uint64_t index = bt_field_path_item_index_get_index(item);
+
+			if (fc_type == BT_FIELD_CLASS_TYPE_STRUCTURE) {
+				if (index >= bt_field_class_structure_get_member_count(fc)) {
+					return NULL;
+				}
+
+				fc = bt_field_class_structure_member_borrow_field_class_const(
+					bt_field_class_structure_borrow_member_by_index_const(
+						fc, index));
+			} else if (bt_field_class_type_is(fc_type,
+					BT_FIELD_CLASS_TYPE_VARIANT)) {
+				if (index >= bt_field_class_variant_get_option_count(fc)) {
+					return NULL;
+				}
+
+				fc = bt_field_class_variant_option_borrow_field_class_const(
+					bt_field_class_variant_borrow_option_by_index_const(
+						fc, index));
+			} else {
+				return NULL;
+			}
+
+			break;
+		}
+		case BT_FIELD_PATH_ITEM_TYPE_CURRENT_ARRAY_ELEMENT:
+			if (!bt_field_class_type_is(fc_type,
+					BT_FIELD_CLASS_TYPE_ARRAY)) {
+				return NULL;
+			}
+
+			fc = bt_field_class_array_borrow_element_field_class_const(fc);
+			break;
+		case BT_FIELD_PATH_ITEM_TYPE_CURRENT_OPTION_CONTENT:
+			if (!bt_field_class_type_is(fc_type,
+					BT_FIELD_CLASS_TYPE_OPTION)) {
+				return NULL;
+			}
+
+			fc = bt_field_class_option_borrow_field_class_const(fc);
+			break;
+		default:
+			return NULL;
+		}
+	}
+
+	return fc;
+}
+
+/*
+ * Writes the ordinal of the field class which the field path
+ * `field_path` locates.
+ */
+static
+int write_fc_ref(struct ipc_sink *ipc_sink, const struct fc_encode_ctx *ctx,
+		const bt_field_path *field_path)
+{
+	const bt_field_class *fc = resolve_field_path(ctx, field_path);
+	gpointer ordinal_plus_one = NULL;
+	int ret = 0;
+
+	if (fc) {
+		ordinal_plus_one = g_hash_table_lookup(ctx->tc->fc_ordinals, fc);
+	}
+
+	if (!ordinal_plus_one) {
+		BT_COMP_LOGE_APPEND_CAUSE(ipc_sink->self_comp,
+			"Cannot find the length or selector field class of a field class: "
+			"root-scope=%d", bt_field_path_get_root_scope(field_path));
+		ret = -1;
+		goto end;
+	}
+
+	ipc_write_uint(ipc_sink->batch, GPOINTER_TO_SIZE(ordinal_plus_one) - 1);
+
+end:
+	return ret;
+}
+
+static
+void write_unsigned_ranges(GByteArray *out,
+		const bt_integer_range_set_unsigned *ranges)
+{
+	uint64_t count = bt_integer_range_set_get_range_count(
+		bt_integer_range_set_unsigned_as_range_set_const(ranges));
+	uint64_t i;
+
+	ipc_write_uint(out, count);
+
+	for (i = 0; i < count; i++) {
+		const bt_integer_range_unsigned *range =
+			bt_integer_range_set_unsigned_borrow_range_by_index_const(
+				ranges, i);
+
+		ipc_write_uint(out, bt_integer_range_unsigned_get_lower(range));
+		ipc_write_uint(out, bt_integer_range_unsigned_get_upper(range));
+	}
+}
+
+static
+void write_signed_ranges(GByteArray *out,
+		const bt_integer_range_set_signed *ranges)
+{
+	uint64_t count = bt_integer_range_set_get_range_count(
+		bt_integer_range_set_signed_as_range_set_const(ranges));
+	uint64_t i;
+
+	ipc_write_uint(out, count);
+
+	for (i = 0; i < count; i++) {
+		const bt_integer_range_signed *range =
+			bt_integer_range_set_signed_borrow_range_by_index_const(
+				ranges, i);
+
+		ipc_write_sint(out, bt_integer_range_signed_get_lower(range));
+		ipc_write_sint(out, bt_integer_range_signed_get_upper(range));
+	}
+}
+
+static
+int write_fc(struct ipc_sink *ipc_sink, const struct fc_encode_ctx *ctx,
+		const bt_field_class *fc)
+{
+	GByteArray *out = ipc_sink->batch;
+	bt_field_class_type fc_type = bt_field_class_get_type(fc);
+	enum ipc_fc_type ipc_fc_type;
+	uint64_t i;
+	int ret = 0;
+
+	/* Pre-order ordinal (see `ipc.h`) */
+	g_hash_table_insert(ctx->tc->fc_ordinals, (gpointer) fc,
+		GSIZE_TO_POINTER(ctx->tc->next_fc_ordinal + 1));
+	ctx->tc->next_fc_ordinal++;
+
+	switch (fc_type) {
+	case BT_FIELD_CLASS_TYPE_BOOL:
+		ipc_fc_type = IPC_FC_TYPE_BOOL;
+		break;
+	case BT_FIELD_CLASS_TYPE_BIT_ARRAY:
+		ipc_fc_type = IPC_FC_TYPE_BIT_ARRAY;
+		break;
+	case BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER:
+		ipc_fc_type = IPC_FC_TYPE_UNSIGNED_INTEGER;
+		break;
+	case BT_FIELD_CLASS_TYPE_SIGNED_INTEGER:
+		ipc_fc_type = IPC_FC_TYPE_SIGNED_INTEGER;
+		break;
+	case BT_FIELD_CLASS_TYPE_UNSIGNED_ENUMERATION:
+		ipc_fc_type = IPC_FC_TYPE_UNSIGNED_ENUMERATION;
+		break;
+	case BT_FIELD_CLASS_TYPE_SIGNED_ENUMERATION:
+		ipc_fc_type = IPC_FC_TYPE_SIGNED_ENUMERATION;
+		break;
+	case BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL:
+		ipc_fc_type = IPC_FC_TYPE_SINGLE_PRECISION_REAL;
+		break;
+	case BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL:
+		ipc_fc_type = IPC_FC_TYPE_DOUBLE_PRECISION_REAL;
+		break;
+	case BT_FIELD_CLASS_TYPE_STRING:
+		ipc_fc_type = IPC_FC_TYPE_STRING;
+		break;
+	case BT_FIELD_CLASS_TYPE_STRUCTURE:
+		ipc_fc_type = IPC_FC_TYPE_STRUCTURE;
+		break;
+	case BT_FIELD_CLASS_TYPE_STATIC_ARRAY:
+		ipc_fc_type = IPC_FC_TYPE_STATIC_ARRAY;
+		break;
+	case BT_FIELD_CLASS_TYPE_DYNAMIC_ARRAY_WITHOUT_LENGTH_FIELD:
+		ipc_fc_type = IPC_FC_TYPE_DYNAMIC_ARRAY;
+		break;
+	case BT_FIELD_CLASS_TYPE_DYNAMIC_ARRAY_WITH_LENGTH_FIELD:
+		ipc_fc_type = IPC_FC_TYPE_DYNAMIC_ARRAY_WITH_LENGTH_FIELD;
+		break;
+	case BT_FIELD_CLASS_TYPE_OPTION_WITHOUT_SELECTOR_FIELD:
+		ipc_fc_type = IPC_FC_TYPE_OPTION;
+		break;
+	case BT_FIELD_CLASS_TYPE_OPTION_WITH_BOOL_SELECTOR_FIELD:
+		ipc_fc_type = IPC_FC_TYPE_OPTION_WITH_BOOL_SELECTOR_FIELD;
+		break;
+	case BT_FIELD_CLASS_TYPE_OPTION_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD:
+		ipc_fc_type = IPC_FC_TYPE_OPTION_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD;
+		break;
+	case BT_FIELD_CLASS_TYPE_OPTION_WITH_SIGNED_INTEGER_SELECTOR_FIELD:
+		ipc_fc_type = IPC_FC_TYPE_OPTION_WITH_SIGNED_INTEGER_SELECTOR_FIELD;
+		break;
+	case BT_FIELD_CLASS_TYPE_VARIANT_WITHOUT_SELECTOR_FIELD:
+		ipc_fc_type = IPC_FC_TYPE_VARIANT;
+		break;
+	case BT_FIELD_CLASS_TYPE_VARIANT_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD:
+		ipc_fc_type = IPC_FC_TYPE_VARIANT_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD;
+		break;
+	case BT_FIELD_CLASS_TYPE_VARIANT_WITH_SIGNED_INTEGER_SELECTOR_FIELD:
+		ipc_fc_type = IPC_FC_TYPE_VARIANT_WITH_SIGNED_INTEGER_SELECTOR_FIELD;
+		break;
+	default:
+		BT_COMP_LOGE_APPEND_CAUSE(ipc_sink->self_comp,
+			"Unsupported field class type: type=%s",
+			bt_common_field_class_type_string(fc_type));
+		ret = -1;
+		goto end;
+	}
+
+	ipc_write_uint(out, ipc_fc_type);
+	ret = write_value(ipc_sink, bt_field_class_borrow_user_attributes_const(fc));
+	if (ret) {
+		goto end;
+	}
+
+	switch (ipc_fc_type) {
+	case IPC_FC_TYPE_BIT_ARRAY:
+		ipc_write_uint(out, bt_field_class_bit_array_get_length(fc));
+		break;
+	case IPC_FC_TYPE_UNSIGNED_INTEGER:
+	case IPC_FC_TYPE_SIGNED_INTEGER:
+	case IPC_FC_TYPE_UNSIGNED_ENUMERATION:
+	case IPC_FC_TYPE_SIGNED_ENUMERATION:
+		ipc_write_uint(out,
+			bt_field_class_integer_get_field_value_range(fc));
+		ipc_write_uint(out,
+			bt_field_class_integer_get_preferred_display_base(fc));
+
+		if (ipc_fc_type == IPC_FC_TYPE_UNSIGNED_INTEGER ||
+				ipc_fc_type == IPC_FC_TYPE_SIGNED_INTEGER) {
+			break;
+		}
+
+		ipc_write_uint(out, bt_field_class_enumeration_get_mapping_count(fc));
+
+		for (i = 0; i < bt_field_class_enumeration_get_mapping_count(fc); i++) {
+			if (ipc_fc_type == IPC_FC_TYPE_UNSIGNED_ENUMERATION) {
+				const bt_field_class_enumeration_unsigned_mapping *mapping =
+					bt_field_class_enumeration_unsigned_borrow_mapping_by_index_const(
+						fc, i);
+
+				ipc_write_string(out,
+					bt_field_class_enumeration_mapping_get_label(
+						bt_field_class_enumeration_unsigned_mapping_as_mapping_const(
+							mapping)));
+				write_unsigned_ranges(out,
+					bt_field_class_enumeration_unsigned_mapping_borrow_ranges_const(
+						mapping));
+			} else {
+				const bt_field_class_enumeration_signed_mapping *mapping =
+					bt_field_class_enumeration_signed_borrow_mapping_by_index_const(
+						fc, i);
+
+				ipc_write_string(out,
+					bt_field_class_enumeration_mapping_get_label(
+						bt_field_class_enumeration_signed_mapping_as_mapping_const(
+							mapping)));
+				write_signed_ranges(out,
+					bt_field_class_enumeration_signed_mapping_borrow_ranges_const(
+						mapping));
+			}
+		}
+
+		break;
+	case IPC_FC_TYPE_STRUCTURE:
+		ipc_write_uint(out, bt_field_class_structure_get_member_count(fc));
+
+		for (i = 0; i < bt_field_class_structure_get_member_count(fc); i++) {
+			const bt_field_class_structure_member *member =
+				bt_field_class_structure_borrow_member_by_index_const(
+					fc, i);
+
+			ipc_write_string(out,
+				bt_field_class_structure_member_get_name(member));
+			ret = write_fc(ipc_sink, ctx,
+				bt_field_class_structure_member_borrow_field_class_const(
+					member));
+			if (ret) {
+				goto end;
+			}
+
+			ret = write_value(ipc_sink,
+				bt_field_class_structure_member_borrow_user_attributes_const(
+					member));
+			if (ret) {
+				goto end;
+			}
+		}
+
+		break;
+	case IPC_FC_TYPE_STATIC_ARRAY:
+		ret = write_fc(ipc_sink, ctx,
+			bt_field_class_array_borrow_element_field_class_const(fc));
+		if (ret) {
+			goto end;
+		}
+
+		ipc_write_uint(out, bt_field_class_array_static_get_length(fc));
+		break;
+	case IPC_FC_TYPE_DYNAMIC_ARRAY_WITH_LENGTH_FIELD:
+		ret = write_fc_ref(ipc_sink, ctx,
+			bt_field_class_array_dynamic_with_length_field_borrow_length_field_path_const(
+				fc));
+		if (ret) {
+			goto end;
+		}
+
+		/* Fall through */
+	case IPC_FC_TYPE_DYNAMIC_ARRAY:
+		ret = write_fc(ipc_sink, ctx,
+			bt_field_class_array_borrow_element_field_class_const(fc));
+		break;
+	case IPC_FC_TYPE_OPTION_WITH_BOOL_SELECTOR_FIELD:
+	case IPC_FC_TYPE_OPTION_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD:
+	case IPC_FC_TYPE_OPTION_WITH_SIGNED_INTEGER_SELECTOR_FIELD:
+		ret = write_fc_ref(ipc_sink, ctx,
+			bt_field_class_option_with_selector_field_borrow_selector_field_path_const(
+				fc));
+		if (ret) {
+			goto end;
+		}
+
+		if (ipc_fc_type == IPC_FC_TYPE_OPTION_WITH_BOOL_SELECTOR_FIELD) {
+			ipc_write_u8(out,
+				bt_field_class_option_with_selector_field_bool_selector_is_reversed(
+					fc));
+		} else if (ipc_fc_type == IPC_FC_TYPE_OPTION_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD) {
+			write_unsigned_ranges(out,
+				bt_field_class_option_with_selector_field_integer_unsigned_borrow_selector_ranges_const(
+					fc));
+		} else {
+			write_signed_ranges(out,
+				bt_field_class_option_with_selector_field_integer_signed_borrow_selector_ranges_const(
+					fc));
+		}
+
+		/* Fall through */
+	case IPC_FC_TYPE_OPTION:
+		ret = write_fc(ipc_sink, ctx,
+			bt_field_class_option_borrow_field_class_const(fc));
+		break;
+	case IPC_FC_TYPE_VARIANT_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD:
+	case IPC_FC_TYPE_VARIANT_WITH_SIGNED_INTEGER_SELECTOR_FIELD:
+		ret = write_fc_ref(ipc_sink, ctx,
+			bt_field_class_variant_with_selector_field_borrow_selector_field_path_const(
+				fc));
+		if (ret) {
+			goto end;
+		}
+
+		/* Fall through */
+	case IPC_FC_TYPE_VARIANT:
+		ipc_write_uint(out, bt_field_class_variant_get_option_count(fc));
+
+		for (i = 0; i < bt_field_class_variant_get_option_count(fc); i++) {
+			const bt_field_class_variant_option *option =
+				bt_field_class_variant_borrow_option_by_index_const(
+					fc, i);
+
+			ipc_write_string(out,
+				bt_field_class_variant_option_get_name(option));
+
+			if (ipc_fc_type == IPC_FC_TYPE_VARIANT_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD) {
+				write_unsigned_ranges(out,
+					bt_field_class_variant_with_selector_field_integer_unsigned_option_borrow_ranges_const(
+						bt_field_class_variant_with_selector_field_integer_unsigned_borrow_option_by_index_const(
+							fc, i)));
+			} else if (ipc_fc_type == IPC_FC_TYPE_VARIANT_WITH_SIGNED_INTEGER_SELECTOR_FIELD) {
+				write_signed_ranges(out,
+					bt_field_class_variant_with_selector_field_integer_signed_option_borrow_ranges_const(
+						bt_field_class_variant_with_selector_field_integer_signed_borrow_option_by_index_const(
+							fc, i)));
+			}
+
+			ret = write_fc(ipc_sink, ctx,
+				bt_field_class_variant_option_borrow_field_class_const(
+					option));
+			if (ret) {
+				goto end;
+			}
+
+			ret = write_value(ipc_sink,
+				bt_field_class_variant_option_borrow_user_attributes_const(
+					option));
+			if (ret) {
+				goto end;
+			}
+		}
+
+		break;
+	default:
+		break;
+	}
+
+end:
+	return ret;
+}
+
+/*
+ * Writes an optional field class: u8 0 if `fc` is `NULL`, or u8 1 and
+ * the field class.
+ */
+static
+int write_opt_fc(struct ipc_sink *ipc_sink, const struct fc_encode_ctx *ctx,
+		const bt_field_class *fc)
+{
+	if (!fc) {
+		ipc_write_u8(ipc_sink->batch, 0);
+		return 0;
+	}
+
+	ipc_write_u8(ipc_sink->batch, 1);
+	return write_fc(ipc_sink, ctx, fc);
+}
+
+/*
+ * The intern_*() functions below set `*id` to the ID of an object,
+ * writing its record first if it's the first time the sink sees it.
+ */
+
+static
+int intern_trace_class(struct ipc_sink *ipc_sink, const bt_trace_class *tc,
+		struct ipc_sink_trace_class **ipc_tc)
+{
+	int ret = 0;
+
+	*ipc_tc = g_hash_table_lookup(ipc_sink->trace_classes, tc);
+	if (*ipc_tc) {
+		goto end;
+	}
+
+	*ipc_tc = g_new0(struct ipc_sink_trace_class, 1);
+	if (!*ipc_tc) {
+		BT_COMP_LOGE_APPEND_CAUSE(ipc_sink->self_comp,
+			"Failed to allocate one trace class structure.");
+		ret = -1;
+		goto end;
+	}
+
+	(*ipc_tc)->id = g_hash_table_size(ipc_sink->trace_classes) + 1;
+	(*ipc_tc)->fc_ordinals = g_hash_table_new(g_direct_hash,
+		g_direct_equal);
+	if (!(*ipc_tc)->fc_ordinals) {
+		BT_COMP_LOGE_APPEND_CAUSE(ipc_sink->self_comp,
+			"Failed to allocate a GHashTable.");
+		destroy_trace_class(*ipc_tc);
+		ret = -1;
+		goto end;
+	}
+
+	bt_trace_class_get_ref(tc);
+	g_hash_table_insert(ipc_sink->trace_classes, (gpointer) tc, *ipc_tc);
+	ipc_write_uint(ipc_sink->batch, IPC_TAG_TRACE_CLASS);
+	ipc_write_uint(ipc_sink->batch, (*ipc_tc)->id);
+	ret = write_value(ipc_sink,
+		bt_trace_class_borrow_user_attributes_const(tc));
+
+end:
+	return ret;
+}
+
+static
+int intern_clock_class(struct ipc_sink *ipc_sink, const bt_clock_class *cc,
+		uint64_t *id)
+{
+	GByteArray *out = ipc_sink->batch;
+	int64_t offset_seconds;
+	uint64_t offset_cycles;
+	int ret = 0;
+
+	*id = GPOINTER_TO_SIZE(g_hash_table_lookup(ipc_sink->clock_classes, cc));
+	if (*id) {
+		goto end;
+	}
+
+	*id = g_hash_table_size(ipc_sink->clock_classes) + 1;
+	bt_clock_class_get_ref(cc);
+	g_hash_table_insert(ipc_sink->clock_classes, (gpointer) cc,
+		GSIZE_TO_POINTER(*id));
+	bt_clock_class_get_offset(cc, &offset_seconds, &offset_cycles);
+	ipc_write_uint(out, IPC_TAG_CLOCK_CLASS);
+	ipc_write_uint(out, *id);
+	ipc_write_opt_string(out, bt_clock_class_get_name(cc));
+	ipc_write_opt_string(out, bt_clock_class_get_description(cc));
+	ipc_write_uint(out, bt_clock_class_get_frequency(cc));
+	ipc_write_uint(out, bt_clock_class_get_precision(cc));
+	ipc_write_sint(out, offset_seconds);
+	ipc_write_uint(out, offset_cycles);
+	ipc_write_u8(out, bt_clock_class_origin_is_unix_epoch(cc));
+	write_uuid(out, bt_clock_class_get_uuid(cc));
+	ret = write_value(ipc_sink,
+		bt_clock_class_borrow_user_attributes_const(cc));
+
+end:
+	return ret;
+}
+
+static
+int intern_stream_class(struct ipc_sink *ipc_sink, const bt_stream_class *sc,
+		uint64_t *id)
+{
+	GByteArray *out = ipc_sink->batch;
+	const bt_clock_class *cc =
+		bt_stream_class_borrow_default_clock_class_const(sc);
+	struct fc_encode_ctx ctx = { 0 };
+	uint64_t cc_id = 0;
+	uint64_t flags = 0;
+	int ret = 0;
+
+	*id = GPOINTER_TO_SIZE(g_hash_table_lookup(ipc_sink->stream_classes, sc));
+	if (*id) {
+		goto end;
+	}
+
+	ret = intern_trace_class(ipc_sink,
+		bt_stream_class_borrow_trace_class_const(sc), &ctx.tc);
+	if (ret) {
+		goto end;
+	}
+
+	if (cc) {
+		ret = intern_clock_class(ipc_sink, cc, &cc_id);
+		if (ret) {
+			goto end;
+		}
+	}
+
+	if (bt_stream_class_supports_packets(sc)) {
+		flags |= IPC_SC_FLAG_SUPPORTS_PACKETS;
+	}
+
+	if (bt_stream_class_packets_have_beginning_default_clock_snapshot(sc)) {
+		flags |= IPC_SC_FLAG_PACKETS_HAVE_BEGINNING_CS;
+	}
+
+	if (bt_stream_class_packets_have_end_default_clock_snapshot(sc)) {
+		flags |= IPC_SC_FLAG_PACKETS_HAVE_END_CS;
+	}
+
+	if (bt_stream_class_supports_discarded_events(sc)) {
+		flags |= IPC_SC_FLAG_SUPPORTS_DISCARDED_EVENTS;
+	}
+
+	if (bt_stream_class_discarded_events_have_default_clock_snapshots(sc)) {
+		flags |= IPC_SC_FLAG_DISCARDED_EVENTS_HAVE_CS;
+	}
+
+	if (bt_stream_class_supports_discarded_packets(sc)) {
+		flags |= IPC_SC_FLAG_SUPPORTS_DISCARDED_PACKETS;
+	}
+
+	if (bt_stream_class_discarded_packets_have_default_clock_snapshots(sc)) {
+		flags |= IPC_SC_FLAG_DISCARDED_PACKETS_HAVE_CS;
+	}
+
+	*id = g_hash_table_size(ipc_sink->stream_classes) + 1;
+	bt_stream_class_get_ref(sc);
+	g_hash_table_insert(ipc_sink->stream_classes, (gpointer) sc,
+		GSIZE_TO_POINTER(*id));
+	ctx.sc = sc;
+	ipc_write_uint(out, IPC_TAG_STREAM_CLASS);
+	ipc_write_uint(out, *id);
+	ipc_write_uint(out, ctx.tc->id);
+	ipc_write_uint(out, bt_stream_class_get_id(sc));
+	ipc_write_opt_string(out, bt_stream_class_get_name(sc));
+	ipc_write_uint(out, cc_id);
+	ipc_write_uint(out, flags);
+	ret = write_opt_fc(ipc_sink, &ctx,
+		bt_stream_class_borrow_packet_context_field_class_const(sc));
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_opt_fc(ipc_sink, &ctx,
+		bt_stream_class_borrow_event_common_context_field_class_const(sc));
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_value(ipc_sink,
+		bt_stream_class_borrow_user_attributes_const(sc));
+
+end:
+	return ret;
+}
+
+static
+int intern_event_class(struct ipc_sink *ipc_sink, const bt_event_class *ec,
+		uint64_t *id)
+{
+	GByteArray *out = ipc_sink->batch;
+	const bt_stream_class *sc = bt_event_class_borrow_stream_class_const(ec);
+	struct fc_encode_ctx ctx = { 0 };
+	bt_event_class_log_level log_level;
+	uint64_t sc_id;
+	int ret = 0;
+
+	*id = GPOINTER_TO_SIZE(g_hash_table_lookup(ipc_sink->event_classes, ec));
+	if (*id) {
+		goto end;
+	}
+
+	ret = intern_stream_class(ipc_sink, sc, &sc_id);
+	if (ret) {
+		goto end;
+	}
+
+	ctx.tc = g_hash_table_lookup(ipc_sink->trace_classes,
+		bt_stream_class_borrow_trace_class_const(sc));
+	BT_ASSERT(ctx.tc);
+	ctx.sc = sc;
+	ctx.ec = ec;
+	*id = g_hash_table_size(ipc_sink->event_classes) + 1;
+	bt_event_class_get_ref(ec);
+	g_hash_table_insert(ipc_sink->event_classes, (gpointer) ec,
+		GSIZE_TO_POINTER(*id));
+	ipc_write_uint(out, IPC_TAG_EVENT_CLASS);
+	ipc_write_uint(out, *id);
+	ipc_write_uint(out, sc_id);
+	ipc_write_uint(out, bt_event_class_get_id(ec));
+	ipc_write_opt_string(out, bt_event_class_get_name(ec));
+
+	if (bt_event_class_get_log_level(ec, &log_level) ==
+			BT_PROPERTY_AVAILABILITY_AVAILABLE) {
+		ipc_write_uint(out, (uint64_t) log_level + 1);
+	} else {
+		ipc_write_uint(out, 0);
+	}
+
+	ipc_write_opt_string(out, bt_event_class_get_emf_uri(ec));
+	ret = write_opt_fc(ipc_sink, &ctx,
+		bt_event_class_borrow_specific_context_field_class_const(ec));
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_opt_fc(ipc_sink, &ctx,
+		bt_event_class_borrow_payload_field_class_const(ec));
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_value(ipc_sink,
+		bt_event_class_borrow_user_attributes_const(ec));
+
+end:
+	return ret;
+}
+
+static
+int intern_trace(struct ipc_sink *ipc_sink, const bt_trace *trace,
+		uint64_t *id)
+{
+	GByteArray *out = ipc_sink->batch;
+	struct ipc_sink_trace_class *ipc_tc;
+	uint64_t i;
+	int ret = 0;
+
+	*id = GPOINTER_TO_SIZE(g_hash_table_lookup(ipc_sink->traces, trace));
+	if (*id) {
+		goto end;
+	}
+
+	ret = intern_trace_class(ipc_sink, bt_trace_borrow_class_const(trace),
+		&ipc_tc);
+	if (ret) {
+		goto end;
+	}
+
+	*id = g_hash_table_size(ipc_sink->traces) + 1;
+	bt_trace_get_ref(trace);
+	g_hash_table_insert(ipc_sink->traces, (gpointer) trace,
+		GSIZE_TO_POINTER(*id));
+	ipc_write_uint(out, IPC_TAG_TRACE);
+	ipc_write_uint(out, *id);
+	ipc_write_uint(out, ipc_tc->id);
+	ipc_write_opt_string(out, bt_trace_get_name(trace));
+	write_uuid(out, bt_trace_get_uuid(trace));
+	ipc_write_uint(out, bt_trace_get_environment_entry_count(trace));
+
+	for (i = 0; i < bt_trace_get_environment_entry_count(trace); i++) {
+		const char *name;
+		const bt_value *value;
+
+		bt_trace_borrow_environment_entry_by_index_const(trace, i,
+			&name, &value);
+		ipc_write_string(out, name);
+		ret = write_value(ipc_sink, value);
+		if (ret) {
+			goto end;
+		}
+	}
+
+	ret = write_value(ipc_sink, bt_trace_borrow_user_attributes_const(trace));
+
+end:
+	return ret;
+}
+
+static
+int intern_stream(struct ipc_sink *ipc_sink, const bt_stream *stream,
+		struct ipc_sink_stream **ipc_stream)
+{
+	GByteArray *out = ipc_sink->batch;
+	uint64_t trace_id;
+	uint64_t sc_id;
+	int ret = 0;
+
+	*ipc_stream = g_hash_table_lookup(ipc_sink->streams, stream);
+	if (*ipc_stream) {
+		goto end;
+	}
+
+	ret = intern_trace(ipc_sink, bt_stream_borrow_trace_const(stream),
+		&trace_id);
+	if (ret) {
+		goto end;
+	}
+
+	ret = intern_stream_class(ipc_sink,
+		bt_stream_borrow_class_const(stream), &sc_id);
+	if (ret) {
+		goto end;
+	}
+
+	*ipc_stream = g_new0(struct ipc_sink_stream, 1);
+	if (!*ipc_stream) {
+		BT_COMP_LOGE_APPEND_CAUSE(ipc_sink->self_comp,
+			"Failed to allocate one stream structure.");
+		ret = -1;
+		goto end;
+	}
+
+	ipc_sink->next_stream_id++;
+	(*ipc_stream)->id = ipc_sink->next_stream_id;
+	bt_stream_get_ref(stream);
+	g_hash_table_insert(ipc_sink->streams, (gpointer) stream, *ipc_stream);
+	ipc_write_uint(out, IPC_TAG_STREAM);
+	ipc_write_uint(out, (*ipc_stream)->id);
+	ipc_write_uint(out, trace_id);
+	ipc_write_uint(out, sc_id);
+	ipc_write_uint(out, bt_stream_get_id(stream));
+	ipc_write_opt_string(out, bt_stream_get_name(stream));
+	ret = write_value(ipc_sink,
+		bt_stream_borrow_user_attributes_const(stream));
+
+end:
+	return ret;
+}
+
+static
+void write_cs(GByteArray *out, struct ipc_sink_stream *ipc_stream,
+		const bt_clock_snapshot *cs)
+{
+	uint64_t value = bt_clock_snapshot_get_value(cs);
+
+	ipc_write_sint(out, (int64_t) (value - ipc_stream->last_cs));
+	ipc_stream->last_cs = value;
+}
+
+static
+void write_field(GByteArray *out, const bt_field *field)
+{
+	bt_field_class_type fc_type = bt_field_get_class_type(field);
+	uint64_t i;
+
+	if (fc_type == BT_FIELD_CLASS_TYPE_BOOL) {
+		ipc_write_u8(out, bt_field_bool_get_value(field));
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_BIT_ARRAY) {
+		ipc_write_uint(out,
+			bt_field_bit_array_get_value_as_integer(field));
+	} else if (bt_field_class_type_is(fc_type,
+			BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER)) {
+		ipc_write_uint(out, bt_field_integer_unsigned_get_value(field));
+	} else if (bt_field_class_type_is(fc_type,
+			BT_FIELD_CLASS_TYPE_SIGNED_INTEGER)) {
+		ipc_write_sint(out, bt_field_integer_signed_get_value(field));
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL) {
+		ipc_write_float(out,
+			bt_field_real_single_precision_get_value(field));
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL) {
+		ipc_write_double(out,
+			bt_field_real_double_precision_get_value(field));
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_STRING) {
+		ipc_write_bytes(out, bt_field_string_get_value(field),
+			bt_field_string_get_length(field));
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_STRUCTURE) {
+		uint64_t member_count = bt_field_class_structure_get_member_count(
+			bt_field_borrow_class_const(field));
+
+		for (i = 0; i < member_count; i++) {
+			write_field(out,
+				bt_field_structure_borrow_member_field_by_index_const(
+					field, i));
+		}
+	} else if (bt_field_class_type_is(fc_type,
+			BT_FIELD_CLASS_TYPE_ARRAY)) {
+		uint64_t length = bt_field_array_get_length(field);
+
+		if (fc_type != BT_FIELD_CLASS_TYPE_STATIC_ARRAY) {
+			ipc_write_uint(out, length);
+		}
+
+		for (i = 0; i < length; i++) {
+			write_field(out,
+				bt_field_array_borrow_element_field_by_index_const(
+					field, i));
+		}
+	} else if (bt_field_class_type_is(fc_type,
+			BT_FIELD_CLASS_TYPE_OPTION)) {
+		const bt_field *content = bt_field_option_borrow_field_const(field);
+
+		ipc_write_u8(out, content != NULL);
+
+		if (content) {
+			write_field(out, content);
+		}
+	} else if (bt_field_class_type_is(fc_type,
+			BT_FIELD_CLASS_TYPE_VARIANT)) {
+		ipc_write_uint(out,
+			bt_field_variant_get_selected_option_index(field));
+		write_field(out,
+			bt_field_variant_borrow_selected_option_field_const(field));
+	} else {
+		bt_common_abort();
+	}
+}
+
+static
+void write_opt_field(GByteArray *out, const bt_field *field)
+{
+	if (field) {
+		write_field(out, field);
+	}
+}
+
+static
+int write_stream_msg(struct ipc_sink *ipc_sink, const bt_message *msg)
+{
+	GByteArray *out = ipc_sink->batch;
+	bool is_beginning =
+		bt_message_get_type(msg) == BT_MESSAGE_TYPE_STREAM_BEGINNING;
+	const bt_stream *stream = is_beginning ?
+		bt_message_stream_beginning_borrow_stream_const(msg) :
+		bt_message_stream_end_borrow_stream_const(msg);
+	struct ipc_sink_stream *ipc_stream;
+	int ret;
+
+	ret = intern_stream(ipc_sink, stream, &ipc_stream);
+	if (ret) {
+		goto end;
+	}
+
+	ipc_write_uint(out, is_beginning ? IPC_TAG_MSG_STREAM_BEGINNING :
+		IPC_TAG_MSG_STREAM_END);
+	ipc_write_uint(out, ipc_stream->id);
+
+	if (bt_stream_class_borrow_default_clock_class_const(
+			bt_stream_borrow_class_const(stream))) {
+		const bt_clock_snapshot *cs;
+		bt_message_stream_clock_snapshot_state cs_state = is_beginning ?
+			bt_message_stream_beginning_borrow_default_clock_snapshot_const(
+				msg, &cs) :
+			bt_message_stream_end_borrow_default_clock_snapshot_const(
+				msg, &cs);
+
+		if (cs_state == BT_MESSAGE_STREAM_CLOCK_SNAPSHOT_STATE_KNOWN) {
+			ipc_write_u8(out, 1);
+			write_cs(out, ipc_stream, cs);
+		} else {
+			ipc_write_u8(out, 0);
+		}
+	}
+
+	if (!is_beginning) {
+		/* No more messages for this stream */
+		g_hash_table_remove(ipc_sink->streams, stream);
+	}
+
+end:
+	return ret;
+}
+
+static
+int write_packet_msg(struct ipc_sink *ipc_sink, const bt_message *msg)
+{
+	GByteArray *out = ipc_sink->batch;
+	bool is_beginning =
+		bt_message_get_type(msg) == BT_MESSAGE_TYPE_PACKET_BEGINNING;
+	const bt_packet *packet = is_beginning ?
+		bt_message_packet_beginning_borrow_packet_const(msg) :
+		bt_message_packet_end_borrow_packet_const(msg);
+	const bt_stream *stream = bt_packet_borrow_stream_const(packet);
+	const bt_stream_class *sc = bt_stream_borrow_class_const(stream);
+	struct ipc_sink_stream *ipc_stream;
+	int ret;
+
+	ret = intern_stream(ipc_sink, stream, &ipc_stream);
+	if (ret) {
+		goto end;
+	}
+
+	ipc_write_uint(out, is_beginning ? IPC_TAG_MSG_PACKET_BEGINNING :
+		IPC_TAG_MSG_PACKET_END);
+	ipc_write_uint(out, ipc_stream->id);
+
+	if (is_beginning) {
+		if (bt_stream_class_packets_have_beginning_default_clock_snapshot(sc)) {
+			write_cs(out, ipc_stream,
+				bt_message_packet_beginning_borrow_default_clock_snapshot_const(
+					msg));
+		}
+
+		write_opt_field(out, bt_packet_borrow_context_field_const(packet));
+	} else if (bt_stream_class_packets_have_end_default_clock_snapshot(sc)) {
+		write_cs(out, ipc_stream,
+			bt_message_packet_end_borrow_default_clock_snapshot_const(
+				msg));
+	}
+
+end:
+	return ret;
+}
+
+static
+int write_event_msg(struct ipc_sink *ipc_sink, const bt_message *msg)
+{
+	GByteArray *out = ipc_sink->batch;
+	const bt_event *event = bt_message_event_borrow_event_const(msg);
+	const bt_stream *stream = bt_event_borrow_stream_const(event);
+	struct ipc_sink_stream *ipc_stream;
+	uint64_t ec_id;
+	int ret;
+
+	ret = intern_event_class(ipc_sink, bt_event_borrow_class_const(event),
+		&ec_id);
+	if (ret) {
+		goto end;
+	}
+
+	ret = intern_stream(ipc_sink, stream, &ipc_stream);
+	if (ret) {
+		goto end;
+	}
+
+	ipc_write_uint(out, IPC_TAG_MSG_EVENT);
+	ipc_write_uint(out, ipc_stream->id);
+	ipc_write_uint(out, ec_id);
+
+	if (bt_stream_class_borrow_default_clock_class_const(
+			bt_stream_borrow_class_const(stream))) {
+		write_cs(out, ipc_stream,
+			bt_message_event_borrow_default_clock_snapshot_const(msg));
+	}
+
+	write_opt_field(out, bt_event_borrow_common_context_field_const(event));
+	write_opt_field(out, bt_event_borrow_specific_context_field_const(event));
+	write_opt_field(out, bt_event_borrow_payload_field_const(event));
+
+end:
+	return ret;
+}
+
+static
+int write_discarded_items_msg(struct ipc_sink *ipc_sink,
+		const bt_message *msg)
+{
+	GByteArray *out = ipc_sink->batch;
+	bool is_events =
+		bt_message_get_type(msg) == BT_MESSAGE_TYPE_DISCARDED_EVENTS;
+	const bt_stream *stream = is_events ?
+		bt_message_discarded_events_borrow_stream_const(msg) :
+		bt_message_discarded_packets_borrow_stream_const(msg);
+	const bt_stream_class *sc = bt_stream_borrow_class_const(stream);
+	struct ipc_sink_stream *ipc_stream;
+	bt_property_availability count_avail;
+	uint64_t count;
+	int ret;
+
+	ret = intern_stream(ipc_sink, stream, &ipc_stream);
+	if (ret) {
+		goto end;
+	}
+
+	ipc_write_uint(out, is_events ? IPC_TAG_MSG_DISCARDED_EVENTS :
+		IPC_TAG_MSG_DISCARDED_PACKETS);
+	ipc_write_uint(out, ipc_stream->id);
+
+	if (is_events) {
+		if (bt_stream_class_discarded_events_have_default_clock_snapshots(sc)) {
+			write_cs(out, ipc_stream,
+				bt_message_discarded_events_borrow_beginning_default_clock_snapshot_const(
+					msg));
+			write_cs(out, ipc_stream,
+				bt_message_discarded_events_borrow_end_default_clock_snapshot_const(
+					msg));
+		}
+
+		count_avail = bt_message_discarded_events_get_count(msg, &count);
+	} else {
+		if (bt_stream_class_discarded_packets_have_default_clock_snapshots(sc)) {
+			write_cs(out, ipc_stream,
+				bt_message_discarded_packets_borrow_beginning_default_clock_snapshot_const(
+					msg));
+			write_cs(out, ipc_stream,
+				bt_message_discarded_packets_borrow_end_default_clock_snapshot_const(
+					msg));
+		}
+
+		count_avail = bt_message_discarded_packets_get_count(msg, &count);
+	}
+
+	if (count_avail == BT_PROPERTY_AVAILABILITY_AVAILABLE) {
+		ipc_write_u8(out, 1);
+		ipc_write_uint(out, count);
+	} else {
+		ipc_write_u8(out, 0);
+	}
+
+end:
+	return ret;
+}
+
+static
+int write_inactivity_msg(struct ipc_sink *ipc_sink, const bt_message *msg)
+{
+	const bt_clock_snapshot *cs =
+		bt_message_message_iterator_inactivity_borrow_clock_snapshot_const(
+			msg);
+	uint64_t cc_id;
+	int ret;
+
+	ret = intern_clock_class(ipc_sink,
+		bt_clock_snapshot_borrow_clock_class_const(cs), &cc_id);
+	if (ret) {
+		goto end;
+	}
+
+	ipc_write_uint(ipc_sink->batch, IPC_TAG_MSG_ITER_INACTIVITY);
+	ipc_write_uint(ipc_sink->batch, cc_id);
+	ipc_write_uint(ipc_sink->batch, bt_clock_snapshot_get_value(cs));
+
+end:
+	return ret;
+}
+
+static
+int write_msg(struct ipc_sink *ipc_sink, const bt_message *msg)
+{
+	switch (bt_message_get_type(msg)) {
+	case BT_MESSAGE_TYPE_STREAM_BEGINNING:
+	case BT_MESSAGE_TYPE_STREAM_END:
+		return write_stream_msg(ipc_sink, msg);
+	case BT_MESSAGE_TYPE_PACKET_BEGINNING:
+	case BT_MESSAGE_TYPE_PACKET_END:
+		return write_packet_msg(ipc_sink, msg);
+	case BT_MESSAGE_TYPE_EVENT:
+		return write_event_msg(ipc_sink, msg);
+	case BT_MESSAGE_TYPE_DISCARDED_EVENTS:
+	case BT_MESSAGE_TYPE_DISCARDED_PACKETS:
+		return write_discarded_items_msg(ipc_sink, msg);
+	case BT_MESSAGE_TYPE_MESSAGE_ITERATOR_INACTIVITY:
+		return write_inactivity_msg(ipc_sink, msg);
+	default:
+		bt_common_abort();
+	}
+}
+
+void ipc_sink_finalize(bt_self_component_sink *self_comp_sink)
+{
+	destroy_ipc_sink(bt_self_component_get_data(
+		bt_self_component_sink_as_self_component(self_comp_sink)));
+}
+
+static
+int open_output(struct ipc_sink *ipc_sink, const char *path)
+{
+	int ret = 0;
+
+	if (strcmp(path, "-") == 0) {
+		ipc_sink->fd = STDOUT_FILENO;
+		ipc_sink->owns_fd = false;
+		goto end;
+	}
+
+	/*
+	 * Opening a FIFO blocks until a reader opens it, for example a
+	 * `src.utils.ipc` component of another process.
+	 */
+	ipc_sink->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_BINARY,
+		0666);
+	if (ipc_sink->fd < 0) {
+		BT_COMP_LOGE_APPEND_CAUSE_ERRNO(ipc_sink->self_comp,
+			"Cannot open output file", ": path=\"%s\"", path);
+		ret = -1;
+		goto end;
+	}
+
+	ipc_sink->owns_fd = true;
+
+end:
+	return ret;
+}
+
+bt_component_class_initialize_method_status ipc_sink_init(
+		bt_self_component_sink *self_comp_sink,
+		bt_self_component_sink_configuration *config __attribute__((unused)),
+		const bt_value *params,
+		void *init_method_data __attribute__((unused)))
+{
+	bt_self_component *self_comp =
+		bt_self_component_sink_as_self_component(self_comp_sink);
+	const bt_component *comp = bt_self_component_as_component(self_comp);
+	bt_logging_level log_level = bt_component_get_logging_level(comp);
+	struct ipc_sink *ipc_sink = g_new0(struct ipc_sink, 1);
+	bt_component_class_initialize_method_status status;
+	bt_self_component_add_port_status add_port_status;
+	enum bt_param_validation_status validation_status;
+	gchar *validate_error = NULL;
+	const char *path;
+	uint8_t header[IPC_HEADER_LEN];
+
+	if (!ipc_sink) {
+		/*
+		 * Don't use BT_COMP_LOGE_APPEND_CAUSE, as `ipc_sink` is
+		 * not initialized.
+		 */
+		BT_COMP_LOG_CUR_LVL(BT_LOG_ERROR, log_level, self_comp,
+			"Failed to allocate one IPC sink structure.");
+		BT_CURRENT_THREAD_ERROR_APPEND_CAUSE_FROM_COMPONENT(self_comp,
+			"Failed to allocate one IPC sink structure.");
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto end;
+	}
+
+	ipc_sink->log_level = log_level;
+	ipc_sink->self_comp = self_comp;
+	ipc_sink->fd = -1;
+	ipc_sink->batch = g_byte_array_sized_new(IPC_BATCH_SIZE * 2);
+	ipc_sink->trace_classes = g_hash_table_new_full(g_direct_hash,
+		g_direct_equal, put_trace_class_ref,
+		(GDestroyNotify) destroy_trace_class);
+	ipc_sink->clock_classes = g_hash_table_new_full(g_direct_hash,
+		g_direct_equal, put_clock_class_ref, NULL);
+	ipc_sink->stream_classes = g_hash_table_new_full(g_direct_hash,
+		g_direct_equal, put_stream_class_ref, NULL);
+	ipc_sink->event_classes = g_hash_table_new_full(g_direct_hash,
+		g_direct_equal, put_event_class_ref, NULL);
+	ipc_sink->traces = g_hash_table_new_full(g_direct_hash,
+		g_direct_equal, put_trace_ref, NULL);
+	ipc_sink->streams = g_hash_table_new_full(g_direct_hash,
+		g_direct_equal, put_stream_ref, g_free);
+	if (!ipc_sink->batch || !ipc_sink->trace_classes ||
+			!ipc_sink->clock_classes || !ipc_sink->stream_classes ||
+			!ipc_sink->event_classes || !ipc_sink->traces ||
+			!ipc_sink->streams) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+			"Failed to allocate component data.");
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	}
+
+	validation_status = bt_param_validation_validate(params,
+		ipc_sink_params, &validate_error);
+	if (validation_status == BT_PARAM_VALIDATION_STATUS_MEMORY_ERROR) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	} else if (validation_status == BT_PARAM_VALIDATION_STATUS_VALIDATION_ERROR) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp, "%s", validate_error);
+		goto error;
+	}
+
+	add_port_status = bt_self_component_sink_add_input_port(self_comp_sink,
+		"in", NULL, NULL);
+	if (add_port_status != BT_SELF_COMPONENT_ADD_PORT_STATUS_OK) {
+		status = (int) add_port_status;
+		goto error;
+	}
+
+	path = bt_value_string_get(
+		bt_value_map_borrow_entry_value_const(params, "path"));
+	if (open_output(ipc_sink, path)) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto error;
+	}
+
+	memcpy(header, IPC_MAGIC, IPC_MAGIC_LEN);
+	header[IPC_MAGIC_LEN] = IPC_VERSION;
+	if (write_all(ipc_sink, header, sizeof(header))) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto error;
+	}
+
+	bt_self_component_set_data(self_comp, ipc_sink);
+	BT_COMP_LOGI("Component initialized: path=\"%s\", fd=%d", path,
+		ipc_sink->fd);
+	status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
+	goto end;
+
+error:
+	destroy_ipc_sink(ipc_sink);
+
+end:
+	g_free(validate_error);
+	return status;
+}
+
+bt_component_class_sink_graph_is_configured_method_status
+ipc_sink_graph_is_configured(bt_self_component_sink *self_comp_sink)
+{
+	bt_component_class_sink_graph_is_configured_method_status status;
+	bt_message_iterator_create_from_sink_component_status
+		msg_iter_status;
+	struct ipc_sink *ipc_sink = bt_self_component_get_data(
+		bt_self_component_sink_as_self_component(self_comp_sink));
+	bt_message_iterator *iterator;
+
+	BT_ASSERT(ipc_sink);
+	msg_iter_status = bt_message_iterator_create_from_sink_component(
+		self_comp_sink,
+		bt_self_component_sink_borrow_input_port_by_name(
+			self_comp_sink, "in"), &iterator);
+	if (msg_iter_status != BT_MESSAGE_ITERATOR_CREATE_FROM_SINK_COMPONENT_STATUS_OK) {
+		BT_COMP_LOGE_APPEND_CAUSE(ipc_sink->self_comp,
+			"Cannot create message iterator on input port.");
+		status = (int) msg_iter_status;
+		goto end;
+	}
+
+	BT_MESSAGE_ITERATOR_MOVE_REF(ipc_sink->msg_iter, iterator);
+	status = BT_COMPONENT_CLASS_SINK_GRAPH_IS_CONFIGURED_METHOD_STATUS_OK;
+
+end:
+	return status;
+}
+
+bt_component_class_sink_consume_method_status ipc_sink_consume(
+		bt_self_component_sink *self_comp_sink)
+{
+	struct ipc_sink *ipc_sink = bt_self_component_get_data(
+		bt_self_component_sink_as_self_component(self_comp_sink));
+	bt_component_class_sink_consume_method_status status;
+	bt_message_iterator_next_status next_status;
+	bt_message_array_const msgs;
+	uint64_t count;
+	uint64_t i;
+	int ret = 0;
+
+	BT_ASSERT_DBG(ipc_sink);
+	BT_ASSERT_DBG(ipc_sink->msg_iter);
+	next_status = bt_message_iterator_next(ipc_sink->msg_iter, &msgs,
+		&count);
+	switch (next_status) {
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_OK:
+		for (i = 0; i < count; i++) {
+			if (ret == 0) {
+				ret = write_msg(ipc_sink, msgs[i]);
+			}
+
+			bt_message_put_ref(msgs[i]);
+		}
+
+		if (ret) {
+			status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_ERROR;
+			goto end;
+		}
+
+		if (ipc_sink->batch->len >= IPC_BATCH_SIZE) {
+			ret = flush_batch(ipc_sink);
+		}
+
+		status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_OK;
+		break;
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_AGAIN:
+		/*
+		 * Don't keep the reader waiting for what's already
+		 * available.
+		 */
+		ret = flush_batch(ipc_sink);
+		status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_AGAIN;
+		break;
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_END:
+		ipc_write_uint(ipc_sink->batch, IPC_TAG_END);
+		ret = flush_batch(ipc_sink);
+
+		if (ret == 0 && ipc_sink->owns_fd) {
+			if (close(ipc_sink->fd)) {
+				BT_COMP_LOGE_APPEND_CAUSE_ERRNO(ipc_sink->self_comp,
+					"Cannot close output file", ": fd=%d",
+					ipc_sink->fd);
+				ret = -1;
+			}
+
+			ipc_sink->fd = -1;
+		}
+
+		status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_END;
+		break;
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_ERROR:
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_MEMORY_ERROR:
+		BT_COMP_LOGE_APPEND_CAUSE(ipc_sink->self_comp,
+			"Failed to get messages from upstream component");
+		status = (int) next_status;
+		goto end;
+	default:
+		bt_common_abort();
+	}
+
+	if (ret) {
+		status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_ERROR;
+	}
+
+end:
+	return status;
+}
@@ -0,0 +1,34 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_IPC_SINK_H
+#define BABELTRACE_PLUGINS_UTILS_IPC_SINK_H
+
+#include <babeltrace2/babeltrace.h>
+#include "common/macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bt_component_class_initialize_method_status ipc_sink_init(
+		bt_self_component_sink *self_comp,
+		bt_self_component_sink_configuration *config,
+		const bt_value *params, void *init_method_data);
+
+void ipc_sink_finalize(bt_self_component_sink *self_comp);
+
+bt_component_class_sink_graph_is_configured_method_status
+ipc_sink_graph_is_configured(bt_self_component_sink *self_comp);
+
+bt_component_class_sink_consume_method_status ipc_sink_consume(
+		bt_self_component_sink *self_comp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BABELTRACE_PLUGINS_UTILS_IPC_SINK_H */
@@ -0,0 +1,2325 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS Inc.
+ */
+
+#define BT_COMP_LOG_SELF_COMP (ipc_src->self_comp)
+#define BT_LOG_OUTPUT_LEVEL (ipc_src->log_level)
+#define BT_LOG_TAG "PLUGIN/SRC.UTILS.IPC"
+#include "logging/comp-logging.h"
+
+#include "ipc-src.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include "common/common.h"
+#include "common/assert.h"
+#include "common/uuid.h"
+#include <babeltrace2/babeltrace.h>
+#include <glib.h>
+#include "plugins/common/param-validation/param-validation.h"
+
+#include "ipc.h"
+
+/* Read the input by chunks of at least this size (bytes) */
+#define IPC_READ_SIZE		(64 * 1024)
+
+/* Maximum nesting level of values and field classes */
+#define IPC_MAX_DEPTH		256
+
+struct ipc_src_trace_class {
+	/* Owned by this */
+	bt_trace_class *tc;
+
+	/* `bt_field_class *` (weak) by ordinal (see `ipc.h`) */
+	GPtrArray *fcs;
+};
+
+struct ipc_src_stream {
+	/* Owned by this */
+	bt_stream *stream;
+
+	/* Current packet (owned by this), if any */
+	bt_packet *packet;
+
+	/* Last decoded clock snapshot value */
+	uint64_t last_cs;
+};
+
+struct ipc_src {
+	bt_logging_level log_level;
+	bt_self_component *self_comp;
+
+	/* Weak; `NULL` until the message iterator exists */
+	bt_self_message_iterator *self_msg_iter;
+
+	/* Input file descriptor (-1 if closed) */
+	int fd;
+
+	/* True if the component owns `fd` (not the standard input) */
+	bool owns_fd;
+
+	/*
+	 * True once a message iterator exists: the input can only be read
+	 * once.
+	 */
+	bool has_msg_iter;
+
+	/* Input data which follows the offset `in_pos` isn't consumed */
+	GByteArray *in_buf;
+	size_t in_pos;
+
+	/* Current batch (points within `in_buf`) */
+	struct ipc_reader batch;
+
+	/* True once the end record is decoded */
+	bool ended;
+
+	/* Owned `struct ipc_src_trace_class *` by ID minus one */
+	GPtrArray *trace_classes;
+
+	/* Owned `bt_clock_class *` by ID minus one */
+	GPtrArray *clock_classes;
+
+	/* Owned `bt_stream_class *` by ID minus one */
+	GPtrArray *stream_classes;
+
+	/* Owned `bt_event_class *` by ID minus one */
+	GPtrArray *event_classes;
+
+	/* Owned `bt_trace *` by ID minus one */
+	GPtrArray *traces;
+
+	/*
+	 * Owned `struct ipc_src_stream *` by ID minus one (`NULL` after
+	 * the stream end message)
+	 */
+	GPtrArray *streams;
+};
+
+static
+struct bt_param_validation_map_value_entry_descr ipc_src_params[] = {
+	{ "path", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_MANDATORY, { .type = BT_VALUE_TYPE_STRING } },
+	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
+};
+
+static
+void destroy_trace_class(struct ipc_src_trace_class *tc)
+{
+	if (tc->fcs) {
+		g_ptr_array_free(tc->fcs, TRUE);
+	}
+
+	bt_trace_class_put_ref(tc->tc);
+	g_free(tc);
+}
+
+static
+void destroy_stream(struct ipc_src_stream *stream)
+{
+	if (!stream) {
+		return;
+	}
+
+	bt_packet_put_ref(stream->packet);
+	bt_stream_put_ref(stream->stream);
+	g_free(stream);
+}
+
+static
+void destroy_ipc_src(struct ipc_src *ipc_src)
+{
+	if (!ipc_src) {
+		return;
+	}
+
+	if (ipc_src->owns_fd && ipc_src->fd >= 0) {
+		close(ipc_src->fd);
+	}
+
+	if (ipc_src->in_buf) {
+		g_byte_array_free(ipc_src->in_buf, TRUE);
+	}
+
+	if (ipc_src->streams) {
+		g_ptr_array_free(ipc_src->streams, TRUE);
+	}
+
+	if (ipc_src->traces) {
+		g_ptr_array_free(ipc_src->traces, TRUE);
+	}
+
+	if (ipc_src->event_classes) {
+		g_ptr_array_free(ipc_src->event_classes, TRUE);
+	}
+
+	if (ipc_src->stream_classes) {
+		g_ptr_array_free(ipc_src->stream_classes, TRUE);
+	}
+
+	if (ipc_src->clock_classes) {
+		g_ptr_array_free(ipc_src->clock_classes, TRUE);
+	}
+
+	if (ipc_src->trace_classes) {
+		g_ptr_array_free(ipc_src->trace_classes, TRUE);
+	}
+
+	g_free(ipc_src);
+}
+
+/*
+ * Makes sure that at least `len` bytes of input data follow
+ * `ipc_src->in_pos`, reading the input file descriptor as needed.
+ *
+ * Returns 0 on success, 1 if the input ends before, or -1 on error.
+ */
+static
+int fill_input(struct ipc_src *ipc_src, size_t len)
+{
+	GByteArray *in_buf = ipc_src->in_buf;
+	int ret = 0;
+
+	if (in_buf->len - ipc_src->in_pos >= len) {
+		goto end;
+	}
+
+	/* Discard the consumed data */
+	g_byte_array_remove_range(in_buf, 0, ipc_src->in_pos);
+	ipc_src->in_pos = 0;
+
+	while (in_buf->len < len) {
+		guint avail = in_buf->len;
+		size_t read_len = MAX(len - avail, IPC_READ_SIZE);
+		ssize_t read_ret;
+
+		g_byte_array_set_size(in_buf, avail + read_len);
+		read_ret = read(ipc_src->fd, &in_buf->data[avail], read_len);
+		g_byte_array_set_size(in_buf, avail + MAX(read_ret, 0));
+
+		if (read_ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			BT_COMP_LOGE_APPEND_CAUSE_ERRNO(ipc_src->self_comp,
+				"Cannot read input", ": fd=%d", ipc_src->fd);
+			ret = -1;
+			goto end;
+		} else if (read_ret == 0) {
+			ret = 1;
+			goto end;
+		}
+	}
+
+end:
+	return ret;
+}
+
+static
+int read_header(struct ipc_src *ipc_src)
+{
+	const uint8_t *header;
+	int ret;
+
+	ret = fill_input(ipc_src, IPC_HEADER_LEN);
+	if (ret < 0) {
+		goto end;
+	}
+
+	header = &ipc_src->in_buf->data[ipc_src->in_pos];
+	if (ret > 0 || memcmp(header, IPC_MAGIC, IPC_MAGIC_LEN) != 0) {
+		BT_COMP_LOGE_APPEND_CAUSE(ipc_src->self_comp,
+			"Input doesn't start with an IPC header.");
+		ret = -1;
+		goto end;
+	}
+
+	if (header[IPC_MAGIC_LEN] != IPC_VERSION) {
+		BT_COMP_LOGE_APPEND_CAUSE(ipc_src->self_comp,
+			"Unsupported IPC format version: version=%u, expected-version=%u",
+			(unsigned int) header[IPC_MAGIC_LEN], IPC_VERSION);
+		ret = -1;
+		goto end;
+	}
+
+	ipc_src->in_pos += IPC_HEADER_LEN;
+
+end:
+	return ret;
+}
+
+/*
+ * Reads the next batch of the input, making `ipc_src->batch` point to
+ * it.
+ *
+ * Returns 0 on success, 1 if the input ends before the next batch, or
+ * -1 on error.
+ */
+static
+int read_batch(struct ipc_src *ipc_src)
+{
+	uint64_t batch_len = 0;
+	unsigned int shift = 0;
+	size_t prefix_len = 0;
+	int ret;
+
+	/* Consume the previous batch */
+	ipc_src->in_pos += ipc_src->batch.len;
+	ipc_src->batch.buf = NULL;
+	ipc_src->batch.len = 0;
+	ipc_src->batch.pos = 0;
+
+	while (true) {
+		uint8_t byte;
+
+		ret = fill_input(ipc_src, prefix_len + 1);
+		if (ret < 0 || (ret > 0 && prefix_len == 0)) {
+			goto end;
+		}
+
+		if (ret > 0 || prefix_len == IPC_UINT_MAX_LEN) {
+			goto invalid;
+		}
+
+		byte = ipc_src->in_buf->data[ipc_src->in_pos + prefix_len];
+		batch_len |= (uint64_t) (byte & 0x7f) << shift;
+		prefix_len++;
+		shift += 7;
+
+		if (!(byte & 0x80)) {
+			break;
+		}
+	}
+
+	if (batch_len == 0 || batch_len > G_MAXUINT - IPC_READ_SIZE) {
+		goto invalid;
+	}
+
+	ipc_src->in_pos += prefix_len;
+	ret = fill_input(ipc_src, batch_len);
+	if (ret < 0) {
+		goto end;
+	} else if (ret > 0) {
+		goto invalid;
+	}
+
+	ipc_src->batch.buf = &ipc_src->in_buf->data[ipc_src->in_pos];
+	ipc_src->batch.len = batch_len;
+	BT_COMP_LOGD("Read batch: len=%" PRIu64, batch_len);
+	goto end;
+
+invalid:
+	BT_COMP_LOGE_APPEND_CAUSE(ipc_src->self_comp,
+		"Truncated or invalid batch: len=%" PRIu64, batch_len);
+	ret = -1;
+
+end:
+	return ret;
+}
+
+static
+bt_value *read_value(struct ipc_reader *reader, unsigned int depth)
+{
+	bt_value *value = NULL;
+	bt_value *elem = NULL;
+	uint64_t type;
+	char *str = NULL;
+	uint64_t i;
+
+	if (depth > IPC_MAX_DEPTH || ipc_read_uint(reader, &type)) {
+		goto error;
+	}
+
+	switch (type) {
+	case IPC_VALUE_TYPE_NULL:
+		value = bt_value_null;
+		bt_value_get_ref(value);
+		break;
+	case IPC_VALUE_TYPE_BOOL:
+	{
+		uint8_t val;
+
+		if (ipc_read_u8(reader, &val)) {
+			goto error;
+		}
+
+		value = bt_value_bool_create_init(val);
+		break;
+	}
+	case IPC_VALUE_TYPE_UNSIGNED_INTEGER:
+	{
+		uint64_t val;
+
+		if (ipc_read_uint(reader, &val)) {
+			goto error;
+		}
+
+		value = bt_value_integer_unsigned_create_init(val);
+		break;
+	}
+	case IPC_VALUE_TYPE_SIGNED_INTEGER:
+	{
+		int64_t val;
+
+		if (ipc_read_sint(reader, &val)) {
+			goto error;
+		}
+
+		value = bt_value_integer_signed_create_init(val);
+		break;
+	}
+	case IPC_VALUE_TYPE_REAL:
+	{
+		double val;
+
+		if (ipc_read_double(reader, &val)) {
+			goto error;
+		}
+
+		value = bt_value_real_create_init(val);
+		break;
+	}
+	case IPC_VALUE_TYPE_STRING:
+		if (ipc_read_string(reader, &str)) {
+			goto error;
+		}
+
+		value = bt_value_string_create_init(str);
+		break;
+	case IPC_VALUE_TYPE_ARRAY:
+	case IPC_VALUE_TYPE_MAP:
+	{
+		uint64_t count;
+
+		if (ipc_read_uint(reader, &count)) {
+			goto error;
+		}
+
+		value = type == IPC_VALUE_TYPE_ARRAY ? bt_value_array_create() :
+			bt_value_map_create();
+		if (!value) {
+			goto error;
+		}
+
+		for (i = 0; i < count; i++) {
+			if (type == IPC_VALUE_TYPE_MAP) {
+				g_free(str);
+				str = NULL;
+
+				if (ipc_read_string(reader, &str)) {
+					goto error;
+				}
+			}
+
+			elem = read_value(reader, depth + 1);
+			if (!elem) {
+				goto error;
+			}
+
+			if (type == IPC_VALUE_TYPE_ARRAY) {
+				if (bt_value_array_append_element(value, elem) !=
+						BT_VALUE_ARRAY_APPEND_ELEMENT_STATUS_OK) {
+					goto error;
+				}
+			} else {
+				if (bt_value_map_insert_entry(value, str, elem) !=
+						BT_VALUE_MAP_INSERT_ENTRY_STATUS_OK) {
+					goto error;
+				}
+			}
+
+			BT_VALUE_PUT_REF_AND_RESET(elem);
+		}
+
+		break;
+	}
+	default:
+		goto error;
+	}
+
+	goto end;
+
+error:
+	BT_VALUE_PUT_REF_AND_RESET(value);
+
+end:
+	bt_value_put_ref(elem);
+	g_free(str);
+	return value;
+}
+
+/*
+ * Reads user attributes, setting `*attrs` to them, or to `NULL` if
+ * there are none.
+ */
+static
+int read_user_attributes(struct ipc_reader *reader, bt_value **attrs)
+{
+	int ret = 0;
+
+	*attrs = read_value(reader, 0);
+	if (!*attrs || !bt_value_is_map(*attrs)) {
+		BT_VALUE_PUT_REF_AND_RESET(*attrs);
+		ret = -1;
+		goto end;
+	}
+
+	if (bt_value_map_is_empty(*attrs)) {
+		BT_VALUE_PUT_REF_AND_RESET(*attrs);
+	}
+
+end:
+	return ret;
+}
+
+static
+int read_uuid(struct ipc_reader *reader, const uint8_t **uuid)
+{
+	uint8_t has_uuid;
+
+	*uuid = NULL;
+
+	if (ipc_read_u8(reader, &has_uuid)) {
+		return -1;
+	}
+
+	if (!has_uuid) {
+		return 0;
+	}
+
+	return ipc_read_raw(reader, BT_UUID_LEN, uuid);
+}
+
+/*
+ * Reads an object ID and sets `*obj` to the corresponding entry of
+ * `objs`, failing if it doesn't exist.
+ */
+static
+int read_obj_ref(struct ipc_reader *reader, GPtrArray *objs, void **obj)
+{
+	uint64_t id;
+
+	if (ipc_read_uint(reader, &id) || id == 0 || id > objs->len) {
+		return -1;
+	}
+
+	*obj = g_ptr_array_index(objs, id - 1);
+	return *obj ? 0 : -1;
+}
+
+/*
+ * Reads the ID of a new object and checks that it's the next ID of
+ * `objs`.
+ */
+static
+int read_new_obj_id(struct ipc_reader *reader, GPtrArray *objs)
+{
+	uint64_t id;
+
+	if (ipc_read_uint(reader, &id) || id != (uint64_t) objs->len + 1) {
+		return -1;
+	}
+
+	return 0;
+}
+
+static
+bt_integer_range_set_unsigned *read_unsigned_ranges(
+		struct ipc_reader *reader)
+{
+	bt_integer_range_set_unsigned *ranges =
+		bt_integer_range_set_unsigned_create();
+	uint64_t count;
+	uint64_t i;
+
+	if (!ranges || ipc_read_uint(reader, &count)) {
+		goto error;
+	}
+
+	for (i = 0; i < count; i++) {
+		uint64_t lower, upper;
+
+		if (ipc_read_uint(reader, &lower) ||
+				ipc_read_uint(reader, &upper) || lower > upper) {
+			goto error;
+		}
+
+		if (bt_integer_range_set_unsigned_add_range(ranges, lower,
+				upper) != BT_INTEGER_RANGE_SET_ADD_RANGE_STATUS_OK) {
+			goto error;
+		}
+	}
+
+	goto end;
+
+error:
+	BT_INTEGER_RANGE_SET_UNSIGNED_PUT_REF_AND_RESET(ranges);
+
+end:
+	return ranges;
+}
+
+static
+bt_integer_range_set_signed *read_signed_ranges(struct ipc_reader *reader)
+{
+	bt_integer_range_set_signed *ranges =
+		bt_integer_range_set_signed_create();
+	uint64_t count;
+	uint64_t i;
+
+	if (!ranges || ipc_read_uint(reader, &count)) {
+		goto error;
+	}
+
+	for (i = 0; i < count; i++) {
+		int64_t lower, upper;
+
+		if (ipc_read_sint(reader, &lower) ||
+				ipc_read_sint(reader, &upper) || lower > upper) {
+			goto error;
+		}
+
+		if (bt_integer_range_set_signed_add_range(ranges, lower,
+				upper) != BT_INTEGER_RANGE_SET_ADD_RANGE_STATUS_OK) {
+			goto error;
+		}
+	}
+
+	goto end;
+
+error:
+	BT_INTEGER_RANGE_SET_SIGNED_PUT_REF_AND_RESET(ranges);
+
+end:
+	return ranges;
+}
+
+/*
+ * Reads a field class ordinal and returns the corresponding, already
+ * decoded field class of `tc` if its type is `expected_type`, or `NULL`
+ * otherwise.
+ */
+static
+bt_field_class *read_fc_ref(struct ipc_reader *reader,
+		struct ipc_src_trace_class *tc, bt_field_class_type expected_type)
+{
+	uint64_t ordinal;
+	bt_field_class *fc;
+
+	if (ipc_read_uint(reader, &ordinal) || ordinal >= tc->fcs->len) {
+		return NULL;
+	}
+
+	fc = g_ptr_array_index(tc->fcs, ordinal);
+	if (!fc || !bt_field_class_type_is(bt_field_class_get_type(fc),
+			expected_type)) {
+		return NULL;
+	}
+
+	return fc;
+}
+
+static
+bt_field_class *read_fc(struct ipc_src *ipc_src, struct ipc_reader *reader,
+		struct ipc_src_trace_class *tc, unsigned int depth)
+{
+	bt_trace_class *trace_class = tc->tc;
+	bt_field_class *fc = NULL;
+	bt_field_class *sub_fc = NULL;
+	bt_field_class *ref_fc = NULL;
+	bt_integer_range_set_unsigned *unsigned_ranges = NULL;
+	bt_integer_range_set_signed *signed_ranges = NULL;
+	bt_value *attrs = NULL;
+	bt_value *member_attrs = NULL;
+	char *name = NULL;
+	guint ordinal = tc->fcs->len;
+	uint64_t type;
+	uint64_t count;
+	uint64_t i;
+
+	/* Reserve the ordinal of this field class (pre-order) */
+	g_ptr_array_add(tc->fcs, NULL);
+
+	if (depth > IPC_MAX_DEPTH || ipc_read_uint(reader, &type) ||
+			read_user_attributes(reader, &attrs)) {
+		goto error;
+	}
+
+	switch (type) {
+	case IPC_FC_TYPE_BOOL:
+		fc = bt_field_class_bool_create(trace_class);
+		break;
+	case IPC_FC_TYPE_BIT_ARRAY:
+		if (ipc_read_uint(reader, &count) || count == 0 || count > 64) {
+			goto error;
+		}
+
+		fc = bt_field_class_bit_array_create(trace_class, count);
+		break;
+	case IPC_FC_TYPE_UNSIGNED_INTEGER:
+	case IPC_FC_TYPE_SIGNED_INTEGER:
+	case IPC_FC_TYPE_UNSIGNED_ENUMERATION:
+	case IPC_FC_TYPE_SIGNED_ENUMERATION:
+	{
+		uint64_t range, base;
+
+		if (ipc_read_uint(reader, &range) || range == 0 || range > 64 ||
+				ipc_read_uint(reader, &base) ||
+				(base != 2 && base != 8 && base != 10 &&
+					base != 16)) {
+			goto error;
+		}
+
+		if (type == IPC_FC_TYPE_UNSIGNED_INTEGER) {
+			fc = bt_field_class_integer_unsigned_create(trace_class);
+		} else if (type == IPC_FC_TYPE_SIGNED_INTEGER) {
+			fc = bt_field_class_integer_signed_create(trace_class);
+		} else if (type == IPC_FC_TYPE_UNSIGNED_ENUMERATION) {
+			fc = bt_field_class_enumeration_unsigned_create(trace_class);
+		} else {
+			fc = bt_field_class_enumeration_signed_create(trace_class);
+		}
+
+		if (!fc) {
+			goto error;
+		}
+
+		bt_field_class_integer_set_field_value_range(fc, range);
+		bt_field_class_integer_set_preferred_display_base(fc, base);
+
+		if (type == IPC_FC_TYPE_UNSIGNED_INTEGER ||
+				type == IPC_FC_TYPE_SIGNED_INTEGER) {
+			break;
+		}
+
+		if (ipc_read_uint(reader, &count)) {
+			goto error;
+		}
+
+		for (i = 0; i < count; i++) {
+			g_free(name);
+			name = NULL;
+
+			if (ipc_read_string(reader, &name)) {
+				goto error;
+			}
+
+			if (type == IPC_FC_TYPE_UNSIGNED_ENUMERATION) {
+				unsigned_ranges = read_unsigned_ranges(reader);
+				if (!unsigned_ranges ||
+						bt_field_class_enumeration_unsigned_add_mapping(
+							fc, name, unsigned_ranges) !=
+						BT_FIELD_CLASS_ENUMERATION_ADD_MAPPING_STATUS_OK) {
+					goto error;
+				}
+
+				BT_INTEGER_RANGE_SET_UNSIGNED_PUT_REF_AND_RESET(
+					unsigned_ranges);
+			} else {
+				signed_ranges = read_signed_ranges(reader);
+				if (!signed_ranges ||
+						bt_field_class_enumeration_signed_add_mapping(
+							fc, name, signed_ranges) !=
+						BT_FIELD_CLASS_ENUMERATION_ADD_MAPPING_STATUS_OK) {
+					goto error;
+				}
+
+				BT_INTEGER_RANGE_SET_SIGNED_PUT_REF_AND_RESET(
+					signed_ranges);
+			}
+		}
+
+		break;
+	}
+	case IPC_FC_TYPE_SINGLE_PRECISION_REAL:
+		fc = bt_field_class_real_single_precision_create(trace_class);
+		break;
+	case IPC_FC_TYPE_DOUBLE_PRECISION_REAL:
+		fc = bt_field_class_real_double_precision_create(trace_class);
+		break;
+	case IPC_FC_TYPE_STRING:
+		fc = bt_field_class_string_create(trace_class);
+		break;
+	case IPC_FC_TYPE_STRUCTURE:
+		fc = bt_field_class_structure_create(trace_class);
+		if (!fc || ipc_read_uint(reader, &count)) {
+			goto error;
+		}
+
+		for (i = 0; i < count; i++) {
+			g_free(name);
+			name = NULL;
+
+			if (ipc_read_string(reader, &name)) {
+				goto error;
+			}
+
+			sub_fc = read_fc(ipc_src, reader, tc, depth + 1);
+			if (!sub_fc ||
+					read_user_attributes(reader, &member_attrs)) {
+				goto error;
+			}
+
+			if (bt_field_class_structure_append_member(fc, name,
+					sub_fc) !=
+					BT_FIELD_CLASS_STRUCTURE_APPEND_MEMBER_STATUS_OK) {
+				goto error;
+			}
+
+			if (member_attrs) {
+				bt_field_class_structure_member_set_user_attributes(
+					bt_field_class_structure_borrow_member_by_index(
+						fc, i), member_attrs);
+				BT_VALUE_PUT_REF_AND_RESET(member_attrs);
+			}
+
+			BT_FIELD_CLASS_PUT_REF_AND_RESET(sub_fc);
+		}
+
+		break;
+	case IPC_FC_TYPE_STATIC_ARRAY:
+		sub_fc = read_fc(ipc_src, reader, tc, depth + 1);
+		if (!sub_fc || ipc_read_uint(reader, &count)) {
+			goto error;
+		}
+
+		fc = bt_field_class_array_static_create(trace_class, sub_fc,
+			count);
+		break;
+	case IPC_FC_TYPE_DYNAMIC_ARRAY_WITH_LENGTH_FIELD:
+		ref_fc = read_fc_ref(reader, tc,
+			BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER);
+		if (!ref_fc) {
+			goto error;
+		}
+
+		/* Fall through */
+	case IPC_FC_TYPE_DYNAMIC_ARRAY:
+		sub_fc = read_fc(ipc_src, reader, tc, depth + 1);
+		if (!sub_fc) {
+			goto error;
+		}
+
+		fc = bt_field_class_array_dynamic_create(trace_class, sub_fc,
+			ref_fc);
+		break;
+	case IPC_FC_TYPE_OPTION:
+		sub_fc = read_fc(ipc_src, reader, tc, depth + 1);
+		if (!sub_fc) {
+			goto error;
+		}
+
+		fc = bt_field_class_option_without_selector_create(trace_class,
+			sub_fc);
+		break;
+	case IPC_FC_TYPE_OPTION_WITH_BOOL_SELECTOR_FIELD:
+	{
+		uint8_t is_reversed;
+
+		ref_fc = read_fc_ref(reader, tc, BT_FIELD_CLASS_TYPE_BOOL);
+		if (!ref_fc || ipc_read_u8(reader, &is_reversed)) {
+			goto error;
+		}
+
+		sub_fc = read_fc(ipc_src, reader, tc, depth + 1);
+		if (!sub_fc) {
+			goto error;
+		}
+
+		fc = bt_field_class_option_with_selector_field_bool_create(
+			trace_class, sub_fc, ref_fc);
+		if (!fc) {
+			goto error;
+		}
+
+		bt_field_class_option_with_selector_field_bool_set_selector_is_reversed(
+			fc, is_reversed);
+		break;
+	}
+	case IPC_FC_TYPE_OPTION_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD:
+		ref_fc = read_fc_ref(reader, tc,
+			BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER);
+		unsigned_ranges = ref_fc ? read_unsigned_ranges(reader) : NULL;
+		if (!unsigned_ranges) {
+			goto error;
+		}
+
+		sub_fc = read_fc(ipc_src, reader, tc, depth + 1);
+		if (!sub_fc) {
+			goto error;
+		}
+
+		fc = bt_field_class_option_with_selector_field_integer_unsigned_create(
+			trace_class, sub_fc, ref_fc, unsigned_ranges);
+		break;
+	case IPC_FC_TYPE_OPTION_WITH_SIGNED_INTEGER_SELECTOR_FIELD:
+		ref_fc = read_fc_ref(reader, tc,
+			BT_FIELD_CLASS_TYPE_SIGNED_INTEGER);
+		signed_ranges = ref_fc ? read_signed_ranges(reader) : NULL;
+		if (!signed_ranges) {
+			goto error;
+		}
+
+		sub_fc = read_fc(ipc_src, reader, tc, depth + 1);
+		if (!sub_fc) {
+			goto error;
+		}
+
+		fc = bt_field_class_option_with_selector_field_integer_signed_create(
+			trace_class, sub_fc, ref_fc, signed_ranges);
+		break;
+	case IPC_FC_TYPE_VARIANT_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD:
+	case IPC_FC_TYPE_VARIANT_WITH_SIGNED_INTEGER_SELECTOR_FIELD:
+		ref_fc = read_fc_ref(reader, tc,
+			type == IPC_FC_TYPE_VARIANT_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD ?
+				BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER :
+				BT_FIELD_CLASS_TYPE_SIGNED_INTEGER);
+		if (!ref_fc) {
+			goto error;
+		}
+
+		/* Fall through */
+	case IPC_FC_TYPE_VARIANT:
+		fc = bt_field_class_variant_create(trace_class, ref_fc);
+		if (!fc || ipc_read_uint(reader, &count)) {
+			goto error;
+		}
+
+		for (i = 0; i < count; i++) {
+			bool append_ok;
+
+			g_free(name);
+			name = NULL;
+
+			if (ipc_read_string(reader, &name)) {
+				goto error;
+			}
+
+			if (type == IPC_FC_TYPE_VARIANT_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD) {
+				unsigned_ranges = read_unsigned_ranges(reader);
+				if (!unsigned_ranges) {
+					goto error;
+				}
+			} else if (type == IPC_FC_TYPE_VARIANT_WITH_SIGNED_INTEGER_SELECTOR_FIELD) {
+				signed_ranges = read_signed_ranges(reader);
+				if (!signed_ranges) {
+					goto error;
+				}
+			}
+
+			sub_fc = read_fc(ipc_src, reader, tc, depth + 1);
+			if (!sub_fc ||
+					read_user_attributes(reader, &member_attrs)) {
+				goto error;
+			}
+
+			if (unsigned_ranges) {
+				append_ok = bt_field_class_variant_with_selector_field_integer_unsigned_append_option(
+					fc, name, sub_fc, unsigned_ranges) ==
+					BT_FIELD_CLASS_VARIANT_WITH_SELECTOR_FIELD_APPEND_OPTION_STATUS_OK;
+			} else if (signed_ranges) {
+				append_ok = bt_field_class_variant_with_selector_field_integer_signed_append_option(
+					fc, name, sub_fc, signed_ranges) ==
+					BT_FIELD_CLASS_VARIANT_WITH_SELECTOR_FIELD_APPEND_OPTION_STATUS_OK;
+			} else {
+				append_ok = bt_field_class_variant_without_selector_append_option(
+					fc, name, sub_fc) ==
+					BT_FIELD_CLASS_VARIANT_WITHOUT_SELECTOR_FIELD_APPEND_OPTION_STATUS_OK;
+			}
+
+			if (!append_ok) {
+				goto error;
+			}
+
+			if (member_attrs) {
+				bt_field_class_variant_option_set_user_attributes(
+					bt_field_class_variant_borrow_option_by_index(
+						fc, i), member_attrs);
+				BT_VALUE_PUT_REF_AND_RESET(member_attrs);
+			}
+
+			BT_FIELD_CLASS_PUT_REF_AND_RESET(sub_fc);
+			BT_INTEGER_RANGE_SET_UNSIGNED_PUT_REF_AND_RESET(
+				unsigned_ranges);
+			BT_INTEGER_RANGE_SET_SIGNED_PUT_REF_AND_RESET(
+				signed_ranges);
+		}
+
+		break;
+	default:
+		goto error;
+	}
+
+	if (!fc) {
+		goto error;
+	}
+
+	if (attrs) {
+		bt_field_class_set_user_attributes(fc, attrs);
+	}
+
+	g_ptr_array_index(tc->fcs, ordinal) = fc;
+	goto end;
+
+error:
+	BT_COMP_LOGE_APPEND_CAUSE(ipc_src->self_comp,
+		"Cannot decode field class: ordinal=%u", ordinal);
+	BT_FIELD_CLASS_PUT_REF_AND_RESET(fc);
+
+end:
+	bt_field_class_put_ref(sub_fc);
+	bt_integer_range_set_unsigned_put_ref(unsigned_ranges);
+	bt_integer_range_set_signed_put_ref(signed_ranges);
+	bt_value_put_ref(attrs);
+	bt_value_put_ref(member_attrs);
+	g_free(name);
+	return fc;
+}
+
+/*
+ * Reads an optional field class (see read_fc()), setting `*fc` to it,
+ * or to `NULL` if there's none.
+ */
+static
+int read_opt_fc(struct ipc_src *ipc_src, struct ipc_reader *reader,
+		struct ipc_src_trace_class *tc, bt_field_class **fc)
+{
+	uint8_t has_fc;
+
+	*fc = NULL;
+
+	if (ipc_read_u8(reader, &has_fc)) {
+		return -1;
+	}
+
+	if (!has_fc) {
+		return 0;
+	}
+
+	*fc = read_fc(ipc_src, reader, tc, 0);
+	return *fc ? 0 : -1;
+}
+
+static
+int read_trace_class_record(struct ipc_src *ipc_src,
+		struct ipc_reader *reader)
+{
+	struct ipc_src_trace_class *tc = NULL;
+	bt_value *attrs = NULL;
+	int ret = 0;
+
+	if (read_new_obj_id(reader, ipc_src->trace_classes) ||
+			read_user_attributes(reader, &attrs)) {
+		goto error;
+	}
+
+	tc = g_new0(struct ipc_src_trace_class, 1);
+	if (!tc) {
+		goto error;
+	}
+
+	tc->fcs = g_ptr_array_new();
+	tc->tc = bt_trace_class_create(ipc_src->self_comp);
+	if (!tc->fcs || !tc->tc) {
+		goto error;
+	}
+
+	/* Keep the original stream class IDs */
+	bt_trace_class_set_assigns_automatic_stream_class_id(tc->tc, BT_FALSE);
+
+	if (attrs) {
+		bt_trace_class_set_user_attributes(tc->tc, attrs);
+	}
+
+	g_ptr_array_add(ipc_src->trace_classes, tc);
+	tc = NULL;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	if (tc) {
+		destroy_trace_class(tc);
+	}
+
+	bt_value_put_ref(attrs);
+	return ret;
+}
+
+static
+int read_clock_class_record(struct ipc_src *ipc_src,
+		struct ipc_reader *reader)
+{
+	bt_clock_class *cc = NULL;
+	bt_value *attrs = NULL;
+	char *name = NULL;
+	char *description = NULL;
+	uint64_t frequency, precision, offset_cycles;
+	int64_t offset_seconds;
+	uint8_t origin_is_unix_epoch;
+	const uint8_t *uuid;
+	int ret = 0;
+
+	if (read_new_obj_id(reader, ipc_src->clock_classes) ||
+			ipc_read_opt_string(reader, &name) ||
+			ipc_read_opt_string(reader, &description) ||
+			ipc_read_uint(reader, &frequency) ||
+			ipc_read_uint(reader, &precision) ||
+			ipc_read_sint(reader, &offset_seconds) ||
+			ipc_read_uint(reader, &offset_cycles) ||
+			ipc_read_u8(reader, &origin_is_unix_epoch) ||
+			read_uuid(reader, &uuid) ||
+			read_user_attributes(reader, &attrs)) {
+		goto error;
+	}
+
+	if (frequency == 0 || offset_cycles >= frequency) {
+		goto error;
+	}
+
+	cc = bt_clock_class_create(ipc_src->self_comp);
+	if (!cc) {
+		goto error;
+	}
+
+	if (name && bt_clock_class_set_name(cc, name) !=
+			BT_CLOCK_CLASS_SET_NAME_STATUS_OK) {
+		goto error;
+	}
+
+	if (description && bt_clock_class_set_description(cc, description) !=
+			BT_CLOCK_CLASS_SET_DESCRIPTION_STATUS_OK) {
+		goto error;
+	}
+
+	bt_clock_class_set_frequency(cc, frequency);
+	bt_clock_class_set_precision(cc, precision);
+	bt_clock_class_set_offset(cc, offset_seconds, offset_cycles);
+	bt_clock_class_set_origin_is_unix_epoch(cc, origin_is_unix_epoch);
+
+	if (uuid) {
+		bt_clock_class_set_uuid(cc, uuid);
+	}
+
+	if (attrs) {
+		bt_clock_class_set_user_attributes(cc, attrs);
+	}
+
+	g_ptr_array_add(ipc_src->clock_classes, cc);
+	cc = NULL;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	bt_clock_class_put_ref(cc);
+	bt_value_put_ref(attrs);
+	g_free(name);
+	g_free(description);
+	return ret;
+}
+
+static
+int read_stream_class_record(struct ipc_src *ipc_src,
+		struct ipc_reader *reader)
+{
+	struct ipc_src_trace_class *tc;
+	bt_stream_class *sc = NULL;
+	bt_clock_class *cc = NULL;
+	bt_field_class *fc = NULL;
+	bt_value *attrs = NULL;
+	char *name = NULL;
+	uint64_t sc_id, cc_id, flags;
+	int ret = 0;
+
+	if (read_new_obj_id(reader, ipc_src->stream_classes) ||
+			read_obj_ref(reader, ipc_src->trace_classes,
+				(void **) &tc) ||
+			ipc_read_uint(reader, &sc_id) ||
+			ipc_read_opt_string(reader, &name) ||
+			ipc_read_uint(reader, &cc_id)) {
+		goto error;
+	}
+
+	if (cc_id != 0) {
+		if (cc_id > ipc_src->clock_classes->len) {
+			goto error;
+		}
+
+		cc = g_ptr_array_index(ipc_src->clock_classes, cc_id - 1);
+	}
+
+	if (ipc_read_uint(reader, &flags)) {
+		goto error;
+	}
+
+	/* Check the library's preconditions */
+	if (!cc && (flags & (IPC_SC_FLAG_PACKETS_HAVE_BEGINNING_CS |
+			IPC_SC_FLAG_PACKETS_HAVE_END_CS |
+			IPC_SC_FLAG_DISCARDED_EVENTS_HAVE_CS |
+			IPC_SC_FLAG_DISCARDED_PACKETS_HAVE_CS))) {
+		goto error;
+	}
+
+	if (!(flags & IPC_SC_FLAG_SUPPORTS_PACKETS) &&
+			(flags & (IPC_SC_FLAG_PACKETS_HAVE_BEGINNING_CS |
+				IPC_SC_FLAG_PACKETS_HAVE_END_CS |
+				IPC_SC_FLAG_SUPPORTS_DISCARDED_PACKETS))) {
+		goto error;
+	}
+
+	if ((!(flags & IPC_SC_FLAG_SUPPORTS_DISCARDED_EVENTS) &&
+			(flags & IPC_SC_FLAG_DISCARDED_EVENTS_HAVE_CS)) ||
+			(!(flags & IPC_SC_FLAG_SUPPORTS_DISCARDED_PACKETS) &&
+			(flags & IPC_SC_FLAG_DISCARDED_PACKETS_HAVE_CS))) {
+		goto error;
+	}
+
+	sc = bt_stream_class_create_with_id(tc->tc, sc_id);
+	if (!sc) {
+		goto error;
+	}
+
+	/* Keep the original event class and stream IDs */
+	bt_stream_class_set_assigns_automatic_event_class_id(sc, BT_FALSE);
+	bt_stream_class_set_assigns_automatic_stream_id(sc, BT_FALSE);
+
+	if (name && bt_stream_class_set_name(sc, name) !=
+			BT_STREAM_CLASS_SET_NAME_STATUS_OK) {
+		goto error;
+	}
+
+	if (cc && bt_stream_class_set_default_clock_class(sc, cc) !=
+			BT_STREAM_CLASS_SET_DEFAULT_CLOCK_CLASS_STATUS_OK) {
+		goto error;
+	}
+
+	bt_stream_class_set_supports_packets(sc,
+		!!(flags & IPC_SC_FLAG_SUPPORTS_PACKETS),
+		!!(flags & IPC_SC_FLAG_PACKETS_HAVE_BEGINNING_CS),
+		!!(flags & IPC_SC_FLAG_PACKETS_HAVE_END_CS));
+	bt_stream_class_set_supports_discarded_events(sc,
+		!!(flags & IPC_SC_FLAG_SUPPORTS_DISCARDED_EVENTS),
+		!!(flags & IPC_SC_FLAG_DISCARDED_EVENTS_HAVE_CS));
+	bt_stream_class_set_supports_discarded_packets(sc,
+		!!(flags & IPC_SC_FLAG_SUPPORTS_DISCARDED_PACKETS),
+		!!(flags & IPC_SC_FLAG_DISCARDED_PACKETS_HAVE_CS));
+
+	if (read_opt_fc(ipc_src, reader, tc, &fc)) {
+		goto error;
+	}
+
+	if (fc) {
+		if (!(flags & IPC_SC_FLAG_SUPPORTS_PACKETS) ||
+				bt_stream_class_set_packet_context_field_class(sc,
+					fc) != BT_STREAM_CLASS_SET_FIELD_CLASS_STATUS_OK) {
+			goto error;
+		}
+
+		BT_FIELD_CLASS_PUT_REF_AND_RESET(fc);
+	}
+
+	if (read_opt_fc(ipc_src, reader, tc, &fc)) {
+		goto error;
+	}
+
+	if (fc) {
+		if (bt_stream_class_set_event_common_context_field_class(sc,
+				fc) != BT_STREAM_CLASS_SET_FIELD_CLASS_STATUS_OK) {
+			goto error;
+		}
+
+		BT_FIELD_CLASS_PUT_REF_AND_RESET(fc);
+	}
+
+	if (read_user_attributes(reader, &attrs)) {
+		goto error;
+	}
+
+	if (attrs) {
+		bt_stream_class_set_user_attributes(sc, attrs);
+	}
+
+	g_ptr_array_add(ipc_src->stream_classes, sc);
+	sc = NULL;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	bt_stream_class_put_ref(sc);
+	bt_field_class_put_ref(fc);
+	bt_value_put_ref(attrs);
+	g_free(name);
+	return ret;
+}
+
+/*
+ * Returns the decoding data of the trace class of the stream class
+ * `sc`.
+ */
+static
+struct ipc_src_trace_class *borrow_trace_class_of_stream_class(
+		struct ipc_src *ipc_src, const bt_stream_class *sc)
+{
+	const bt_trace_class *trace_class =
+		bt_stream_class_borrow_trace_class_const(sc);
+	guint i;
+
+	for (i = 0; i < ipc_src->trace_classes->len; i++) {
+		struct ipc_src_trace_class *tc =
+			g_ptr_array_index(ipc_src->trace_classes, i);
+
+		if (tc->tc == trace_class) {
+			return tc;
+		}
+	}
+
+	bt_common_abort();
+}
+
+static
+int read_event_class_record(struct ipc_src *ipc_src,
+		struct ipc_reader *reader)
+{
+	struct ipc_src_trace_class *tc;
+	bt_stream_class *sc;
+	bt_event_class *ec = NULL;
+	bt_field_class *fc = NULL;
+	bt_value *attrs = NULL;
+	char *name = NULL;
+	char *emf_uri = NULL;
+	uint64_t ec_id, log_level;
+	int ret = 0;
+
+	if (read_new_obj_id(reader, ipc_src->event_classes) ||
+			read_obj_ref(reader, ipc_src->stream_classes,
+				(void **) &sc) ||
+			ipc_read_uint(reader, &ec_id) ||
+			ipc_read_opt_string(reader, &name) ||
+			ipc_read_uint(reader, &log_level) ||
+			log_level > (uint64_t) BT_EVENT_CLASS_LOG_LEVEL_DEBUG + 1 ||
+			ipc_read_opt_string(reader, &emf_uri)) {
+		goto error;
+	}
+
+	tc = borrow_trace_class_of_stream_class(ipc_src, sc);
+	ec = bt_event_class_create_with_id(sc, ec_id);
+	if (!ec) {
+		goto error;
+	}
+
+	if (name && bt_event_class_set_name(ec, name) !=
+			BT_EVENT_CLASS_SET_NAME_STATUS_OK) {
+		goto error;
+	}
+
+	if (log_level > 0) {
+		bt_event_class_set_log_level(ec,
+			(bt_event_class_log_level) (log_level - 1));
+	}
+
+	if (emf_uri && bt_event_class_set_emf_uri(ec, emf_uri) !=
+			BT_EVENT_CLASS_SET_EMF_URI_STATUS_OK) {
+		goto error;
+	}
+
+	if (read_opt_fc(ipc_src, reader, tc, &fc)) {
+		goto error;
+	}
+
+	if (fc) {
+		if (bt_event_class_set_specific_context_field_class(ec, fc) !=
+				BT_EVENT_CLASS_SET_FIELD_CLASS_STATUS_OK) {
+			goto error;
+		}
+
+		BT_FIELD_CLASS_PUT_REF_AND_RESET(fc);
+	}
+
+	if (read_opt_fc(ipc_src, reader, tc, &fc)) {
+		goto error;
+	}
+
+	if (fc) {
+		if (bt_event_class_set_payload_field_class(ec, fc) !=
+				BT_EVENT_CLASS_SET_FIELD_CLASS_STATUS_OK) {
+			goto error;
+		}
+
+		BT_FIELD_CLASS_PUT_REF_AND_RESET(fc);
+	}
+
+	if (read_user_attributes(reader, &attrs)) {
+		goto error;
+	}
+
+	if (attrs) {
+		bt_event_class_set_user_attributes(ec, attrs);
+	}
+
+	g_ptr_array_add(ipc_src->event_classes, ec);
+	ec = NULL;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	bt_event_class_put_ref(ec);
+	bt_field_class_put_ref(fc);
+	bt_value_put_ref(attrs);
+	g_free(name);
+	g_free(emf_uri);
+	return ret;
+}
+
+static
+int read_trace_record(struct ipc_src *ipc_src, struct ipc_reader *reader)
+{
+	struct ipc_src_trace_class *tc;
+	bt_trace *trace = NULL;
+	bt_value *value = NULL;
+	char *name = NULL;
+	const uint8_t *uuid;
+	uint64_t count;
+	uint64_t i;
+	int ret = 0;
+
+	if (read_new_obj_id(reader, ipc_src->traces) ||
+			read_obj_ref(reader, ipc_src->trace_classes,
+				(void **) &tc) ||
+			ipc_read_opt_string(reader, &name) ||
+			read_uuid(reader, &uuid) ||
+			ipc_read_uint(reader, &count)) {
+		goto error;
+	}
+
+	trace = bt_trace_create(tc->tc);
+	if (!trace) {
+		goto error;
+	}
+
+	if (name && bt_trace_set_name(trace, name) !=
+			BT_TRACE_SET_NAME_STATUS_OK) {
+		goto error;
+	}
+
+	if (uuid) {
+		bt_trace_set_uuid(trace, uuid);
+	}
+
+	for (i = 0; i < count; i++) {
+		bt_trace_set_environment_entry_status set_status;
+
+		g_free(name);
+		name = NULL;
+
+		if (ipc_read_string(reader, &name)) {
+			goto error;
+		}
+
+		value = read_value(reader, 0);
+		if (!value) {
+			goto error;
+		}
+
+		if (bt_value_is_signed_integer(value)) {
+			set_status = bt_trace_set_environment_entry_integer(
+				trace, name, bt_value_integer_signed_get(value));
+		} else if (bt_value_is_string(value)) {
+			set_status = bt_trace_set_environment_entry_string(
+				trace, name, bt_value_string_get(value));
+		} else {
+			goto error;
+		}
+
+		if (set_status != BT_TRACE_SET_ENVIRONMENT_ENTRY_STATUS_OK) {
+			goto error;
+		}
+
+		BT_VALUE_PUT_REF_AND_RESET(value);
+	}
+
+	if (read_user_attributes(reader, &value)) {
+		goto error;
+	}
+
+	if (value) {
+		bt_trace_set_user_attributes(trace, value);
+	}
+
+	g_ptr_array_add(ipc_src->traces, trace);
+	trace = NULL;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	bt_trace_put_ref(trace);
+	bt_value_put_ref(value);
+	g_free(name);
+	return ret;
+}
+
+static
+int read_stream_record(struct ipc_src *ipc_src, struct ipc_reader *reader)
+{
+	struct ipc_src_stream *stream = NULL;
+	bt_trace *trace;
+	bt_stream_class *sc;
+	bt_value *attrs = NULL;
+	char *name = NULL;
+	uint64_t stream_id;
+	int ret = 0;
+
+	if (read_new_obj_id(reader, ipc_src->streams) ||
+			read_obj_ref(reader, ipc_src->traces, (void **) &trace) ||
+			read_obj_ref(reader, ipc_src->stream_classes,
+				(void **) &sc) ||
+			ipc_read_uint(reader, &stream_id) ||
+			ipc_read_opt_string(reader, &name) ||
+			read_user_attributes(reader, &attrs)) {
+		goto error;
+	}
+
+	if (bt_stream_class_borrow_trace_class_const(sc) !=
+			bt_trace_borrow_class_const(trace)) {
+		goto error;
+	}
+
+	stream = g_new0(struct ipc_src_stream, 1);
+	if (!stream) {
+		goto error;
+	}
+
+	stream->stream = bt_stream_create_with_id(sc, trace, stream_id);
+	if (!stream->stream) {
+		goto error;
+	}
+
+	if (name && bt_stream_set_name(stream->stream, name) !=
+			BT_STREAM_SET_NAME_STATUS_OK) {
+		goto error;
+	}
+
+	if (attrs) {
+		bt_stream_set_user_attributes(stream->stream, attrs);
+	}
+
+	g_ptr_array_add(ipc_src->streams, stream);
+	stream = NULL;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	destroy_stream(stream);
+	bt_value_put_ref(attrs);
+	g_free(name);
+	return ret;
+}
+
+/*
+ * Returns whether or not the encoding of a field of which the class is
+ * `fc` can be empty (zero bytes).
+ */
+static
+bool field_class_encoding_can_be_empty(const bt_field_class *fc)
+{
+	bt_field_class_type fc_type = bt_field_class_get_type(fc);
+	uint64_t i;
+
+	if (fc_type == BT_FIELD_CLASS_TYPE_STRUCTURE) {
+		for (i = 0; i < bt_field_class_structure_get_member_count(fc);
+				i++) {
+			if (!field_class_encoding_can_be_empty(
+					bt_field_class_structure_member_borrow_field_class_const(
+						bt_field_class_structure_borrow_member_by_index_const(
+							fc, i)))) {
+				return false;
+			}
+		}
+
+		return true;
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_STATIC_ARRAY) {
+		return bt_field_class_array_static_get_length(fc) == 0 ||
+			field_class_encoding_can_be_empty(
+				bt_field_class_array_borrow_element_field_class_const(
+					fc));
+	}
+
+	/*
+	 * Any other field has at least one byte: a value, a length, a
+	 * "has field" flag, or a selected option index.
+	 */
+	return false;
+}
+
+static
+int read_field(struct ipc_reader *reader, bt_field *field)
+{
+	bt_field_class_type fc_type = bt_field_get_class_type(field);
+	uint64_t i;
+	int ret = 0;
+
+	if (fc_type == BT_FIELD_CLASS_TYPE_BOOL) {
+		uint8_t val;
+
+		ret = ipc_read_u8(reader, &val);
+		if (ret == 0) {
+			bt_field_bool_set_value(field, val);
+		}
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_BIT_ARRAY) {
+		uint64_t val;
+
+		ret = ipc_read_uint(reader, &val);
+		if (ret == 0) {
+			bt_field_bit_array_set_value_as_integer(field, val);
+		}
+	} else if (bt_field_class_type_is(fc_type,
+			BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER)) {
+		uint64_t val;
+
+		ret = ipc_read_uint(reader, &val);
+		if (ret == 0) {
+			bt_field_integer_unsigned_set_value(field, val);
+		}
+	} else if (bt_field_class_type_is(fc_type,
+			BT_FIELD_CLASS_TYPE_SIGNED_INTEGER)) {
+		int64_t val;
+
+		ret = ipc_read_sint(reader, &val);
+		if (ret == 0) {
+			bt_field_integer_signed_set_value(field, val);
+		}
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL) {
+		float val;
+
+		ret = ipc_read_float(reader, &val);
+		if (ret == 0) {
+			bt_field_real_single_precision_set_value(field, val);
+		}
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL) {
+		double val;
+
+		ret = ipc_read_double(reader, &val);
+		if (ret == 0) {
+			bt_field_real_double_precision_set_value(field, val);
+		}
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_STRING) {
+		const char *str;
+		uint64_t len;
+
+		ret = ipc_read_bytes(reader, &str, &len);
+		if (ret == 0) {
+			bt_field_string_clear(field);
+
+			if (bt_field_string_append_with_length(field, str, len) !=
+					BT_FIELD_STRING_APPEND_STATUS_OK) {
+				ret = -1;
+			}
+		}
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_STRUCTURE) {
+		uint64_t member_count = bt_field_class_structure_get_member_count(
+			bt_field_borrow_class_const(field));
+
+		for (i = 0; i < member_count && ret == 0; i++) {
+			ret = read_field(reader,
+				bt_field_structure_borrow_member_field_by_index(
+					field, i));
+		}
+	} else if (bt_field_class_type_is(fc_type,
+			BT_FIELD_CLASS_TYPE_ARRAY)) {
+		uint64_t length;
+
+		if (fc_type == BT_FIELD_CLASS_TYPE_STATIC_ARRAY) {
+			length = bt_field_array_get_length(field);
+		} else {
+			const bt_field_class *elem_fc =
+				bt_field_class_array_borrow_element_field_class_const(
+					bt_field_borrow_class_const(field));
+
+			ret = ipc_read_uint(reader, &length);
+
+			/*
+			 * Validate the length before allocating the
+			 * elements: each element has at least one
+			 * encoded byte, unless its encoding can be
+			 * empty.
+			 */
+			if (ret == 0 &&
+					(field_class_encoding_can_be_empty(elem_fc) ?
+						length > IPC_EMPTY_ELEM_ARRAY_MAX_LEN :
+						length > reader->len - reader->pos)) {
+				ret = -1;
+			}
+
+			if (ret == 0 && bt_field_array_dynamic_set_length(field,
+					length) !=
+					BT_FIELD_DYNAMIC_ARRAY_SET_LENGTH_STATUS_OK) {
+				ret = -1;
+			}
+		}
+
+		for (i = 0; ret == 0 && i < length; i++) {
+			ret = read_field(reader,
+				bt_field_array_borrow_element_field_by_index(
+					field, i));
+		}
+	} else if (bt_field_class_type_is(fc_type,
+			BT_FIELD_CLASS_TYPE_OPTION)) {
+		uint8_t has_field;
+
+		ret = ipc_read_u8(reader, &has_field);
+		if (ret == 0) {
+			bt_field_option_set_has_field(field, has_field);
+
+			if (has_field) {
+				ret = read_field(reader,
+					bt_field_option_borrow_field(field));
+			}
+		}
+	} else if (bt_field_class_type_is(fc_type,
+			BT_FIELD_CLASS_TYPE_VARIANT)) {
+		uint64_t index;
+
+		ret = ipc_read_uint(reader, &index);
+		if (ret == 0 && (index >= bt_field_class_variant_get_option_count(
+					bt_field_borrow_class_const(field)) ||
+				bt_field_variant_select_option_by_index(field,
+					index) !=
+				BT_FIELD_VARIANT_SELECT_OPTION_STATUS_OK)) {
+			ret = -1;
+		}
+
+		if (ret == 0) {
+			ret = read_field(reader,
+				bt_field_variant_borrow_selected_option_field(
+					field));
+		}
+	} else {
+		bt_common_abort();
+	}
+
+	return ret;
+}
+
+static
+int read_opt_field(struct ipc_reader *reader, bt_field *field)
+{
+	return field ? read_field(reader, field) : 0;
+}
+
+/*
+ * Reads a stream ID, setting `*stream` to the corresponding stream and
+ * `*index` to its index within `ipc_src->streams`.
+ */
+static
+int read_stream_ref(struct ipc_src *ipc_src, struct ipc_reader *reader,
+		struct ipc_src_stream **stream, guint *index)
+{
+	uint64_t id;
+
+	if (ipc_read_uint(reader, &id) || id == 0 ||
+			id > ipc_src->streams->len) {
+		return -1;
+	}
+
+	*index = id - 1;
+	*stream = g_ptr_array_index(ipc_src->streams, *index);
+	return *stream ? 0 : -1;
+}
+
+static
+int read_cs(struct ipc_reader *reader, struct ipc_src_stream *stream,
+		uint64_t *value)
+{
+	int64_t delta;
+
+	if (ipc_read_sint(reader, &delta)) {
+		return -1;
+	}
+
+	*value = stream->last_cs + (uint64_t) delta;
+	stream->last_cs = *value;
+	return 0;
+}
+
+static
+int read_stream_msg_record(struct ipc_src *ipc_src,
+		struct ipc_reader *reader, bool is_beginning, bt_message **msg)
+{
+	struct ipc_src_stream *stream;
+	uint8_t is_known = 0;
+	uint64_t cs = 0;
+	guint index;
+
+	if (read_stream_ref(ipc_src, reader, &stream, &index)) {
+		return -1;
+	}
+
+	if (bt_stream_class_borrow_default_clock_class_const(
+			bt_stream_borrow_class_const(stream->stream))) {
+		if (ipc_read_u8(reader, &is_known) ||
+				(is_known && read_cs(reader, stream, &cs))) {
+			return -1;
+		}
+	}
+
+	if (is_beginning) {
+		*msg = bt_message_stream_beginning_create(
+			ipc_src->self_msg_iter, stream->stream);
+		if (*msg && is_known) {
+			bt_message_stream_beginning_set_default_clock_snapshot(
+				*msg, cs);
+		}
+	} else {
+		*msg = bt_message_stream_end_create(ipc_src->self_msg_iter,
+			stream->stream);
+		if (*msg && is_known) {
+			bt_message_stream_end_set_default_clock_snapshot(*msg,
+				cs);
+		}
+
+		/*
+		 * No more messages for this stream: the message holds a
+		 * reference on it.
+		 */
+		destroy_stream(stream);
+		g_ptr_array_index(ipc_src->streams, index) = NULL;
+	}
+
+	return *msg ? 0 : -1;
+}
+
+static
+int read_packet_msg_record(struct ipc_src *ipc_src,
+		struct ipc_reader *reader, bool is_beginning, bt_message **msg)
+{
+	struct ipc_src_stream *stream;
+	const bt_stream_class *sc;
+	guint index;
+	uint64_t cs;
+	bool has_cs;
+
+	if (read_stream_ref(ipc_src, reader, &stream, &index)) {
+		return -1;
+	}
+
+	sc = bt_stream_borrow_class_const(stream->stream);
+	if (!bt_stream_class_supports_packets(sc)) {
+		return -1;
+	}
+
+	if (is_beginning) {
+		has_cs = bt_stream_class_packets_have_beginning_default_clock_snapshot(sc);
+		if (has_cs && read_cs(reader, stream, &cs)) {
+			return -1;
+		}
+
+		BT_PACKET_PUT_REF_AND_RESET(stream->packet);
+		stream->packet = bt_packet_create(stream->stream);
+		if (!stream->packet ||
+				read_opt_field(reader,
+					bt_packet_borrow_context_field(
+						stream->packet))) {
+			return -1;
+		}
+
+		*msg = has_cs ?
+			bt_message_packet_beginning_create_with_default_clock_snapshot(
+				ipc_src->self_msg_iter, stream->packet, cs) :
+			bt_message_packet_beginning_create(
+				ipc_src->self_msg_iter, stream->packet);
+	} else {
+		if (!stream->packet) {
+			return -1;
+		}
+
+		has_cs = bt_stream_class_packets_have_end_default_clock_snapshot(sc);
+		if (has_cs && read_cs(reader, stream, &cs)) {
+			return -1;
+		}
+
+		*msg = has_cs ?
+			bt_message_packet_end_create_with_default_clock_snapshot(
+				ipc_src->self_msg_iter, stream->packet, cs) :
+			bt_message_packet_end_create(ipc_src->self_msg_iter,
+				stream->packet);
+		BT_PACKET_PUT_REF_AND_RESET(stream->packet);
+	}
+
+	return *msg ? 0 : -1;
+}
+
+static
+int read_event_msg_record(struct ipc_src *ipc_src,
+		struct ipc_reader *reader, bt_message **msg)
+{
+	struct ipc_src_stream *stream;
+	const bt_stream_class *sc;
+	guint index;
+	bt_event_class *ec;
+	bt_event *event;
+	uint64_t cs = 0;
+	bool has_cs;
+
+	if (read_stream_ref(ipc_src, reader, &stream, &index) ||
+			read_obj_ref(reader, ipc_src->event_classes,
+				(void **) &ec)) {
+		return -1;
+	}
+
+	sc = bt_stream_borrow_class_const(stream->stream);
+	if (bt_event_class_borrow_stream_class_const(ec) != sc) {
+		return -1;
+	}
+
+	has_cs = bt_stream_class_borrow_default_clock_class_const(sc) != NULL;
+	if (has_cs && read_cs(reader, stream, &cs)) {
+		return -1;
+	}
+
+	if (bt_stream_class_supports_packets(sc)) {
+		if (!stream->packet) {
+			return -1;
+		}
+
+		*msg = has_cs ?
+			bt_message_event_create_with_packet_and_default_clock_snapshot(
+				ipc_src->self_msg_iter, ec, stream->packet, cs) :
+			bt_message_event_create_with_packet(
+				ipc_src->self_msg_iter, ec, stream->packet);
+	} else {
+		*msg = has_cs ?
+			bt_message_event_create_with_default_clock_snapshot(
+				ipc_src->self_msg_iter, ec, stream->stream, cs) :
+			bt_message_event_create(ipc_src->self_msg_iter, ec,
+				stream->stream);
+	}
+
+	if (!*msg) {
+		return -1;
+	}
+
+	event = bt_message_event_borrow_event(*msg);
+	if (read_opt_field(reader,
+				bt_event_borrow_common_context_field(event)) ||
+			read_opt_field(reader,
+				bt_event_borrow_specific_context_field(event)) ||
+			read_opt_field(reader,
+				bt_event_borrow_payload_field(event))) {
+		return -1;
+	}
+
+	return 0;
+}
+
+static
+int read_discarded_items_msg_record(struct ipc_src *ipc_src,
+		struct ipc_reader *reader, bool is_events, bt_message **msg)
+{
+	struct ipc_src_stream *stream;
+	const bt_stream_class *sc;
+	guint index;
+	uint64_t beginning_cs = 0, end_cs = 0, count = 0;
+	uint8_t has_count;
+	bool has_cs;
+
+	if (read_stream_ref(ipc_src, reader, &stream, &index)) {
+		return -1;
+	}
+
+	sc = bt_stream_borrow_class_const(stream->stream);
+	if (is_events) {
+		if (!bt_stream_class_supports_discarded_events(sc)) {
+			return -1;
+		}
+
+		has_cs = bt_stream_class_discarded_events_have_default_clock_snapshots(sc);
+	} else {
+		if (!bt_stream_class_supports_discarded_packets(sc)) {
+			return -1;
+		}
+
+		has_cs = bt_stream_class_discarded_packets_have_default_clock_snapshots(sc);
+	}
+
+	if (has_cs && (read_cs(reader, stream, &beginning_cs) ||
+			read_cs(reader, stream, &end_cs) ||
+			beginning_cs > end_cs)) {
+		return -1;
+	}
+
+	if (ipc_read_u8(reader, &has_count) ||
+			(has_count && (ipc_read_uint(reader, &count) ||
+				count == 0))) {
+		return -1;
+	}
+
+	if (is_events) {
+		*msg = has_cs ?
+			bt_message_discarded_events_create_with_default_clock_snapshots(
+				ipc_src->self_msg_iter, stream->stream,
+				beginning_cs, end_cs) :
+			bt_message_discarded_events_create(
+				ipc_src->self_msg_iter, stream->stream);
+		if (*msg && has_count) {
+			bt_message_discarded_events_set_count(*msg, count);
+		}
+	} else {
+		*msg = has_cs ?
+			bt_message_discarded_packets_create_with_default_clock_snapshots(
+				ipc_src->self_msg_iter, stream->stream,
+				beginning_cs, end_cs) :
+			bt_message_discarded_packets_create(
+				ipc_src->self_msg_iter, stream->stream);
+		if (*msg && has_count) {
+			bt_message_discarded_packets_set_count(*msg, count);
+		}
+	}
+
+	return *msg ? 0 : -1;
+}
+
+static
+int read_inactivity_msg_record(struct ipc_src *ipc_src,
+		struct ipc_reader *reader, bt_message **msg)
+{
+	bt_clock_class *cc;
+	uint64_t value;
+
+	if (read_obj_ref(reader, ipc_src->clock_classes, (void **) &cc) ||
+			ipc_read_uint(reader, &value)) {
+		return -1;
+	}
+
+	*msg = bt_message_message_iterator_inactivity_create(
+		ipc_src->self_msg_iter, cc, value);
+	return *msg ? 0 : -1;
+}
+
+/*
+ * Decodes the next record of the current batch, setting `*msg` to the
+ * created message, if any.
+ */
+static
+int read_record(struct ipc_src *ipc_src, bt_message **msg)
+{
+	struct ipc_reader *reader = &ipc_src->batch;
+	size_t offset = reader->pos;
+	uint64_t tag = 0;
+	int ret;
+
+	*msg = NULL;
+	ret = ipc_read_uint(reader, &tag);
+	if (ret) {
+		goto end;
+	}
+
+	switch (tag) {
+	case IPC_TAG_TRACE_CLASS:
+		ret = read_trace_class_record(ipc_src, reader);
+		break;
+	case IPC_TAG_CLOCK_CLASS:
+		ret = read_clock_class_record(ipc_src, reader);
+		break;
+	case IPC_TAG_STREAM_CLASS:
+		ret = read_stream_class_record(ipc_src, reader);
+		break;
+	case IPC_TAG_EVENT_CLASS:
+		ret = read_event_class_record(ipc_src, reader);
+		break;
+	case IPC_TAG_TRACE:
+		ret = read_trace_record(ipc_src, reader);
+		break;
+	case IPC_TAG_STREAM:
+		ret = read_stream_record(ipc_src, reader);
+		break;
+	case IPC_TAG_MSG_STREAM_BEGINNING:
+	case IPC_TAG_MSG_STREAM_END:
+		ret = read_stream_msg_record(ipc_src, reader,
+			tag == IPC_TAG_MSG_STREAM_BEGINNING, msg);
+		break;
+	case IPC_TAG_MSG_PACKET_BEGINNING:
+	case IPC_TAG_MSG_PACKET_END:
+		ret = read_packet_msg_record(ipc_src, reader,
+			tag == IPC_TAG_MSG_PACKET_BEGINNING, msg);
+		break;
+	case IPC_TAG_MSG_EVENT:
+		ret = read_event_msg_record(ipc_src, reader, msg);
+		break;
+	case IPC_TAG_MSG_DISCARDED_EVENTS:
+	case IPC_TAG_MSG_DISCARDED_PACKETS:
+		ret = read_discarded_items_msg_record(ipc_src, reader,
+			tag == IPC_TAG_MSG_DISCARDED_EVENTS, msg);
+		break;
+	case IPC_TAG_MSG_ITER_INACTIVITY:
+		ret = read_inactivity_msg_record(ipc_src, reader, msg);
+		break;
+	case IPC_TAG_END:
+		ipc_src->ended = true;
+		break;
+	default:
+		ret = -1;
+		break;
+	}
+
+end:
+	if (ret) {
+		BT_MESSAGE_PUT_REF_AND_RESET(*msg);
+		BT_COMP_LOGE_APPEND_CAUSE(ipc_src->self_comp,
+			"Cannot decode record: tag=%" PRIu64 ", batch-offset=%zu",
+			tag, offset);
+	}
+
+	return ret;
+}
+
+bt_message_iterator_class_next_method_status ipc_src_msg_iter_next(
+		bt_self_message_iterator *self_msg_iter,
+		bt_message_array_const msgs, uint64_t capacity,
+		uint64_t *count)
+{
+	struct ipc_src *ipc_src =
+		bt_self_message_iterator_get_data(self_msg_iter);
+	bt_message_iterator_class_next_method_status status =
+		BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+	uint64_t i = 0;
+
+	while (i < capacity && !ipc_src->ended) {
+		bt_message *msg;
+
+		if (ipc_src->batch.pos == ipc_src->batch.len) {
+			int ret;
+
+			/*
+			 * Don't block on the input while having messages
+			 * to return.
+			 */
+			if (i > 0) {
+				break;
+			}
+
+			ret = read_batch(ipc_src);
+			if (ret > 0) {
+				BT_COMP_LOGE_APPEND_CAUSE(ipc_src->self_comp,
+					"Input ended without an end record: "
+					"the writer may have been terminated.");
+				ret = -1;
+			}
+
+			if (ret) {
+				status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+				goto end;
+			}
+		}
+
+		if (read_record(ipc_src, &msg)) {
+			status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+			goto end;
+		}
+
+		if (msg) {
+			msgs[i] = msg;
+			i++;
+		}
+	}
+
+	if (i == 0) {
+		BT_ASSERT(ipc_src->ended);
+		status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_END;
+	}
+
+end:
+	if (status == BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK) {
+		*count = i;
+	} else {
+		uint64_t j;
+
+		for (j = 0; j < i; j++) {
+			bt_message_put_ref(msgs[j]);
+		}
+	}
+
+	return status;
+}
+
+bt_message_iterator_class_initialize_method_status ipc_src_msg_iter_init(
+		bt_self_message_iterator *self_msg_iter,
+		bt_self_message_iterator_configuration *config __attribute__((unused)),
+		bt_self_component_port_output *self_port __attribute__((unused)))
+{
+	struct ipc_src *ipc_src = bt_self_component_get_data(
+		bt_self_message_iterator_borrow_component(self_msg_iter));
+	bt_message_iterator_class_initialize_method_status status;
+
+	if (ipc_src->has_msg_iter) {
+		BT_COMP_LOGE_APPEND_CAUSE(ipc_src->self_comp,
+			"Cannot create more than one message iterator: "
+			"the input can only be read once.");
+		status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto end;
+	}
+
+	ipc_src->has_msg_iter = true;
+	ipc_src->self_msg_iter = self_msg_iter;
+	bt_self_message_iterator_set_data(self_msg_iter, ipc_src);
+	status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_OK;
+
+end:
+	return status;
+}
+
+void ipc_src_msg_iter_finalize(bt_self_message_iterator *self_msg_iter)
+{
+	struct ipc_src *ipc_src =
+		bt_self_message_iterator_get_data(self_msg_iter);
+
+	ipc_src->self_msg_iter = NULL;
+}
+
+static
+int open_input(struct ipc_src *ipc_src, const char *path)
+{
+	int ret = 0;
+
+	if (strcmp(path, "-") == 0) {
+		ipc_src->fd = STDIN_FILENO;
+		ipc_src->owns_fd = false;
+		goto end;
+	}
+
+	/*
+	 * Opening a FIFO blocks until a writer opens it, for example a
+	 * `sink.utils.ipc` component of another process.
+	 */
+	ipc_src->fd = open(path, O_RDONLY | O_BINARY);
+	if (ipc_src->fd < 0) {
+		BT_COMP_LOGE_APPEND_CAUSE_ERRNO(ipc_src->self_comp,
+			"Cannot open input file", ": path=\"%s\"", path);
+		ret = -1;
+		goto end;
+	}
+
+	ipc_src->owns_fd = true;
+
+end:
+	return ret;
+}
+
+bt_component_class_initialize_method_status ipc_src_init(
+		bt_self_component_source *self_comp_src,
+		bt_self_component_source_configuration *config __attribute__((unused)),
+		const bt_value *params,
+		void *init_method_data __attribute__((unused)))
+{
+	bt_self_component *self_comp =
+		bt_self_component_source_as_self_component(self_comp_src);
+	const bt_component *comp = bt_self_component_as_component(self_comp);
+	bt_logging_level log_level = bt_component_get_logging_level(comp);
+	struct ipc_src *ipc_src = g_new0(struct ipc_src, 1);
+	bt_component_class_initialize_method_status status;
+	bt_self_component_add_port_status add_port_status;
+	enum bt_param_validation_status validation_status;
+	gchar *validate_error = NULL;
+	const char *path;
+
+	if (!ipc_src) {
+		/*
+		 * Don't use BT_COMP_LOGE_APPEND_CAUSE, as `ipc_src` is
+		 * not initialized.
+		 */
+		BT_COMP_LOG_CUR_LVL(BT_LOG_ERROR, log_level, self_comp,
+			"Failed to allocate one IPC source structure.");
+		BT_CURRENT_THREAD_ERROR_APPEND_CAUSE_FROM_COMPONENT(self_comp,
+			"Failed to allocate one IPC source structure.");
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto end;
+	}
+
+	ipc_src->log_level = log_level;
+	ipc_src->self_comp = self_comp;
+	ipc_src->fd = -1;
+	ipc_src->in_buf = g_byte_array_sized_new(IPC_READ_SIZE);
+	ipc_src->trace_classes = g_ptr_array_new_with_free_func(
+		(GDestroyNotify) destroy_trace_class);
+	ipc_src->clock_classes = g_ptr_array_new_with_free_func(
+		(GDestroyNotify) bt_clock_class_put_ref);
+	ipc_src->stream_classes = g_ptr_array_new_with_free_func(
+		(GDestroyNotify) bt_stream_class_put_ref);
+	ipc_src->event_classes = g_ptr_array_new_with_free_func(
+		(GDestroyNotify) bt_event_class_put_ref);
+	ipc_src->traces = g_ptr_array_new_with_free_func(
+		(GDestroyNotify) bt_trace_put_ref);
+	ipc_src->streams = g_ptr_array_new_with_free_func(
+		(GDestroyNotify) destroy_stream);
+	if (!ipc_src->in_buf || !ipc_src->trace_classes ||
+			!ipc_src->clock_classes || !ipc_src->stream_classes ||
+			!ipc_src->event_classes || !ipc_src->traces ||
+			!ipc_src->streams) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+			"Failed to allocate component data.");
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	}
+
+	validation_status = bt_param_validation_validate(params,
+		ipc_src_params, &validate_error);
+	if (validation_status == BT_PARAM_VALIDATION_STATUS_MEMORY_ERROR) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	} else if (validation_status == BT_PARAM_VALIDATION_STATUS_VALIDATION_ERROR) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp, "%s", validate_error);
+		goto error;
+	}
+
+	path = bt_value_string_get(
+		bt_value_map_borrow_entry_value_const(params, "path"));
+	if (open_input(ipc_src, path) || read_header(ipc_src)) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto error;
+	}
+
+	add_port_status = bt_self_component_source_add_output_port(
+		self_comp_src, "out", NULL, NULL);
+	if (add_port_status != BT_SELF_COMPONENT_ADD_PORT_STATUS_OK) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+			"Failed to add output port.");
+		status = (int) add_port_status;
+		goto error;
+	}
+
+	bt_self_component_set_data(self_comp, ipc_src);
+	BT_COMP_LOGI("Component initialized: path=\"%s\", fd=%d", path,
+		ipc_src->fd);
+	status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
+	goto end;
+
+error:
+	destroy_ipc_src(ipc_src);
+
+end:
+	g_free(validate_error);
+	return status;
+}
+
+void ipc_src_finalize(bt_self_component_source *self_comp_src)
+{
+	destroy_ipc_src(bt_self_component_get_data(
+		bt_self_component_source_as_self_component(self_comp_src)));
+}
@@ -0,0 +1,40 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_IPC_SRC_H
+#define BABELTRACE_PLUGINS_UTILS_IPC_SRC_H
+
+#include <babeltrace2/babeltrace.h>
+#include "common/macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bt_component_class_initialize_method_status ipc_src_init(
+		bt_self_component_source *self_comp,
+		bt_self_component_source_configuration *config,
+		const bt_value *params, void *init_method_data);
+
+void ipc_src_finalize(bt_self_component_source *self_comp);
+
+bt_message_iterator_class_initialize_method_status ipc_src_msg_iter_init(
+		bt_self_message_iterator *self_msg_iter,
+		bt_self_message_iterator_configuration *config,
+		bt_self_component_port_output *self_port);
+
+void ipc_src_msg_iter_finalize(bt_self_message_iterator *self_msg_iter);
+
+bt_message_iterator_class_next_method_status ipc_src_msg_iter_next(
+		bt_self_message_iterator *self_msg_iter,
+		bt_message_array_const msgs, uint64_t capacity,
+		uint64_t *count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BABELTRACE_PLUGINS_UTILS_IPC_SRC_H */
@@ -0,0 +1,429 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_IPC_H
+#define BABELTRACE_PLUGINS_UTILS_IPC_H
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <glib.h>
+
+/*
+ * Wire format shared by `sink.utils.ipc` and `src.utils.ipc`.
+ *
+ * A stream starts with the `IPC_MAGIC` bytes followed with one
+ * `IPC_VERSION` byte, followed with batches.
+ *
+ * A batch is a variable-length unsigned integer (see below), its
+ * length in bytes, followed with one or more complete records: a
+ * record never spans two batches.
+ *
+ * A record is a variable-length unsigned integer, its tag (one of
+ * `enum ipc_tag`), followed with its payload.
+ *
+ * Primitive encodings:
+ *
+ * uint:
+ *     Unsigned LEB128 (7 bits per byte, least significant group
+ *     first, most significant bit set on all the bytes but the last
+ *     one).
+ *
+ * sint:
+ *     Zigzag-encoded uint (0, -1, 1, -2, ... become 0, 1, 2, 3, ...).
+ *
+ * u8:
+ *     One byte.
+ *
+ * string:
+ *     uint length, then as many bytes (no terminating null
+ *     character).
+ *
+ * opt-string:
+ *     uint 0 for no string, or uint length plus one, then as many
+ *     bytes.
+ *
+ * opt-uuid:
+ *     u8 0 for no UUID, or u8 1, then the 16 bytes of the UUID.
+ *
+ * real:
+ *     IEEE 754 value, little-endian (4 or 8 bytes).
+ *
+ * value:
+ *     uint type (one of `enum ipc_value_type`), then the value: u8
+ *     for a boolean, uint, sint, or 8-byte real for a number, string,
+ *     uint length and elements for an array, and uint size and
+ *     (string key, value) entries for a map.
+ *
+ * The sink sends the class-like objects (trace classes, clock
+ * classes, stream classes, event classes, traces, and streams) once,
+ * the first time a message needs them, giving each one a numeric ID
+ * (1, 2, 3, ..., per object kind). The other records refer to them
+ * with this ID.
+ *
+ * Field classes are serialized recursively, in pre-order, as part of
+ * their stream or event class. Each field class has an ordinal within
+ * its trace class (0, 1, 2, ...) which a dynamic array, option, or
+ * variant field class uses to refer to its length or selector field
+ * class.
+ *
+ * Fields are serialized according to their class, without any class
+ * information: u8 for a boolean field, uint for a bit array or an
+ * unsigned integer field, sint for a signed integer field, real for a
+ * real field, string for a string field, the members for a structure
+ * field, uint length and elements for a dynamic array field (only the
+ * elements for a static array field), u8 flag and optional content for
+ * an option field, and uint option index and option field for a variant
+ * field.
+ *
+ * Clock snapshot values are sint differences from the previous clock
+ * snapshot value of the same stream (initially 0), except for the value
+ * of a message iterator inactivity message, which is a uint.
+ *
+ * See `ipc-sink.c` for the payload of each record.
+ */
+
+#ifndef O_BINARY
+# define O_BINARY 0
+#endif
+
+#define IPC_MAGIC		"BT2IPC"
+#define IPC_MAGIC_LEN		6
+#define IPC_VERSION		1
+
+/* Header length: magic and version */
+#define IPC_HEADER_LEN		(IPC_MAGIC_LEN + 1)
+
+/* Maximum length of an encoded uint */
+#define IPC_UINT_MAX_LEN	10
+
+/*
+ * Maximum length of a dynamic array field of which the elements can
+ * have no encoded bytes (for example, empty structures): the length of
+ * the remaining data doesn't bound the length of such an array.
+ */
+#define IPC_EMPTY_ELEM_ARRAY_MAX_LEN	65536
+
+enum ipc_tag {
+	IPC_TAG_TRACE_CLASS = 1,
+	IPC_TAG_CLOCK_CLASS,
+	IPC_TAG_STREAM_CLASS,
+	IPC_TAG_EVENT_CLASS,
+	IPC_TAG_TRACE,
+	IPC_TAG_STREAM,
+	IPC_TAG_MSG_STREAM_BEGINNING,
+	IPC_TAG_MSG_STREAM_END,
+	IPC_TAG_MSG_PACKET_BEGINNING,
+	IPC_TAG_MSG_PACKET_END,
+	IPC_TAG_MSG_EVENT,
+	IPC_TAG_MSG_DISCARDED_EVENTS,
+	IPC_TAG_MSG_DISCARDED_PACKETS,
+	IPC_TAG_MSG_ITER_INACTIVITY,
+
+	/* End of the message stream: nothing follows */
+	IPC_TAG_END,
+};
+
+enum ipc_value_type {
+	IPC_VALUE_TYPE_NULL,
+	IPC_VALUE_TYPE_BOOL,
+	IPC_VALUE_TYPE_UNSIGNED_INTEGER,
+	IPC_VALUE_TYPE_SIGNED_INTEGER,
+	IPC_VALUE_TYPE_REAL,
+	IPC_VALUE_TYPE_STRING,
+	IPC_VALUE_TYPE_ARRAY,
+	IPC_VALUE_TYPE_MAP,
+};
+
+/* Field class types, as serialized */
+enum ipc_fc_type {
+	IPC_FC_TYPE_BOOL,
+	IPC_FC_TYPE_BIT_ARRAY,
+	IPC_FC_TYPE_UNSIGNED_INTEGER,
+	IPC_FC_TYPE_SIGNED_INTEGER,
+	IPC_FC_TYPE_UNSIGNED_ENUMERATION,
+	IPC_FC_TYPE_SIGNED_ENUMERATION,
+	IPC_FC_TYPE_SINGLE_PRECISION_REAL,
+	IPC_FC_TYPE_DOUBLE_PRECISION_REAL,
+	IPC_FC_TYPE_STRING,
+	IPC_FC_TYPE_STRUCTURE,
+	IPC_FC_TYPE_STATIC_ARRAY,
+	IPC_FC_TYPE_DYNAMIC_ARRAY,
+	IPC_FC_TYPE_DYNAMIC_ARRAY_WITH_LENGTH_FIELD,
+	IPC_FC_TYPE_OPTION,
+	IPC_FC_TYPE_OPTION_WITH_BOOL_SELECTOR_FIELD,
+	IPC_FC_TYPE_OPTION_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD,
+	IPC_FC_TYPE_OPTION_WITH_SIGNED_INTEGER_SELECTOR_FIELD,
+	IPC_FC_TYPE_VARIANT,
+	IPC_FC_TYPE_VARIANT_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD,
+	IPC_FC_TYPE_VARIANT_WITH_SIGNED_INTEGER_SELECTOR_FIELD,
+};
+
+/* Stream class flags */
+#define IPC_SC_FLAG_SUPPORTS_PACKETS				(1 << 0)
+#define IPC_SC_FLAG_PACKETS_HAVE_BEGINNING_CS			(1 << 1)
+#define IPC_SC_FLAG_PACKETS_HAVE_END_CS				(1 << 2)
+#define IPC_SC_FLAG_SUPPORTS_DISCARDED_EVENTS			(1 << 3)
+#define IPC_SC_FLAG_DISCARDED_EVENTS_HAVE_CS			(1 << 4)
+#define IPC_SC_FLAG_SUPPORTS_DISCARDED_PACKETS			(1 << 5)
+#define IPC_SC_FLAG_DISCARDED_PACKETS_HAVE_CS			(1 << 6)
+
+/* Decoding cursor over a complete batch */
+struct ipc_reader {
+	const uint8_t *buf;
+	size_t len;
+	size_t pos;
+};
+
+static inline
+void ipc_write_u8(GByteArray *out, uint8_t val)
+{
+	g_byte_array_append(out, &val, 1);
+}
+
+static inline
+void ipc_write_uint(GByteArray *out, uint64_t val)
+{
+	uint8_t bytes[IPC_UINT_MAX_LEN];
+	guint len = 0;
+
+	do {
+		bytes[len] = val & 0x7f;
+		val >>= 7;
+
+		if (val != 0) {
+			bytes[len] |= 0x80;
+		}
+
+		len++;
+	} while (val != 0);
+
+	g_byte_array_append(out, bytes, len);
+}
+
+static inline
+void ipc_write_sint(GByteArray *out, int64_t val)
+{
+	ipc_write_uint(out, ((uint64_t) val << 1) ^ (uint64_t) (val >> 63));
+}
+
+static inline
+void ipc_write_bytes(GByteArray *out, const void *bytes, size_t len)
+{
+	ipc_write_uint(out, len);
+	g_byte_array_append(out, bytes, len);
+}
+
+static inline
+void ipc_write_string(GByteArray *out, const char *str)
+{
+	ipc_write_bytes(out, str, strlen(str));
+}
+
+static inline
+void ipc_write_opt_string(GByteArray *out, const char *str)
+{
+	if (!str) {
+		ipc_write_uint(out, 0);
+		return;
+	}
+
+	ipc_write_uint(out, strlen(str) + 1);
+	g_byte_array_append(out, (const uint8_t *) str, strlen(str));
+}
+
+static inline
+void ipc_write_float(GByteArray *out, float val)
+{
+	uint32_t bits;
+
+	memcpy(&bits, &val, sizeof(bits));
+	bits = GUINT32_TO_LE(bits);
+	g_byte_array_append(out, (const uint8_t *) &bits, sizeof(bits));
+}
+
+static inline
+void ipc_write_double(GByteArray *out, double val)
+{
+	uint64_t bits;
+
+	memcpy(&bits, &val, sizeof(bits));
+	bits = GUINT64_TO_LE(bits);
+	g_byte_array_append(out, (const uint8_t *) &bits, sizeof(bits));
+}
+
+/*
+ * The reading functions below return 0 on success, or -1 if the
+ * remaining bytes of `reader` don't contain a valid value.
+ */
+
+static inline
+int ipc_read_u8(struct ipc_reader *reader, uint8_t *val)
+{
+	if (reader->pos >= reader->len) {
+		return -1;
+	}
+
+	*val = reader->buf[reader->pos];
+	reader->pos++;
+	return 0;
+}
+
+static inline
+int ipc_read_uint(struct ipc_reader *reader, uint64_t *val)
+{
+	uint64_t result = 0;
+	unsigned int shift = 0;
+
+	while (reader->pos < reader->len && shift < 64) {
+		uint8_t byte = reader->buf[reader->pos];
+
+		reader->pos++;
+		result |= (uint64_t) (byte & 0x7f) << shift;
+
+		if (!(byte & 0x80)) {
+			*val = result;
+			return 0;
+		}
+
+		shift += 7;
+	}
+
+	return -1;
+}
+
+static inline
+int ipc_read_sint(struct ipc_reader *reader, int64_t *val)
+{
+	uint64_t uval;
+
+	if (ipc_read_uint(reader, &uval)) {
+		return -1;
+	}
+
+	*val = (int64_t) (uval >> 1) ^ -(int64_t) (uval & 1);
+	return 0;
+}
+
+/*
+ * Sets `*bytes` to the next `len` bytes of `reader` (not copied).
+ */
+static inline
+int ipc_read_raw(struct ipc_reader *reader, size_t len,
+		const uint8_t **bytes)
+{
+	if (len > reader->len - reader->pos) {
+		return -1;
+	}
+
+	*bytes = &reader->buf[reader->pos];
+	reader->pos += len;
+	return 0;
+}
+
+/*
+ * Reads a string, setting `*str` to its first byte (not
+ * null-terminated) and `*len` to its length.
+ */
+static inline
+int ipc_read_bytes(struct ipc_reader *reader, const char **str,
+		uint64_t *len)
+{
+	const uint8_t *bytes;
+
+	if (ipc_read_uint(reader, len) ||
+			*len > reader->len - reader->pos ||
+			ipc_read_raw(reader, *len, &bytes)) {
+		return -1;
+	}
+
+	*str = (const char *) bytes;
+	return 0;
+}
+
+/*
+ * Reads a string, setting `*str` to a new null-terminated copy of it
+ * (free with g_free()).
+ */
+static inline
+int ipc_read_string(struct ipc_reader *reader, char **str)
+{
+	const char *bytes;
+	uint64_t len;
+
+	if (ipc_read_bytes(reader, &bytes, &len)) {
+		return -1;
+	}
+
+	*str = g_strndup(bytes, len);
+	return 0;
+}
+
+/*
+ * Reads an optional string, setting `*str` to a new null-terminated
+ * copy of it (free with g_free()), or to `NULL` if there's no string.
+ */
+static inline
+int ipc_read_opt_string(struct ipc_reader *reader, char **str)
+{
+	uint64_t len;
+	const uint8_t *bytes;
+
+	if (ipc_read_uint(reader, &len)) {
+		return -1;
+	}
+
+	if (len == 0) {
+		*str = NULL;
+		return 0;
+	}
+
+	len--;
+
+	if (len > reader->len - reader->pos ||
+			ipc_read_raw(reader, len, &bytes)) {
+		return -1;
+	}
+
+	*str = g_strndup((const char *) bytes, len);
+	return 0;
+}
+
+static inline
+int ipc_read_float(struct ipc_reader *reader, float *val)
+{
+	const uint8_t *bytes;
+	uint32_t bits;
+
+	if (ipc_read_raw(reader, sizeof(bits), &bytes)) {
+		return -1;
+	}
+
+	memcpy(&bits, bytes, sizeof(bits));
+	bits = GUINT32_FROM_LE(bits);
+	memcpy(val, &bits, sizeof(bits));
+	return 0;
+}
+
+static inline
+int ipc_read_double(struct ipc_reader *reader, double *val)
+{
+	const uint8_t *bytes;
+	uint64_t bits;
+
+	if (ipc_read_raw(reader, sizeof(bits), &bytes)) {
+		return -1;
+	}
+
+	memcpy(&bits, bytes, sizeof(bits));
+	bits = GUINT64_FROM_LE(bits);
+	memcpy(val, &bits, sizeof(bits));
+	return 0;
+}
+
+#endif /* BABELTRACE_PLUGINS_UTILS_IPC_H */
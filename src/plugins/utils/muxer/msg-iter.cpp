@@ -38,6 +38,12 @@ MsgIter::MsgIter(const bt2::SelfMessageIterator selfMsgIter,
             continue;
         }
 
+        /*
+         * A muxer message iterator forwards the event messages as is:
+         * it needs the same event fields as its downstream component.
+         */
+        inputPort.neededEventFields(selfMsgIter.neededEventFields());
+
         /*
          * Create new upstream message iterator and immediately make it
          * part of `_mUpstreamMsgItersToReload` (_ensureFullHeap() will
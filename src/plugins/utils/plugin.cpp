@@ -10,8 +10,12 @@
 
 #include "counter/counter.h"
 #include "dummy/dummy.h"
+#include "filter/filter.h"
+#include "ipc/ipc-sink.h"
+#include "ipc/ipc-src.h"
 #include "muxer/comp.hpp"
 #include "muxer/msg-iter.hpp"
+#include "synthetic/synthetic.h"
 #include "trimmer/trimmer.h"
 
 #ifndef BT_BUILT_IN_PLUGINS
@@ -40,6 +44,42 @@ BT_PLUGIN_SINK_COMPONENT_CLASS_DESCRIPTION(counter, "Count messages and print th
 BT_PLUGIN_SINK_COMPONENT_CLASS_HELP(counter,
                                     "See the babeltrace2-sink.utils.counter(7) manual page.");
 
+/* sink.utils.ipc */
+BT_PLUGIN_SINK_COMPONENT_CLASS(ipc, ipc_sink_consume);
+BT_PLUGIN_SINK_COMPONENT_CLASS_INITIALIZE_METHOD(ipc, ipc_sink_init);
+BT_PLUGIN_SINK_COMPONENT_CLASS_FINALIZE_METHOD(ipc, ipc_sink_finalize);
+BT_PLUGIN_SINK_COMPONENT_CLASS_GRAPH_IS_CONFIGURED_METHOD(ipc, ipc_sink_graph_is_configured);
+BT_PLUGIN_SINK_COMPONENT_CLASS_DESCRIPTION(
+    ipc, "Write messages to a pipe or a file in a compact binary format.");
+BT_PLUGIN_SINK_COMPONENT_CLASS_HELP(ipc, "See the babeltrace2-sink.utils.ipc(7) manual page.");
+
+/* src.utils.ipc */
+BT_PLUGIN_SOURCE_COMPONENT_CLASS(ipc, ipc_src_msg_iter_next);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_DESCRIPTION(
+    ipc, "Read messages which a `sink.utils.ipc` component wrote from a pipe or a file.");
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_HELP(ipc, "See the babeltrace2-source.utils.ipc(7) manual page.");
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_INITIALIZE_METHOD(ipc, ipc_src_init);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_FINALIZE_METHOD(ipc, ipc_src_finalize);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD(ipc,
+                                                                          ipc_src_msg_iter_init);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_FINALIZE_METHOD(ipc,
+                                                                        ipc_src_msg_iter_finalize);
+
+/* src.utils.synthetic */
+BT_PLUGIN_SOURCE_COMPONENT_CLASS(synthetic, synthetic_msg_iter_next);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_DESCRIPTION(
+    synthetic, "Generate synthetic messages at a controlled rate and shape.");
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_HELP(synthetic,
+                                      "See the babeltrace2-source.utils.synthetic(7) manual page.");
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_INITIALIZE_METHOD(synthetic, synthetic_init);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_FINALIZE_METHOD(synthetic, synthetic_finalize);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD(synthetic,
+                                                                          synthetic_msg_iter_init);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_FINALIZE_METHOD(
+    synthetic, synthetic_msg_iter_finalize);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_SEEK_BEGINNING_METHODS(
+    synthetic, synthetic_msg_iter_seek_beginning, synthetic_msg_iter_can_seek_beginning);
+
 /* flt.utils.trimmer */
 BT_PLUGIN_FILTER_COMPONENT_CLASS(trimmer, trimmer_msg_iter_next);
 BT_PLUGIN_FILTER_COMPONENT_CLASS_DESCRIPTION(
@@ -59,3 +99,20 @@ BT_PLUGIN_FILTER_COMPONENT_CLASS_DESCRIPTION(
     muxer, "Sort messages from multiple input ports to a single output port by time.");
 BT_PLUGIN_FILTER_COMPONENT_CLASS_HELP(muxer,
                                       "See the babeltrace2-filter.utils.muxer(7) manual page.");
+
+/* flt.utils.filter */
+BT_PLUGIN_FILTER_COMPONENT_CLASS(filter, filter_msg_iter_next);
+BT_PLUGIN_FILTER_COMPONENT_CLASS_DESCRIPTION(
+    filter, "Discard the event messages which don't satisfy a predicate expression.");
+BT_PLUGIN_FILTER_COMPONENT_CLASS_HELP(filter,
+                                      "See the babeltrace2-filter.utils.filter(7) manual page.");
+BT_PLUGIN_FILTER_COMPONENT_CLASS_INITIALIZE_METHOD(filter, filter_init);
+BT_PLUGIN_FILTER_COMPONENT_CLASS_FINALIZE_METHOD(filter, filter_finalize);
+BT_PLUGIN_FILTER_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD(filter,
+                                                                          filter_msg_iter_init);
+BT_PLUGIN_FILTER_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_FINALIZE_METHOD(filter,
+                                                                        filter_msg_iter_finalize);
+BT_PLUGIN_FILTER_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_SEEK_BEGINNING_METHODS(
+    filter, filter_msg_iter_seek_beginning, filter_msg_iter_can_seek_beginning);
+BT_PLUGIN_FILTER_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_SEEK_NS_FROM_ORIGIN_METHODS(
+    filter, filter_msg_iter_seek_ns_from_origin, filter_msg_iter_can_seek_ns_from_origin);
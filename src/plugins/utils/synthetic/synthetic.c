@@ -0,0 +1,1539 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2024 EfficiOS Inc.
+ */
+
+#define BT_COMP_LOG_SELF_COMP (synth_comp->self_comp)
+#define BT_LOG_OUTPUT_LEVEL (synth_comp->log_level)
+#define BT_LOG_TAG "PLUGIN/SRC.UTILS.SYNTHETIC"
+#include "logging/comp-logging.h"
+
+#include "synthetic.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common/common.h"
+#include "common/assert.h"
+#include <babeltrace2/babeltrace.h>
+#include <glib.h>
+#include "plugins/common/param-validation/param-validation.h"
+
+#define USEC_PER_SEC 1000000ULL
+
+/* Number of events of a burst with the `burst` distribution */
+#define BURST_EVENT_COUNT 64
+
+/* Maximum length of a static array member */
+#define MAX_ARRAY_MEMBER_LENGTH 65536
+
+enum member_kind {
+	MEMBER_KIND_UINT,
+	MEMBER_KIND_SINT,
+	MEMBER_KIND_BOOL,
+	MEMBER_KIND_FLOAT,
+	MEMBER_KIND_DOUBLE,
+	MEMBER_KIND_STRING,
+};
+
+/*
+ * Payload member of an event class, resolved once so that filling a
+ * payload field doesn't need to introspect its class.
+ */
+struct synth_member {
+	enum member_kind kind;
+
+	/* Field value range, in bits (integer members only) */
+	unsigned int size;
+
+	/* Length of the static array, or 0 for a scalar member */
+	uint64_t array_len;
+};
+
+struct synth_event_class {
+	/* Weak: owned by the stream class */
+	bt_event_class *event_class;
+
+	/* Array of `struct synth_member` */
+	GArray *members;
+};
+
+enum timestamp_distribution {
+	TIMESTAMP_DISTRIBUTION_CONSTANT,
+	TIMESTAMP_DISTRIBUTION_UNIFORM,
+	TIMESTAMP_DISTRIBUTION_BURST,
+};
+
+struct synth_component {
+	bt_logging_level log_level;
+
+	struct {
+		uint64_t stream_count;
+		uint64_t event_count;
+		uint64_t events_per_packet;
+		enum timestamp_distribution ts_distribution;
+		uint64_t ts_mean_delta;
+		uint64_t discarded_events_period;
+		uint64_t rate;
+		bool port_per_stream;
+		uint64_t seed;
+	} params;
+
+	bt_self_component *self_comp;
+	bt_trace_class *trace_class;
+	bt_stream_class *stream_class;
+	bt_clock_class *clock_class;
+	bt_trace *trace;
+
+	/* Array of `struct synth_event_class` */
+	GArray *event_classes;
+
+	/* Array of `bt_stream *` (owned) */
+	GPtrArray *streams;
+};
+
+enum stream_action {
+	STREAM_ACTION_STREAM_BEGINNING,
+	STREAM_ACTION_PACKET_BEGINNING,
+	STREAM_ACTION_EVENT,
+	STREAM_ACTION_PACKET_END,
+	STREAM_ACTION_STREAM_END,
+	STREAM_ACTION_DONE,
+};
+
+struct synth_stream_state {
+	/* Weak */
+	bt_stream *stream;
+
+	/* Current packet (owned), if any */
+	bt_packet *packet;
+
+	enum stream_action action;
+
+	/* Number of emitted events */
+	uint64_t event_count;
+
+	/* Number of emitted events in the current packet */
+	uint64_t packet_event_count;
+
+	/*
+	 * Value of `event_count` at which to emit the next discarded
+	 * events message.
+	 */
+	uint64_t next_discarded_at;
+
+	/*
+	 * True if the timestamp of the next event, `pending_ts`, is
+	 * already known: a discarded events message was just emitted,
+	 * or the event message creation failed.
+	 */
+	bool has_pending_ts;
+	uint64_t pending_ts;
+};
+
+struct synth_msg_iter {
+	struct synth_component *synth_comp;
+
+	/* Weak */
+	bt_self_message_iterator *self_msg_iter;
+
+	/* Array of `struct synth_stream_state` */
+	GArray *streams;
+
+	/* Index, within `streams`, of the stream of the next message */
+	guint cur_stream;
+
+	/* Number of streams which are not done */
+	guint active_stream_count;
+
+	/* Index of the event class of the next event */
+	guint next_event_class;
+
+	/* Last timestamp (clock value) */
+	uint64_t ts;
+
+	/* Number of remaining events in the current burst */
+	uint64_t burst_remaining;
+
+	/* xorshift64* state (never 0) */
+	uint64_t prng_state;
+
+	/*
+	 * Rate limiting: monotonic time (µs) of the first "next" call
+	 * (negative if not called yet) and total number of emitted
+	 * events since then.
+	 */
+	gint64 start_time_us;
+	uint64_t emitted_event_count;
+};
+
+static const char *words[] = {
+	"alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf",
+	"hotel", "india", "juliett", "kilo", "lima", "mike", "november",
+	"oscar", "papa",
+};
+
+static const char *ts_distribution_choices[] = {
+	"constant", "uniform", "burst", NULL,
+};
+
+static const struct bt_param_validation_value_descr member_type_descr = {
+	.type = BT_VALUE_TYPE_STRING,
+};
+
+static const struct bt_param_validation_map_value_entry_descr event_class_entries[] = {
+	{ "name", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_STRING } },
+	{ "payload", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_MANDATORY, { BT_VALUE_TYPE_ARRAY, .array = {
+		.min_length = 0,
+		.max_length = BT_PARAM_VALIDATION_INFINITE,
+		.element_type = &member_type_descr,
+	} } },
+	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
+};
+
+static const struct bt_param_validation_value_descr event_class_descr = {
+	.type = BT_VALUE_TYPE_MAP,
+	.map = {
+		.entries = event_class_entries,
+	},
+};
+
+static
+struct bt_param_validation_map_value_entry_descr synth_params[] = {
+	{ "stream-count", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_UNSIGNED_INTEGER } },
+	{ "event-count", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_UNSIGNED_INTEGER } },
+	{ "events-per-packet", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_UNSIGNED_INTEGER } },
+	{ "event-classes", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { BT_VALUE_TYPE_ARRAY, .array = {
+		.min_length = 1,
+		.max_length = BT_PARAM_VALIDATION_INFINITE,
+		.element_type = &event_class_descr,
+	} } },
+	{ "timestamp-distribution", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { BT_VALUE_TYPE_STRING, .string = {
+		.choices = ts_distribution_choices,
+	} } },
+	{ "timestamp-mean-delta", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_UNSIGNED_INTEGER } },
+	{ "discarded-events-period", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_UNSIGNED_INTEGER } },
+	{ "rate", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_UNSIGNED_INTEGER } },
+	{ "port-per-stream", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
+	{ "seed", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_UNSIGNED_INTEGER } },
+	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
+};
+
+/* Payload of the event class when there's no `event-classes` parameter */
+static const char *default_payload[] = {
+	"u64", "s64", "double", "string", NULL,
+};
+
+/*
+ * Parses the payload member type `str`, for example `u32`, `string`,
+ * or `double[8]`, into `member`.
+ *
+ * Returns true on success.
+ */
+static
+bool parse_member_type(const char *str, struct synth_member *member)
+{
+	const char *bracket = strchr(str, '[');
+	size_t base_len = bracket ? (size_t) (bracket - str) : strlen(str);
+	static const struct {
+		const char *name;
+		enum member_kind kind;
+		unsigned int size;
+	} types[] = {
+		{ "u8", MEMBER_KIND_UINT, 8 },
+		{ "u16", MEMBER_KIND_UINT, 16 },
+		{ "u32", MEMBER_KIND_UINT, 32 },
+		{ "u64", MEMBER_KIND_UINT, 64 },
+		{ "s8", MEMBER_KIND_SINT, 8 },
+		{ "s16", MEMBER_KIND_SINT, 16 },
+		{ "s32", MEMBER_KIND_SINT, 32 },
+		{ "s64", MEMBER_KIND_SINT, 64 },
+		{ "bool", MEMBER_KIND_BOOL, 0 },
+		{ "float", MEMBER_KIND_FLOAT, 0 },
+		{ "double", MEMBER_KIND_DOUBLE, 0 },
+		{ "string", MEMBER_KIND_STRING, 0 },
+	};
+	size_t i;
+
+	for (i = 0; i < G_N_ELEMENTS(types); i++) {
+		if (strlen(types[i].name) == base_len &&
+				strncmp(str, types[i].name, base_len) == 0) {
+			break;
+		}
+	}
+
+	if (i == G_N_ELEMENTS(types)) {
+		return false;
+	}
+
+	member->kind = types[i].kind;
+	member->size = types[i].size;
+	member->array_len = 0;
+
+	if (bracket) {
+		char *end;
+		unsigned long long len;
+
+		if (bracket[1] < '0' || bracket[1] > '9') {
+			return false;
+		}
+
+		len = strtoull(bracket + 1, &end, 10);
+		if (end[0] != ']' || end[1] != '\0' || len == 0 ||
+				len > MAX_ARRAY_MEMBER_LENGTH) {
+			return false;
+		}
+
+		member->array_len = len;
+	}
+
+	return true;
+}
+
+static
+bt_field_class *create_member_fc(struct synth_component *synth_comp,
+		const struct synth_member *member)
+{
+	bt_field_class *fc = NULL;
+	bt_field_class *array_fc;
+
+	switch (member->kind) {
+	case MEMBER_KIND_UINT:
+		fc = bt_field_class_integer_unsigned_create(
+			synth_comp->trace_class);
+		break;
+	case MEMBER_KIND_SINT:
+		fc = bt_field_class_integer_signed_create(
+			synth_comp->trace_class);
+		break;
+	case MEMBER_KIND_BOOL:
+		fc = bt_field_class_bool_create(synth_comp->trace_class);
+		break;
+	case MEMBER_KIND_FLOAT:
+		fc = bt_field_class_real_single_precision_create(
+			synth_comp->trace_class);
+		break;
+	case MEMBER_KIND_DOUBLE:
+		fc = bt_field_class_real_double_precision_create(
+			synth_comp->trace_class);
+		break;
+	case MEMBER_KIND_STRING:
+		fc = bt_field_class_string_create(synth_comp->trace_class);
+		break;
+	default:
+		bt_common_abort();
+	}
+
+	if (!fc) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot create field class object.");
+		goto end;
+	}
+
+	if (member->kind == MEMBER_KIND_UINT ||
+			member->kind == MEMBER_KIND_SINT) {
+		bt_field_class_integer_set_field_value_range(fc, member->size);
+	}
+
+	if (member->array_len == 0) {
+		goto end;
+	}
+
+	array_fc = bt_field_class_array_static_create(synth_comp->trace_class,
+		fc, member->array_len);
+	bt_field_class_put_ref(fc);
+	fc = array_fc;
+	if (!fc) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot create static array field class object: "
+			"length=%" PRIu64, member->array_len);
+		goto end;
+	}
+
+end:
+	return fc;
+}
+
+/*
+ * Creates an event class named `name` of which the payload members have
+ * the types `member_types` (`member_type_count` elements) and appends
+ * it to `synth_comp->event_classes`.
+ */
+static
+int add_event_class(struct synth_component *synth_comp, const char *name,
+		const char * const *member_types, uint64_t member_type_count)
+{
+	struct synth_event_class synth_ec = { 0 };
+	bt_field_class *payload_fc = NULL;
+	bt_field_class *member_fc = NULL;
+	GString *member_name = NULL;
+	uint64_t i;
+	int ret = 0;
+
+	synth_ec.members = g_array_new(FALSE, FALSE,
+		sizeof(struct synth_member));
+	member_name = g_string_new(NULL);
+	if (!synth_ec.members || !member_name) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Failed to allocate event class data.");
+		goto error;
+	}
+
+	synth_ec.event_class = bt_event_class_create(synth_comp->stream_class);
+	if (!synth_ec.event_class) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot create an event class object.");
+		goto error;
+	}
+
+	/*
+	 * The stream class owns the event class: keep a weak
+	 * reference.
+	 */
+	bt_event_class_put_ref(synth_ec.event_class);
+
+	ret = bt_event_class_set_name(synth_ec.event_class, name);
+	if (ret) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot set event class's name: name=\"%s\"", name);
+		goto error;
+	}
+
+	payload_fc = bt_field_class_structure_create(synth_comp->trace_class);
+	if (!payload_fc) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot create an empty structure field class object.");
+		goto error;
+	}
+
+	for (i = 0; i < member_type_count; i++) {
+		struct synth_member member;
+		bt_field_class_structure_append_member_status append_member_status;
+
+		if (!parse_member_type(member_types[i], &member)) {
+			BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+				"Invalid payload member type: "
+				"event-class-name=\"%s\", index=%" PRIu64 ", "
+				"type=\"%s\"", name, i, member_types[i]);
+			goto error;
+		}
+
+		member_fc = create_member_fc(synth_comp, &member);
+		if (!member_fc) {
+			goto error;
+		}
+
+		g_string_printf(member_name, "f%" PRIu64, i);
+		append_member_status = bt_field_class_structure_append_member(
+			payload_fc, member_name->str, member_fc);
+		if (append_member_status != BT_FIELD_CLASS_STRUCTURE_APPEND_MEMBER_STATUS_OK) {
+			BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+				"Cannot add `%s` member to structure field class: ret=%d",
+				member_name->str, append_member_status);
+			goto error;
+		}
+
+		BT_FIELD_CLASS_PUT_REF_AND_RESET(member_fc);
+		g_array_append_val(synth_ec.members, member);
+	}
+
+	ret = bt_event_class_set_payload_field_class(synth_ec.event_class,
+		payload_fc);
+	if (ret) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot set event class's event payload field class.");
+		goto error;
+	}
+
+	g_array_append_val(synth_comp->event_classes, synth_ec);
+	synth_ec.members = NULL;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	if (synth_ec.members) {
+		g_array_free(synth_ec.members, TRUE);
+	}
+
+	if (member_name) {
+		g_string_free(member_name, TRUE);
+	}
+
+	bt_field_class_put_ref(member_fc);
+	bt_field_class_put_ref(payload_fc);
+	return ret;
+}
+
+static
+int create_event_classes(struct synth_component *synth_comp,
+		const bt_value *event_classes)
+{
+	const char **member_types = NULL;
+	GString *name = NULL;
+	uint64_t i;
+	int ret = 0;
+
+	if (!event_classes) {
+		ret = add_event_class(synth_comp, "synthetic", default_payload,
+			G_N_ELEMENTS(default_payload) - 1);
+		goto end;
+	}
+
+	name = g_string_new(NULL);
+	if (!name) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Failed to allocate a GString.");
+		goto error;
+	}
+
+	for (i = 0; i < bt_value_array_get_length(event_classes); i++) {
+		const bt_value *ec = bt_value_array_borrow_element_by_index_const(
+			event_classes, i);
+		const bt_value *name_value =
+			bt_value_map_borrow_entry_value_const(ec, "name");
+		const bt_value *payload =
+			bt_value_map_borrow_entry_value_const(ec, "payload");
+		uint64_t member_count = bt_value_array_get_length(payload);
+		uint64_t j;
+
+		if (name_value) {
+			g_string_assign(name, bt_value_string_get(name_value));
+		} else {
+			g_string_printf(name, "event-class-%" PRIu64, i);
+		}
+
+		g_free(member_types);
+		member_types = g_new0(const char *, member_count + 1);
+		if (!member_types) {
+			BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+				"Failed to allocate member type array.");
+			goto error;
+		}
+
+		for (j = 0; j < member_count; j++) {
+			member_types[j] = bt_value_string_get(
+				bt_value_array_borrow_element_by_index_const(
+					payload, j));
+		}
+
+		ret = add_event_class(synth_comp, name->str, member_types,
+			member_count);
+		if (ret) {
+			goto error;
+		}
+	}
+
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	g_free(member_types);
+
+	if (name) {
+		g_string_free(name, TRUE);
+	}
+
+	return ret;
+}
+
+static
+int create_meta(struct synth_component *synth_comp,
+		const bt_value *event_classes)
+{
+	int ret = 0;
+
+	synth_comp->trace_class = bt_trace_class_create(synth_comp->self_comp);
+	if (!synth_comp->trace_class) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot create an empty trace class object.");
+		goto error;
+	}
+
+	synth_comp->stream_class = bt_stream_class_create(
+		synth_comp->trace_class);
+	if (!synth_comp->stream_class) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot create a stream class object.");
+		goto error;
+	}
+
+	synth_comp->clock_class = bt_clock_class_create(synth_comp->self_comp);
+	if (!synth_comp->clock_class) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot create clock class.");
+		goto error;
+	}
+
+	/* Clock values are nanoseconds from an arbitrary origin */
+	bt_clock_class_set_origin_is_unix_epoch(synth_comp->clock_class,
+		BT_FALSE);
+
+	ret = bt_clock_class_set_name(synth_comp->clock_class, "synthetic");
+	if (ret) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot set clock class's name.");
+		goto error;
+	}
+
+	ret = bt_stream_class_set_default_clock_class(
+		synth_comp->stream_class, synth_comp->clock_class);
+	if (ret) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot set stream class's default clock class.");
+		goto error;
+	}
+
+	if (synth_comp->params.events_per_packet > 0) {
+		bt_stream_class_set_supports_packets(synth_comp->stream_class,
+			BT_TRUE, BT_TRUE, BT_TRUE);
+	}
+
+	if (synth_comp->params.discarded_events_period > 0) {
+		bt_stream_class_set_supports_discarded_events(
+			synth_comp->stream_class, BT_TRUE, BT_TRUE);
+	}
+
+	ret = create_event_classes(synth_comp, event_classes);
+	if (ret) {
+		goto error;
+	}
+
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	return ret;
+}
+
+static
+int create_trace_and_streams(struct synth_component *synth_comp)
+{
+	uint64_t i;
+	int ret = 0;
+
+	synth_comp->trace = bt_trace_create(synth_comp->trace_class);
+	if (!synth_comp->trace) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot create trace object.");
+		goto error;
+	}
+
+	ret = bt_trace_set_name(synth_comp->trace, "synthetic");
+	if (ret) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot set trace's name.");
+		goto error;
+	}
+
+	for (i = 0; i < synth_comp->params.stream_count; i++) {
+		bt_stream *stream = bt_stream_create(synth_comp->stream_class,
+			synth_comp->trace);
+
+		if (!stream) {
+			BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+				"Cannot create stream object: index=%" PRIu64,
+				i);
+			goto error;
+		}
+
+		g_ptr_array_add(synth_comp->streams, stream);
+	}
+
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	return ret;
+}
+
+static
+bt_component_class_initialize_method_status handle_params(
+		struct synth_component *synth_comp,
+		const bt_value *params)
+{
+	const bt_value *value;
+	bt_component_class_initialize_method_status status;
+	enum bt_param_validation_status validation_status;
+	gchar *validate_error = NULL;
+
+	validation_status = bt_param_validation_validate(params,
+		synth_params, &validate_error);
+	if (validation_status == BT_PARAM_VALIDATION_STATUS_MEMORY_ERROR) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto end;
+	} else if (validation_status == BT_PARAM_VALIDATION_STATUS_VALIDATION_ERROR) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"%s", validate_error);
+		goto end;
+	}
+
+	synth_comp->params.stream_count = 1;
+	synth_comp->params.event_count = 1000000;
+	synth_comp->params.ts_distribution = TIMESTAMP_DISTRIBUTION_CONSTANT;
+	synth_comp->params.ts_mean_delta = 1000;
+
+	value = bt_value_map_borrow_entry_value_const(params, "stream-count");
+	if (value) {
+		synth_comp->params.stream_count =
+			bt_value_integer_unsigned_get(value);
+	}
+
+	value = bt_value_map_borrow_entry_value_const(params, "event-count");
+	if (value) {
+		synth_comp->params.event_count =
+			bt_value_integer_unsigned_get(value);
+	}
+
+	value = bt_value_map_borrow_entry_value_const(params,
+		"events-per-packet");
+	if (value) {
+		synth_comp->params.events_per_packet =
+			bt_value_integer_unsigned_get(value);
+	}
+
+	value = bt_value_map_borrow_entry_value_const(params,
+		"timestamp-distribution");
+	if (value) {
+		const char *str = bt_value_string_get(value);
+
+		if (strcmp(str, "uniform") == 0) {
+			synth_comp->params.ts_distribution =
+				TIMESTAMP_DISTRIBUTION_UNIFORM;
+		} else if (strcmp(str, "burst") == 0) {
+			synth_comp->params.ts_distribution =
+				TIMESTAMP_DISTRIBUTION_BURST;
+		} else {
+			BT_ASSERT(strcmp(str, "constant") == 0);
+		}
+	}
+
+	value = bt_value_map_borrow_entry_value_const(params,
+		"timestamp-mean-delta");
+	if (value) {
+		synth_comp->params.ts_mean_delta =
+			bt_value_integer_unsigned_get(value);
+	}
+
+	value = bt_value_map_borrow_entry_value_const(params,
+		"discarded-events-period");
+	if (value) {
+		synth_comp->params.discarded_events_period =
+			bt_value_integer_unsigned_get(value);
+	}
+
+	value = bt_value_map_borrow_entry_value_const(params, "rate");
+	if (value) {
+		synth_comp->params.rate = bt_value_integer_unsigned_get(value);
+	}
+
+	value = bt_value_map_borrow_entry_value_const(params,
+		"port-per-stream");
+	if (value) {
+		synth_comp->params.port_per_stream = bt_value_bool_get(value);
+	}
+
+	value = bt_value_map_borrow_entry_value_const(params, "seed");
+	if (value) {
+		synth_comp->params.seed = bt_value_integer_unsigned_get(value);
+	}
+
+	if (synth_comp->params.stream_count == 0) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"The `stream-count` parameter must be greater than 0.");
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto end;
+	}
+
+	if (synth_comp->params.ts_mean_delta == 0 ||
+			synth_comp->params.ts_mean_delta > UINT32_MAX) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"The `timestamp-mean-delta` parameter must be in "
+			"the [1, %" PRIu32 "] range: value=%" PRIu64,
+			UINT32_MAX, synth_comp->params.ts_mean_delta);
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto end;
+	}
+
+	status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
+
+end:
+	g_free(validate_error);
+
+	return status;
+}
+
+static
+void destroy_synth_component(struct synth_component *synth_comp)
+{
+	if (!synth_comp) {
+		return;
+	}
+
+	if (synth_comp->event_classes) {
+		guint i;
+
+		for (i = 0; i < synth_comp->event_classes->len; i++) {
+			struct synth_event_class *synth_ec = &g_array_index(
+				synth_comp->event_classes,
+				struct synth_event_class, i);
+
+			g_array_free(synth_ec->members, TRUE);
+		}
+
+		g_array_free(synth_comp->event_classes, TRUE);
+	}
+
+	if (synth_comp->streams) {
+		g_ptr_array_free(synth_comp->streams, TRUE);
+	}
+
+	bt_trace_put_ref(synth_comp->trace);
+	bt_stream_class_put_ref(synth_comp->stream_class);
+	bt_clock_class_put_ref(synth_comp->clock_class);
+	bt_trace_class_put_ref(synth_comp->trace_class);
+	g_free(synth_comp);
+}
+
+bt_component_class_initialize_method_status synthetic_init(
+		bt_self_component_source *self_comp_src,
+		bt_self_component_source_configuration *config __attribute__((unused)),
+		const bt_value *params,
+		void *init_method_data __attribute__((unused)))
+{
+	struct synth_component *synth_comp =
+		g_new0(struct synth_component, 1);
+	bt_component_class_initialize_method_status status;
+	bt_self_component *self_comp =
+		bt_self_component_source_as_self_component(self_comp_src);
+	const bt_component *comp = bt_self_component_as_component(self_comp);
+	bt_logging_level log_level = bt_component_get_logging_level(comp);
+	bt_self_component_add_port_status add_port_status;
+	GString *port_name = NULL;
+
+	if (!synth_comp) {
+		/*
+		 * Don't use BT_COMP_LOGE_APPEND_CAUSE, as `synth_comp` is
+		 * not initialized.
+		 */
+		BT_COMP_LOG_CUR_LVL(BT_LOG_ERROR, log_level, self_comp,
+			"Failed to allocate one synthetic component structure.");
+		BT_CURRENT_THREAD_ERROR_APPEND_CAUSE_FROM_COMPONENT(self_comp,
+			"Failed to allocate one synthetic component structure.");
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	}
+
+	synth_comp->log_level = log_level;
+	synth_comp->self_comp = self_comp;
+	synth_comp->event_classes = g_array_new(FALSE, FALSE,
+		sizeof(struct synth_event_class));
+	synth_comp->streams = g_ptr_array_new_with_free_func(
+		(GDestroyNotify) bt_stream_put_ref);
+	port_name = g_string_new(NULL);
+	if (!synth_comp->event_classes || !synth_comp->streams || !port_name) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+			"Failed to allocate component data.");
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	}
+
+	status = handle_params(synth_comp, params);
+	if (status != BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+			"Invalid parameters: comp-addr=%p", self_comp);
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto error;
+	}
+
+	if (create_meta(synth_comp, bt_value_map_borrow_entry_value_const(
+			params, "event-classes"))) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+			"Cannot create metadata objects: comp-addr=%p",
+			self_comp);
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto error;
+	}
+
+	if (create_trace_and_streams(synth_comp)) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto error;
+	}
+
+	if (synth_comp->params.port_per_stream) {
+		uint64_t i;
+
+		/*
+		 * The user data of a port is its stream index plus one
+		 * so that it's never `NULL`.
+		 */
+		for (i = 0; i < synth_comp->params.stream_count; i++) {
+			g_string_printf(port_name, "out%" PRIu64, i);
+			add_port_status = bt_self_component_source_add_output_port(
+				self_comp_src, port_name->str,
+				GUINT_TO_POINTER(i + 1), NULL);
+			if (add_port_status != BT_SELF_COMPONENT_ADD_PORT_STATUS_OK) {
+				BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+					"Failed to add output port: name=\"%s\"",
+					port_name->str);
+				status = (int) add_port_status;
+				goto error;
+			}
+		}
+	} else {
+		add_port_status = bt_self_component_source_add_output_port(
+			self_comp_src, "out", NULL, NULL);
+		if (add_port_status != BT_SELF_COMPONENT_ADD_PORT_STATUS_OK) {
+			BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+				"Failed to add output port.");
+			status = (int) add_port_status;
+			goto error;
+		}
+	}
+
+	bt_self_component_set_data(self_comp, synth_comp);
+	BT_COMP_LOGI("Component initialized: stream-count=%" PRIu64 ", "
+		"event-count=%" PRIu64 ", events-per-packet=%" PRIu64 ", "
+		"event-class-count=%u, rate=%" PRIu64,
+		synth_comp->params.stream_count,
+		synth_comp->params.event_count,
+		synth_comp->params.events_per_packet,
+		synth_comp->event_classes->len, synth_comp->params.rate);
+
+	status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
+	goto end;
+
+error:
+	destroy_synth_component(synth_comp);
+	bt_self_component_set_data(self_comp, NULL);
+
+end:
+	if (port_name) {
+		g_string_free(port_name, TRUE);
+	}
+
+	return status;
+}
+
+void synthetic_finalize(bt_self_component_source *self_comp)
+{
+	destroy_synth_component(bt_self_component_get_data(
+		bt_self_component_source_as_self_component(self_comp)));
+}
+
+static
+uint64_t next_random(struct synth_msg_iter *synth_msg_iter)
+{
+	uint64_t x = synth_msg_iter->prng_state;
+
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	synth_msg_iter->prng_state = x;
+	return x * UINT64_C(0x2545F4914F6CDD1D);
+}
+
+/*
+ * Resets the state of `synth_msg_iter` so that it emits its messages
+ * from the beginning again: the same parameters always lead to the same
+ * messages.
+ */
+static
+void reset_msg_iter(struct synth_msg_iter *synth_msg_iter)
+{
+	struct synth_component *synth_comp = synth_msg_iter->synth_comp;
+	guint i;
+
+	for (i = 0; i < synth_msg_iter->streams->len; i++) {
+		struct synth_stream_state *stream_state = &g_array_index(
+			synth_msg_iter->streams, struct synth_stream_state, i);
+
+		BT_PACKET_PUT_REF_AND_RESET(stream_state->packet);
+		stream_state->action = STREAM_ACTION_STREAM_BEGINNING;
+		stream_state->event_count = 0;
+		stream_state->packet_event_count = 0;
+		stream_state->next_discarded_at =
+			synth_comp->params.discarded_events_period;
+		stream_state->has_pending_ts = false;
+	}
+
+	synth_msg_iter->cur_stream = 0;
+	synth_msg_iter->active_stream_count = synth_msg_iter->streams->len;
+	synth_msg_iter->next_event_class = 0;
+	synth_msg_iter->ts = 0;
+	synth_msg_iter->burst_remaining = 0;
+
+	/* xorshift64* needs a non-zero state */
+	synth_msg_iter->prng_state = synth_comp->params.seed ^
+		UINT64_C(0x9E3779B97F4A7C15);
+	if (synth_msg_iter->prng_state == 0) {
+		synth_msg_iter->prng_state = 1;
+	}
+
+	synth_msg_iter->start_time_us = -1;
+	synth_msg_iter->emitted_event_count = 0;
+}
+
+static
+void destroy_synth_msg_iter(struct synth_msg_iter *synth_msg_iter)
+{
+	if (!synth_msg_iter) {
+		return;
+	}
+
+	if (synth_msg_iter->streams) {
+		guint i;
+
+		for (i = 0; i < synth_msg_iter->streams->len; i++) {
+			bt_packet_put_ref(g_array_index(synth_msg_iter->streams,
+				struct synth_stream_state, i).packet);
+		}
+
+		g_array_free(synth_msg_iter->streams, TRUE);
+	}
+
+	g_free(synth_msg_iter);
+}
+
+bt_message_iterator_class_initialize_method_status synthetic_msg_iter_init(
+		bt_self_message_iterator *self_msg_iter,
+		bt_self_message_iterator_configuration *config __attribute__((unused)),
+		bt_self_component_port_output *self_port)
+{
+	bt_self_component *self_comp =
+		bt_self_message_iterator_borrow_component(self_msg_iter);
+	struct synth_component *synth_comp =
+		bt_self_component_get_data(self_comp);
+	struct synth_msg_iter *synth_msg_iter =
+		g_new0(struct synth_msg_iter, 1);
+	guint port_data = GPOINTER_TO_UINT(bt_self_component_port_get_data(
+		bt_self_component_port_output_as_self_component_port(
+			self_port)));
+	bt_message_iterator_class_initialize_method_status status;
+	guint i;
+
+	if (!synth_msg_iter) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+			"Failed to allocate one synthetic message iterator structure.");
+		status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	}
+
+	synth_msg_iter->synth_comp = synth_comp;
+	synth_msg_iter->self_msg_iter = self_msg_iter;
+	synth_msg_iter->streams = g_array_new(FALSE, TRUE,
+		sizeof(struct synth_stream_state));
+	if (!synth_msg_iter->streams) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+			"Failed to allocate a GArray.");
+		status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	}
+
+	/* A port without user data emits all the streams */
+	for (i = 0; i < synth_comp->streams->len; i++) {
+		struct synth_stream_state stream_state = { 0 };
+
+		if (port_data != 0 && port_data != i + 1) {
+			continue;
+		}
+
+		stream_state.stream = g_ptr_array_index(synth_comp->streams, i);
+		g_array_append_val(synth_msg_iter->streams, stream_state);
+	}
+
+	BT_ASSERT(synth_msg_iter->streams->len > 0);
+	reset_msg_iter(synth_msg_iter);
+	bt_self_message_iterator_set_data(self_msg_iter, synth_msg_iter);
+	status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_OK;
+	goto end;
+
+error:
+	destroy_synth_msg_iter(synth_msg_iter);
+	bt_self_message_iterator_set_data(self_msg_iter, NULL);
+
+end:
+	return status;
+}
+
+void synthetic_msg_iter_finalize(
+		bt_self_message_iterator *self_msg_iter)
+{
+	destroy_synth_msg_iter(bt_self_message_iterator_get_data(
+		self_msg_iter));
+}
+
+/*
+ * Returns the timestamp of the next event, advancing the current
+ * timestamp according to the timestamp distribution.
+ *
+ * All the distributions have a mean delta of `timestamp-mean-delta`:
+ *
+ * `constant`:
+ *     Always the mean delta.
+ *
+ * `uniform`:
+ *     A delta in the [1, 2 × mean − 1] range.
+ *
+ * `burst`:
+ *     Bursts of `BURST_EVENT_COUNT` events, 1 ns apart, separated
+ *     with a gap which keeps the mean.
+ */
+static
+uint64_t next_event_ts(struct synth_msg_iter *synth_msg_iter)
+{
+	const uint64_t mean = synth_msg_iter->synth_comp->params.ts_mean_delta;
+	uint64_t delta;
+
+	switch (synth_msg_iter->synth_comp->params.ts_distribution) {
+	case TIMESTAMP_DISTRIBUTION_CONSTANT:
+		delta = mean;
+		break;
+	case TIMESTAMP_DISTRIBUTION_UNIFORM:
+		delta = 1 + next_random(synth_msg_iter) % (2 * mean - 1);
+		break;
+	case TIMESTAMP_DISTRIBUTION_BURST:
+		if (synth_msg_iter->burst_remaining == 0) {
+			synth_msg_iter->burst_remaining = BURST_EVENT_COUNT;
+			delta = BURST_EVENT_COUNT * mean -
+				(BURST_EVENT_COUNT - 1);
+		} else {
+			delta = 1;
+		}
+
+		synth_msg_iter->burst_remaining--;
+		break;
+	default:
+		bt_common_abort();
+	}
+
+	synth_msg_iter->ts += delta;
+	return synth_msg_iter->ts;
+}
+
+static
+int fill_member_field(struct synth_msg_iter *synth_msg_iter,
+		const struct synth_member *member, bt_field *field)
+{
+	const uint64_t r = next_random(synth_msg_iter);
+	int ret = 0;
+
+	switch (member->kind) {
+	case MEMBER_KIND_UINT:
+		bt_field_integer_unsigned_set_value(field, member->size == 64 ?
+			r : r & ((UINT64_C(1) << member->size) - 1));
+		break;
+	case MEMBER_KIND_SINT:
+		/* Arithmetic shift keeps the value within the range */
+		bt_field_integer_signed_set_value(field,
+			(int64_t) r >> (64 - member->size));
+		break;
+	case MEMBER_KIND_BOOL:
+		bt_field_bool_set_value(field, (bt_bool) (r >> 63));
+		break;
+	case MEMBER_KIND_FLOAT:
+		bt_field_real_single_precision_set_value(field,
+			(float) (r >> 40) / (float) (UINT64_C(1) << 24));
+		break;
+	case MEMBER_KIND_DOUBLE:
+		bt_field_real_double_precision_set_value(field,
+			(double) (r >> 11) / (double) (UINT64_C(1) << 53));
+		break;
+	case MEMBER_KIND_STRING:
+		if (bt_field_string_set_value(field,
+				words[(r >> 32) % G_N_ELEMENTS(words)])) {
+			ret = -1;
+		}
+
+		break;
+	default:
+		bt_common_abort();
+	}
+
+	return ret;
+}
+
+static
+int fill_payload(struct synth_msg_iter *synth_msg_iter,
+		const struct synth_event_class *synth_ec, bt_field *payload)
+{
+	guint i;
+	int ret = 0;
+
+	for (i = 0; i < synth_ec->members->len; i++) {
+		const struct synth_member *member = &g_array_index(
+			synth_ec->members, struct synth_member, i);
+		bt_field *field =
+			bt_field_structure_borrow_member_field_by_index(
+				payload, i);
+
+		if (member->array_len == 0) {
+			ret = fill_member_field(synth_msg_iter, member, field);
+		} else {
+			uint64_t j;
+
+			for (j = 0; j < member->array_len && ret == 0; j++) {
+				ret = fill_member_field(synth_msg_iter, member,
+					bt_field_array_borrow_element_field_by_index(
+						field, j));
+			}
+		}
+
+		if (ret) {
+			break;
+		}
+	}
+
+	return ret;
+}
+
+static
+bt_message *create_event_msg(struct synth_msg_iter *synth_msg_iter,
+		struct synth_stream_state *stream_state, uint64_t ts)
+{
+	struct synth_component *synth_comp = synth_msg_iter->synth_comp;
+	const struct synth_event_class *synth_ec = &g_array_index(
+		synth_comp->event_classes, struct synth_event_class,
+		synth_msg_iter->next_event_class);
+	bt_message *msg;
+
+	if (stream_state->packet) {
+		msg = bt_message_event_create_with_packet_and_default_clock_snapshot(
+			synth_msg_iter->self_msg_iter, synth_ec->event_class,
+			stream_state->packet, ts);
+	} else {
+		msg = bt_message_event_create_with_default_clock_snapshot(
+			synth_msg_iter->self_msg_iter, synth_ec->event_class,
+			stream_state->stream, ts);
+	}
+
+	if (!msg) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot create event message.");
+		goto end;
+	}
+
+	if (fill_payload(synth_msg_iter, synth_ec,
+			bt_event_borrow_payload_field(
+				bt_message_event_borrow_event(msg)))) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot set event payload field.");
+		BT_MESSAGE_PUT_REF_AND_RESET(msg);
+		goto end;
+	}
+
+	synth_msg_iter->next_event_class++;
+	if (synth_msg_iter->next_event_class == synth_comp->event_classes->len) {
+		synth_msg_iter->next_event_class = 0;
+	}
+
+end:
+	return msg;
+}
+
+/*
+ * Returns whether or not the message iterator may emit one more event
+ * message now, considering the `rate` parameter.
+ */
+static
+bool rate_allows_event(struct synth_msg_iter *synth_msg_iter)
+{
+	const uint64_t rate = synth_msg_iter->synth_comp->params.rate;
+	gint64 now_us;
+	uint64_t allowed;
+
+	if (rate == 0) {
+		return true;
+	}
+
+	now_us = g_get_monotonic_time();
+	if (synth_msg_iter->start_time_us < 0) {
+		synth_msg_iter->start_time_us = now_us;
+	}
+
+	allowed = (uint64_t) ((double) (now_us -
+		synth_msg_iter->start_time_us) * (double) rate / USEC_PER_SEC);
+	return synth_msg_iter->emitted_event_count <= allowed;
+}
+
+/*
+ * Makes the next stream which isn't done the current one, if any.
+ */
+static
+void next_stream(struct synth_msg_iter *synth_msg_iter)
+{
+	guint i;
+
+	for (i = 0; i < synth_msg_iter->streams->len; i++) {
+		synth_msg_iter->cur_stream++;
+		if (synth_msg_iter->cur_stream == synth_msg_iter->streams->len) {
+			synth_msg_iter->cur_stream = 0;
+		}
+
+		if (g_array_index(synth_msg_iter->streams,
+				struct synth_stream_state,
+				synth_msg_iter->cur_stream).action !=
+				STREAM_ACTION_DONE) {
+			break;
+		}
+	}
+}
+
+/*
+ * Sets the action of `stream_state` which follows an event or a packet
+ * beginning message.
+ */
+static
+void set_action_after_event(struct synth_msg_iter *synth_msg_iter,
+		struct synth_stream_state *stream_state)
+{
+	const struct synth_component *synth_comp = synth_msg_iter->synth_comp;
+
+	if (stream_state->packet &&
+			(stream_state->packet_event_count ==
+				synth_comp->params.events_per_packet ||
+			stream_state->event_count ==
+				synth_comp->params.event_count)) {
+		stream_state->action = STREAM_ACTION_PACKET_END;
+	} else if (stream_state->event_count == synth_comp->params.event_count) {
+		stream_state->action = STREAM_ACTION_STREAM_END;
+	} else {
+		stream_state->action = STREAM_ACTION_EVENT;
+	}
+}
+
+static
+bt_message_iterator_class_next_method_status synthetic_msg_iter_next_one(
+		struct synth_msg_iter *synth_msg_iter,
+		bt_message **msg)
+{
+	struct synth_component *synth_comp = synth_msg_iter->synth_comp;
+	struct synth_stream_state *stream_state;
+	bt_message_iterator_class_next_method_status status;
+	bool switch_stream = true;
+	uint64_t ts;
+
+	if (synth_msg_iter->active_stream_count == 0) {
+		status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_END;
+		goto end;
+	}
+
+	stream_state = &g_array_index(synth_msg_iter->streams,
+		struct synth_stream_state, synth_msg_iter->cur_stream);
+
+	/*
+	 * Each case only updates the state of the message iterator once
+	 * it has created its message: after a failure, the next call
+	 * tries to create the same message again.
+	 */
+	switch (stream_state->action) {
+	case STREAM_ACTION_STREAM_BEGINNING:
+		*msg = bt_message_stream_beginning_create(
+			synth_msg_iter->self_msg_iter, stream_state->stream);
+		if (!*msg) {
+			break;
+		}
+
+		if (synth_comp->params.event_count == 0) {
+			stream_state->action = STREAM_ACTION_STREAM_END;
+		} else if (synth_comp->params.events_per_packet > 0) {
+			stream_state->action = STREAM_ACTION_PACKET_BEGINNING;
+		} else {
+			stream_state->action = STREAM_ACTION_EVENT;
+		}
+
+		break;
+	case STREAM_ACTION_PACKET_BEGINNING:
+		BT_ASSERT_DBG(!stream_state->packet);
+		stream_state->packet = bt_packet_create(stream_state->stream);
+		if (!stream_state->packet) {
+			BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+				"Cannot create packet object.");
+			status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_MEMORY_ERROR;
+			goto end;
+		}
+
+		*msg = bt_message_packet_beginning_create_with_default_clock_snapshot(
+			synth_msg_iter->self_msg_iter, stream_state->packet,
+			synth_msg_iter->ts);
+		if (!*msg) {
+			BT_PACKET_PUT_REF_AND_RESET(stream_state->packet);
+			break;
+		}
+
+		stream_state->packet_event_count = 0;
+		stream_state->action = STREAM_ACTION_EVENT;
+		switch_stream = false;
+		break;
+	case STREAM_ACTION_EVENT:
+		if (!rate_allows_event(synth_msg_iter)) {
+			status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN;
+			goto end;
+		}
+
+		/*
+		 * The timestamp of this event remains pending until its
+		 * event message exists.
+		 */
+		if (!stream_state->has_pending_ts) {
+			stream_state->pending_ts = next_event_ts(synth_msg_iter);
+			stream_state->has_pending_ts = true;
+		}
+
+		ts = stream_state->pending_ts;
+
+		if (stream_state->event_count ==
+				stream_state->next_discarded_at &&
+				stream_state->event_count > 0) {
+			/*
+			 * Emit a discarded events message between the
+			 * previous message and this event.
+			 */
+			*msg = bt_message_discarded_events_create_with_default_clock_snapshots(
+				synth_msg_iter->self_msg_iter,
+				stream_state->stream, ts - 1, ts);
+			if (!*msg) {
+				break;
+			}
+
+			bt_message_discarded_events_set_count(*msg,
+				1 + next_random(synth_msg_iter) % 100);
+			stream_state->next_discarded_at +=
+				synth_comp->params.discarded_events_period;
+			switch_stream = false;
+			break;
+		}
+
+		*msg = create_event_msg(synth_msg_iter, stream_state, ts);
+		if (!*msg) {
+			break;
+		}
+
+		stream_state->has_pending_ts = false;
+		stream_state->event_count++;
+		stream_state->packet_event_count++;
+		synth_msg_iter->emitted_event_count++;
+		set_action_after_event(synth_msg_iter, stream_state);
+		switch_stream = stream_state->action == STREAM_ACTION_EVENT;
+		break;
+	case STREAM_ACTION_PACKET_END:
+		BT_ASSERT_DBG(stream_state->packet);
+		*msg = bt_message_packet_end_create_with_default_clock_snapshot(
+			synth_msg_iter->self_msg_iter, stream_state->packet,
+			synth_msg_iter->ts);
+		if (!*msg) {
+			break;
+		}
+
+		BT_PACKET_PUT_REF_AND_RESET(stream_state->packet);
+
+		if (stream_state->event_count == synth_comp->params.event_count) {
+			stream_state->action = STREAM_ACTION_STREAM_END;
+		} else {
+			stream_state->action = STREAM_ACTION_PACKET_BEGINNING;
+		}
+
+		break;
+	case STREAM_ACTION_STREAM_END:
+		*msg = bt_message_stream_end_create(
+			synth_msg_iter->self_msg_iter, stream_state->stream);
+		if (!*msg) {
+			break;
+		}
+
+		stream_state->action = STREAM_ACTION_DONE;
+		synth_msg_iter->active_stream_count--;
+		break;
+	default:
+		bt_common_abort();
+	}
+
+	if (!*msg) {
+		BT_COMP_LOGE_APPEND_CAUSE(synth_comp->self_comp,
+			"Cannot create message: synth-comp-addr=%p",
+			synth_comp);
+		status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+		goto end;
+	}
+
+	if (switch_stream) {
+		next_stream(synth_msg_iter);
+	}
+
+	status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+
+end:
+	return status;
+}
+
+bt_message_iterator_class_next_method_status synthetic_msg_iter_next(
+		bt_self_message_iterator *self_msg_iter,
+		bt_message_array_const msgs, uint64_t capacity,
+		uint64_t *count)
+{
+	struct synth_msg_iter *synth_msg_iter =
+		bt_self_message_iterator_get_data(self_msg_iter);
+	bt_message_iterator_class_next_method_status status =
+		BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+	uint64_t i = 0;
+
+	while (i < capacity &&
+			status == BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK) {
+		bt_message *priv_msg = NULL;
+
+		status = synthetic_msg_iter_next_one(synth_msg_iter,
+			&priv_msg);
+		msgs[i] = priv_msg;
+		if (status == BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK) {
+			i++;
+		}
+	}
+
+	if (i > 0) {
+		/*
+		 * Return the accumulated messages now: the other status
+		 * occurs again on the next call, as
+		 * synthetic_msg_iter_next_one() doesn't update the state
+		 * of the message iterator when it fails.
+		 *
+		 * In the meantime, this status must not leave an error
+		 * cause behind.
+		 */
+		if (status < 0) {
+			bt_current_thread_clear_error();
+		}
+
+		*count = i;
+		status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+	}
+
+	return status;
+}
+
+bt_message_iterator_class_can_seek_beginning_method_status
+synthetic_msg_iter_can_seek_beginning(
+		bt_self_message_iterator *self_msg_iter __attribute__((unused)),
+		bt_bool *can_seek)
+{
+	*can_seek = BT_TRUE;
+	return BT_MESSAGE_ITERATOR_CLASS_CAN_SEEK_BEGINNING_METHOD_STATUS_OK;
+}
+
+bt_message_iterator_class_seek_beginning_method_status
+synthetic_msg_iter_seek_beginning(
+		bt_self_message_iterator *self_msg_iter)
+{
+	reset_msg_iter(bt_self_message_iterator_get_data(self_msg_iter));
+	return BT_MESSAGE_ITERATOR_CLASS_SEEK_BEGINNING_METHOD_STATUS_OK;
+}
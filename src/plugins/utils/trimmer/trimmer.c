@@ -106,14 +106,43 @@ struct trimmer_iterator {
 	 *
 	 * This is where the trimming operation pushes the messages to
 	 * output by this message iterator.
+	 *
+	 * This message iterator only gets messages from its upstream
+	 * message iterator when this queue is empty, so that the queue
+	 * holds at most one upstream batch and the stream end messages
+	 * of end_iterator_streams().
 	 */
 	GQueue *output_messages;
 
+	/*
+	 * Estimated size of the messages of `output_messages` (bytes),
+	 * which the component reports to retain.
+	 */
+	uint64_t output_messages_size;
+
+	/*
+	 * Whether or not the graph has a memory limit: estimating the
+	 * size of a message walks its fields, so this message iterator
+	 * only reports the size of `output_messages` when some
+	 * component may read its remaining memory budget.
+	 */
+	bool report_output_messages_size;
+
 	/*
 	 * Hash table of `bt_stream *` (weak) to
 	 * `struct trimmer_iterator_stream_state *` (owned by the HT).
 	 */
 	GHashTable *stream_states;
+
+	/*
+	 * Last stream state looked up in `stream_states` and its
+	 * stream (both weak, `NULL` initially).
+	 *
+	 * Consecutive messages very often belong to the same stream, so
+	 * this cache avoids most hash table lookups.
+	 */
+	const bt_stream *last_stream;
+	struct trimmer_iterator_stream_state *last_sstate;
 };
 
 struct trimmer_iterator_stream_state {
@@ -661,6 +690,12 @@ void destroy_trimmer_iterator(struct trimmer_iterator *trimmer_it)
 		g_queue_free(trimmer_it->output_messages);
 	}
 
+	if (trimmer_it->output_messages_size > 0) {
+		bt_self_component_remove_retained_memory_size(
+			trimmer_it->trimmer_comp->self_comp,
+			trimmer_it->output_messages_size);
+	}
+
 	if (trimmer_it->stream_states) {
 		g_hash_table_destroy(trimmer_it->stream_states);
 	}
@@ -688,6 +723,7 @@ bt_message_iterator_class_initialize_method_status trimmer_msg_iter_init(
 	bt_message_iterator_create_from_message_iterator_status
 		msg_iter_status;
 	struct trimmer_iterator *trimmer_it;
+	bt_self_component_port_input *in_port;
 	bt_self_component *self_comp =
 		bt_self_message_iterator_borrow_component(self_msg_iter);
 
@@ -713,12 +749,18 @@ bt_message_iterator_class_initialize_method_status trimmer_msg_iter_init(
 
 	trimmer_it->begin = trimmer_it->trimmer_comp->begin;
 	trimmer_it->end = trimmer_it->trimmer_comp->end;
+	in_port = bt_self_component_filter_borrow_input_port_by_name(
+		trimmer_it->trimmer_comp->self_comp_filter, in_port_name);
+
+	/*
+	 * The trimmer only needs the event timestamps: pass the hint of
+	 * the downstream component through.
+	 */
+	bt_self_component_port_input_set_needed_event_fields(in_port,
+		bt_self_message_iterator_get_needed_event_fields(self_msg_iter));
 	msg_iter_status =
 		bt_message_iterator_create_from_message_iterator(
-			self_msg_iter,
-			bt_self_component_filter_borrow_input_port_by_name(
-				trimmer_it->trimmer_comp->self_comp_filter, in_port_name),
-			&trimmer_it->upstream_iter);
+			self_msg_iter, in_port, &trimmer_it->upstream_iter);
 	if (msg_iter_status != BT_MESSAGE_ITERATOR_CREATE_FROM_MESSAGE_ITERATOR_STATUS_OK) {
 		status = (int) msg_iter_status;
 		goto error;
@@ -730,6 +772,11 @@ bt_message_iterator_class_initialize_method_status trimmer_msg_iter_init(
 		goto error;
 	}
 
+	/* The memory limit of a graph is fixed once it's configured */
+	trimmer_it->report_output_messages_size =
+		bt_self_component_get_remaining_memory_budget(self_comp) !=
+			UINT64_MAX;
+
 	trimmer_it->stream_states = g_hash_table_new_full(g_direct_hash,
 		g_direct_equal, NULL,
 		(GDestroyNotify) destroy_trimmer_iterator_stream_state);
@@ -1100,7 +1147,18 @@ end:
 static inline
 void push_message(struct trimmer_iterator *trimmer_it, const bt_message *msg)
 {
+	uint64_t size;
+
 	g_queue_push_head(trimmer_it->output_messages, (void *) msg);
+
+	if (G_LIKELY(!trimmer_it->report_output_messages_size)) {
+		return;
+	}
+
+	size = bt_message_get_retained_memory_size(msg);
+	trimmer_it->output_messages_size += size;
+	bt_self_component_add_retained_memory_size(
+		trimmer_it->trimmer_comp->self_comp, size);
 }
 
 static inline
@@ -1214,6 +1272,13 @@ end:
 	return status;
 }
 
+static inline
+void reset_last_stream_state(struct trimmer_iterator *trimmer_it)
+{
+	trimmer_it->last_stream = NULL;
+	trimmer_it->last_sstate = NULL;
+}
+
 static inline
 bt_message_iterator_class_next_method_status end_iterator_streams(
 		struct trimmer_iterator *trimmer_it)
@@ -1246,6 +1311,7 @@ bt_message_iterator_class_next_method_status end_iterator_streams(
 	}
 
 remove_all:
+	reset_last_stream_state(trimmer_it);
 	g_hash_table_remove_all(trimmer_it->stream_states);
 
 end:
@@ -1378,9 +1444,18 @@ struct trimmer_iterator_stream_state *get_stream_state_entry(
 	struct trimmer_iterator_stream_state *sstate;
 
 	BT_ASSERT_DBG(stream);
+
+	if (G_LIKELY(stream == trimmer_it->last_stream)) {
+		sstate = trimmer_it->last_sstate;
+		goto end;
+	}
+
 	sstate = g_hash_table_lookup(trimmer_it->stream_states, stream);
-	BT_ASSERT_DBG(sstate);
+	trimmer_it->last_stream = stream;
+	trimmer_it->last_sstate = sstate;
 
+end:
+	BT_ASSERT_DBG(sstate);
 	return sstate;
 }
 
@@ -1421,28 +1496,10 @@ handle_message_with_stream(
 		sstate = get_stream_state_entry(trimmer_it, stream);
 	}
 
-	switch (msg_type) {
-	case BT_MESSAGE_TYPE_EVENT:
-		/*
-		 * Event messages always have a clock snapshot if the stream
-		 * class has a clock class. And we know it has, otherwise we
-		 * couldn't be using the trimmer component.
-		 */
-		BT_ASSERT_DBG(ns_from_origin);
-
-		if (G_UNLIKELY(!trimmer_it->end.is_infinite &&
-				*ns_from_origin > trimmer_it->end.ns_from_origin)) {
-			status = end_iterator_streams(trimmer_it);
-			*reached_end = true;
-			break;
-		}
-
-		sstate->seen_clock_snapshot = true;
-
-		push_message(trimmer_it, msg);
-		msg = NULL;
-		break;
+	/* Event messages are handled by handle_event_message() */
+	BT_ASSERT_DBG(msg_type != BT_MESSAGE_TYPE_EVENT);
 
+	switch (msg_type) {
 	case BT_MESSAGE_TYPE_PACKET_BEGINNING:
 		/*
 		 * Packet beginning messages won't have a clock snapshot if
@@ -1643,6 +1700,7 @@ handle_message_with_stream(
 		msg = NULL;
 
 		/* Forget about this stream. */
+		reset_last_stream_state(trimmer_it);
 		removed = g_hash_table_remove(trimmer_it->stream_states, sstate->stream);
 		BT_ASSERT(removed);
 		break;
@@ -1657,6 +1715,62 @@ end:
 	return status;
 }
 
+/*
+ * Handles an event message, the fast path of handle_message().
+ *
+ * Event messages always have a clock snapshot if the stream class has
+ * a clock class. And we know it has, otherwise we couldn't be using
+ * the trimmer component.
+ *
+ * With an infinite trimming range's end time, there's no bound to
+ * check and the stream state's `seen_clock_snapshot` flag is never
+ * used (see end_stream()): forward the message as is without looking
+ * up its stream state nor computing its time.
+ *
+ * This function consumes the `msg` reference, _whatever the outcome_.
+ */
+static inline
+bt_message_iterator_class_next_method_status handle_event_message(
+		struct trimmer_iterator *trimmer_it, const bt_message *msg,
+		bool *reached_end)
+{
+	bt_message_iterator_class_next_method_status status =
+		BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+	struct trimmer_iterator_stream_state *sstate;
+	int64_t ns_from_origin;
+
+	if (trimmer_it->end.is_infinite) {
+		push_message(trimmer_it, msg);
+		msg = NULL;
+		goto end;
+	}
+
+	if (G_UNLIKELY(bt_clock_snapshot_get_ns_from_origin(
+			bt_message_event_borrow_default_clock_snapshot_const(msg),
+			&ns_from_origin))) {
+		status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+		goto end;
+	}
+
+	if (G_UNLIKELY(ns_from_origin > trimmer_it->end.ns_from_origin)) {
+		status = end_iterator_streams(trimmer_it);
+		*reached_end = true;
+		goto end;
+	}
+
+	sstate = get_stream_state_entry(trimmer_it,
+		bt_event_borrow_stream_const(
+			bt_message_event_borrow_event_const(msg)));
+	sstate->seen_clock_snapshot = true;
+	push_message(trimmer_it, msg);
+	msg = NULL;
+
+end:
+	/* We release the message's reference whatever the outcome */
+	bt_message_put_ref(msg);
+	return status;
+}
+
 /*
  * Handles an input message. This _could_ make the iterator's output
  * message queue grow; this could also consume the message without
@@ -1680,12 +1794,16 @@ bt_message_iterator_class_next_method_status handle_message(
 	bool has_ns_from_origin = false;
 	int ret;
 
+	if (G_LIKELY(bt_message_get_type(msg) == BT_MESSAGE_TYPE_EVENT)) {
+		status = handle_event_message(trimmer_it, msg, reached_end);
+
+		/* handle_event_message() unconditionally consumes `msg` */
+		msg = NULL;
+		goto end;
+	}
+
 	/* Find message's associated stream */
 	switch (bt_message_get_type(msg)) {
-	case BT_MESSAGE_TYPE_EVENT:
-		stream = bt_event_borrow_stream_const(
-			bt_message_event_borrow_event_const(msg));
-		break;
 	case BT_MESSAGE_TYPE_PACKET_BEGINNING:
 		stream = bt_packet_borrow_stream_const(
 			bt_message_packet_beginning_borrow_packet_const(msg));
@@ -1767,6 +1885,14 @@ void fill_message_array_from_output_messages(
 	}
 
 	BT_ASSERT_DBG(*count > 0);
+
+	if (trimmer_it->output_messages_size > 0 &&
+			g_queue_is_empty(trimmer_it->output_messages)) {
+		bt_self_component_remove_retained_memory_size(
+			trimmer_it->trimmer_comp->self_comp,
+			trimmer_it->output_messages_size);
+		trimmer_it->output_messages_size = 0;
+	}
 }
 
 static inline
@@ -1874,6 +2000,39 @@ end:
 	return status;
 }
 
+/*
+ * With an infinite trimming range's end time, this message iterator
+ * forwards everything it receives once trimming: it only needs to see
+ * the stream and packet beginning/end messages to maintain its stream
+ * states. Once the output message queue is empty, make the library
+ * pass all the other messages of the upstream message iterator
+ * through, without calling trimmer_msg_iter_next(), until a batch
+ * contains such a message.
+ *
+ * When the upstream message iterator ends while passing through, this
+ * message iterator also ends: there's no stream to end in that case
+ * (see end_iterator_streams()).
+ */
+static inline
+void try_pass_through(struct trimmer_iterator *trimmer_it)
+{
+	if (!trimmer_it->end.is_infinite ||
+			trimmer_it->state != TRIMMER_ITERATOR_STATE_TRIM ||
+			!g_queue_is_empty(trimmer_it->output_messages)) {
+		goto end;
+	}
+
+	bt_self_message_iterator_set_pass_through(trimmer_it->self_msg_iter,
+		trimmer_it->upstream_iter,
+		BT_MESSAGE_TYPE_STREAM_BEGINNING |
+		BT_MESSAGE_TYPE_STREAM_END |
+		BT_MESSAGE_TYPE_PACKET_BEGINNING |
+		BT_MESSAGE_TYPE_PACKET_END);
+
+end:
+	return;
+}
+
 bt_message_iterator_class_next_method_status trimmer_msg_iter_next(
 		bt_self_message_iterator *self_msg_iter,
 		bt_message_array_const msgs, uint64_t capacity,
@@ -1891,6 +2050,8 @@ bt_message_iterator_class_next_method_status trimmer_msg_iter_next(
 		if (status != BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK) {
 			goto end;
 		}
+
+		try_pass_through(trimmer_it);
 	} else {
 		switch (trimmer_it->state) {
 		case TRIMMER_ITERATOR_STATE_SET_BOUNDS_NS_FROM_ORIGIN:
@@ -0,0 +1,559 @@
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2024 EfficiOS Inc.
+#
+
+# Runs the trace processing benchmark scenarios and reports the results
+# as a JSON object.
+#
+# Each scenario runs the `babeltrace2` command a few times on a
+# synthetic trace which `gen-trace.py` generates, or on copies of the
+# real metadata of a trace of `tests/data/ctf-traces`. Its result
+# contains the median wall time, the resulting input throughput
+# (messages and data stream bytes per second), and the maximum peak
+# resident set size of the runs.
+#
+# The throughput of a scenario is always relative to its _input_ trace:
+# for example, the `trim` scenario reads the whole trace but only
+# outputs half of its messages.
+
+import os
+import sys
+import json
+import time
+import shutil
+import argparse
+import platform
+import tempfile
+import statistics
+import subprocess
+from typing import Any, Dict, List, Callable, Optional
+
+_SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+
+# Real LTTng kernel trace of which the `real-metadata` scenario decodes
+# the metadata
+_REAL_METADATA_TRACE_DIR = os.path.normpath(
+    os.path.join(
+        _SCRIPT_DIR, "..", "data", "ctf-traces", "succeed", "multi-domains", "kernel"
+    )
+)
+
+# Version of the JSON report layout
+_REPORT_VERSION = 1
+
+
+class _Trace:
+    def __init__(self, path: str, info: Dict[str, int]):
+        self._path = path
+        self._info = info
+
+    @property
+    def path(self):
+        return self._path
+
+    @property
+    def info(self):
+        return self._info
+
+
+class _Scenario:
+    def __init__(
+        self,
+        name: str,
+        descr: str,
+        trace_name: str,
+        args: Callable[[_Trace, str], List[str]],
+        required_cc: Optional[str] = None,
+    ):
+        self._name = name
+        self._descr = descr
+        self._trace_name = trace_name
+        self._args = args
+        self._required_cc = required_cc
+
+    @property
+    def name(self):
+        return self._name
+
+    @property
+    def descr(self):
+        return self._descr
+
+    @property
+    def trace_name(self):
+        return self._trace_name
+
+    # Returns the `babeltrace2` arguments to run this scenario on
+    # `trace`, `tmp_dir` being an empty temporary directory.
+    def args(self, trace: _Trace, tmp_dir: str):
+        return self._args(trace, tmp_dir)
+
+    # Component class which the `babeltrace2` command must have to run
+    # this scenario, if any.
+    @property
+    def required_cc(self):
+        return self._required_cc
+
+
+# Returns the `--begin`/`--end` arguments to keep the middle half of
+# the time range of the generated traces.
+def _trim_args(trace: _Trace):
+    # Event timestamps increase by 500 ns on average
+    duration_ns = 500 * trace.info["events"] // trace.info["streams"]
+    begin_ns = 1700000000 * 1000000000 + duration_ns // 4
+    end_ns = begin_ns + duration_ns // 2
+    return [
+        "--begin={}.{:09}".format(begin_ns // 1000000000, begin_ns % 1000000000),
+        "--end={}.{:09}".format(end_ns // 1000000000, end_ns % 1000000000),
+    ]
+
+
+# Returns the `--begin` argument to keep the last three quarters of the
+# time range of the generated traces: the end of the trimming time range
+# is infinite.
+def _trim_begin_args(trace: _Trace):
+    return _trim_args(trace)[:1]
+
+
+_SCENARIOS = [
+    _Scenario(
+        "read",
+        "Read the trace (`sink.utils.dummy`)",
+        "main",
+        lambda t, d: [t.path, "-o", "dummy"],
+    ),
+    _Scenario(
+        "count",
+        "Count the messages (`sink.utils.counter`)",
+        "main",
+        lambda t, d: [t.path, "-c", "sink.utils.counter"],
+    ),
+    _Scenario(
+        "pretty",
+        "Pretty-print the trace (`sink.text.pretty`)",
+        "main",
+        lambda t, d: [t.path, "-w", os.path.join(d, "out.txt")],
+    ),
+    _Scenario(
+        "details",
+        "Print the details of the messages (`sink.text.details`)",
+        "main",
+        lambda t, d: [t.path, "-c", "sink.text.details"],
+    ),
+    _Scenario(
+        "trim",
+        "Trim the trace to the middle half of its time range",
+        "main",
+        lambda t, d: [t.path, "-o", "dummy"] + _trim_args(t),
+    ),
+    _Scenario(
+        "trim-begin",
+        "Trim the trace to its last three quarters (infinite end)",
+        "main",
+        lambda t, d: [t.path, "-o", "dummy"] + _trim_begin_args(t),
+    ),
+    _Scenario(
+        "trim-mem-limit",
+        "Like `trim-begin`, with a graph memory limit (`--memory-limit`)",
+        "main",
+        lambda t, d: [t.path, "-o", "dummy", "--memory-limit=1G"] + _trim_begin_args(t),
+    ),
+    _Scenario(
+        "mux",
+        "Read the many-stream trace (`flt.utils.muxer`)",
+        "mux",
+        lambda t, d: [t.path, "-o", "dummy"],
+    ),
+    _Scenario(
+        "debug-info",
+        "Read the trace through `flt.lttng-utils.debug-info`",
+        "main",
+        lambda t, d: [t.path, "-o", "dummy", "--debug-info"],
+        "filter.lttng-utils.debug-info",
+    ),
+    _Scenario(
+        "ctf-reencode",
+        "Write the trace back as CTF (`sink.ctf.fs`)",
+        "main",
+        lambda t, d: [t.path, "-o", "ctf", "-w", os.path.join(d, "out")],
+    ),
+    _Scenario(
+        "metadata",
+        "Read the trace of which the metadata has many event classes",
+        "metadata",
+        lambda t, d: [t.path, "-o", "dummy"],
+    ),
+    _Scenario(
+        "real-metadata",
+        "Decode copies of real LTTng kernel metadata (`babeltrace.trace-infos` query)",
+        "real-metadata",
+        lambda t, d: [
+            "query",
+            "--params=inputs=[{}]".format(
+                ", ".join('"{}"'.format(path) for path in _real_metadata_dirs(t.path))
+            ),
+            "src.ctf.fs",
+            "babeltrace.trace-infos",
+        ],
+    ),
+    _Scenario(
+        "graph-overhead",
+        "Read a trace made of small packets (`sink.utils.dummy`)",
+        "small-packets",
+        lambda t, d: [t.path, "-o", "dummy"],
+    ),
+]
+
+
+# Returns the generation arguments (for `gen-trace.py`) of each trace
+# which the scenarios need.
+def _trace_gen_args(args: argparse.Namespace):
+    return {
+        "main": ["--events", str(args.events), "--streams", "4"],
+        "mux": [
+            "--events",
+            str(args.events),
+            "--streams",
+            str(args.mux_streams),
+        ],
+        "metadata": [
+            "--events",
+            str(max(args.events // 100, 1)),
+            "--extra-event-classes",
+            str(args.metadata_event_classes),
+        ],
+        "small-packets": [
+            "--events",
+            str(args.events),
+            "--events-per-packet",
+            "8",
+        ],
+    }
+
+
+# Generates the trace `name` with the arguments `gen_args`, unless
+# `work_dir` already contains it, and returns it.
+def _get_trace(work_dir: str, name: str, gen_args: List[str], python: str):
+    trace_dir = os.path.join(work_dir, "traces", name)
+    info_path = os.path.join(work_dir, "traces", name + ".json")
+
+    if os.path.isfile(info_path):
+        with open(info_path) as f:
+            cached = json.load(f)
+
+        if cached["gen-args"] == gen_args:
+            return _Trace(trace_dir, cached["info"])
+
+    shutil.rmtree(trace_dir, ignore_errors=True)
+    print("Generating trace `{}`.".format(name), file=sys.stderr)
+    output = subprocess.check_output(
+        [python, os.path.join(_SCRIPT_DIR, "gen-trace.py"), trace_dir] + gen_args,
+        universal_newlines=True,
+    )
+    info = json.loads(output.strip().splitlines()[-1])
+
+    with open(info_path, "w") as f:
+        json.dump({"gen-args": gen_args, "info": info}, f)
+
+    return _Trace(trace_dir, info)
+
+
+# Returns the trace directories of the `real-metadata` trace `path`.
+def _real_metadata_dirs(path: str):
+    return sorted(os.path.join(path, name) for name in os.listdir(path))
+
+
+# Makes `copies` trace directories, within the `real-metadata` trace
+# directory of `work_dir`, which only contain the metadata stream of
+# `_REAL_METADATA_TRACE_DIR`, unless `work_dir` already contains them,
+# and returns this trace.
+#
+# As those traces have no data streams, a `babeltrace.trace-infos` query
+# of `src.ctf.fs` on all of them mostly decodes their metadata
+# streams (the copies have the same UUID, therefore the query merges
+# them into a single trace).
+def _get_real_metadata_trace(work_dir: str, copies: int):
+    trace_dir = os.path.join(work_dir, "traces", "real-metadata")
+    metadata_path = os.path.join(_REAL_METADATA_TRACE_DIR, "metadata")
+    metadata_size = os.path.getsize(metadata_path)
+    info = {
+        "copies": copies,
+        "messages": 0,
+        "data-bytes": copies * metadata_size,
+    }
+
+    if os.path.isdir(trace_dir) and len(os.listdir(trace_dir)) == copies:
+        return _Trace(trace_dir, info)
+
+    shutil.rmtree(trace_dir, ignore_errors=True)
+    print("Copying metadata of `{}`.".format(metadata_path), file=sys.stderr)
+
+    for index in range(copies):
+        copy_dir = os.path.join(trace_dir, "trace-{:05}".format(index))
+        os.makedirs(copy_dir)
+        shutil.copyfile(metadata_path, os.path.join(copy_dir, "metadata"))
+
+    return _Trace(trace_dir, info)
+
+
+# Runs `cmd` and returns its wall time (s) and peak resident set
+# size (KiB).
+def _run(cmd: List[str], tmp_dir: str):
+    stderr_path = os.path.join(tmp_dir, "stderr")
+
+    with open(os.devnull, "w") as devnull, open(stderr_path, "w") as stderr:
+        begin = time.perf_counter()
+        proc = subprocess.Popen(cmd, stdout=devnull, stderr=stderr)
+
+        # Unlike proc.wait(), os.wait4() gives the resource usage of
+        # this very process.
+        _, status, rusage = os.wait4(proc.pid, 0)
+        wall_time = time.perf_counter() - begin
+
+    if os.WIFEXITED(status):
+        proc.returncode = os.WEXITSTATUS(status)
+    else:
+        proc.returncode = -os.WTERMSIG(status)
+
+    if proc.returncode != 0:
+        with open(stderr_path, errors="replace") as f:
+            raise RuntimeError(
+                "Command `{}` failed with exit status {}:\n{}".format(
+                    " ".join(cmd), proc.returncode, f.read()
+                )
+            )
+
+    peak_rss_kib = rusage.ru_maxrss
+
+    # macOS reports bytes instead of kibibytes
+    if sys.platform == "darwin":
+        peak_rss_kib //= 1024
+
+    return wall_time, peak_rss_kib
+
+
+def _has_cc(bt2_bin: str, cc: str):
+    ret = subprocess.call(
+        [bt2_bin, "help", cc], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL
+    )
+    return ret == 0
+
+
+def _bt2_version(bt2_bin: str):
+    output = subprocess.check_output([bt2_bin, "--version"], universal_newlines=True)
+    return output.strip().splitlines()[0]
+
+
+def _git_commit():
+    try:
+        return subprocess.check_output(
+            ["git", "-C", _SCRIPT_DIR, "describe", "--always", "--dirty"],
+            stderr=subprocess.DEVNULL,
+            universal_newlines=True,
+        ).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def _run_scenario(
+    scenario: _Scenario, trace: _Trace, args: argparse.Namespace
+) -> Dict[str, Any]:
+    runs = []  # type: List[Dict[str, Any]]
+
+    print("Running scenario `{}`.".format(scenario.name), file=sys.stderr)
+
+    for _ in range(args.repeat):
+        with tempfile.TemporaryDirectory(dir=args.work_dir) as tmp_dir:
+            cmd = [args.bt2_bin] + scenario.args(trace, tmp_dir)
+            wall_time, peak_rss_kib = _run(cmd, tmp_dir)
+
+        runs.append({"wall-time-s": wall_time, "peak-rss-kib": peak_rss_kib})
+
+    wall_time = statistics.median([run["wall-time-s"] for run in runs])
+    return {
+        "name": scenario.name,
+        "description": scenario.descr,
+        "command-args": scenario.args(trace, "TMP"),
+        "trace": trace.info,
+        "runs": runs,
+        "wall-time-s": wall_time,
+        "messages-per-s": trace.info["messages"] / wall_time,
+        "bytes-per-s": trace.info["data-bytes"] / wall_time,
+        "peak-rss-kib": max([run["peak-rss-kib"] for run in runs]),
+    }
+
+
+# Prints the relative throughput of the results of `report` compared
+# to the results of the report `baseline` to the standard error.
+def _print_comparison(report: Dict[str, Any], baseline: Dict[str, Any]):
+    base_results = {result["name"]: result for result in baseline["results"]}
+
+    print(
+        "{:<16} {:>14} {:>14} {:>8} {:>12}".format(
+            "Scenario", "Baseline (s)", "Current (s)", "Speedup", "RSS delta"
+        ),
+        file=sys.stderr,
+    )
+
+    for result in report["results"]:
+        base_result = base_results.get(result["name"])
+
+        if base_result is None or "skipped" in result or "skipped" in base_result:
+            continue
+
+        print(
+            "{:<16} {:>14.3f} {:>14.3f} {:>7.2f}x {:>+9} KiB".format(
+                result["name"],
+                base_result["wall-time-s"],
+                result["wall-time-s"],
+                base_result["wall-time-s"] / result["wall-time-s"],
+                result["peak-rss-kib"] - base_result["peak-rss-kib"],
+            ),
+            file=sys.stderr,
+        )
+
+
+def _parse_args():
+    parser = argparse.ArgumentParser(
+        description="Run the babeltrace2 trace processing benchmarks."
+    )
+    parser.add_argument(
+        "--bt2-bin", required=True, help="path to the `babeltrace2` command"
+    )
+    parser.add_argument(
+        "--work-dir",
+        default="bench-work",
+        help="directory which contains the generated traces (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--events",
+        type=int,
+        default=1000000,
+        help="number of events of the main trace (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--mux-streams",
+        type=int,
+        default=64,
+        help="number of streams of the `mux` scenario trace (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--metadata-event-classes",
+        type=int,
+        default=20000,
+        help="number of additional event classes of the `metadata` scenario "
+        "trace (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--real-metadata-copies",
+        type=int,
+        default=500,
+        help="number of copies of the real metadata which the `real-metadata` "
+        "scenario decodes (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--repeat",
+        type=int,
+        default=3,
+        help="number of runs of each scenario (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--scenario",
+        action="append",
+        choices=[scenario.name for scenario in _SCENARIOS],
+        help="run this scenario only (repeatable)",
+    )
+    parser.add_argument(
+        "--output", "-o", help="write the JSON report to this file instead of stdout"
+    )
+    parser.add_argument(
+        "--baseline",
+        help="compare the results to those of this JSON report",
+    )
+    args = parser.parse_args()
+
+    if (
+        args.repeat < 1
+        or args.events < args.mux_streams
+        or args.real_metadata_copies < 1
+    ):
+        parser.error("invalid benchmark dimensions")
+
+    return args
+
+
+def main():
+    args = _parse_args()
+    os.makedirs(args.work_dir, exist_ok=True)
+    trace_gen_args = _trace_gen_args(args)
+    traces = {}  # type: Dict[str, _Trace]
+    results = []  # type: List[Dict[str, Any]]
+
+    for scenario in _SCENARIOS:
+        if args.scenario is not None and scenario.name not in args.scenario:
+            continue
+
+        if scenario.required_cc is not None and not _has_cc(
+            args.bt2_bin, scenario.required_cc
+        ):
+            print(
+                "Skipping scenario `{}`: `{}` is not available.".format(
+                    scenario.name, scenario.required_cc
+                ),
+                file=sys.stderr,
+            )
+            results.append({"name": scenario.name, "skipped": True})
+            continue
+
+        if scenario.trace_name not in traces:
+            if scenario.trace_name == "real-metadata":
+                traces[scenario.trace_name] = _get_real_metadata_trace(
+                    args.work_dir, args.real_metadata_copies
+                )
+            else:
+                traces[scenario.trace_name] = _get_trace(
+                    args.work_dir,
+                    scenario.trace_name,
+                    trace_gen_args[scenario.trace_name],
+                    sys.executable,
+                )
+
+        results.append(_run_scenario(scenario, traces[scenario.trace_name], args))
+
+    report = {
+        "version": _REPORT_VERSION,
+        "babeltrace2-version": _bt2_version(args.bt2_bin),
+        "commit": _git_commit(),
+        "host": {
+            "machine": platform.machine(),
+            "system": platform.system(),
+            "release": platform.release(),
+            "cpu-count": os.cpu_count(),
+            "python-version": platform.python_version(),
+        },
+        "parameters": {
+            "events": args.events,
+            "mux-streams": args.mux_streams,
+            "metadata-event-classes": args.metadata_event_classes,
+            "real-metadata-copies": args.real_metadata_copies,
+            "repeat": args.repeat,
+        },
+        "results": results,
+    }
+
+    if args.output is not None:
+        with open(args.output, "w") as f:
+            json.dump(report, f, indent=2)
+            f.write("\n")
+    else:
+        json.dump(report, sys.stdout, indent=2)
+        sys.stdout.write("\n")
+
+    if args.baseline is not None:
+        with open(args.baseline) as f:
+            _print_comparison(report, json.load(f))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,23 @@
+#!/bin/bash
+#
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2024 EfficiOS Inc.
+#
+
+# Runs the benchmark scenarios (see `bench.py`) with the built
+# `babeltrace2` command and plugins.
+#
+# All the arguments are forwarded to `bench.py`.
+
+if [[ -n ${BT_TESTS_SRCDIR:-} ]]; then
+	UTILSSH=$BT_TESTS_SRCDIR/utils/utils.sh
+else
+	UTILSSH=$(dirname "$0")/../utils/utils.sh
+fi
+
+# shellcheck source=../utils/utils.sh
+source "$UTILSSH"
+
+bt_run_in_py_env "$BT_TESTS_PYTHON_BIN" "$BT_TESTS_SRCDIR/benchmark/bench.py" \
+	--bt2-bin "$BT_TESTS_BT2_BIN" "$@"
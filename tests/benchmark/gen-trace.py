@@ -0,0 +1,358 @@
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2024 EfficiOS Inc.
+#
+
+# Generates a deterministic synthetic CTF 1.8 trace for benchmarking.
+#
+# The same arguments always produce the same trace, byte for byte: the
+# event class and payload of each event, as well as the timestamp
+# deltas, come from a pseudo-random number generator of which the seed
+# only depends on `--seed` and on the stream index.
+#
+# The trace looks like an LTTng-UST trace (environment, `vpid` and `ip`
+# stream event context fields) so that `flt.lttng-utils.debug-info`
+# does its work on it.
+#
+# The last line of the standard output is a JSON object which describes
+# the generated trace (number of events, packets, streams, messages,
+# and data stream bytes).
+
+import os
+import sys
+import json
+import random
+import struct
+import argparse
+
+_CLOCK_OFFSET_S = 1700000000
+_CTF_MAGIC = 0xC1FC1FC1
+
+# Packet header: magic, stream_id
+_PKT_HEADER = struct.Struct("<II")
+
+# Packet context: timestamp_begin, timestamp_end, content_size,
+# packet_size, packet_seq_num, events_discarded
+_PKT_CONTEXT = struct.Struct("<QQQQQQ")
+
+# Event header (id, timestamp) and stream event context (_vpid, _ip)
+_EVENT_HEADER_CONTEXT = struct.Struct("<HQiQ")
+
+# Payloads of the regular event classes
+_PAYLOAD_SIMPLE = struct.Struct("<I")
+_PAYLOAD_MIXED = struct.Struct("<qHd")
+_PAYLOAD_ENUM = struct.Struct("<B")
+
+_REGULAR_EVENT_CLASS_COUNT = 4
+
+_WORDS = (
+    "alpha",
+    "bravo",
+    "charlie",
+    "delta",
+    "echo",
+    "foxtrot",
+    "golf",
+    "hotel",
+    "india",
+    "juliett",
+)
+
+
+def _metadata(extra_event_class_count: int):
+    lines = [
+        "/* CTF 1.8 */",
+        "",
+        "typealias integer { size = 8; align = 8; signed = false; } := uint8_t;",
+        "typealias integer { size = 16; align = 8; signed = false; } := uint16_t;",
+        "typealias integer { size = 32; align = 8; signed = false; } := uint32_t;",
+        "typealias integer { size = 64; align = 8; signed = false; } := uint64_t;",
+        "typealias integer { size = 32; align = 8; signed = true; } := int32_t;",
+        "typealias integer { size = 64; align = 8; signed = true; } := int64_t;",
+        "typealias floating_point { exp_dig = 11; mant_dig = 53; align = 8; } := double;",
+        "",
+        "trace {",
+        "\tmajor = 1;",
+        "\tminor = 8;",
+        "\tbyte_order = le;",
+        "\tpacket.header := struct {",
+        "\t\tuint32_t magic;",
+        "\t\tuint32_t stream_id;",
+        "\t};",
+        "};",
+        "",
+        "env {",
+        '\tdomain = "ust";',
+        '\ttracer_name = "lttng-ust";',
+        "\ttracer_major = 2;",
+        "\ttracer_minor = 13;",
+        '\thostname = "bench";',
+        "};",
+        "",
+        "clock {",
+        "\tname = monotonic;",
+        "\tfreq = 1000000000;",
+        "\toffset_s = {};".format(_CLOCK_OFFSET_S),
+        "\toffset = 0;",
+        "\tabsolute = false;",
+        "};",
+        "",
+        "typealias integer { size = 64; align = 8; signed = false; map = clock.monotonic.value; } := uint64_clock_monotonic_t;",
+        "",
+        "stream {",
+        "\tid = 0;",
+        "\tpacket.context := struct {",
+        "\t\tuint64_clock_monotonic_t timestamp_begin;",
+        "\t\tuint64_clock_monotonic_t timestamp_end;",
+        "\t\tuint64_t content_size;",
+        "\t\tuint64_t packet_size;",
+        "\t\tuint64_t packet_seq_num;",
+        "\t\tuint64_t events_discarded;",
+        "\t};",
+        "\tevent.header := struct {",
+        "\t\tuint16_t id;",
+        "\t\tuint64_clock_monotonic_t timestamp;",
+        "\t};",
+        "\tevent.context := struct {",
+        "\t\tint32_t _vpid;",
+        "\t\tuint64_t _ip;",
+        "\t};",
+        "};",
+        "",
+        "event {",
+        '\tname = "bench:simple";',
+        "\tid = 0;",
+        "\tstream_id = 0;",
+        "\tloglevel = 13;",
+        "\tfields := struct {",
+        "\t\tuint32_t _value;",
+        "\t};",
+        "};",
+        "",
+        "event {",
+        '\tname = "bench:mixed";',
+        "\tid = 1;",
+        "\tstream_id = 0;",
+        "\tloglevel = 13;",
+        "\tfields := struct {",
+        "\t\tint64_t _a;",
+        "\t\tuint16_t _b;",
+        "\t\tdouble _c;",
+        "\t\tstring _s;",
+        "\t};",
+        "};",
+        "",
+        "event {",
+        '\tname = "bench:sequence";',
+        "\tid = 2;",
+        "\tstream_id = 0;",
+        "\tloglevel = 13;",
+        "\tfields := struct {",
+        "\t\tuint8_t _len;",
+        "\t\tuint32_t _values[_len];",
+        "\t};",
+        "};",
+        "",
+        "event {",
+        '\tname = "bench:enum";',
+        "\tid = 3;",
+        "\tstream_id = 0;",
+        "\tloglevel = 13;",
+        "\tfields := struct {",
+        "\t\tenum : uint8_t { IDLE, RUNNING, BLOCKED = 2 ... 3 } _state;",
+        "\t\tstring _msg;",
+        "\t};",
+        "};",
+        "",
+    ]
+
+    # Event classes which only make the metadata larger
+    for i in range(extra_event_class_count):
+        ec_id = _REGULAR_EVENT_CLASS_COUNT + i
+        lines += [
+            "event {",
+            '\tname = "bench:extra_{}";'.format(i),
+            "\tid = {};".format(ec_id),
+            "\tstream_id = 0;",
+            "\tloglevel = 13;",
+            "\tfields := struct {",
+            "\t\tuint32_t _u32;",
+            "\t\tint64_t _s64;",
+            "\t\tstruct {",
+            "\t\t\tuint8_t _len;",
+            "\t\t\tuint16_t _values[_len];",
+            "\t\t} _inner;",
+            "\t\tenum : uint8_t { ZERO, ONE, TWO } _e;",
+            "\t\tstring _name;",
+            "\t};",
+            "};",
+            "",
+        ]
+
+    return "\n".join(lines)
+
+
+def _encode_string(s: str):
+    return s.encode() + b"\0"
+
+
+# Appends the payload of an event of the regular event class `ec_id` to
+# `buf`.
+def _append_payload(buf: bytearray, ec_id: int, rng: random.Random):
+    if ec_id == 0:
+        buf += _PAYLOAD_SIMPLE.pack(rng.getrandbits(32))
+    elif ec_id == 1:
+        buf += _PAYLOAD_MIXED.pack(
+            rng.getrandbits(63) - (1 << 62), rng.getrandbits(16), rng.random()
+        )
+        buf += _encode_string(rng.choice(_WORDS))
+    elif ec_id == 2:
+        count = rng.randrange(8)
+        buf.append(count)
+        buf += struct.pack(
+            "<{}I".format(count), *[rng.getrandbits(32) for _ in range(count)]
+        )
+    else:
+        buf += _PAYLOAD_ENUM.pack(rng.randrange(4))
+        buf += _encode_string("{} {}".format(rng.choice(_WORDS), rng.choice(_WORDS)))
+
+
+# Writes the data stream file `path` and returns its number of packets
+# and its size.
+def _write_stream(
+    path: str,
+    stream_index: int,
+    event_count: int,
+    events_per_packet: int,
+    seed: int,
+):
+    rng = random.Random(seed * 1000003 + stream_index)
+    vpid = 1000 + stream_index
+    ts = 0
+    packet_count = 0
+    size = 0
+
+    with open(path, "wb") as f:
+        remaining = event_count
+
+        while remaining > 0:
+            count = min(remaining, events_per_packet)
+            events = bytearray()
+            ts_begin = ts
+
+            for _ in range(count):
+                ts += rng.randint(1, 1000)
+                ec_id = rng.randrange(_REGULAR_EVENT_CLASS_COUNT)
+                ip = 0x400000 + rng.randrange(0x10000)
+                events += _EVENT_HEADER_CONTEXT.pack(ec_id, ts, vpid, ip)
+                _append_payload(events, ec_id, rng)
+
+            content_size = _PKT_HEADER.size + _PKT_CONTEXT.size + len(events)
+            f.write(_PKT_HEADER.pack(_CTF_MAGIC, 0))
+            f.write(
+                _PKT_CONTEXT.pack(
+                    ts_begin,
+                    ts,
+                    content_size * 8,
+                    content_size * 8,
+                    packet_count,
+                    0,
+                )
+            )
+            f.write(events)
+            packet_count += 1
+            size += content_size
+            remaining -= count
+
+    return packet_count, size
+
+
+def _parse_args():
+    parser = argparse.ArgumentParser(
+        description="Generate a deterministic synthetic CTF trace."
+    )
+    parser.add_argument("output_dir", help="output trace directory")
+    parser.add_argument(
+        "--events",
+        type=int,
+        default=1000000,
+        help="total number of events (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--streams",
+        type=int,
+        default=1,
+        help="number of data streams (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--events-per-packet",
+        type=int,
+        default=4096,
+        help="maximum number of events per packet (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--extra-event-classes",
+        type=int,
+        default=0,
+        help="number of additional event classes which no event "
+        "instantiates (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--seed",
+        type=int,
+        default=0,
+        help="pseudo-random number generator seed (default: %(default)s)",
+    )
+    args = parser.parse_args()
+
+    # Each stream needs at least one event to have a packet
+    if args.streams < 1 or args.events < args.streams or args.events_per_packet < 1:
+        parser.error("invalid trace dimensions")
+
+    return args
+
+
+def main():
+    args = _parse_args()
+    os.makedirs(args.output_dir, exist_ok=True)
+
+    with open(os.path.join(args.output_dir, "metadata"), "w") as f:
+        f.write(_metadata(args.extra_event_classes))
+
+    packet_count = 0
+    data_size = 0
+
+    for i in range(args.streams):
+        # Spread the events evenly among the streams
+        event_count = args.events // args.streams
+
+        if i < args.events % args.streams:
+            event_count += 1
+
+        stream_packet_count, size = _write_stream(
+            os.path.join(args.output_dir, "stream_{}".format(i)),
+            i,
+            event_count,
+            args.events_per_packet,
+            args.seed,
+        )
+        packet_count += stream_packet_count
+        data_size += size
+
+    # Each stream has a stream beginning and a stream end message; each
+    # packet has a packet beginning and a packet end message.
+    print(
+        json.dumps(
+            {
+                "events": args.events,
+                "packets": packet_count,
+                "streams": args.streams,
+                "messages": args.events + 2 * packet_count + 2 * args.streams,
+                "data-bytes": data_size,
+            }
+        )
+    )
+
+
+if __name__ == "__main__":
+    sys.exit(main())
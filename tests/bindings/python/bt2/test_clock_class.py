@@ -167,6 +167,13 @@ class ClockClassTestCase(unittest.TestCase):
         cc = run_in_component_init(f)
         self.assertEqual(cc.cycles_to_ns_from_origin(112), 1120)
 
+    def test_cycles_to_ns_from_origin_exact(self):
+        def f(comp_self):
+            return comp_self._create_clock_class(frequency=1000)
+
+        cc = run_in_component_init(f)
+        self.assertEqual(cc.cycles_to_ns_from_origin(2**40 + 1), (2**40 + 1) * 10**6)
+
     def test_cycles_to_ns_from_origin_overflow(self):
         def f(comp_self):
             return comp_self._create_clock_class(frequency=1000)
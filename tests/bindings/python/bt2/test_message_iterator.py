@@ -464,6 +464,99 @@ class UserMessageIteratorTestCase(unittest.TestCase):
         with self.assertRaisesRegex(bt2._Error, "ValueError: woops"):
             g.run()
 
+    @staticmethod
+    def _create_batch_graph(user_next_batch):
+        class MySourceIter(bt2._UserMessageIterator):
+            def __init__(self, config, port):
+                tc, sc, ec = port.user_data
+                trace = tc()
+                stream = trace.create_stream(sc)
+                self._msgs = [self._create_stream_beginning_message(stream)]
+
+                for i in range(100):
+                    self._msgs.append(self._create_event_message(ec, stream))
+
+                self._msgs.append(self._create_stream_end_message(stream))
+
+            _user_next_batch = user_next_batch
+
+        class MySource(bt2._UserSourceComponent, message_iterator_class=MySourceIter):
+            def __init__(self, config, params, obj):
+                tc = self._create_trace_class()
+                sc = tc.create_stream_class()
+                ec = sc.create_event_class()
+                self._add_output_port("out", (tc, sc, ec))
+
+        class MySink(bt2._UserSinkComponent):
+            def __init__(self, config, params, obj):
+                self._add_input_port("in")
+                self._state = obj
+
+            def _user_graph_is_configured(self):
+                self._msg_iter = self._create_message_iterator(self._input_ports["in"])
+
+            def _user_consume(self):
+                msgs = self._msg_iter.next_batch()
+                self._state["batch_sizes"].append(len(msgs))
+                self._state["msgs"] += msgs
+
+        state = {"batch_sizes": [], "msgs": []}
+        graph = bt2.Graph()
+        src = graph.add_component(MySource, "src")
+        sink = graph.add_component(MySink, "sink", obj=state)
+        graph.connect_ports(src.output_ports["out"], sink.input_ports["in"])
+        return graph, state
+
+    # Test that _user_next_batch() may return many messages at once and
+    # that a sink gets them as a batch with next_batch().
+    def test_next_batch(self):
+        def user_next_batch(self, capacity):
+            if len(self._msgs) == 0:
+                raise StopIteration
+
+            msgs = self._msgs[:capacity]
+            del self._msgs[:capacity]
+            return msgs
+
+        graph, state = self._create_batch_graph(user_next_batch)
+        graph.run()
+        msgs = state["msgs"]
+        self.assertEqual(len(msgs), 102)
+        self.assertIs(type(msgs[0]), bt2._StreamBeginningMessageConst)
+
+        for msg in msgs[1:-1]:
+            self.assertIs(type(msg), bt2._EventMessageConst)
+
+        self.assertIs(type(msgs[-1]), bt2._StreamEndMessageConst)
+        self.assertGreater(max(state["batch_sizes"]), 1)
+
+    def test_next_batch_empty(self):
+        def user_next_batch(self, capacity):
+            return []
+
+        graph, _ = self._create_batch_graph(user_next_batch)
+
+        with self.assertRaisesRegex(bt2._Error, "returned no messages"):
+            graph.run()
+
+    def test_next_batch_too_many(self):
+        def user_next_batch(self, capacity):
+            return self._msgs[: capacity + 1]
+
+        graph, _ = self._create_batch_graph(user_next_batch)
+
+        with self.assertRaisesRegex(bt2._Error, "returned too many messages"):
+            graph.run()
+
+    def test_next_batch_wrong_type(self):
+        def user_next_batch(self, capacity):
+            return [self._msgs[0], 23]
+
+        graph, _ = self._create_batch_graph(user_next_batch)
+
+        with self.assertRaisesRegex(bt2._Error, "TypeError"):
+            graph.run()
+
 
 def _setup_seek_test(
     sink_cls,
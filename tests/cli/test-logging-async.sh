@@ -0,0 +1,91 @@
+#!/bin/bash
+#
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2026 EfficiOS Inc.
+#
+
+# This file tests the asynchronous logging back end
+# (`BABELTRACE_LOGGING_ASYNC=1`).
+
+SH_TAP=1
+
+if [ -n "${BT_TESTS_SRCDIR:-}" ]; then
+	UTILSSH="$BT_TESTS_SRCDIR/utils/utils.sh"
+else
+	UTILSSH="$(dirname "$0")/../utils/utils.sh"
+fi
+
+# shellcheck source=../utils/utils.sh
+source "$UTILSSH"
+
+trace_dir="$BT_CTF_TRACES_PATH/succeed/wk-heartbeat-u"
+
+sync_stdout=$(mktemp -t sync-stdout.XXXXXX)
+sync_stderr=$(mktemp -t sync-stderr.XXXXXX)
+async_stdout=$(mktemp -t async-stdout.XXXXXX)
+async_stderr=$(mktemp -t async-stderr.XXXXXX)
+async_log=$(mktemp -t async-log.XXXXXX)
+sync_records=$(mktemp -t sync-records.XXXXXX)
+async_records=$(mktemp -t async-records.XXXXXX)
+
+plan_tests 8
+
+# Prints the level, tag, and source location of each log record of the
+# file `$1`, sorted.
+#
+# A record header is:
+#
+#     MM-DD HH:MM:SS.MMM PID TID LEVEL TAG FUNC@FILE:LINE
+records() {
+	awk '$5 ~ /^[TDIWEF]$/ && $7 ~ /@/ { print $5, $6, $7 }' "$1" | sort
+}
+
+# Runs the CLI with the asynchronous back end, the overflow policy `$1`,
+# and the log level `$2`, writing the log records to `$async_log`.
+run_async() {
+	local -r policy=$1
+	local -r log_level=$2
+
+	: > "$async_log"
+	(
+		export BABELTRACE_LOGGING_ASYNC=1
+		export BABELTRACE_LOGGING_ASYNC_PATH=$async_log
+		export BABELTRACE_LOGGING_ASYNC_OVERFLOW=$policy
+		bt_cli "$async_stdout" "$async_stderr" \
+			--log-level="$log_level" "$trace_dir"
+	)
+}
+
+# Reference: synchronous back end
+bt_cli "$sync_stdout" "$sync_stderr" --log-level=I "$trace_dir"
+ok $? "run with the synchronous back end"
+
+# `BLOCK` policy: no record is lost
+run_async BLOCK I
+ok $? "run with the asynchronous back end (BLOCK policy)"
+
+bt_diff "$sync_stdout" "$async_stdout"
+ok $? "asynchronous back end: same standard output"
+
+grep -q 'CLI configuration:' "$async_stderr"
+isnt $? 0 "asynchronous back end: no records written to the standard error"
+
+grep -q ' I CLI .*CLI configuration:' "$async_log"
+ok $? "asynchronous back end: CLI record written to the output file"
+
+records "$sync_stderr" > "$sync_records"
+records "$async_log" > "$async_records"
+bt_diff "$sync_records" "$async_records"
+ok $? "asynchronous back end: same records as the synchronous back end"
+
+# Default (`DROP`) policy at the most verbose level: records may be
+# dropped, but the ones which reach the output file are complete.
+run_async DROP T
+ok $? "run with the asynchronous back end (DROP policy, TRACE level)"
+
+grep -q ' T LIB/' "$async_log" && ! grep -q 'CLI configuration:' "$async_stderr"
+ok $? "asynchronous back end: library trace records written to the output file"
+
+rm -f "$sync_stdout" "$sync_stderr" "$async_stdout" "$async_stderr" \
+	"$async_log" "$sync_records" "$async_records"
@@ -0,0 +1,74 @@
+#!/bin/bash
+#
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2026 EfficiOS Inc.
+#
+
+# This file tests the `--memory-limit` option of the `convert` and
+# `run` commands.
+
+SH_TAP=1
+
+if [ -n "${BT_TESTS_SRCDIR:-}" ]; then
+	UTILSSH="$BT_TESTS_SRCDIR/utils/utils.sh"
+else
+	UTILSSH="$(dirname "$0")/../utils/utils.sh"
+fi
+
+# shellcheck source=../utils/utils.sh
+source "$UTILSSH"
+
+trace_dir="$BT_CTF_TRACES_PATH/succeed/wk-heartbeat-u"
+
+temp_stdout=$(mktemp -t stdout.XXXXXX)
+temp_stderr=$(mktemp -t stderr.XXXXXX)
+temp_expected_stdout=$(mktemp -t expected-stdout.XXXXXX)
+
+# Checks that the `run` command fails with the --memory-limit
+# option's argument `$1`.
+test_invalid_memory_limit() {
+	local limit="$1"
+
+	bt_cli "$temp_stdout" "$temp_stderr" run --memory-limit="$limit" \
+		--component=src:source.ctf.fs --params="inputs=[\"$trace_dir\"]" \
+		--component=sink:sink.utils.counter \
+		--connect=src:sink
+	isnt $? 0 "\`--memory-limit=$limit\` is rejected"
+
+	grep -q "Invalid --memory-limit option's argument" "$temp_stderr"
+	ok $? "\`--memory-limit=$limit\`: expected error message"
+}
+
+plan_tests 14
+
+bt_cli "$temp_expected_stdout" /dev/null "$trace_dir" \
+	--component=sink.utils.counter
+ok $? "run \`convert\` command without --memory-limit"
+
+# `convert` command
+bt_cli "$temp_stdout" "$temp_stderr" --memory-limit=64K "$trace_dir" \
+	--component=sink.utils.counter
+ok $? "run \`convert\` command with --memory-limit"
+
+bt_diff "$temp_expected_stdout" "$temp_stdout"
+ok $? "\`convert\` command: the limit doesn't change the output"
+
+# `run` command
+bt_cli "$temp_stdout" "$temp_stderr" run --memory-limit=1M \
+	--component=src:source.ctf.fs --params="inputs=[\"$trace_dir\"]" \
+	--component=sink:sink.utils.counter \
+	--connect=src:sink
+ok $? "run \`run\` command with --memory-limit"
+
+test_invalid_memory_limit 0
+test_invalid_memory_limit 12T
+test_invalid_memory_limit -1
+
+# Doesn't fit a 64-bit unsigned integer
+test_invalid_memory_limit 99999999999999999999
+
+# Fits a 64-bit unsigned integer, but not once shifted
+test_invalid_memory_limit 17179869184G
+
+rm -f "$temp_stdout" "$temp_stderr" "$temp_expected_stdout"
@@ -0,0 +1,76 @@
+#!/bin/bash
+#
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2026 EfficiOS Inc.
+#
+
+# This file tests the `--stats` option of the `convert` and `run`
+# commands.
+
+SH_TAP=1
+
+if [ -n "${BT_TESTS_SRCDIR:-}" ]; then
+	UTILSSH="$BT_TESTS_SRCDIR/utils/utils.sh"
+else
+	UTILSSH="$(dirname "$0")/../utils/utils.sh"
+fi
+
+# shellcheck source=../utils/utils.sh
+source "$UTILSSH"
+
+trace_dir="$BT_CTF_TRACES_PATH/succeed/wk-heartbeat-u"
+
+temp_stdout=$(mktemp -t stdout.XXXXXX)
+temp_stderr=$(mktemp -t stderr.XXXXXX)
+
+plan_tests 9
+
+# Prints the row of the component `$2` of the statistics table of the
+# file `$1`.
+stats_row() {
+	awk -v name="$2" '$1 == name' "$1"
+}
+
+# `convert` command
+bt_cli "$temp_stdout" "$temp_stderr" --stats "$trace_dir" \
+	--component=sink.utils.counter
+ok $? "run \`convert\` command with --stats"
+
+grep -q '^Component  *Type  *Calls  *Messages  *Again' "$temp_stderr"
+ok $? "\`convert\` command: statistics table header is printed"
+
+[ "$(stats_row "$temp_stderr" muxer | awk '{ print $2 }')" = filter ]
+ok $? "\`convert\` command: statistics table has the muxer filter"
+
+[ "$(awk '$2 == "source"' "$temp_stderr" | wc -l)" -ge 1 ]
+ok $? "\`convert\` command: statistics table has a source"
+
+[ "$(awk '$2 == "sink"' "$temp_stderr" | wc -l)" -eq 1 ]
+ok $? "\`convert\` command: statistics table has the sink"
+
+# The muxer message count is the total number of messages, which
+# includes the events which sink.utils.counter counts.
+event_count=$(awk '$2 == "Event" { print $1 }' "$temp_stdout")
+muxer_msg_count=$(stats_row "$temp_stderr" muxer | awk '{ print $4 }')
+[ -n "$event_count" ] && [ "$muxer_msg_count" -gt "$event_count" ]
+ok $? "\`convert\` command: muxer message count includes the events"
+
+# Without --stats: no table
+bt_cli "$temp_stdout" "$temp_stderr" "$trace_dir" \
+	--component=sink.utils.counter
+grep -q '^Component  *Type' "$temp_stderr"
+isnt $? 0 "\`convert\` command: no statistics table without --stats"
+
+# `run` command
+bt_cli "$temp_stdout" "$temp_stderr" run --stats \
+	--component=src:source.ctf.fs --params="inputs=[\"$trace_dir\"]" \
+	--component=sink:sink.utils.counter \
+	--connect=src:sink
+ok $? "run \`run\` command with --stats"
+
+[ "$(stats_row "$temp_stderr" src | awk '{ print $2 }')" = source ] &&
+	[ "$(stats_row "$temp_stderr" sink | awk '{ print $2 }')" = sink ]
+ok $? "\`run\` command: statistics table has both components"
+
+rm -f "$temp_stdout" "$temp_stderr"
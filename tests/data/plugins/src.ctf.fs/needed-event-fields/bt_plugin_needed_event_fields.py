@@ -0,0 +1,39 @@
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2026 EfficiOS Inc.
+#
+
+import bt2
+
+
+class PayloadsIterator(bt2._UserMessageIterator):
+    def __init__(self, config, port):
+        self._upstream_it = self._create_message_iterator(
+            self._component._input_ports["in"]
+        )
+        self._path = port.user_data
+
+    def __next__(self):
+        msg = next(self._upstream_it)
+
+        if type(msg) is bt2._EventMessageConst:
+            with open(self._path, "a") as f:
+                f.write("{}\n".format(repr(msg.event.payload_field)))
+
+        return msg
+
+
+# Filter which appends the payload of each event message to the file
+# of which the path is the `path` parameter.
+#
+# This filter doesn't forward the needed event fields of its downstream
+# component to its input port: its upstream message iterator gets the
+# default hint (all the event fields).
+@bt2.plugin_component_class
+class Payloads(bt2._UserFilterComponent, message_iterator_class=PayloadsIterator):
+    def __init__(self, config, params, obj):
+        self._add_input_port("in")
+        self._add_output_port("out", user_data=str(params["path"]))
+
+
+bt2.register_plugin(__name__, "needed_event_fields")
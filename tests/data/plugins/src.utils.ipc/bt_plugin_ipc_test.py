@@ -0,0 +1,167 @@
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2026 EfficiOS Inc.
+#
+
+import bt2
+
+# Number of event messages
+_EVENT_COUNT = 6
+
+
+def _make_payload_fc(tc):
+    fc = tc.create_structure_field_class()
+    string_fc = tc.create_string_field_class()
+
+    # Distinct length and selector field classes: the library finds
+    # the path of a length or selector field from its class.
+    len_fc = tc.create_unsigned_integer_field_class(8)
+    flag_fc = tc.create_bool_field_class()
+    tag_fc = tc.create_unsigned_integer_field_class(8)
+
+    # Dynamic arrays, with and without a length field
+    fc.append_member("len", len_fc)
+    fc.append_member(
+        "seq",
+        tc.create_dynamic_array_field_class(
+            tc.create_signed_integer_field_class(32), len_fc
+        ),
+    )
+    fc.append_member("strings", tc.create_dynamic_array_field_class(string_fc))
+
+    # The elements of this one have no encoded bytes
+    fc.append_member(
+        "empties",
+        tc.create_dynamic_array_field_class(tc.create_structure_field_class()),
+    )
+    fc.append_member(
+        "static",
+        tc.create_static_array_field_class(
+            tc.create_unsigned_integer_field_class(16), 2
+        ),
+    )
+    fc.append_member("bits", tc.create_bit_array_field_class(12))
+
+    # Options, with and without a selector field
+    fc.append_member("flag", flag_fc)
+    fc.append_member(
+        "opt_bool",
+        tc.create_option_with_bool_selector_field_class(
+            tc.create_unsigned_integer_field_class(64), flag_fc
+        ),
+    )
+    fc.append_member(
+        "opt_bool_rev",
+        tc.create_option_with_bool_selector_field_class(
+            string_fc, flag_fc, selector_is_reversed=True
+        ),
+    )
+    fc.append_member(
+        "opt_none", tc.create_option_without_selector_field_class(string_fc)
+    )
+
+    # Variants, with and without a selector field
+    fc.append_member("tag", tag_fc)
+    var_tag_fc = tc.create_variant_field_class(tag_fc)
+    var_tag_fc.append_option(
+        "a",
+        tc.create_unsigned_integer_field_class(64),
+        bt2.UnsignedIntegerRangeSet([(0, 0)]),
+    )
+    var_tag_fc.append_option("b", string_fc, bt2.UnsignedIntegerRangeSet([(1, 1)]))
+    struct_fc = tc.create_structure_field_class()
+    struct_fc.append_member("x", tc.create_double_precision_real_field_class())
+    struct_fc.append_member(
+        "y",
+        tc.create_dynamic_array_field_class(tc.create_unsigned_integer_field_class(8)),
+    )
+    var_tag_fc.append_option("c", struct_fc, bt2.UnsignedIntegerRangeSet([(2, 3)]))
+    fc.append_member("var_tag", var_tag_fc)
+    var_fc = tc.create_variant_field_class()
+    var_fc.append_option("i", tc.create_signed_integer_field_class(64))
+    var_fc.append_option("s", string_fc)
+    fc.append_member("var", var_fc)
+    fc.append_member(
+        "opt_int",
+        tc.create_option_with_integer_selector_field_class(
+            var_fc, tag_fc, bt2.UnsignedIntegerRangeSet([(1, 2)])
+        ),
+    )
+    return fc
+
+
+def _set_payload(payload, i):
+    payload["len"] = i
+    payload["seq"] = [j * -3 for j in range(i)]
+    payload["strings"] = ["s{}".format(j) for j in range(i % 3)]
+    payload["empties"].length = i
+    payload["static"] = [i, 1000 - i]
+    payload["bits"].value_as_integer = 0x5A0 + i
+
+    flag = i % 2 == 0
+    payload["flag"] = flag
+
+    if flag:
+        payload["opt_bool"] = i * 100
+    else:
+        payload["opt_bool_rev"] = "not {}".format(i)
+
+    if i % 3 != 0:
+        payload["opt_none"] = "some {}".format(i)
+
+    tag = i % 4
+    payload["tag"] = tag
+    var_tag = payload["var_tag"]
+    var_tag.selected_option_index = min(tag, 2)
+
+    if tag == 0:
+        var_tag.value = i
+    elif tag == 1:
+        var_tag.value = "b{}".format(i)
+    else:
+        var_tag.selected_option["x"] = i / 4
+        var_tag.selected_option["y"] = list(range(tag))
+
+    payload["var"].selected_option_index = i % 2
+    payload["var"].value = -i if i % 2 == 0 else "var {}".format(i)
+
+    if tag in (1, 2):
+        opt_int = payload["opt_int"]
+        opt_int.has_field = True
+        opt_int.field.selected_option_index = 1
+        opt_int.field.value = "opt {}".format(i)
+
+
+class TheSourceIterator(bt2._UserMessageIterator):
+    def __init__(self, config, port):
+        tc, sc, ec = port.user_data
+        trace = tc()
+        stream = trace.create_stream(sc)
+        self._msgs = [self._create_stream_beginning_message(stream)]
+
+        for i in range(_EVENT_COUNT):
+            msg = self._create_event_message(ec, stream)
+            _set_payload(msg.event.payload_field, i)
+            self._msgs.append(msg)
+
+        self._msgs.append(self._create_stream_end_message(stream))
+
+    def __next__(self):
+        if len(self._msgs) == 0:
+            raise StopIteration
+
+        return self._msgs.pop(0)
+
+
+@bt2.plugin_component_class
+class TheSource(bt2._UserSourceComponent, message_iterator_class=TheSourceIterator):
+    def __init__(self, config, params, obj):
+        tc = self._create_trace_class()
+        sc = tc.create_stream_class()
+        ec = sc.create_event_class(
+            name="the-event", payload_field_class=_make_payload_fc(tc)
+        )
+        self._add_output_port("out", user_data=(tc, sc, ec))
+
+
+bt2.register_plugin(__name__, "ipc_test")
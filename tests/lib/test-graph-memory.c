@@ -0,0 +1,385 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Copyright (C) 2026 EfficiOS Inc.
+ */
+
+#include <babeltrace2/babeltrace.h>
+#include "common/assert.h"
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <glib.h>
+
+#include "tap/tap.h"
+#include "utils/msg-src.h"
+
+#define NR_TESTS	13
+
+/* Number of event messages of the source */
+#define EVENT_COUNT	20
+
+/* Size which the sink reports to retain per event message (bytes) */
+#define SIZE_PER_EVENT	100
+
+/* Memory limit of the graph: exhausted before the last event message */
+#define MEMORY_LIMIT	(SIZE_PER_EVENT * EVENT_COUNT / 2)
+
+/*
+ * Sink which keeps all the event messages it consumes, reporting
+ * `SIZE_PER_EVENT` bytes of retained memory for each one.
+ */
+struct mem_sink_data {
+	/* Weak */
+	bt_self_component *self_comp;
+
+	/* Memory limit of the graph (0 means no limit) */
+	uint64_t limit;
+
+	bt_message_iterator *msg_iter;
+
+	/* Array of `const bt_message *` (owned by this) */
+	GPtrArray *kept_msgs;
+
+	/* Size which this sink currently reports to retain */
+	uint64_t retained_size;
+
+	/*
+	 * Whether or not the remaining memory budget was the expected
+	 * one after each retained memory size report.
+	 */
+	bool budget_is_expected;
+
+	/* Whether or not the budget reached zero */
+	bool budget_reached_zero;
+
+	/* Whether or not the event message size estimates are positive */
+	bool msg_sizes_are_positive;
+
+	/* Remaining memory budget when the graph is configured */
+	uint64_t initial_budget;
+};
+
+/*
+ * Returns the remaining memory budget which the sink expects.
+ */
+static
+uint64_t expected_budget(const struct mem_sink_data *data)
+{
+	if (data->limit == 0) {
+		return UINT64_MAX;
+	}
+
+	return data->retained_size >= data->limit ? 0 :
+		data->limit - data->retained_size;
+}
+
+static
+bt_component_class_initialize_method_status mem_sink_init(
+		bt_self_component_sink *self_comp_sink,
+		bt_self_component_sink_configuration *config __attribute__((unused)),
+		const bt_value *params __attribute__((unused)),
+		void *init_method_data)
+{
+	struct mem_sink_data *data = init_method_data;
+	bt_self_component_add_port_status add_port_status;
+
+	BT_ASSERT(data);
+	data->self_comp = bt_self_component_sink_as_self_component(
+		self_comp_sink);
+	add_port_status = bt_self_component_sink_add_input_port(
+		self_comp_sink, "in", NULL, NULL);
+	BT_ASSERT(add_port_status == BT_SELF_COMPONENT_ADD_PORT_STATUS_OK);
+	bt_self_component_set_data(data->self_comp, data);
+	return BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
+}
+
+static
+bt_component_class_sink_graph_is_configured_method_status
+mem_sink_graph_is_configured(bt_self_component_sink *self_comp_sink)
+{
+	struct mem_sink_data *data = bt_self_component_get_data(
+		bt_self_component_sink_as_self_component(self_comp_sink));
+	bt_message_iterator_create_from_sink_component_status status;
+
+	status = bt_message_iterator_create_from_sink_component(
+		self_comp_sink,
+		bt_self_component_sink_borrow_input_port_by_name(
+			self_comp_sink, "in"),
+		&data->msg_iter);
+	BT_ASSERT(status ==
+		BT_MESSAGE_ITERATOR_CREATE_FROM_SINK_COMPONENT_STATUS_OK);
+	data->initial_budget = bt_self_component_get_remaining_memory_budget(
+		data->self_comp);
+	return BT_COMPONENT_CLASS_SINK_GRAPH_IS_CONFIGURED_METHOD_STATUS_OK;
+}
+
+static
+bt_component_class_sink_consume_method_status mem_sink_consume(
+		bt_self_component_sink *self_comp_sink)
+{
+	struct mem_sink_data *data = bt_self_component_get_data(
+		bt_self_component_sink_as_self_component(self_comp_sink));
+	bt_message_iterator_next_status status;
+	bt_message_array_const msgs;
+	uint64_t count;
+	uint64_t i;
+
+	status = bt_message_iterator_next(data->msg_iter, &msgs, &count);
+	switch (status) {
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_OK:
+		break;
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_END:
+		return BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_END;
+	default:
+		return BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_ERROR;
+	}
+
+	for (i = 0; i < count; i++) {
+		const bt_message *msg = msgs[i];
+
+		if (bt_message_get_type(msg) != BT_MESSAGE_TYPE_EVENT) {
+			bt_message_put_ref(msg);
+			continue;
+		}
+
+		if (bt_message_get_retained_memory_size(msg) == 0) {
+			data->msg_sizes_are_positive = false;
+		}
+
+		g_ptr_array_add(data->kept_msgs, (void *) msg);
+		bt_self_component_add_retained_memory_size(data->self_comp,
+			SIZE_PER_EVENT);
+		data->retained_size += SIZE_PER_EVENT;
+
+		if (bt_self_component_get_remaining_memory_budget(
+				data->self_comp) !=
+				expected_budget(data)) {
+			data->budget_is_expected = false;
+		}
+
+		if (bt_self_component_get_remaining_memory_budget(
+				data->self_comp) == 0) {
+			data->budget_reached_zero = true;
+		}
+	}
+
+	return BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_OK;
+}
+
+/*
+ * Releases the messages which the sink keeps, reporting it to its
+ * graph one message at a time.
+ */
+static
+void mem_sink_release_msgs(struct mem_sink_data *data)
+{
+	guint i;
+
+	for (i = 0; i < data->kept_msgs->len; i++) {
+		bt_message_put_ref(data->kept_msgs->pdata[i]);
+		bt_self_component_remove_retained_memory_size(data->self_comp,
+			SIZE_PER_EVENT);
+		data->retained_size -= SIZE_PER_EVENT;
+
+		if (bt_self_component_get_remaining_memory_budget(
+				data->self_comp) != expected_budget(data)) {
+			data->budget_is_expected = false;
+		}
+	}
+
+	g_ptr_array_set_size(data->kept_msgs, 0);
+}
+
+static
+void mem_sink_finalize(bt_self_component_sink *self_comp_sink)
+{
+	struct mem_sink_data *data = bt_self_component_get_data(
+		bt_self_component_sink_as_self_component(self_comp_sink));
+
+	bt_message_iterator_put_ref(data->msg_iter);
+}
+
+static
+bt_component_class_sink *mem_sink_create_class(void)
+{
+	bt_component_class_sink *comp_cls;
+	bt_component_class_set_method_status set_method_status;
+
+	comp_cls = bt_component_class_sink_create("mem-sink",
+		mem_sink_consume);
+	BT_ASSERT(comp_cls);
+	set_method_status = bt_component_class_sink_set_initialize_method(
+		comp_cls, mem_sink_init);
+	BT_ASSERT(set_method_status == BT_COMPONENT_CLASS_SET_METHOD_STATUS_OK);
+	set_method_status = bt_component_class_sink_set_graph_is_configured_method(
+		comp_cls, mem_sink_graph_is_configured);
+	BT_ASSERT(set_method_status == BT_COMPONENT_CLASS_SET_METHOD_STATUS_OK);
+	set_method_status = bt_component_class_sink_set_finalize_method(
+		comp_cls, mem_sink_finalize);
+	BT_ASSERT(set_method_status == BT_COMPONENT_CLASS_SET_METHOD_STATUS_OK);
+	return comp_cls;
+}
+
+/*
+ * Creates a graph, with the memory limit `sink_data->limit` if it's
+ * not 0, made of a msg-src source connected to a mem-sink sink of
+ * which the data is `sink_data`.
+ */
+static
+bt_graph *create_graph(struct msg_src_data *src_data,
+		struct mem_sink_data *sink_data)
+{
+	bt_component_class_source *src_comp_cls = msg_src_create_class();
+	bt_component_class_sink *sink_comp_cls = mem_sink_create_class();
+	bt_graph *graph = bt_graph_create(0);
+	const bt_component_source *src_comp;
+	const bt_component_sink *sink_comp;
+	bt_graph_add_component_status add_comp_status;
+	bt_graph_connect_ports_status connect_status;
+
+	BT_ASSERT(graph);
+
+	if (sink_data->limit > 0) {
+		bt_graph_set_memory_limit(graph, sink_data->limit);
+	}
+
+	bt_graph_enable_statistics(graph);
+	add_comp_status = bt_graph_add_source_component_with_initialize_method_data(
+		graph, src_comp_cls, "src", NULL, src_data,
+		BT_LOGGING_LEVEL_NONE, &src_comp);
+	BT_ASSERT(add_comp_status == BT_GRAPH_ADD_COMPONENT_STATUS_OK);
+	add_comp_status = bt_graph_add_sink_component_with_initialize_method_data(
+		graph, sink_comp_cls, "sink", NULL, sink_data,
+		BT_LOGGING_LEVEL_NONE, &sink_comp);
+	BT_ASSERT(add_comp_status == BT_GRAPH_ADD_COMPONENT_STATUS_OK);
+	connect_status = bt_graph_connect_ports(graph,
+		bt_component_source_borrow_output_port_by_index_const(
+			src_comp, 0),
+		bt_component_sink_borrow_input_port_by_index_const(
+			sink_comp, 0), NULL);
+	BT_ASSERT(connect_status == BT_GRAPH_CONNECT_PORTS_STATUS_OK);
+	bt_component_class_source_put_ref(src_comp_cls);
+	bt_component_class_sink_put_ref(sink_comp_cls);
+	return graph;
+}
+
+static
+void init_sink_data(struct mem_sink_data *sink_data, uint64_t limit)
+{
+	sink_data->limit = limit;
+	sink_data->kept_msgs = g_ptr_array_new();
+	BT_ASSERT(sink_data->kept_msgs);
+	sink_data->budget_is_expected = true;
+	sink_data->msg_sizes_are_positive = true;
+}
+
+/*
+ * Returns the retained memory peak size of the sink from the
+ * statistics of `graph`.
+ */
+static
+uint64_t sink_retained_memory_peak_size(bt_graph *graph)
+{
+	const bt_value *stats = NULL;
+	const bt_value *val;
+	uint64_t peak_size = UINT64_MAX;
+	bt_graph_get_statistics_status status;
+
+	status = bt_graph_get_statistics(graph, &stats);
+	BT_ASSERT(status == BT_GRAPH_GET_STATISTICS_STATUS_OK);
+	val = bt_value_map_borrow_entry_value_const(
+		bt_value_array_borrow_element_by_index_const(stats, 1),
+		"retained-memory-peak-size");
+	if (val && bt_value_is_unsigned_integer(val)) {
+		peak_size = bt_value_integer_unsigned_get(val);
+	}
+
+	bt_value_put_ref(stats);
+	return peak_size;
+}
+
+static
+void test_memory_limit(void)
+{
+	struct msg_src_data src_data = {
+		.event_count = EVENT_COUNT,
+	};
+	struct mem_sink_data sink_data = { 0 };
+	bt_graph *graph;
+	bt_graph_run_status run_status;
+
+	init_sink_data(&sink_data, MEMORY_LIMIT);
+	graph = create_graph(&src_data, &sink_data);
+	ok(bt_graph_get_retained_memory_size(graph) == 0,
+		"with limit: graph retains no memory initially");
+	run_status = bt_graph_run(graph);
+	ok(run_status == BT_GRAPH_RUN_STATUS_OK,
+		"with limit: graph runs successfully");
+	ok(sink_data.initial_budget == MEMORY_LIMIT,
+		"with limit: initial budget is the limit (%" PRIu64 ")",
+		sink_data.initial_budget);
+	ok(sink_data.msg_sizes_are_positive,
+		"event message retained memory size estimates are positive");
+
+	/* The sink still keeps all the event messages */
+	ok(bt_graph_get_retained_memory_size(graph) ==
+		SIZE_PER_EVENT * EVENT_COUNT,
+		"with limit: graph retains what the sink reported (%" PRIu64 ")",
+		bt_graph_get_retained_memory_size(graph));
+	ok(sink_data.budget_reached_zero &&
+		bt_self_component_get_remaining_memory_budget(
+			sink_data.self_comp) == 0,
+		"with limit: budget is 0 beyond the limit");
+
+	mem_sink_release_msgs(&sink_data);
+	ok(sink_data.budget_is_expected,
+		"with limit: budget is the limit minus the retained size after each report");
+	ok(bt_graph_get_retained_memory_size(graph) == 0,
+		"with limit: graph retains no memory after the sink releases it");
+	ok(bt_self_component_get_remaining_memory_budget(sink_data.self_comp) ==
+		MEMORY_LIMIT,
+		"with limit: budget is the limit again after the sink releases memory");
+	ok(sink_retained_memory_peak_size(graph) ==
+		SIZE_PER_EVENT * EVENT_COUNT,
+		"with limit: statistics contain the sink's retained memory peak size");
+	bt_graph_put_ref(graph);
+	g_ptr_array_free(sink_data.kept_msgs, TRUE);
+}
+
+static
+void test_no_memory_limit(void)
+{
+	struct msg_src_data src_data = {
+		.event_count = EVENT_COUNT,
+	};
+	struct mem_sink_data sink_data = { 0 };
+	bt_graph *graph;
+	bt_graph_run_status run_status;
+
+	init_sink_data(&sink_data, 0);
+	graph = create_graph(&src_data, &sink_data);
+	run_status = bt_graph_run(graph);
+	ok(run_status == BT_GRAPH_RUN_STATUS_OK,
+		"without limit: graph runs successfully");
+	ok(sink_data.initial_budget == UINT64_MAX &&
+		bt_graph_get_retained_memory_size(graph) ==
+			SIZE_PER_EVENT * EVENT_COUNT &&
+		bt_self_component_get_remaining_memory_budget(
+			sink_data.self_comp) == UINT64_MAX,
+		"without limit: budget is unlimited, but the graph retains what the sink reported");
+	mem_sink_release_msgs(&sink_data);
+	ok(sink_data.budget_is_expected &&
+		bt_graph_get_retained_memory_size(graph) == 0,
+		"without limit: budget stays unlimited, graph retains no memory after the sink releases it");
+	bt_graph_put_ref(graph);
+	g_ptr_array_free(sink_data.kept_msgs, TRUE);
+}
+
+int main(void)
+{
+	plan_tests(NR_TESTS);
+	test_memory_limit();
+	test_no_memory_limit();
+	return exit_status();
+}
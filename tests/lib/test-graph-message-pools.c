@@ -0,0 +1,263 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Copyright (C) 2026 EfficiOS Inc.
+ */
+
+#include <babeltrace2/babeltrace.h>
+#include "common/assert.h"
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <glib.h>
+
+#include "tap/tap.h"
+#include "utils/msg-src.h"
+
+#define NR_TESTS	11
+
+/* Number of event messages of the source: the burst */
+#define EVENT_COUNT	32
+
+/* Maximum size of each message pool */
+#define POOL_MAX_SIZE	8
+
+/* Number of messages to allocate in each message pool up front */
+#define PREWARM_COUNT	4
+
+/*
+ * Number of event messages to release once the event message pool is
+ * full, before destroying the graph
+ */
+#define EXTRA_RELEASE_COUNT	4
+
+static
+bt_graph_simple_sink_component_consume_func_status sink_consume(
+		bt_message_iterator *iterator,
+		void *data __attribute__((unused)))
+{
+	bt_message_iterator_next_status status;
+	bt_message_array_const msgs;
+	uint64_t count;
+	uint64_t i;
+
+	status = bt_message_iterator_next(iterator, &msgs, &count);
+	switch (status) {
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_OK:
+		break;
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_END:
+		return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_END;
+	default:
+		return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_ERROR;
+	}
+
+	for (i = 0; i < count; i++) {
+		bt_message_put_ref(msgs[i]);
+	}
+
+	return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_OK;
+}
+
+/*
+ * Creates a graph made of a msg-src source, of which the data is
+ * `src_data`, connected to a simple sink.
+ */
+static
+bt_graph *create_graph(struct msg_src_data *src_data)
+{
+	bt_component_class_source *src_comp_cls = msg_src_create_class();
+	bt_graph *graph = bt_graph_create(0);
+	const bt_component_source *src_comp;
+	const bt_component_sink *sink_comp;
+	bt_graph_add_component_status add_comp_status;
+	bt_graph_connect_ports_status connect_status;
+
+	BT_ASSERT(graph);
+	add_comp_status = bt_graph_add_source_component_with_initialize_method_data(
+		graph, src_comp_cls, "src", NULL, src_data,
+		BT_LOGGING_LEVEL_NONE, &src_comp);
+	BT_ASSERT(add_comp_status == BT_GRAPH_ADD_COMPONENT_STATUS_OK);
+	add_comp_status = bt_graph_add_simple_sink_component(graph, "sink",
+		NULL, sink_consume, NULL, NULL, &sink_comp);
+	BT_ASSERT(add_comp_status == BT_GRAPH_ADD_COMPONENT_STATUS_OK);
+	connect_status = bt_graph_connect_ports(graph,
+		bt_component_source_borrow_output_port_by_index_const(
+			src_comp, 0),
+		bt_component_sink_borrow_input_port_by_index_const(
+			sink_comp, 0), NULL);
+	BT_ASSERT(connect_status == BT_GRAPH_CONNECT_PORTS_STATUS_OK);
+	bt_component_class_source_put_ref(src_comp_cls);
+	return graph;
+}
+
+/*
+ * Returns the counter `key` of the message pool `pool_name` of
+ * `graph`.
+ */
+static
+uint64_t pool_stat(const bt_graph *graph, const char *pool_name,
+		const char *key)
+{
+	const bt_value *stats = NULL;
+	const bt_value *pool_stats;
+	const bt_value *val = NULL;
+	uint64_t ret = UINT64_MAX;
+	bt_graph_get_message_pool_statistics_status status;
+
+	status = bt_graph_get_message_pool_statistics(graph, &stats);
+	BT_ASSERT(status == BT_GRAPH_GET_MESSAGE_POOL_STATISTICS_STATUS_OK);
+	pool_stats = bt_value_map_borrow_entry_value_const(stats, pool_name);
+	if (pool_stats) {
+		val = bt_value_map_borrow_entry_value_const(pool_stats, key);
+	}
+
+	if (val && bt_value_is_unsigned_integer(val)) {
+		ret = bt_value_integer_unsigned_get(val);
+	}
+
+	bt_value_put_ref(stats);
+	return ret;
+}
+
+/*
+ * Puts the references of the messages of `msgs` at the indexes
+ * `first`, `first + step`, and so on, setting those entries to `NULL`.
+ */
+static
+void put_msgs(GPtrArray *msgs, guint first, guint step)
+{
+	guint i;
+
+	for (i = first; i < msgs->len; i += step) {
+		bt_message_put_ref(msgs->pdata[i]);
+		msgs->pdata[i] = NULL;
+	}
+}
+
+static
+void test_bounded_pools(void)
+{
+	struct msg_src_data src_data = {
+		.event_count = EVENT_COUNT,
+	};
+	bt_graph *graph;
+	bt_graph_run_status run_status;
+	const bt_value *stats = NULL;
+	bt_graph_get_message_pool_statistics_status get_stats_status;
+	uint64_t i;
+
+	src_data.emitted_msgs = g_ptr_array_new();
+	BT_ASSERT(src_data.emitted_msgs);
+	graph = create_graph(&src_data);
+	bt_graph_set_message_pool_max_size(graph, POOL_MAX_SIZE);
+	bt_graph_set_message_pool_prewarm_count(graph, PREWARM_COUNT);
+
+	/*
+	 * The source keeps a reference of each message it emits: all
+	 * the event messages are alive at the same time.
+	 */
+	run_status = bt_graph_run(graph);
+	ok(run_status == BT_GRAPH_RUN_STATUS_OK,
+		"bounded pools: graph runs successfully");
+	BT_ASSERT(src_data.emitted_msgs->len == EVENT_COUNT + 2);
+
+	get_stats_status = bt_graph_get_message_pool_statistics(graph, &stats);
+	ok(get_stats_status == BT_GRAPH_GET_MESSAGE_POOL_STATISTICS_STATUS_OK &&
+		bt_value_is_map(stats) &&
+		bt_value_map_has_entry(stats, "event") &&
+		bt_value_map_has_entry(stats, "packet-beginning") &&
+		bt_value_map_has_entry(stats, "packet-end"),
+		"bt_graph_get_message_pool_statistics() returns one entry per pool");
+	bt_value_put_ref(stats);
+
+	/* Pre-warmed messages first, and then new ones */
+	ok(pool_stat(graph, "event", "hits") == PREWARM_COUNT &&
+		pool_stat(graph, "event", "misses") ==
+			EVENT_COUNT - PREWARM_COUNT &&
+		pool_stat(graph, "event", "size") == 0 &&
+		pool_stat(graph, "event", "peak-size") == PREWARM_COUNT,
+		"bounded pools: burst takes the pre-warmed event messages, and then allocates");
+	ok(pool_stat(graph, "packet-beginning", "size") == PREWARM_COUNT &&
+		pool_stat(graph, "packet-end", "size") == PREWARM_COUNT &&
+		pool_stat(graph, "packet-beginning", "misses") == 0,
+		"bounded pools: unused pools keep their pre-warmed messages");
+
+	/*
+	 * Release every other event message (and the stream end
+	 * message), from the first one: each released message which the
+	 * full pool destroys removes itself from the middle of the
+	 * graph's message array, moving the last one into its slot.
+	 */
+	put_msgs(src_data.emitted_msgs, 1, 2);
+	ok(pool_stat(graph, "event", "size") == POOL_MAX_SIZE &&
+		pool_stat(graph, "event", "peak-size") == POOL_MAX_SIZE,
+		"bounded pools: event message pool doesn't grow beyond its maximum size");
+	ok(pool_stat(graph, "event", "discards") ==
+		EVENT_COUNT / 2 - POOL_MAX_SIZE,
+		"bounded pools: full event message pool discards the other messages (%" PRIu64 ")",
+		pool_stat(graph, "event", "discards"));
+
+	/*
+	 * Release the last `EXTRA_RELEASE_COUNT` kept event messages,
+	 * from the last one: the full pool discards them too.
+	 */
+	for (i = 0; i < EXTRA_RELEASE_COUNT; i++) {
+		guint index = EVENT_COUNT - i * 2;
+
+		bt_message_put_ref(src_data.emitted_msgs->pdata[index]);
+		src_data.emitted_msgs->pdata[index] = NULL;
+	}
+
+	ok(pool_stat(graph, "event", "discards") ==
+		EVENT_COUNT / 2 - POOL_MAX_SIZE + EXTRA_RELEASE_COUNT,
+		"bounded pools: full event message pool discards each released message (%" PRIu64 ")",
+		pool_stat(graph, "event", "discards"));
+
+	/*
+	 * Destroy the graph while some messages are still alive: it
+	 * unlinks them with the indexes which the removals above
+	 * updated, and then they're destroyed without a graph.
+	 */
+	BT_GRAPH_PUT_REF_AND_RESET(graph);
+	msg_src_clear_emitted_msgs(src_data.emitted_msgs);
+	pass("bounded pools: messages which outlive their graph are destroyed");
+	g_ptr_array_free(src_data.emitted_msgs, TRUE);
+}
+
+static
+void test_unbounded_pools(void)
+{
+	struct msg_src_data src_data = {
+		.event_count = EVENT_COUNT,
+	};
+	bt_graph *graph;
+	bt_graph_run_status run_status;
+
+	src_data.emitted_msgs = g_ptr_array_new();
+	BT_ASSERT(src_data.emitted_msgs);
+	graph = create_graph(&src_data);
+	run_status = bt_graph_run(graph);
+	ok(run_status == BT_GRAPH_RUN_STATUS_OK,
+		"unbounded pools: graph runs successfully");
+	ok(pool_stat(graph, "event", "hits") == 0 &&
+		pool_stat(graph, "event", "misses") == EVENT_COUNT &&
+		pool_stat(graph, "packet-beginning", "size") == 0,
+		"unbounded pools: no pre-warmed messages");
+
+	/* Without a maximum size, the pool keeps the whole burst */
+	msg_src_clear_emitted_msgs(src_data.emitted_msgs);
+	ok(pool_stat(graph, "event", "size") == EVENT_COUNT &&
+		pool_stat(graph, "event", "peak-size") == EVENT_COUNT &&
+		pool_stat(graph, "event", "discards") == 0,
+		"unbounded pools: event message pool keeps all the released messages");
+	bt_graph_put_ref(graph);
+	g_ptr_array_free(src_data.emitted_msgs, TRUE);
+}
+
+int main(void)
+{
+	plan_tests(NR_TESTS);
+	test_bounded_pools();
+	test_unbounded_pools();
+	return exit_status();
+}
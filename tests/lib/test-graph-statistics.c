@@ -0,0 +1,180 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Copyright (C) 2026 EfficiOS Inc.
+ */
+
+#include <babeltrace2/babeltrace.h>
+#include "common/assert.h"
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "tap/tap.h"
+#include "utils/msg-src.h"
+
+#define NR_TESTS	16
+
+/* Number of event messages of the source */
+#define EVENT_COUNT	10
+
+/* Maximum number of messages per source "next" method call */
+#define BATCH_SIZE	3
+
+static
+bt_graph_simple_sink_component_consume_func_status sink_consume(
+		bt_message_iterator *iterator,
+		void *data __attribute__((unused)))
+{
+	bt_message_iterator_next_status status;
+	bt_message_array_const msgs;
+	uint64_t count;
+	uint64_t i;
+
+	status = bt_message_iterator_next(iterator, &msgs, &count);
+	switch (status) {
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_OK:
+		break;
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_END:
+		return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_END;
+	default:
+		return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_ERROR;
+	}
+
+	for (i = 0; i < count; i++) {
+		bt_message_put_ref(msgs[i]);
+	}
+
+	return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_OK;
+}
+
+static
+const char *stats_map_string(const bt_value *map, const char *key)
+{
+	const bt_value *val = bt_value_map_borrow_entry_value_const(map, key);
+
+	return val && bt_value_is_string(val) ? bt_value_string_get(val) : "";
+}
+
+static
+uint64_t stats_map_uint(const bt_value *map, const char *key)
+{
+	const bt_value *val = bt_value_map_borrow_entry_value_const(map, key);
+
+	return val && bt_value_is_unsigned_integer(val) ?
+		bt_value_integer_unsigned_get(val) : UINT64_MAX;
+}
+
+static
+void test_graph_statistics(void)
+{
+	/*
+	 * The source returns all its messages in batches of
+	 * `BATCH_SIZE`, and then ends: one more "next" method call.
+	 */
+	const uint64_t msg_count = EVENT_COUNT + 2;
+	const uint64_t next_call_count =
+		(msg_count + BATCH_SIZE - 1) / BATCH_SIZE + 1;
+	struct msg_src_data src_data = {
+		.event_count = EVENT_COUNT,
+		.batch_size = BATCH_SIZE,
+	};
+	bt_component_class_source *src_comp_cls = msg_src_create_class();
+	bt_graph *graph = bt_graph_create(0);
+	const bt_component_source *src_comp;
+	const bt_component_sink *sink_comp;
+	bt_graph_add_component_status add_comp_status;
+	bt_graph_connect_ports_status connect_status;
+	bt_graph_run_status run_status;
+	bt_graph_get_statistics_status get_stats_status;
+	const bt_value *stats = NULL;
+	const bt_value *src_stats;
+	const bt_value *sink_stats;
+
+	BT_ASSERT(graph);
+	bt_graph_enable_statistics(graph);
+	add_comp_status = bt_graph_add_source_component_with_initialize_method_data(
+		graph, src_comp_cls, "src", NULL, &src_data,
+		BT_LOGGING_LEVEL_NONE, &src_comp);
+	BT_ASSERT(add_comp_status == BT_GRAPH_ADD_COMPONENT_STATUS_OK);
+	add_comp_status = bt_graph_add_simple_sink_component(graph, "sink",
+		NULL, sink_consume, NULL, NULL, &sink_comp);
+	BT_ASSERT(add_comp_status == BT_GRAPH_ADD_COMPONENT_STATUS_OK);
+	connect_status = bt_graph_connect_ports(graph,
+		bt_component_source_borrow_output_port_by_index_const(
+			src_comp, 0),
+		bt_component_sink_borrow_input_port_by_index_const(
+			sink_comp, 0), NULL);
+	BT_ASSERT(connect_status == BT_GRAPH_CONNECT_PORTS_STATUS_OK);
+
+	run_status = bt_graph_run(graph);
+	ok(run_status == BT_GRAPH_RUN_STATUS_OK, "graph runs successfully");
+
+	get_stats_status = bt_graph_get_statistics(graph, &stats);
+	ok(get_stats_status == BT_GRAPH_GET_STATISTICS_STATUS_OK,
+		"bt_graph_get_statistics() succeeds");
+	BT_ASSERT(stats);
+	ok(bt_value_is_array(stats) && bt_value_array_get_length(stats) == 2,
+		"statistics contain one element per component");
+	src_stats = bt_value_array_borrow_element_by_index_const(stats, 0);
+	sink_stats = bt_value_array_borrow_element_by_index_const(stats, 1);
+
+	/* Source */
+	ok(strcmp(stats_map_string(src_stats, "component-name"), "src") == 0 &&
+		strcmp(stats_map_string(src_stats, "component-class-type"),
+			"source") == 0 &&
+		strcmp(stats_map_string(src_stats, "component-class-name"),
+			"msg-src") == 0,
+		"source statistics: names and type");
+	ok(!bt_value_map_has_entry(src_stats, "consume-calls"),
+		"source statistics: no \"consume\" method counters");
+	ok(stats_map_uint(src_stats, "message-iterator-count") == 1,
+		"source statistics: one message iterator");
+	ok(stats_map_uint(src_stats, "next-calls") == next_call_count,
+		"source statistics: \"next\" method calls (%" PRIu64 ")",
+		stats_map_uint(src_stats, "next-calls"));
+	ok(stats_map_uint(src_stats, "messages") == msg_count,
+		"source statistics: messages (%" PRIu64 ")",
+		stats_map_uint(src_stats, "messages"));
+	ok(stats_map_uint(src_stats, "again-count") == 0,
+		"source statistics: no \"try again\" status");
+	ok(stats_map_uint(src_stats, "next-exclusive-time-ns") ==
+		stats_map_uint(src_stats, "next-inclusive-time-ns"),
+		"source statistics: exclusive time is inclusive time (no upstream)");
+
+	/* Sink */
+	ok(strcmp(stats_map_string(sink_stats, "component-name"), "sink") == 0 &&
+		strcmp(stats_map_string(sink_stats, "component-class-type"),
+			"sink") == 0,
+		"sink statistics: name and type");
+	ok(!bt_value_map_has_entry(sink_stats, "next-calls") &&
+		!bt_value_map_has_entry(sink_stats, "messages"),
+		"sink statistics: no \"next\" method counters");
+
+	/* One "consume" method call per source "next" method call */
+	ok(stats_map_uint(sink_stats, "consume-calls") == next_call_count,
+		"sink statistics: \"consume\" method calls (%" PRIu64 ")",
+		stats_map_uint(sink_stats, "consume-calls"));
+	ok(stats_map_uint(sink_stats, "consume-inclusive-time-ns") >=
+		stats_map_uint(src_stats, "next-inclusive-time-ns"),
+		"sink statistics: inclusive time includes the source time");
+	ok(stats_map_uint(sink_stats, "consume-exclusive-time-ns") +
+		stats_map_uint(src_stats, "next-inclusive-time-ns") ==
+		stats_map_uint(sink_stats, "consume-inclusive-time-ns"),
+		"sink statistics: exclusive time excludes the source time");
+	ok(bt_value_map_has_entry(src_stats, "retained-memory-peak-size") &&
+		bt_value_map_has_entry(sink_stats, "retained-memory-peak-size"),
+		"statistics contain the retained memory peak size");
+
+	bt_value_put_ref(stats);
+	bt_graph_put_ref(graph);
+	bt_component_class_source_put_ref(src_comp_cls);
+}
+
+int main(void)
+{
+	plan_tests(NR_TESTS);
+	test_graph_statistics();
+	return exit_status();
+}
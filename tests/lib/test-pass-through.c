@@ -0,0 +1,343 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Copyright (C) 2026 EfficiOS Inc.
+ */
+
+#include <babeltrace2/babeltrace.h>
+#include "common/assert.h"
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <glib.h>
+
+#include "tap/tap.h"
+#include "utils/msg-src.h"
+
+#define NR_TESTS	10
+
+/* Number of event messages of the source */
+#define EVENT_COUNT	10
+
+/* Number of messages which the sink consumes before seeking */
+#define MSG_COUNT_BEFORE_SEEK	5
+
+struct flt_iter {
+	bt_message_iterator *upstream_iter;
+};
+
+static struct {
+	/* Number of filter "next" method calls since the last seek */
+	uint64_t flt_next_call_count;
+
+	/* Value of `flt_next_call_count` when the sink seeks */
+	uint64_t flt_next_call_count_before_seek;
+
+	/* Whether or not the filter got a stream end message */
+	bool flt_got_stream_end;
+
+	/* Messages which the sink consumed since it seeked (owned) */
+	GPtrArray *received_msgs;
+
+	bool sink_seeked;
+} state;
+
+static
+bt_component_class_initialize_method_status flt_init(
+		bt_self_component_filter *self_comp,
+		bt_self_component_filter_configuration *config __attribute__((unused)),
+		const bt_value *params __attribute__((unused)),
+		void *init_method_data __attribute__((unused)))
+{
+	bt_self_component_add_port_status status;
+
+	status = bt_self_component_filter_add_input_port(self_comp, "in",
+		NULL, NULL);
+	BT_ASSERT(status == BT_SELF_COMPONENT_ADD_PORT_STATUS_OK);
+	status = bt_self_component_filter_add_output_port(self_comp, "out",
+		NULL, NULL);
+	BT_ASSERT(status == BT_SELF_COMPONENT_ADD_PORT_STATUS_OK);
+	return BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
+}
+
+static
+bt_message_iterator_class_initialize_method_status flt_iter_init(
+		bt_self_message_iterator *self_msg_iter,
+		bt_self_message_iterator_configuration *config __attribute__((unused)),
+		bt_self_component_port_output *port __attribute__((unused)))
+{
+	struct flt_iter *iter = g_new0(struct flt_iter, 1);
+	bt_self_component_port_input *in_port;
+	bt_message_iterator_create_from_message_iterator_status status;
+
+	in_port = bt_self_component_filter_borrow_input_port_by_name(
+		(bt_self_component_filter *)
+			bt_self_message_iterator_borrow_component(self_msg_iter),
+		"in");
+	BT_ASSERT(in_port);
+	status = bt_message_iterator_create_from_message_iterator(
+		self_msg_iter, in_port, &iter->upstream_iter);
+	BT_ASSERT(status == BT_MESSAGE_ITERATOR_CREATE_FROM_MESSAGE_ITERATOR_STATUS_OK);
+	bt_self_message_iterator_set_data(self_msg_iter, iter);
+	return BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_OK;
+}
+
+static
+void flt_iter_finalize(bt_self_message_iterator *self_msg_iter)
+{
+	struct flt_iter *iter =
+		bt_self_message_iterator_get_data(self_msg_iter);
+
+	bt_message_iterator_put_ref(iter->upstream_iter);
+	g_free(iter);
+}
+
+/*
+ * Forwards the upstream messages, and then passes through until a
+ * stream end message.
+ */
+static
+bt_message_iterator_class_next_method_status flt_iter_next(
+		bt_self_message_iterator *self_msg_iter,
+		bt_message_array_const msgs,
+		uint64_t capacity __attribute__((unused)),
+		uint64_t *count)
+{
+	struct flt_iter *iter =
+		bt_self_message_iterator_get_data(self_msg_iter);
+	bt_message_iterator_next_status status;
+	bt_message_array_const upstream_msgs;
+	uint64_t upstream_count;
+	bool got_stream_end = false;
+	uint64_t i;
+
+	state.flt_next_call_count++;
+	status = bt_message_iterator_next(iter->upstream_iter, &upstream_msgs,
+		&upstream_count);
+	if (status != BT_MESSAGE_ITERATOR_NEXT_STATUS_OK) {
+		return (int) status;
+	}
+
+	for (i = 0; i < upstream_count; i++) {
+		if (bt_message_get_type(upstream_msgs[i]) ==
+				BT_MESSAGE_TYPE_STREAM_END) {
+			got_stream_end = true;
+		}
+
+		msgs[i] = upstream_msgs[i];
+	}
+
+	*count = upstream_count;
+
+	if (got_stream_end) {
+		state.flt_got_stream_end = true;
+	} else {
+		bt_self_message_iterator_set_pass_through(self_msg_iter,
+			iter->upstream_iter, BT_MESSAGE_TYPE_STREAM_END);
+	}
+
+	return BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+}
+
+static
+bt_message_iterator_class_can_seek_beginning_method_status
+flt_iter_can_seek_beginning(bt_self_message_iterator *self_msg_iter,
+		bt_bool *can_seek)
+{
+	struct flt_iter *iter =
+		bt_self_message_iterator_get_data(self_msg_iter);
+
+	return (int) bt_message_iterator_can_seek_beginning(
+		iter->upstream_iter, can_seek);
+}
+
+static
+bt_message_iterator_class_seek_beginning_method_status
+flt_iter_seek_beginning(bt_self_message_iterator *self_msg_iter)
+{
+	struct flt_iter *iter =
+		bt_self_message_iterator_get_data(self_msg_iter);
+
+	state.flt_next_call_count = 0;
+	return (int) bt_message_iterator_seek_beginning(iter->upstream_iter);
+}
+
+static
+bt_component_class_filter *create_flt_comp_cls(void)
+{
+	bt_message_iterator_class *msg_iter_cls;
+	bt_component_class_filter *comp_cls;
+	bt_message_iterator_class_set_method_status msg_iter_set_method_status;
+	bt_component_class_set_method_status set_method_status;
+
+	msg_iter_cls = bt_message_iterator_class_create(flt_iter_next);
+	BT_ASSERT(msg_iter_cls);
+	msg_iter_set_method_status = bt_message_iterator_class_set_initialize_method(
+		msg_iter_cls, flt_iter_init);
+	BT_ASSERT(msg_iter_set_method_status ==
+		BT_MESSAGE_ITERATOR_CLASS_SET_METHOD_STATUS_OK);
+	msg_iter_set_method_status = bt_message_iterator_class_set_finalize_method(
+		msg_iter_cls, flt_iter_finalize);
+	BT_ASSERT(msg_iter_set_method_status ==
+		BT_MESSAGE_ITERATOR_CLASS_SET_METHOD_STATUS_OK);
+	msg_iter_set_method_status = bt_message_iterator_class_set_seek_beginning_methods(
+		msg_iter_cls, flt_iter_seek_beginning,
+		flt_iter_can_seek_beginning);
+	BT_ASSERT(msg_iter_set_method_status ==
+		BT_MESSAGE_ITERATOR_CLASS_SET_METHOD_STATUS_OK);
+	comp_cls = bt_component_class_filter_create("flt", msg_iter_cls);
+	BT_ASSERT(comp_cls);
+	set_method_status = bt_component_class_filter_set_initialize_method(
+		comp_cls, flt_init);
+	BT_ASSERT(set_method_status == BT_COMPONENT_CLASS_SET_METHOD_STATUS_OK);
+	bt_message_iterator_class_put_ref(msg_iter_cls);
+	return comp_cls;
+}
+
+static
+bt_graph_simple_sink_component_consume_func_status sink_consume(
+		bt_message_iterator *iterator,
+		void *data __attribute__((unused)))
+{
+	bt_message_iterator_next_status status;
+	bt_message_array_const msgs;
+	uint64_t count;
+	uint64_t i;
+
+	status = bt_message_iterator_next(iterator, &msgs, &count);
+	switch (status) {
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_OK:
+		break;
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_END:
+		return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_END;
+	default:
+		return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_ERROR;
+	}
+
+	for (i = 0; i < count; i++) {
+		g_ptr_array_add(state.received_msgs, (gpointer) msgs[i]);
+	}
+
+	if (!state.sink_seeked &&
+			state.received_msgs->len >= MSG_COUNT_BEFORE_SEEK) {
+		bt_bool can_seek = BT_FALSE;
+		bt_message_iterator_can_seek_beginning_status can_seek_status;
+		bt_message_iterator_seek_beginning_status seek_status;
+
+		state.flt_next_call_count_before_seek =
+			state.flt_next_call_count;
+		msg_src_clear_emitted_msgs(state.received_msgs);
+		can_seek_status = bt_message_iterator_can_seek_beginning(
+			iterator, &can_seek);
+		BT_ASSERT(can_seek_status ==
+			BT_MESSAGE_ITERATOR_CAN_SEEK_BEGINNING_STATUS_OK);
+		BT_ASSERT(can_seek);
+		seek_status = bt_message_iterator_seek_beginning(iterator);
+		BT_ASSERT(seek_status ==
+			BT_MESSAGE_ITERATOR_SEEK_BEGINNING_STATUS_OK);
+		state.sink_seeked = true;
+	}
+
+	return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_OK;
+}
+
+static
+void test_pass_through(void)
+{
+	struct msg_src_data src_data = {
+		.event_count = EVENT_COUNT,
+
+		/* One message per batch to count the filter method calls */
+		.batch_size = 1,
+		.emitted_msgs = g_ptr_array_new(),
+	};
+	bt_component_class_source *src_comp_cls = msg_src_create_class();
+	bt_component_class_filter *flt_comp_cls = create_flt_comp_cls();
+	bt_graph *graph = bt_graph_create(0);
+	const bt_component_source *src_comp;
+	const bt_component_filter *flt_comp;
+	const bt_component_sink *sink_comp;
+	bt_graph_add_component_status add_comp_status;
+	bt_graph_connect_ports_status connect_status;
+	bt_graph_run_status run_status;
+	bool same_msgs = true;
+	guint i;
+
+	BT_ASSERT(graph);
+	state.received_msgs = g_ptr_array_new();
+	add_comp_status = bt_graph_add_source_component_with_initialize_method_data(
+		graph, src_comp_cls, "src", NULL, &src_data,
+		BT_LOGGING_LEVEL_NONE, &src_comp);
+	BT_ASSERT(add_comp_status == BT_GRAPH_ADD_COMPONENT_STATUS_OK);
+	add_comp_status = bt_graph_add_filter_component(graph, flt_comp_cls,
+		"flt", NULL, BT_LOGGING_LEVEL_NONE, &flt_comp);
+	BT_ASSERT(add_comp_status == BT_GRAPH_ADD_COMPONENT_STATUS_OK);
+	add_comp_status = bt_graph_add_simple_sink_component(graph, "sink",
+		NULL, sink_consume, NULL, NULL, &sink_comp);
+	BT_ASSERT(add_comp_status == BT_GRAPH_ADD_COMPONENT_STATUS_OK);
+	connect_status = bt_graph_connect_ports(graph,
+		bt_component_source_borrow_output_port_by_index_const(
+			src_comp, 0),
+		bt_component_filter_borrow_input_port_by_index_const(
+			flt_comp, 0), NULL);
+	BT_ASSERT(connect_status == BT_GRAPH_CONNECT_PORTS_STATUS_OK);
+	connect_status = bt_graph_connect_ports(graph,
+		bt_component_filter_borrow_output_port_by_index_const(
+			flt_comp, 0),
+		bt_component_sink_borrow_input_port_by_index_const(
+			sink_comp, 0), NULL);
+	BT_ASSERT(connect_status == BT_GRAPH_CONNECT_PORTS_STATUS_OK);
+
+	run_status = bt_graph_run(graph);
+	ok(run_status == BT_GRAPH_RUN_STATUS_OK, "graph runs successfully");
+	ok(state.sink_seeked, "sink seeked its upstream message iterator");
+	ok(src_data.seek_count == 1,
+		"seeking the filter message iterator seeks the source one");
+
+	/* Before seeking: stream beginning message, then pass-through */
+	ok(state.flt_next_call_count_before_seek == 1,
+		"filter \"next\" method isn't called while passing through");
+
+	/*
+	 * After seeking: stream beginning message, then pass-through,
+	 * reclaim for the stream end message, and end.
+	 */
+	ok(state.flt_next_call_count == 3,
+		"filter \"next\" method is called again after seeking and to reclaim control (%" PRIu64 " calls)",
+		state.flt_next_call_count);
+	ok(state.flt_got_stream_end,
+		"filter \"next\" method gets the batch which makes it reclaim control");
+	ok(state.received_msgs->len == EVENT_COUNT + 2,
+		"sink consumes all the messages after seeking (%u messages)",
+		state.received_msgs->len);
+	ok(state.received_msgs->len == src_data.emitted_msgs->len,
+		"sink consumes as many messages as the source emits after seeking");
+
+	for (i = 0; i < state.received_msgs->len &&
+			i < src_data.emitted_msgs->len; i++) {
+		if (state.received_msgs->pdata[i] !=
+				src_data.emitted_msgs->pdata[i]) {
+			same_msgs = false;
+		}
+	}
+
+	ok(same_msgs, "sink consumes the source messages as is");
+	ok(bt_message_get_type(g_ptr_array_index(state.received_msgs,
+		state.received_msgs->len - 1)) == BT_MESSAGE_TYPE_STREAM_END,
+		"last consumed message is the stream end message");
+
+	bt_graph_put_ref(graph);
+	msg_src_clear_emitted_msgs(state.received_msgs);
+	g_ptr_array_free(state.received_msgs, TRUE);
+	msg_src_clear_emitted_msgs(src_data.emitted_msgs);
+	g_ptr_array_free(src_data.emitted_msgs, TRUE);
+	bt_component_class_filter_put_ref(flt_comp_cls);
+	bt_component_class_source_put_ref(src_comp_cls);
+}
+
+int main(void)
+{
+	plan_tests(NR_TESTS);
+	test_pass_through();
+	return exit_status();
+}
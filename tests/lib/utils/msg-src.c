@@ -0,0 +1,220 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Copyright (C) 2026 EfficiOS Inc.
+ */
+
+#include <babeltrace2/babeltrace.h>
+#include "common/assert.h"
+#include <stdint.h>
+#include <glib.h>
+
+#include "msg-src.h"
+
+struct msg_src_comp {
+	/* Weak */
+	struct msg_src_data *data;
+
+	bt_trace *trace;
+	bt_stream *stream;
+	bt_event_class *event_class;
+};
+
+struct msg_src_iter {
+	/* Weak */
+	struct msg_src_comp *comp;
+
+	/*
+	 * Index of the next message to emit: 0 is the stream beginning
+	 * message, and `event_count + 1` is the stream end message.
+	 */
+	uint64_t index;
+};
+
+void msg_src_clear_emitted_msgs(GPtrArray *emitted_msgs)
+{
+	guint i;
+
+	for (i = 0; i < emitted_msgs->len; i++) {
+		bt_message_put_ref(emitted_msgs->pdata[i]);
+	}
+
+	g_ptr_array_set_size(emitted_msgs, 0);
+}
+
+static
+bt_component_class_initialize_method_status msg_src_init(
+		bt_self_component_source *self_comp_src,
+		bt_self_component_source_configuration *config __attribute__((unused)),
+		const bt_value *params __attribute__((unused)),
+		void *init_method_data)
+{
+	bt_self_component *self_comp =
+		bt_self_component_source_as_self_component(self_comp_src);
+	struct msg_src_comp *comp = g_new0(struct msg_src_comp, 1);
+	bt_trace_class *trace_class;
+	bt_stream_class *stream_class;
+	bt_self_component_add_port_status add_port_status;
+
+	BT_ASSERT(init_method_data);
+	comp->data = init_method_data;
+	trace_class = bt_trace_class_create(self_comp);
+	BT_ASSERT(trace_class);
+	stream_class = bt_stream_class_create(trace_class);
+	BT_ASSERT(stream_class);
+	comp->event_class = bt_event_class_create(stream_class);
+	BT_ASSERT(comp->event_class);
+	comp->trace = bt_trace_create(trace_class);
+	BT_ASSERT(comp->trace);
+	comp->stream = bt_stream_create(stream_class, comp->trace);
+	BT_ASSERT(comp->stream);
+	bt_stream_class_put_ref(stream_class);
+	bt_trace_class_put_ref(trace_class);
+	add_port_status = bt_self_component_source_add_output_port(
+		self_comp_src, "out", NULL, NULL);
+	BT_ASSERT(add_port_status == BT_SELF_COMPONENT_ADD_PORT_STATUS_OK);
+	bt_self_component_set_data(self_comp, comp);
+	return BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
+}
+
+static
+void msg_src_finalize(bt_self_component_source *self_comp_src)
+{
+	struct msg_src_comp *comp = bt_self_component_get_data(
+		bt_self_component_source_as_self_component(self_comp_src));
+
+	bt_stream_put_ref(comp->stream);
+	bt_trace_put_ref(comp->trace);
+	bt_event_class_put_ref(comp->event_class);
+	g_free(comp);
+}
+
+static
+bt_message_iterator_class_initialize_method_status msg_src_iter_init(
+		bt_self_message_iterator *self_msg_iter,
+		bt_self_message_iterator_configuration *config __attribute__((unused)),
+		bt_self_component_port_output *port __attribute__((unused)))
+{
+	struct msg_src_iter *iter = g_new0(struct msg_src_iter, 1);
+
+	iter->comp = bt_self_component_get_data(
+		bt_self_message_iterator_borrow_component(self_msg_iter));
+	bt_self_message_iterator_set_data(self_msg_iter, iter);
+	return BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_OK;
+}
+
+static
+void msg_src_iter_finalize(bt_self_message_iterator *self_msg_iter)
+{
+	g_free(bt_self_message_iterator_get_data(self_msg_iter));
+}
+
+static
+bt_message_iterator_class_next_method_status msg_src_iter_next(
+		bt_self_message_iterator *self_msg_iter,
+		bt_message_array_const msgs, uint64_t capacity,
+		uint64_t *count)
+{
+	struct msg_src_iter *iter =
+		bt_self_message_iterator_get_data(self_msg_iter);
+	struct msg_src_comp *comp = iter->comp;
+	const uint64_t end_index = comp->data->event_count + 1;
+	uint64_t i;
+
+	if (iter->index > end_index) {
+		return BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_END;
+	}
+
+	if (comp->data->batch_size > 0 && comp->data->batch_size < capacity) {
+		capacity = comp->data->batch_size;
+	}
+
+	for (i = 0; i < capacity && iter->index <= end_index; i++) {
+		bt_message *msg;
+
+		if (iter->index == 0) {
+			msg = bt_message_stream_beginning_create(self_msg_iter,
+				comp->stream);
+		} else if (iter->index == end_index) {
+			msg = bt_message_stream_end_create(self_msg_iter,
+				comp->stream);
+		} else {
+			msg = bt_message_event_create(self_msg_iter,
+				comp->event_class, comp->stream);
+		}
+
+		BT_ASSERT(msg);
+
+		if (comp->data->emitted_msgs) {
+			bt_message_get_ref(msg);
+			g_ptr_array_add(comp->data->emitted_msgs, msg);
+		}
+
+		msgs[i] = msg;
+		iter->index++;
+	}
+
+	*count = i;
+	return BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+}
+
+static
+bt_message_iterator_class_can_seek_beginning_method_status
+msg_src_iter_can_seek_beginning(
+		bt_self_message_iterator *self_msg_iter __attribute__((unused)),
+		bt_bool *can_seek)
+{
+	*can_seek = BT_TRUE;
+	return BT_MESSAGE_ITERATOR_CLASS_CAN_SEEK_BEGINNING_METHOD_STATUS_OK;
+}
+
+static
+bt_message_iterator_class_seek_beginning_method_status
+msg_src_iter_seek_beginning(bt_self_message_iterator *self_msg_iter)
+{
+	struct msg_src_iter *iter =
+		bt_self_message_iterator_get_data(self_msg_iter);
+
+	iter->index = 0;
+	iter->comp->data->seek_count++;
+
+	if (iter->comp->data->emitted_msgs) {
+		msg_src_clear_emitted_msgs(iter->comp->data->emitted_msgs);
+	}
+
+	return BT_MESSAGE_ITERATOR_CLASS_SEEK_BEGINNING_METHOD_STATUS_OK;
+}
+
+bt_component_class_source *msg_src_create_class(void)
+{
+	bt_message_iterator_class *msg_iter_cls;
+	bt_component_class_source *comp_cls;
+	bt_message_iterator_class_set_method_status msg_iter_set_method_status;
+	bt_component_class_set_method_status set_method_status;
+
+	msg_iter_cls = bt_message_iterator_class_create(msg_src_iter_next);
+	BT_ASSERT(msg_iter_cls);
+	msg_iter_set_method_status = bt_message_iterator_class_set_initialize_method(
+		msg_iter_cls, msg_src_iter_init);
+	BT_ASSERT(msg_iter_set_method_status ==
+		BT_MESSAGE_ITERATOR_CLASS_SET_METHOD_STATUS_OK);
+	msg_iter_set_method_status = bt_message_iterator_class_set_finalize_method(
+		msg_iter_cls, msg_src_iter_finalize);
+	BT_ASSERT(msg_iter_set_method_status ==
+		BT_MESSAGE_ITERATOR_CLASS_SET_METHOD_STATUS_OK);
+	msg_iter_set_method_status = bt_message_iterator_class_set_seek_beginning_methods(
+		msg_iter_cls, msg_src_iter_seek_beginning,
+		msg_src_iter_can_seek_beginning);
+	BT_ASSERT(msg_iter_set_method_status ==
+		BT_MESSAGE_ITERATOR_CLASS_SET_METHOD_STATUS_OK);
+	comp_cls = bt_component_class_source_create("msg-src", msg_iter_cls);
+	BT_ASSERT(comp_cls);
+	set_method_status = bt_component_class_source_set_initialize_method(
+		comp_cls, msg_src_init);
+	BT_ASSERT(set_method_status == BT_COMPONENT_CLASS_SET_METHOD_STATUS_OK);
+	set_method_status = bt_component_class_source_set_finalize_method(
+		comp_cls, msg_src_finalize);
+	BT_ASSERT(set_method_status == BT_COMPONENT_CLASS_SET_METHOD_STATUS_OK);
+	bt_message_iterator_class_put_ref(msg_iter_cls);
+	return comp_cls;
+}
@@ -0,0 +1,63 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Copyright (C) 2026 EfficiOS Inc.
+ */
+
+#ifndef TESTS_LIB_UTILS_MSG_SRC_H
+#define TESTS_LIB_UTILS_MSG_SRC_H
+
+#include <stdint.h>
+#include <babeltrace2/babeltrace.h>
+#include <glib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Initialization method data of a component of the class which
+ * msg_src_create_class() returns (owned by the test).
+ */
+struct msg_src_data {
+	/* Number of event messages of the single stream */
+	uint64_t event_count;
+
+	/*
+	 * Maximum number of messages that the "next" method returns at
+	 * once (0 means the capacity of the message array).
+	 */
+	uint64_t batch_size;
+
+	/*
+	 * If not `NULL`, the message iterator appends a new reference of
+	 * each message it emits to this array, and empties it when it
+	 * seeks its beginning.
+	 */
+	GPtrArray *emitted_msgs;
+
+	/* Number of "seek beginning" method calls */
+	uint64_t seek_count;
+};
+
+/*
+ * Creates a source component class of which the message iterators
+ * emit a stream beginning message, `event_count` event messages, and a
+ * stream end message, and can seek their beginning.
+ *
+ * Pass a `struct msg_src_data` as the initialization method data when
+ * adding a component of this class to a graph.
+ */
+bt_component_class_source *msg_src_create_class(void);
+
+/*
+ * Puts the references of the messages of `emitted_msgs`, and empties
+ * it.
+ */
+void msg_src_clear_emitted_msgs(GPtrArray *emitted_msgs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_LIB_UTILS_MSG_SRC_H */
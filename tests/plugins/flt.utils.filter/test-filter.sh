@@ -0,0 +1,130 @@
+#!/bin/bash
+#
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2026 EfficiOS Inc.
+#
+
+# This file tests which event messages flt.utils.filter discards.
+
+SH_TAP=1
+
+if [ -n "${BT_TESTS_SRCDIR:-}" ]; then
+	UTILSSH="$BT_TESTS_SRCDIR/utils/utils.sh"
+else
+	UTILSSH="$(dirname "$0")/../../utils/utils.sh"
+fi
+
+# shellcheck source=../../utils/utils.sh
+source "$UTILSSH"
+
+# Two event classes, `a` and `b`, used in a round-robin fashion: 5
+# events of each class.
+synth_params='event-count=+10,event-classes=[{name=a,payload=[u64,s64,string]},{name=b,payload=[u64,s64,string]}]'
+
+temp_stdout=$(mktemp)
+temp_stderr=$(mktemp)
+temp_details=$(mktemp)
+
+# Runs a graph with the filter expression `$1` and prints the number
+# of event messages which reach the sink.
+event_count() {
+	local expr="$1"
+
+	bt_cli "$temp_stdout" "$temp_stderr" run \
+		-c src:src.utils.synthetic -p "$synth_params" \
+		-c flt:flt.utils.filter -p "expression=\"$expr\"" \
+		-c sink:sink.utils.counter \
+		-C src:flt -C flt:sink || return 1
+
+	awk '$2 == "Event" { print $1 }' "$temp_stdout"
+}
+
+# Runs event_count() with the filter expression `$1` and checks that
+# the result is `$2`.
+test_filter() {
+	local expr="$1"
+	local expected="$2"
+	local count
+
+	count=$(event_count "$expr")
+	is "$count" "$expected" "expression \`$expr\` accepts $expected event(s)"
+}
+
+# Prints the values of the payload member `$2` of the events of the
+# sink.text.details output file `$1`, without the digit separators.
+details_payload_member_values() {
+	awk -v member="$2:" '$1 == member { gsub(",", "", $2); print $2 }' "$1"
+}
+
+# Checks that, with a `payload.$2 > N` filter expression, N being the
+# median of the values of the payload member `$2` of the events of the
+# single-stream CTF trace `$1`, flt.utils.filter lets through the
+# events of which the member value, as sink.text.details prints it, is
+# greater than N.
+test_ctf_fs_filter() {
+	local trace_dir="$BT_CTF_TRACES_PATH/succeed/$1"
+	local member="$2"
+	local threshold
+	local expected
+	local expr
+
+	bt_cli "$temp_details" /dev/null "$trace_dir" \
+		-c sink.text.details -p with-metadata=no
+	ok $? "'$1': read trace"
+	threshold=$(details_payload_member_values "$temp_details" "$member" |
+		sort -n | awk '{ values[NR] = $1 } END { print values[int((NR + 1) / 2)] }')
+	expected=$(details_payload_member_values "$temp_details" "$member" |
+		awk -v threshold="$threshold" '$1 > threshold { n++ } END { print n + 0 }')
+	expr="payload.$member > $threshold"
+
+	bt_cli "$temp_stdout" "$temp_stderr" run \
+		-c src:src.ctf.fs -p "inputs=[\"$trace_dir\"]" \
+		-c flt:flt.utils.filter -p "expression=\"$expr\"" \
+		-c sink:sink.utils.counter \
+		-C src:flt -C flt:sink
+	is "$(awk '$2 == "Event" { print $1 }' "$temp_stdout")" "$expected" \
+		"'$1': expression \`$expr\` accepts $expected event(s) (sink.utils.counter)"
+
+	bt_cli "$temp_stdout" "$temp_stderr" run \
+		-c src:src.ctf.fs -p "inputs=[\"$trace_dir\"]" \
+		-c flt:flt.utils.filter -p "expression=\"$expr\"" \
+		-c sink:sink.text.details -p with-metadata=no \
+		-C src:flt -C flt:sink
+	is "$(grep -c '} Event ' "$temp_stdout")" "$expected" \
+		"'$1': expression \`$expr\` accepts $expected event(s) (sink.text.details)"
+}
+
+plan_tests 21
+
+test_filter 'true' 10
+test_filter 'false' 0
+test_filter 'name == \"a\"' 5
+test_filter 'name != \"a\"' 5
+test_filter 'name == \"*\"' 10
+test_filter 'trace.name == \"synth*\"' 10
+
+# The streams of src.utils.synthetic have no name
+test_filter 'stream.name == \"*\"' 0
+
+test_filter 'payload.f0 >= 0' 10
+test_filter 'payload.f0 < 0' 0
+test_filter 'payload.f1 in [-9223372036854775808, 9223372036854775807]' 10
+test_filter 'payload.f2 == \"*\"' 10
+test_filter 'payload.nope == 1 || payload.f2 < 1' 0
+test_filter 'name == \"a\" || payload.f0 < 0' 5
+test_filter '!(name == \"a\") && payload.f0 >= 0' 5
+
+bt_cli "$temp_stdout" "$temp_stderr" run \
+	-c src:src.utils.synthetic -p "$synth_params" \
+	-c flt:flt.utils.filter -p 'expression="name =="' \
+	-c sink:sink.utils.counter \
+	-C src:flt -C flt:sink
+isnt "$?" 0 "invalid expression fails"
+
+# CTF traces: sink.utils.counter needs no event field, but the filter
+# needs the payloads
+test_ctf_fs_filter barectf-event-before-packet value
+test_ctf_fs_filter debug-info my_integer_field
+
+rm -f "$temp_stdout" "$temp_stderr" "$temp_details"
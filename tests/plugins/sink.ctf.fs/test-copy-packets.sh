@@ -0,0 +1,121 @@
+#!/bin/bash
+#
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2024 EfficiOS Inc.
+#
+
+# This file tests the copy-packets parameter of sink.ctf.fs.
+
+SH_TAP=1
+
+if [ -n "${BT_TESTS_SRCDIR:-}" ]; then
+	UTILSSH="$BT_TESTS_SRCDIR/utils/utils.sh"
+else
+	UTILSSH="$(dirname "$0")/../../utils/utils.sh"
+fi
+
+# shellcheck source=../../utils/utils.sh
+source "$UTILSSH"
+
+# LTTng trace with packetized metadata
+src_trace_dir="$BT_CTF_TRACES_PATH/succeed/trace-with-index"
+
+temp_expected_stdout=$(mktemp)
+temp_trimmed_expected_stdout=$(mktemp)
+temp_stdout=$(mktemp)
+temp_stderr=$(mktemp)
+temp_output_dir=$(mktemp -d)
+
+# Prints the number of packets which sink.ctf.fs copied verbatim,
+# according to its INFO logs in the file `$1`.
+copied_packet_count() {
+	grep -c 'Copied packet verbatim' "$1"
+}
+
+# Runs sink.ctf.fs with copy-packets=true and INFO logs, writing the
+# trace `$src_trace_dir` to the directory `$1`, the other arguments
+# being additional `babeltrace2` arguments.
+run_copy_packets() {
+	local trace_dir="$1"
+
+	shift
+	bt_cli "$temp_stdout" "$temp_stderr" --log-level=I "$@" "$src_trace_dir" \
+		-c sink.ctf.fs -p "path=\"$trace_dir\"" -p 'assume-single-trace=true' \
+		-p 'copy-packets=true' -p 'quiet=true'
+}
+
+plan_tests 14
+
+bt_cli "$temp_expected_stdout" /dev/null --clock-seconds "$src_trace_dir"
+ok "$?" "read source trace"
+
+bt_cli "$temp_stdout" /dev/null -c sink.text.details \
+	-p compact=yes,with-metadata=no "$src_trace_dir"
+packet_count=$(grep -c 'Packet beginning' "$temp_stdout")
+
+# Times of the events at the middle and at 90 % of the trace
+event_count=$(wc -l < "$temp_expected_stdout")
+begin=$(sed -n "$((event_count / 2)){s/^\[\([0-9.]*\)\].*/\1/p}" "$temp_expected_stdout")
+end=$(sed -n "$((event_count * 9 / 10)){s/^\[\([0-9.]*\)\].*/\1/p}" "$temp_expected_stdout")
+
+# Whole trace: all the packets are intact
+trace_dir="$temp_output_dir/whole"
+run_copy_packets "$trace_dir"
+ok "$?" "run sink.ctf.fs with copy-packets=true"
+
+is "$(copied_packet_count "$temp_stderr")" "$packet_count" \
+	"sink.ctf.fs copies all the packets verbatim ($packet_count)"
+
+grep -q 'Copying the packets of trace with its original metadata' "$temp_stderr"
+ok "$?" "sink.ctf.fs writes the original metadata"
+
+bt_diff_cli "$temp_expected_stdout" /dev/null --clock-seconds "$trace_dir"
+ok "$?" "read back whole output trace"
+
+for stream_file in "$src_trace_dir"/ust_channel_*; do
+	if ! cmp -s "$stream_file" "$trace_dir/$(basename "$stream_file")"; then
+		diag "Stream file \`$stream_file\` differs from its copy"
+		false
+		break
+	fi
+done
+
+ok "$?" "output stream files are the same as the source stream files"
+
+# Trimmed trace: the first packet which sink.ctf.fs receives contains
+# the beginning time, so it's not intact: sink.ctf.fs refuses to copy
+# the packets and encodes all the events instead.
+bt_cli "$temp_trimmed_expected_stdout" /dev/null --clock-seconds --begin="$begin" \
+	"$src_trace_dir"
+ok "$?" "read trimmed source trace"
+
+trace_dir="$temp_output_dir/trimmed"
+run_copy_packets "$trace_dir" --begin="$begin"
+ok "$?" "run sink.ctf.fs with copy-packets=true after trimming the beginning"
+
+is "$(copied_packet_count "$temp_stderr")" 0 \
+	"sink.ctf.fs doesn't copy any packet of a trimmed trace"
+
+grep -q 'Encoding the packets of trace' "$temp_stderr"
+ok "$?" "sink.ctf.fs encodes the packets of a trimmed trace"
+
+bt_diff_cli "$temp_trimmed_expected_stdout" /dev/null --clock-seconds "$trace_dir"
+ok "$?" "read back trimmed output trace"
+
+# Trimmed end: sink.ctf.fs copies the first, intact packets, and then
+# cannot copy the packets which contain the end time nor encode them
+# with the original metadata.
+trace_dir="$temp_output_dir/trimmed-end"
+run_copy_packets "$trace_dir" --end="$end"
+isnt "$?" 0 "sink.ctf.fs with copy-packets=true fails after trimming the end"
+
+isnt "$(copied_packet_count "$temp_stderr")" 0 \
+	"sink.ctf.fs copies the first packets of the trace"
+
+grep -q 'Cannot copy altered packet to a trace with copied packets' "$temp_stderr"
+ok "$?" "sink.ctf.fs refuses to copy an altered packet"
+
+rm -rf "$temp_output_dir"
+rm -f "$temp_expected_stdout" "$temp_trimmed_expected_stdout" "$temp_stdout" \
+	"$temp_stderr"
@@ -0,0 +1,93 @@
+#!/bin/bash
+#
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2024 EfficiOS Inc.
+#
+
+# This file tests the write-index and compress parameters of sink.ctf.fs.
+
+SH_TAP=1
+
+if [ -n "${BT_TESTS_SRCDIR:-}" ]; then
+	UTILSSH="$BT_TESTS_SRCDIR/utils/utils.sh"
+else
+	UTILSSH="$(dirname "$0")/../../utils/utils.sh"
+fi
+
+# shellcheck source=../../utils/utils.sh
+source "$UTILSSH"
+
+input_trace_dir="$BT_CTF_TRACES_PATH/succeed/trace-with-index"
+
+temp_expected_stdout=$(mktemp)
+temp_stdout=$(mktemp)
+temp_stderr=$(mktemp)
+temp_output_dir=$(mktemp -d)
+
+plan_tests 8
+
+# Expected text output of the output traces
+bt_cli "$temp_expected_stdout" /dev/null "$input_trace_dir"
+ok "$?" "read input trace"
+
+# Checks that the output trace `$1` has an index file for each stream
+# file of which the name ends with `$2`.
+check_index_files() {
+	local -r trace_dir=$1
+	local -r suffix=$2
+	local stream_file
+	local name
+	local missing=0
+
+	for stream_file in "$trace_dir"/*"$suffix"; do
+		name=$(basename "$stream_file" "$suffix")
+
+		if [ "$name" = "metadata" ] || [ "$name" = "index" ]; then
+			continue
+		fi
+
+		if [ ! -f "$trace_dir/index/$name.idx" ]; then
+			diag "Missing index file for stream file \`$stream_file\`"
+			missing=1
+		fi
+	done
+
+	return $missing
+}
+
+# Uncompressed stream files with index files
+trace_dir="$temp_output_dir/indexed"
+bt_cli "$temp_stdout" "$temp_stderr" "$input_trace_dir" \
+	-c sink.ctf.fs -p "path=\"$trace_dir\"" -p 'assume-single-trace=true' \
+	-p 'write-index=true' -p 'quiet=true'
+ok "$?" "run sink.ctf.fs with write-index=true"
+
+check_index_files "$trace_dir" ""
+ok "$?" "index files exist"
+
+bt_diff_cli "$temp_expected_stdout" /dev/null "$trace_dir"
+ok "$?" "read back indexed output trace"
+
+# Compressed stream files with index files
+trace_dir="$temp_output_dir/compressed"
+
+[ "$BT_TESTS_ENABLE_ZSTD" != "1" ]
+skip $? "This test requires zstd support" 4 || {
+	bt_cli "$temp_stdout" "$temp_stderr" "$input_trace_dir" \
+		-c sink.ctf.fs -p "path=\"$trace_dir\"" -p 'assume-single-trace=true' \
+		-p 'write-index=true' -p 'compress=true' -p 'quiet=true'
+	ok "$?" "run sink.ctf.fs with write-index=true and compress=true"
+
+	compgen -G "$trace_dir/ust_channel_*.zst" > /dev/null
+	ok "$?" "compressed stream files exist"
+
+	check_index_files "$trace_dir" ".zst"
+	ok "$?" "index files of compressed stream files exist"
+
+	bt_diff_cli "$temp_expected_stdout" /dev/null "$trace_dir"
+	ok "$?" "read back compressed output trace"
+}
+
+rm -rf "$temp_output_dir"
+rm -f "$temp_expected_stdout" "$temp_stdout" "$temp_stderr"
@@ -47,6 +47,16 @@ test_ctf_single() {
 	ok $? "Trace '$name' gives the expected output"
 }
 
+test_prefetch_depth() {
+	local name="$1"
+	local depth="$2"
+
+	bt_diff_cli "$expect_dir/trace-$name.expect" /dev/null \
+		"$succeed_trace_dir/$name" -p "prefetch-depth=+$depth" \
+		-c sink.text.details "${test_ctf_common_details_args[@]}"
+	ok $? "Trace '$name' gives the expected output with a prefetch depth of $depth"
+}
+
 test_packet_end() {
 	local name="$1"
 	local expected_stdout="$expect_dir/trace-$name.expect"
@@ -125,7 +135,7 @@ test_force_origin_unix_epoch() {
 	rm -f "$temp_stdout_output_file" "$temp_stderr_output_file"
 }
 
-plan_tests 13
+plan_tests 15
 
 test_force_origin_unix_epoch 2packets barectf-event-before-packet
 test_ctf_gen_single simple
@@ -137,5 +147,7 @@ test_ctf_single lttng-tracefile-rotation
 test_ctf_single array-align-elem
 test_ctf_single struct-array-align-elem
 test_ctf_single meta-ctx-sequence
+test_prefetch_depth lttng-tracefile-rotation 0
+test_prefetch_depth lttng-tracefile-rotation 1
 test_packet_end lttng-event-after-packet
 test_packet_end lttng-crash
@@ -0,0 +1,71 @@
+#!/bin/bash
+#
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2026 EfficiOS Inc.
+#
+
+# This file tests that src.ctf.fs reads stream files in the zstd
+# seekable format (`.zst` suffix).
+#
+# The `trace-with-index-zstd` trace is `succeed/trace-with-index` of
+# which each stream file is compressed with 3000-byte frames, so that
+# most packets span more than one frame.
+
+SH_TAP=1
+
+if [ -n "${BT_TESTS_SRCDIR:-}" ]; then
+	UTILSSH="$BT_TESTS_SRCDIR/utils/utils.sh"
+else
+	UTILSSH="$(dirname "$0")/../../utils/utils.sh"
+fi
+
+# shellcheck source=../../utils/utils.sh
+source "$UTILSSH"
+
+plain_trace_dir="$BT_CTF_TRACES_PATH/succeed/trace-with-index"
+compressed_trace_dir="$BT_CTF_TRACES_PATH/compressed/trace-with-index-zstd"
+
+temp_expected_stdout=$(mktemp)
+temp_stdout=$(mktemp)
+temp_stderr=$(mktemp)
+temp_trace_dir=$(mktemp -d)
+
+plan_tests 5
+
+[ "$BT_TESTS_ENABLE_ZSTD" != "1" ]
+skip $? "This test requires zstd support" 4 || {
+	bt_cli "$temp_expected_stdout" /dev/null --clock-seconds \
+		"$plain_trace_dir"
+	ok "$?" "read uncompressed trace"
+
+	bt_diff_cli "$temp_expected_stdout" /dev/null --clock-seconds \
+		"$compressed_trace_dir"
+	ok "$?" "compressed trace gives the same output"
+
+	# Without index files, src.ctf.fs finds the packets by decoding
+	# the decompressed packet headers.
+	cp -R "$compressed_trace_dir/." "$temp_trace_dir"
+	rm -rf "$temp_trace_dir/index"
+	bt_diff_cli "$temp_expected_stdout" /dev/null --clock-seconds \
+		"$temp_trace_dir"
+	ok "$?" "compressed trace without index files gives the same output"
+
+	# Seeking: begin in the middle of the trace
+	event_count=$(wc -l < "$temp_expected_stdout")
+	begin=$(sed -n "$((event_count / 2)){s/^\[\([0-9.]*\)\].*/\1/p}" "$temp_expected_stdout")
+	bt_cli "$temp_expected_stdout" /dev/null --clock-seconds \
+		--begin="$begin" "$plain_trace_dir"
+	bt_diff_cli "$temp_expected_stdout" /dev/null --clock-seconds \
+		--begin="$begin" "$compressed_trace_dir"
+	ok "$?" "trimmed compressed trace gives the same output"
+}
+
+[ "$BT_TESTS_ENABLE_ZSTD" = "1" ]
+skip $? "This test requires zstd support to be disabled" 1 || {
+	bt_cli "$temp_stdout" "$temp_stderr" "$compressed_trace_dir"
+	isnt "$?" 0 "reading a compressed trace without zstd support fails"
+}
+
+rm -rf "$temp_trace_dir"
+rm -f "$temp_expected_stdout" "$temp_stdout" "$temp_stderr"
@@ -0,0 +1,210 @@
+#!/bin/bash
+#
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2026 EfficiOS Inc.
+#
+
+# This file tests that a src.ctf.fs message iterator which skips the
+# event fields that its downstream component doesn't need emits the
+# same events as when it decodes all of them.
+#
+# sink.utils.counter needs no event field: the message iterator skips
+# each event dynamic scope which has a fixed layout, and decodes the
+# other ones (strings, sequences, variants, and stored sequence lengths
+# or variant tags) without setting their fields. sink.text.details
+# needs all of them.
+
+SH_TAP=1
+
+if [ -n "${BT_TESTS_SRCDIR:-}" ]; then
+	UTILSSH="$BT_TESTS_SRCDIR/utils/utils.sh"
+else
+	UTILSSH="$(dirname "$0")/../../utils/utils.sh"
+fi
+
+# shellcheck source=../../utils/utils.sh
+source "$UTILSSH"
+
+succeed_trace_dir="$BT_CTF_TRACES_PATH/succeed"
+plugin_dir="$BT_TESTS_DATADIR/plugins/src.ctf.fs/needed-event-fields"
+
+temp_stdout=$(mktemp)
+temp_stderr=$(mktemp)
+temp_payloads=$(mktemp)
+temp_payloads_expected=$(mktemp)
+
+# Event dynamic scopes with a fixed layout: skipped
+skip_traces=(
+	2packets
+	array-align-elem
+	barectf-event-before-packet
+	struct-array-align-elem
+	wk-heartbeat-u
+)
+
+# Event dynamic scopes with sequences, stored lengths, variants, or
+# stored tags: decoded
+decode_traces=(
+	lf-metadata
+	meta-variant-one-underscore
+	meta-variant-reserved-keywords
+	sequence
+)
+
+# Traces with a single data stream, which a src.ctf.fs component can
+# connect directly to a sink component
+single_stream_traces=(
+	barectf-event-before-packet
+	lf-metadata
+	meta-variant-one-underscore
+	struct-array-align-elem
+)
+
+# Traces with timestamps, to trim
+trim_traces=(
+	2packets
+	barectf-event-before-packet
+	lf-metadata
+	sequence
+	wk-heartbeat-u
+)
+
+# Prints the number of event messages which sink.utils.counter
+# counted in the file `$1`.
+counter_event_count() {
+	awk '$2 == "Event" { print $1 }' "$1"
+}
+
+# Prints the number of event messages of the compact sink.text.details
+# output file `$1`.
+details_event_count() {
+	grep -c '} Event ' "$1"
+}
+
+# Checks that sink.utils.counter counts as many event messages as
+# sink.text.details prints, adding each sink component, named `sink`,
+# to the `babeltrace2` arguments which follow the test name `$1`.
+test_event_count() {
+	local test_name="$1"
+	local details_count
+
+	shift
+
+	bt_cli "$temp_stdout" "$temp_stderr" "$@" \
+		-c sink:sink.text.details -p compact=yes,with-metadata=no
+	details_count=$(details_event_count "$temp_stdout")
+	bt_cli "$temp_stdout" "$temp_stderr" "$@" \
+		-c sink:sink.utils.counter
+	is "$(counter_event_count "$temp_stdout")" "$details_count" \
+		"$test_name: same event count as a full decode ($details_count)"
+}
+
+# Prints the `--begin` and `--end` option arguments, one per line, of a
+# time range which contains the middle third of the events of the
+# trace `$1`, using the timestamps of a full decode.
+print_middle_third_time_range() {
+	local trace_dir="$1"
+	local ns_from_origin=()
+	local count
+	local ns
+
+	bt_cli "$temp_stdout" "$temp_stderr" "$trace_dir" \
+		-c sink.text.details -p compact=yes,with-metadata=no
+
+	# `[CYCLES NS] {...} Event ...`: keep `NS`, without the commas
+	mapfile -t ns_from_origin < <(grep '} Event ' "$temp_stdout" |
+		sed -E 's/^\[[0-9,]+ ([0-9,-]+)\].*/\1/; s/,//g' | sort -n)
+	count=${#ns_from_origin[@]}
+
+	for ns in "${ns_from_origin[$((count / 3))]}" \
+			"${ns_from_origin[$((count * 2 / 3))]}"; do
+		printf '%d.%09d\n' $((ns / 1000000000)) $((ns % 1000000000))
+	done
+}
+
+# Checks that, between the timestamps of the first and second thirds of
+# the events of the trace `$1`, flt.utils.trimmer lets as many events
+# through with sink.utils.counter as with sink.text.details.
+#
+# With sink.utils.counter, flt.utils.trimmer gets the timestamps of
+# events of which the src.ctf.fs message iterator skipped the dynamic
+# scopes: a wrong skip size makes it read the next event header at the
+# wrong offset.
+test_trimmer() {
+	local trace_name="$1"
+	local trace_dir="$succeed_trace_dir/$trace_name"
+	local bounds
+
+	mapfile -t bounds < <(print_middle_third_time_range "$trace_dir")
+	test_event_count "'$trace_name', muxer and trimmer" \
+		"$trace_dir" --begin="${bounds[0]}" --end="${bounds[1]}"
+}
+
+# Runs a graph in which a flt.needed_event_fields.Payloads component
+# between a src.ctf.fs component reading the trace `$1` and a sink
+# component of the class `$2` writes the event payloads to
+# `$temp_payloads`.
+run_payloads_filter() {
+	local trace_dir="$1"
+	local sink_comp_cls="$2"
+
+	: > "$temp_payloads"
+	bt_cli "$temp_stdout" "$temp_stderr" run \
+		--plugin-path="$plugin_dir" \
+		-c src:src.ctf.fs -p "inputs=[\"$trace_dir\"]" \
+		-c flt:filter.needed_event_fields.Payloads \
+		-p "path=\"$temp_payloads\"" \
+		-c sink:"$sink_comp_cls" \
+		-C src:flt -C flt:sink
+}
+
+# Checks that flt.needed_event_fields.Payloads, which doesn't forward
+# the needed event fields of its downstream component, gets the same
+# event payloads from the trace `$1` with sink.utils.counter (no needed
+# event fields) as with sink.utils.dummy (default needed event fields)
+# downstream.
+test_non_forwarding_filter() {
+	local trace_name="$1"
+	local trace_dir="$succeed_trace_dir/$trace_name"
+	local dummy_status
+
+	if [ "$BT_TESTS_ENABLE_PYTHON_PLUGINS" != "1" ]; then
+		skip 0 "Python plugins are not enabled" 2
+		return
+	fi
+
+	run_payloads_filter "$trace_dir" sink.utils.dummy
+	dummy_status=$?
+	cp "$temp_payloads" "$temp_payloads_expected"
+	run_payloads_filter "$trace_dir" sink.utils.counter
+	ok $((dummy_status || $?)) \
+		"'$trace_name', non-forwarding filter: graphs run successfully"
+
+	[ -s "$temp_payloads_expected" ] &&
+		bt_diff "$temp_payloads_expected" "$temp_payloads"
+	ok $? "'$trace_name', non-forwarding filter: filter gets the decoded payloads"
+}
+
+plan_tests $((${#skip_traces[@]} + ${#decode_traces[@]} + ${#single_stream_traces[@]} + ${#trim_traces[@]} + 2))
+
+for trace_name in "${skip_traces[@]}" "${decode_traces[@]}"; do
+	test_event_count "'$trace_name', muxer" \
+		"$succeed_trace_dir/$trace_name"
+done
+
+# No muxer: src.ctf.fs gets the needed event fields of the sink directly
+for trace_name in "${single_stream_traces[@]}"; do
+	trace_dir="$succeed_trace_dir/$trace_name"
+	test_event_count "'$trace_name', no muxer" run \
+		-c src:src.ctf.fs -p "inputs=[\"$trace_dir\"]" -C src:sink
+done
+
+for trace_name in "${trim_traces[@]}"; do
+	test_trimmer "$trace_name"
+done
+
+test_non_forwarding_filter barectf-event-before-packet
+
+rm -f "$temp_stdout" "$temp_stderr" "$temp_payloads" \
+	"$temp_payloads_expected"
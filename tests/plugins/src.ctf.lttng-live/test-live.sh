@@ -288,6 +288,69 @@ test_rate_limited() {
 		"$expected_stderr" "$trace_dir_native" "${server_args[@]}"
 }
 
+test_whole_packets() {
+	# Attach and consume data from a multi packets ust session, fetching
+	# each packet with a single request.
+	local test_text="CLI whole packet requests"
+	local cli_args_template="-c src.ctf.lttng-live --params inputs=[\"net://localhost:@PORT@/host/hostname/trace-with-index\"],session-not-found-action=\"end\",whole-packets=true -c sink.text.details"
+	local server_args=("$test_data_dir/base.json")
+	local expected_stdout="${test_data_dir}/cli-base.expect"
+	local expected_stderr="/dev/null"
+
+	run_test "$test_text" "$cli_args_template" "$expected_stdout" \
+		"$expected_stderr" "$trace_dir_native" "${server_args[@]}"
+}
+
+test_archive() {
+	# Attach and consume data from a multi packets ust session, archiving
+	# the trace, and compare the archived trace to the original trace.
+	local test_text="CLI archive trace"
+	local archive_dir
+	local cli_args_template
+	local server_args=("$test_data_dir/base.json")
+	local expected_stdout="${test_data_dir}/cli-base.expect"
+	local expected_stderr="/dev/null"
+	local details_params="with-trace-name=false,with-stream-name=false"
+	local archive_stdout
+	local original_stdout
+
+	archive_dir="$(mktemp -d -t 'test-live-archive.XXXXXX')"
+	archive_stdout="$(mktemp -t test-live-archive-stdout.XXXXXX)"
+	original_stdout="$(mktemp -t test-live-original-stdout.XXXXXX)"
+	cli_args_template="-c src.ctf.lttng-live --params inputs=[\"net://localhost:@PORT@/host/hostname/trace-with-index\"],session-not-found-action=\"end\",archive-path=\"$archive_dir\" -c sink.text.details"
+
+	run_test "$test_text" "$cli_args_template" "$expected_stdout" \
+		"$expected_stderr" "$trace_dir_native" "${server_args[@]}"
+
+	bt_cli "$original_stdout" /dev/null "${trace_dir}/succeed/trace-with-index" \
+		-c sink.text.details --params "$details_params"
+	bt_cli "$archive_stdout" /dev/null "$archive_dir" \
+		-c sink.text.details --params "$details_params"
+	bt_diff "$original_stdout" "$archive_stdout"
+	ok $? "$test_text - archived trace"
+
+	# Archive the same trace again with the same archive path: the
+	# second session must not overwrite the files of the first one.
+	local first_trace_dir
+
+	first_trace_dir="$(dirname "$(find "$archive_dir" -name metadata)")"
+	run_test "$test_text (same archive path)" "$cli_args_template" \
+		"$expected_stdout" "$expected_stderr" "$trace_dir_native" \
+		"${server_args[@]}"
+
+	is "$(find "$archive_dir" -name metadata | wc -l | tr -d " ")" 2 \
+		"$test_text - second archive has its own directory"
+
+	bt_cli "$archive_stdout" /dev/null "$first_trace_dir" \
+		-c sink.text.details --params "$details_params"
+	bt_diff "$original_stdout" "$archive_stdout"
+	ok $? "$test_text - first archived trace is intact"
+
+	rm -rf "$archive_dir"
+	rm -f "$archive_stdout"
+	rm -f "$original_stdout"
+}
+
 test_compare_to_ctf_fs() {
 	# Compare the details text sink or ctf.fs and ctf.lttng-live to ensure
 	# that the trace is parsed the same way.
@@ -416,12 +479,14 @@ test_live_new_stream_during_inactivity() {
 	rm -rf "$tmp_dir"
 }
 
-plan_tests 20
+plan_tests 29
 
 test_list_sessions
 test_base
 test_multi_domains
 test_rate_limited
+test_whole_packets
+test_archive
 test_compare_to_ctf_fs
 test_inactivity_discarded_packet
 test_split_metadata
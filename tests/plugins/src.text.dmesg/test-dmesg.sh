@@ -0,0 +1,185 @@
+#!/bin/bash
+#
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2026 EfficiOS Inc.
+#
+
+# This file tests the src.text.dmesg component class: timestamp
+# extraction, lines without timestamps, lines which span the input
+# buffer boundaries, and follow mode.
+
+SH_TAP=1
+
+if [ -n "${BT_TESTS_SRCDIR:-}" ]; then
+	UTILSSH="$BT_TESTS_SRCDIR/utils/utils.sh"
+else
+	UTILSSH="$(dirname "$0")/../../utils/utils.sh"
+fi
+
+# shellcheck source=../../utils/utils.sh
+source "$UTILSSH"
+
+input_file=$(mktemp -t input.XXXXXX)
+expected_file=$(mktemp -t expected.XXXXXX)
+actual_file=$(mktemp -t actual.XXXXXX)
+temp_stdout=$(mktemp -t stdout.XXXXXX)
+temp_stderr=$(mktemp -t stderr.XXXXXX)
+
+plan_tests 13
+
+# Runs src.text.dmesg with the parameters `$2` and sink.text.details,
+# writing the standard output to the file `$1`.
+run_dmesg() {
+	local -r stdout_file=$1
+	local -r params=$2
+
+	bt_cli "$stdout_file" "$temp_stderr" -c src.text.dmesg -p "$params" \
+		-c sink.text.details -p 'with-metadata=no'
+}
+
+# Prints the `str` payload fields of the sink.text.details output file
+# `$1`, one per line.
+payloads() {
+	sed -n 's/^    str: //p' "$1"
+}
+
+# Prints the timestamps (ns) of the sink.text.details output file `$1`,
+# one per line.
+timestamps() {
+	sed -n 's/^\[\([0-9,]*\) cycles.*/\1/p' "$1" | tr -d ,
+}
+
+# Checks that the payloads of the output file `$1` are the lines of the
+# file `$2`.
+check_payloads() {
+	payloads "$1" > "$actual_file"
+	bt_diff "$2" "$actual_file"
+}
+
+# Checks that the timestamps of the output file `$1` are the lines of
+# the file `$2`.
+check_timestamps() {
+	timestamps "$1" > "$actual_file"
+	bt_diff "$2" "$actual_file"
+}
+
+# Multiple lines with `[SEC.USEC]` timestamps, a blank line, and a last
+# line without a newline character.
+printf '%s\n' \
+	'[    0.000000] Linux version 6.1.0' \
+	'[    0.000001] Command line: ro quiet' \
+	'   ' \
+	'[   12.500000] usb 1-1: new device' > "$input_file"
+printf '%s' '[87166.510937] PM: Finishing wakeup.' >> "$input_file"
+run_dmesg "$temp_stdout" "path=\"$input_file\""
+printf '%s\n' \
+	'Linux version 6.1.0' \
+	'Command line: ro quiet' \
+	'usb 1-1: new device' \
+	'PM: Finishing wakeup.' > "$expected_file"
+check_payloads "$temp_stdout" "$expected_file"
+ok $? "multiple lines: payloads"
+printf '%s\n' 0 1000 12500000000 87166510937000 > "$expected_file"
+check_timestamps "$temp_stdout" "$expected_file"
+ok $? "multiple lines: timestamps"
+
+# Same input from the standard input stream
+bt_cli "$actual_file" "$temp_stderr" -c src.text.dmesg \
+	-c sink.text.details -p 'with-metadata=no' < "$input_file"
+bt_diff "$temp_stdout" "$actual_file"
+ok $? "standard input stream gives the same output"
+
+# Same input, without timestamp extraction: the payloads are the whole
+# lines.
+run_dmesg "$temp_stdout" "path=\"$input_file\",no-extract-timestamp=yes"
+grep -v '^ *$' "$input_file" > "$expected_file"
+check_payloads "$temp_stdout" "$expected_file"
+ok $? "no timestamp extraction: payloads are whole lines"
+timestamps "$temp_stdout" | grep -q .
+isnt $? 0 "no timestamp extraction: no timestamps"
+
+# Human-readable timestamps, two of them within the same second
+printf '%s\n' \
+	'[2026-10-18 12:34:56.100] first' \
+	'[2026-10-18 12:34:56.200] second' \
+	'[2026-10-18 12:34:57.000] third' > "$input_file"
+run_dmesg "$temp_stdout" "path=\"$input_file\""
+printf '%s\n' first second third > "$expected_file"
+check_payloads "$temp_stdout" "$expected_file"
+ok $? "human-readable timestamps: payloads"
+printf '%s\n' 1792326896100000000 1792326896200000000 \
+	1792326897000000000 > "$expected_file"
+check_timestamps "$temp_stdout" "$expected_file"
+ok $? "human-readable timestamps: timestamps"
+
+# Lines without timestamps
+printf '%s\n' 'no timestamp here' '[not a timestamp] either' > "$input_file"
+run_dmesg "$temp_stdout" "path=\"$input_file\""
+check_payloads "$temp_stdout" "$input_file"
+ok $? "lines without timestamps: payloads are whole lines"
+
+# Lines which span the boundaries of the input buffer (initially
+# 256 KiB), and a single line which is larger than the buffer.
+awk 'BEGIN {
+	for (i = 0; i < 20000; i++) {
+		line = "line " i " "
+		for (j = 0; j < i % 50; j++) {
+			line = line "x"
+		}
+		print line
+		if (i == 10000) {
+			line = "y"
+			while (length(line) < 300000) {
+				line = line line
+			}
+			print "long line " line
+		}
+	}
+}' > "$input_file"
+run_dmesg "$temp_stdout" "path=\"$input_file\""
+check_payloads "$temp_stdout" "$input_file"
+ok $? "lines which span the input buffer boundaries"
+
+# Follow mode: read appended lines, including a line which is written
+# in two parts.
+wait_for_payloads() {
+	local -r stdout_file=$1
+	local -r count=$2
+	local i
+
+	for ((i = 0; i < 100; i++)); do
+		if [ "$(payloads "$stdout_file" | wc -l)" -ge "$count" ]; then
+			return 0
+		fi
+
+		sleep 0.1
+	done
+
+	return 1
+}
+
+printf '%s\n' '[1.000000] one' '[2.000000] two' > "$input_file"
+run_dmesg "$temp_stdout" "path=\"$input_file\",follow=yes" &
+bt_pid=$!
+wait_for_payloads "$temp_stdout" 2
+ok $? "follow mode: initial lines"
+
+printf '%s' '[3.000000] thr' >> "$input_file"
+sleep 0.5
+printf '%s\n' 'ee' '[4.000000] four' >> "$input_file"
+wait_for_payloads "$temp_stdout" 4
+ok $? "follow mode: appended lines"
+
+pkill -INT -P "$bt_pid" || kill "$bt_pid"
+wait "$bt_pid"
+printf '%s\n' one two three four > "$expected_file"
+check_payloads "$temp_stdout" "$expected_file"
+ok $? "follow mode: payloads"
+
+bt_cli "$temp_stdout" "$temp_stderr" -c src.text.dmesg -p 'follow=yes' \
+	-c sink.text.details
+isnt $? 0 "follow mode requires a path"
+
+rm -f "$input_file" "$expected_file" "$actual_file" "$temp_stdout" \
+	"$temp_stderr"
@@ -0,0 +1,135 @@
+#!/bin/bash
+#
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2026 EfficiOS Inc.
+#
+
+# This file tests that the messages which src.utils.ipc reads are the
+# ones which sink.utils.ipc wrote.
+
+SH_TAP=1
+
+if [ -n "${BT_TESTS_SRCDIR:-}" ]; then
+	UTILSSH="$BT_TESTS_SRCDIR/utils/utils.sh"
+else
+	UTILSSH="$(dirname "$0")/../../utils/utils.sh"
+fi
+
+# shellcheck source=../../utils/utils.sh
+source "$UTILSSH"
+
+input_trace_dir="$BT_CTF_TRACES_PATH/succeed/trace-with-index"
+
+temp_expected_stdout=$(mktemp)
+temp_stdout=$(mktemp)
+temp_stderr=$(mktemp)
+temp_output_dir=$(mktemp -d)
+
+# Writes the messages of the CTF trace `$1` to a regular file with
+# sink.utils.ipc, and checks that src.utils.ipc reads back the same
+# messages.
+test_ctf_trace_round_trip() {
+	local trace_name="$1"
+	local trace_dir="$BT_CTF_TRACES_PATH/succeed/$trace_name"
+	local ipc_file="$temp_output_dir/$trace_name"
+
+	bt_cli "$temp_expected_stdout" /dev/null "$trace_dir" \
+		-c sink.text.details
+	bt_cli "$temp_stdout" "$temp_stderr" run \
+		-c src:src.ctf.fs -p "inputs=[\"$trace_dir\"]" \
+		-c sink:sink.utils.ipc -p "path=\"$ipc_file\"" \
+		-C src:sink
+	ok "$?" "'$trace_name': write messages"
+
+	bt_diff_cli "$temp_expected_stdout" /dev/null \
+		-c src.utils.ipc -p "path=\"$ipc_file\"" -c sink.text.details
+	ok "$?" "'$trace_name': read back messages"
+}
+
+# Writes the messages of the `src.ipc_test.TheSource` Python component
+# class, of which the event payloads contain all the compound field
+# types, and checks that src.utils.ipc reads back the same messages.
+test_compound_fields_round_trip() {
+	local plugin_dir="$BT_TESTS_DATADIR/plugins/src.utils.ipc"
+	local ipc_file="$temp_output_dir/compound-fields"
+
+	if [ "$BT_TESTS_ENABLE_PYTHON_PLUGINS" != "1" ]; then
+		skip 0 "Python plugins are not enabled" 3
+		return
+	fi
+
+	bt_cli "$temp_expected_stdout" /dev/null run \
+		--plugin-path="$plugin_dir" \
+		-c src:src.ipc_test.TheSource \
+		-c sink:sink.text.details -C src:sink
+	ok "$?" "compound fields: read source messages"
+
+	bt_cli "$temp_stdout" "$temp_stderr" run \
+		--plugin-path="$plugin_dir" \
+		-c src:src.ipc_test.TheSource \
+		-c sink:sink.utils.ipc -p "path=\"$ipc_file\"" \
+		-C src:sink
+	ok "$?" "compound fields: write messages"
+
+	bt_diff_cli "$temp_expected_stdout" /dev/null run \
+		-c src:src.utils.ipc -p "path=\"$ipc_file\"" \
+		-c sink:sink.text.details -C src:sink
+	ok "$?" "compound fields: read back messages"
+}
+
+plan_tests 18
+
+bt_cli "$temp_expected_stdout" /dev/null "$input_trace_dir" \
+	-c sink.text.details
+ok "$?" "read source trace"
+
+# Regular file
+ipc_file="$temp_output_dir/messages"
+bt_cli "$temp_stdout" "$temp_stderr" run \
+	-c src:src.ctf.fs -p "inputs=[\"$input_trace_dir\"]" \
+	-c sink:sink.utils.ipc -p "path=\"$ipc_file\"" \
+	-C src:sink
+ok "$?" "write messages to a regular file"
+
+bt_diff_cli "$temp_expected_stdout" /dev/null \
+	-c src.utils.ipc -p "path=\"$ipc_file\"" -c sink.text.details
+ok "$?" "read back messages from a regular file"
+
+# Truncated file: the reader must fail instead of ending normally
+truncated_ipc_file="$temp_output_dir/truncated"
+head -c "$(($(wc -c < "$ipc_file") - 1))" "$ipc_file" > "$truncated_ipc_file"
+bt_cli "$temp_stdout" "$temp_stderr" \
+	-c src.utils.ipc -p "path=\"$truncated_ipc_file\"" -c sink.text.details
+isnt "$?" 0 "reading a truncated file fails"
+
+# Named pipe
+fifo="$temp_output_dir/fifo"
+mkfifo "$fifo"
+ok "$?" "create named pipe"
+
+bt_cli /dev/null "$temp_stderr" run \
+	-c src:src.ctf.fs -p "inputs=[\"$input_trace_dir\"]" \
+	-c sink:sink.utils.ipc -p "path=\"$fifo\"" \
+	-C src:sink &
+writer_pid=$!
+
+bt_diff_cli "$temp_expected_stdout" /dev/null \
+	-c src.utils.ipc -p "path=\"$fifo\"" -c sink.text.details
+ok "$?" "read back messages from a named pipe"
+
+wait "$writer_pid"
+ok "$?" "write messages to a named pipe"
+
+# Variants and sequences (dynamic arrays)
+test_ctf_trace_round_trip meta-variant-one-underscore
+test_ctf_trace_round_trip sequence
+test_ctf_trace_round_trip meta-ctx-sequence
+test_ctf_trace_round_trip struct-array-align-elem
+
+# Options, variants and dynamic arrays, with and without a selector or
+# length field
+test_compound_fields_round_trip
+
+rm -rf "$temp_output_dir"
+rm -f "$temp_expected_stdout" "$temp_stdout" "$temp_stderr"
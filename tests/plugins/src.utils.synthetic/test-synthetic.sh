@@ -0,0 +1,114 @@
+#!/bin/bash
+#
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Copyright (C) 2026 EfficiOS Inc.
+#
+
+# This file tests the message sequence of src.utils.synthetic and the
+# validation of its parameters.
+
+SH_TAP=1
+
+if [ -n "${BT_TESTS_SRCDIR:-}" ]; then
+	UTILSSH="$BT_TESTS_SRCDIR/utils/utils.sh"
+else
+	UTILSSH="$(dirname "$0")/../../utils/utils.sh"
+fi
+
+# shellcheck source=../../utils/utils.sh
+source "$UTILSSH"
+
+expect_dir="$BT_TESTS_DATADIR/plugins/src.utils.synthetic"
+
+temp_stdout=$(mktemp)
+temp_stderr=$(mktemp)
+temp_stdout2=$(mktemp)
+
+# Runs a src.utils.synthetic component with the parameters `$1`,
+# connected to a sink.text.details component with the parameters `$2`,
+# writing the standard output to `$temp_stdout`.
+#
+# There's no muxer between the two components: the sink receives the
+# messages in the order in which the source emits them.
+run_details() {
+	local synth_params="$1"
+	local details_params="$2"
+
+	bt_cli "$temp_stdout" "$temp_stderr" run \
+		-c src:src.utils.synthetic -p "$synth_params" \
+		-c sink:sink.text.details -p "$details_params" \
+		-C src:sink
+}
+
+# Checks that the compact output of sink.text.details, with the
+# parameters `$2` for src.utils.synthetic, is the contents of the
+# expected file `$1.expect`.
+test_sequence() {
+	local test_name="$1"
+	local synth_params="$2"
+
+	bt_diff_cli "$expect_dir/$test_name.expect" /dev/null run \
+		-c src:src.utils.synthetic -p "$synth_params" \
+		-c sink:sink.text.details -p compact=yes,with-metadata=no \
+		-C src:sink
+	ok $? "'$test_name' message sequence is the expected one"
+}
+
+# Checks that a src.utils.synthetic component with the parameters `$1`
+# fails to initialize.
+test_invalid_params() {
+	local synth_params="$1"
+
+	bt_cli "$temp_stdout" "$temp_stderr" run \
+		-c src:src.utils.synthetic -p "$synth_params" \
+		-c sink:sink.utils.dummy -C src:sink
+	isnt $? 0 "parameters \`$synth_params\` are rejected"
+}
+
+plan_tests 14
+
+# Two streams with two events per packet: round robin between streams,
+# constant timestamp delta.
+test_sequence packets \
+	'stream-count=+2,event-count=+3,events-per-packet=+2'
+
+# Round robin between event classes
+test_sequence event-classes \
+	'event-count=+4,timestamp-mean-delta=+10,event-classes=[{name=a,payload=[u64]},{name=b,payload=[string]}]'
+
+# A discarded events message before the third event; its count is
+# pseudo-random.
+run_details 'event-count=+4,discarded-events-period=+2' \
+	compact=yes,with-metadata=no
+ok $? "discarded events: graph runs successfully"
+sed -E -i 's/\([0-9]+ events\)/(N events)/' "$temp_stdout"
+bt_diff "$expect_dir/discarded-events.expect" "$temp_stdout"
+ok $? "discarded events: message sequence is the expected one"
+
+# Same seed: same output, including the pseudo-random payloads and
+# timestamps.
+seed_params='stream-count=+2,event-count=+20,events-per-packet=+3,timestamp-distribution=uniform,discarded-events-period=+7,seed=+42'
+run_details "$seed_params" with-metadata=no
+cp "$temp_stdout" "$temp_stdout2"
+run_details "$seed_params" with-metadata=no
+bt_diff "$temp_stdout2" "$temp_stdout"
+ok $? "same seed: same output"
+
+# Event message count
+bt_cli "$temp_stdout" "$temp_stderr" run \
+	-c src:src.utils.synthetic -p 'stream-count=+3,event-count=+1000,events-per-packet=+64' \
+	-c sink:sink.utils.counter -C src:sink
+is "$(awk '$2 == "Event" { print $1 }' "$temp_stdout")" 3000 \
+	"three streams: 3000 event messages"
+
+test_invalid_params 'stream-count=+0'
+test_invalid_params 'event-count=10'
+test_invalid_params 'timestamp-mean-delta=+0'
+test_invalid_params 'timestamp-mean-delta=+4294967296'
+test_invalid_params 'timestamp-distribution=gaussian'
+test_invalid_params 'event-classes=[]'
+test_invalid_params 'event-classes=[{name=a,payload=[u128]}]'
+test_invalid_params 'event-classes=[{name=a}]'
+
+rm -f "$temp_stdout" "$temp_stderr" "$temp_stdout2"